@@ -9,6 +9,7 @@
 
 #include "zensim/ZpcImplPattern.hpp"
 #include "zensim/ZpcMeta.hpp"
+#include "zensim/execution/AsyncMemoryPool.hpp"
 #include "zensim/execution/Atomics.hpp"
 
 namespace zs {
@@ -29,6 +30,15 @@ namespace zs {
       constexpr void await_resume() const noexcept {}
     };
 
+    /// @brief coroutine frames come from size-bucketed per-thread slab pools, frames destroyed on
+    /// another thread go back to the owner lock-free, oversized frames fall back to the arena
+    static void *operator new(size_t bytes) {
+      return detail::AsyncBlockAllocator{}.allocate(bytes, alignof(std::max_align_t));
+    }
+    static void operator delete(void *p, size_t bytes) noexcept {
+      detail::AsyncBlockAllocator{}.deallocate(p, bytes, alignof(std::max_align_t));
+    }
+
     std::suspend_always initial_suspend() noexcept { return {}; }
     FinalAwaiter final_suspend() noexcept { return {}; }
     void set_continuation(std::coroutine_handle<> handle) noexcept { _continuation = handle; }
@@ -165,7 +165,7 @@ namespace zs {
   /// @brief predefined monoids
   template <typename T> struct monoid<plus<T>, T> {
     static_assert(is_arithmetic_v<T>, "T must be an arithmetic type.");
-    static constexpr auto identity() noexcept { return 0; }
+    static constexpr T identity() noexcept { return 0; }
     template <typename... Args> constexpr T operator()(Args... args) const noexcept {
       return (args + ...);
     }
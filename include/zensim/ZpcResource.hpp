@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <new>
 
 #include "zensim/ZpcImplPattern.hpp"
 #include "zensim/ZpcTuple.hpp"
@@ -277,6 +278,9 @@ namespace zs {
     return a.get() != b.get();
   }
 
+  template <typename T>
+  class SharedPtr;
+
   namespace detail {
     template <typename From, typename To>
     struct shared_ptr_compatible : bool_constant<is_convertible_v<From*, To*>> {};
@@ -338,6 +342,37 @@ namespace zs {
 
       void delete_self() noexcept override { delete this; }
     };
+
+    /// @brief control block storing the object inline, obtained from an mr-style allocator
+    /// (allocate(bytes, alignment) / deallocate(p, bytes, alignment))
+    template <typename T, typename Alloc>
+    struct SharedInplaceControlBlock final : SharedControlBlockBase {
+      template <typename... Args>
+      SharedInplaceControlBlock(const Alloc& a, Args&&... args) : alloc{a} {
+        ::new (static_cast<void*>(storage)) T(FWD(args)...);
+      }
+
+      T* get() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+
+      void destroy_object() noexcept override { get()->~T(); }
+
+      void delete_self() noexcept override {
+        Alloc a = zs::move(alloc);
+        this->~SharedInplaceControlBlock();
+        a.deallocate(static_cast<void*>(this), sizeof(SharedInplaceControlBlock),
+                     alignof(SharedInplaceControlBlock));
+      }
+
+      Alloc alloc;
+      alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    struct SharedPtrAccess {
+      template <typename T>
+      static SharedPtr<T> adopt(T* p, SharedControlBlockBase* control) noexcept {
+        return SharedPtr<T>(p, control, 0);
+      }
+    };
   }  // namespace detail
 
   template <typename T>
@@ -466,6 +501,7 @@ namespace zs {
     friend class SharedPtr;
     template <typename U>
     friend class WeakPtr;
+    friend struct detail::SharedPtrAccess;
 
     template <typename To, typename From>
     friend SharedPtr<To> static_pointer_cast(const SharedPtr<From>&) noexcept;
@@ -788,6 +824,24 @@ namespace zs {
     return SharedPtr<T>(new T(FWD(args)...));
   }
 
+  /// @brief single allocation for the control block and the object
+  /// @note 'alloc' follows the memory resource interface (allocate(bytes, alignment) /
+  /// deallocate(p, bytes, alignment)) and is copied into the control block
+  template <typename T, typename Alloc, typename... Args, enable_if_t<!is_array_v<T>> = 0>
+  auto allocate_shared(const Alloc& alloc, Args&&... args) -> SharedPtr<T> {
+    using block_t = detail::SharedInplaceControlBlock<T, Alloc>;
+    Alloc a = alloc;
+    void* mem = a.allocate(sizeof(block_t), alignof(block_t));
+    block_t* block = nullptr;
+    try {
+      block = ::new (mem) block_t(a, FWD(args)...);
+    } catch (...) {
+      a.deallocate(mem, sizeof(block_t), alignof(block_t));
+      throw;
+    }
+    return detail::SharedPtrAccess::adopt<T>(block->get(), block);
+  }
+
   template <typename T, enable_if_t<is_array_v<T> && (extent<T>::value == 0)> = 0>
   auto make_shared(size_t count) -> SharedPtr<remove_extent_t<T>[]> {
     using element_type = remove_extent_t<T>;
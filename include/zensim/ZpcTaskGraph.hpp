@@ -24,25 +24,23 @@ namespace zs {
     TaskGraph &operator=(const TaskGraph &) = delete;
 
     CoroTaskNode *addNode(Future<void> &&task, const char *tag = "") {
-      size_t index = _numNodes.load();
-      do {
-        if (index >= kMaxNodes) return nullptr;
-      } while (!_numNodes.compare_exchange_weak(index, index + 1));
+      auto *node = allocate_node_(tag);
+      if (node) node->_task = zs::move(task);
+      return node;
+    }
 
-      auto *node = &_nodes[index];
-      ::new (static_cast<void *>(node)) CoroTaskNode{};
-      node->_task = zs::move(task);
-      node->_tag = tag;
-      node->_state.store(CoroTaskNode::idle);
+    /// @brief plain callables become callable nodes, no coroutine frame nor type erasure through
+    /// 'function' is involved
+    template <typename F, typename = void_t<decltype(declval<decay_t<F> &>()())>>
+    CoroTaskNode *addNode(F &&fn, const char *tag = "") {
+      auto *node = allocate_node_(tag);
+      if (node) node->set_callable(zs::forward<F>(fn));
       return node;
     }
 
     CoroTaskNode *addNode(function<void()> fn, const char *tag = "") {
-      auto coroutine = [](function<void()> call) -> Future<void> {
-        if (call) call();
-        co_return;
-      };
-      return addNode(coroutine(zs::move(fn)), tag);
+      if (!fn) return addNode([] {}, tag);
+      return addNode<function<void()>>(zs::move(fn), tag);
     }
 
     void addEdge(CoroTaskNode *from, CoroTaskNode *to) {
@@ -52,11 +50,13 @@ namespace zs {
     void submit(AsyncScheduler &scheduler) {
       const size_t count = _numNodes.load();
       for (size_t i = 0; i < count; ++i) _nodes[i]._state.store(CoroTaskNode::idle);
-      for (size_t i = 0; i < count; ++i) {
-        if (_nodes[i]._numDeps.load() == 0) {
-          scheduler.schedule(&_nodes[i]);
-        }
-      }
+      /// roots are collected before any of them runs, otherwise a successor released by an early
+      /// root would be taken for a root as well
+      u32 roots[kMaxNodes];
+      size_t numRoots = 0;
+      for (size_t i = 0; i < count; ++i)
+        if (_nodes[i]._numDeps.load() == 0) roots[numRoots++] = static_cast<u32>(i);
+      for (size_t i = 0; i < numRoots; ++i) scheduler.schedule(&_nodes[roots[i]]);
     }
 
     void wait(AsyncScheduler &scheduler) { scheduler.wait(); }
@@ -72,6 +72,19 @@ namespace zs {
     size_t numNodes() const noexcept { return _numNodes.load(); }
 
   private:
+    CoroTaskNode *allocate_node_(const char *tag) {
+      size_t index = _numNodes.load();
+      do {
+        if (index >= kMaxNodes) return nullptr;
+      } while (!_numNodes.compare_exchange_weak(index, index + 1));
+
+      auto *node = &_nodes[index];
+      ::new (static_cast<void *>(node)) CoroTaskNode{};
+      node->_tag = tag;
+      node->_state.store(CoroTaskNode::idle);
+      return node;
+    }
+
     alignas(alignof(CoroTaskNode)) byte _nodeStorage[sizeof(CoroTaskNode) * kMaxNodes]{};
     CoroTaskNode *_nodes = reinterpret_cast<CoroTaskNode *>(_nodeStorage);
     atomic_size_t _numNodes{0};
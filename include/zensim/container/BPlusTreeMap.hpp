@@ -0,0 +1,792 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "zensim/types/Iterator.h"
+
+namespace zs {
+  /**
+   * A B+tree keeps every entry in its leaves, which are chained into a
+   * doubly-linked list, and only separator keys in the inner nodes. The keys
+   * of a node are stored contiguously and span a few cache lines, so a lookup
+   * touches O(log_B n) nodes, and ordered traversals walk the leaf chain.
+   * It offers the interface of RBTreeMap.
+   *
+   * @tparam Key the type of keys maintained by this map
+   * @tparam Value the type of mapped values
+   * @tparam Compare the compare function
+   * @tparam CacheLines the number of 64-byte cache lines spanned by the keys of a node
+   */
+  template <typename Key, typename Value, typename Compare = std::less<Key>, int CacheLines = 4>
+  class BPlusTreeMap {
+  public:
+    static constexpr int capacity
+        = CacheLines * 64 / (int)sizeof(Key) > 4 ? CacheLines * 64 / (int)sizeof(Key) : 4;
+
+  private:
+    /// @note arithmetic keys under the default ordering are searched by counting the smaller
+    /// keys over the whole (padded) key array. the fixed trip count lets it compile to vector
+    /// compares instead of a data-dependent binary search.
+    static constexpr bool simd_search
+        = std::is_arithmetic_v<Key> && !std::is_same_v<Key, bool>
+          && (std::is_same_v<Compare, std::less<Key>> || std::is_same_v<Compare, std::less<>>);
+    static constexpr int leaf_min = capacity / 2;
+    static constexpr int inner_min = (capacity - 1) / 2;
+    static constexpr int max_depth = 64;
+
+    Compare compare = Compare();
+
+    static Key padding() {
+      if constexpr (simd_search) {
+        if constexpr (std::numeric_limits<Key>::has_infinity)
+          return std::numeric_limits<Key>::infinity();
+        else
+          return std::numeric_limits<Key>::max();
+      } else
+        return Key{};
+    }
+
+    struct Node {
+      int size = 0;
+      bool isLeaf;
+      explicit Node(bool leaf) noexcept : isLeaf{leaf} {}
+    };
+    struct Leaf : Node {
+      Leaf() : Node{true} {
+        for (auto& key : keys) key = padding();
+      }
+      Leaf* prev = this;
+      Leaf* next = this;
+      alignas(64) Key keys[capacity];
+      Value values[capacity];
+    };
+    struct Inner : Node {
+      Inner() : Node{false} {
+        for (auto& key : keys) key = padding();
+      }
+      /// keys of children[i] lie in (keys[i - 1], keys[i]]
+      alignas(64) Key keys[capacity];
+      Node* children[capacity + 1] = {};
+    };
+    struct PathEntry {
+      Inner* node;
+      int child;
+    };
+
+    Leaf* header = nullptr;
+    Node* root = nullptr;
+    size_t cnt = 0;
+
+    using K = const Key&;
+    using V = const Value&;
+
+    /// @brief the number of keys ordered before [key] among the first [n] ones
+    int rank(const Key* keys, int n, K key) const noexcept {
+      if constexpr (simd_search) {
+        int r = 0;
+        for (int i = 0; i != capacity; ++i) r += keys[i] < key ? 1 : 0;
+        return r;
+      } else {
+        int lo = 0, hi = n;
+        while (lo < hi) {
+          const int mid = (lo + hi) / 2;
+          if (compare(keys[mid], key))
+            lo = mid + 1;
+          else
+            hi = mid;
+        }
+        return lo;
+      }
+    }
+
+    template <bool IsConst> struct entry_ref {
+      const Key& first;
+      std::conditional_t<IsConst, const Value&, Value&> second;
+    };
+
+    template <bool IsConst> struct iterator_impl : IteratorInterface<iterator_impl<IsConst>> {
+      using leaf_pointer = std::conditional_t<IsConst, const Leaf*, Leaf*>;
+      constexpr iterator_impl() = default;
+      constexpr iterator_impl(leaf_pointer leaf, int idx) : _leaf{leaf}, _idx{idx} {}
+      template <bool C = IsConst, std::enable_if_t<C, int> = 0>
+      constexpr iterator_impl(const iterator_impl<false>& o) : _leaf{o._leaf}, _idx{o._idx} {}
+
+      constexpr entry_ref<IsConst> dereference() {
+        return {_leaf->keys[_idx], _leaf->values[_idx]};
+      }
+      constexpr bool equal_to(const iterator_impl& it) const noexcept {
+        return it._leaf == _leaf && it._idx == _idx;
+      }
+      constexpr void increment() noexcept {
+        if (++_idx >= _leaf->size) {
+          _leaf = _leaf->next;
+          _idx = 0;
+        }
+      }
+      constexpr void decrement() noexcept {
+        if (_idx == 0) {
+          _leaf = _leaf->prev;
+          _idx = _leaf->size > 0 ? _leaf->size - 1 : 0;
+        } else
+          --_idx;
+      }
+
+      leaf_pointer _leaf{nullptr};
+      int _idx{0};
+    };
+    template <bool IsConst> struct reverse_iterator_impl
+        : IteratorInterface<reverse_iterator_impl<IsConst>> {
+      using leaf_pointer = std::conditional_t<IsConst, const Leaf*, Leaf*>;
+      constexpr reverse_iterator_impl() = default;
+      constexpr reverse_iterator_impl(leaf_pointer leaf, int idx) : _leaf{leaf}, _idx{idx} {}
+      template <bool C = IsConst, std::enable_if_t<C, int> = 0>
+      constexpr reverse_iterator_impl(const reverse_iterator_impl<false>& o)
+          : _leaf{o._leaf}, _idx{o._idx} {}
+
+      constexpr entry_ref<IsConst> dereference() {
+        return {_leaf->keys[_idx], _leaf->values[_idx]};
+      }
+      constexpr bool equal_to(const reverse_iterator_impl& it) const noexcept {
+        return it._leaf == _leaf && it._idx == _idx;
+      }
+      constexpr void increment() noexcept {
+        if (_idx == 0) {
+          _leaf = _leaf->prev;
+          _idx = _leaf->size > 0 ? _leaf->size - 1 : 0;
+        } else
+          --_idx;
+      }
+      constexpr void decrement() noexcept {
+        if (++_idx >= _leaf->size) {
+          _leaf = _leaf->next;
+          _idx = 0;
+        }
+      }
+
+      leaf_pointer _leaf{nullptr};
+      int _idx{0};
+    };
+
+  public:
+    using iterator = LegacyIterator<iterator_impl<false>>;
+    using const_iterator = LegacyIterator<iterator_impl<true>>;
+    using reverse_iterator = LegacyIterator<reverse_iterator_impl<false>>;
+    using const_reverse_iterator = LegacyIterator<reverse_iterator_impl<true>>;
+
+    class NoSuchMappingException : protected std::exception {
+    private:
+      const char* message;
+
+    public:
+      explicit NoSuchMappingException(const char* msg) : message(msg) {}
+
+      const char* what() const noexcept override { return message; }
+    };
+
+    BPlusTreeMap() : header{new Leaf()} {}
+    BPlusTreeMap(const BPlusTreeMap&) = delete;
+    BPlusTreeMap& operator=(const BPlusTreeMap&) = delete;
+    BPlusTreeMap(BPlusTreeMap&& o) : BPlusTreeMap{} { swap(o); }
+    BPlusTreeMap& operator=(BPlusTreeMap&& o) noexcept {
+      swap(o);
+      return *this;
+    }
+    ~BPlusTreeMap() noexcept {
+      this->clear();
+      delete this->header;
+      this->header = nullptr;
+    }
+
+    void swap(BPlusTreeMap& o) noexcept {
+      std::swap(this->compare, o.compare);
+      std::swap(this->header, o.header);
+      std::swap(this->root, o.root);
+      std::swap(this->cnt, o.cnt);
+    }
+
+    constexpr auto begin() noexcept { return make_iterator<iterator_impl<false>>(header->next, 0); }
+    constexpr auto end() noexcept { return make_iterator<iterator_impl<false>>(header, 0); }
+    constexpr auto begin() const noexcept { return cbegin(); }
+    constexpr auto end() const noexcept { return cend(); }
+    constexpr auto cbegin() const noexcept {
+      return make_iterator<iterator_impl<true>>(header->next, 0);
+    }
+    constexpr auto cend() const noexcept { return make_iterator<iterator_impl<true>>(header, 0); }
+    constexpr auto rbegin() noexcept {
+      return make_iterator<reverse_iterator_impl<false>>(
+          header->prev, header->prev->size > 0 ? header->prev->size - 1 : 0);
+    }
+    constexpr auto rend() noexcept {
+      return make_iterator<reverse_iterator_impl<false>>(header, 0);
+    }
+    constexpr auto crbegin() const noexcept {
+      return make_iterator<reverse_iterator_impl<true>>(
+          header->prev, header->prev->size > 0 ? header->prev->size - 1 : 0);
+    }
+    constexpr auto crend() const noexcept {
+      return make_iterator<reverse_iterator_impl<true>>(header, 0);
+    }
+
+    /**
+     * Returns the number of entries in this map.
+     * @return size_t
+     */
+    inline size_t size() const noexcept { return this->cnt; }
+
+    /**
+     * Returns true if this collection contains no elements.
+     * @return bool
+     */
+    inline bool empty() const noexcept { return this->cnt == 0; }
+
+    /**
+     * Removes all of the elements from this map.
+     */
+    void clear() noexcept {
+      if (this->root != nullptr) release(this->root);
+      this->root = nullptr;
+      this->header->next = this->header->prev = this->header;
+      this->cnt = 0;
+    }
+
+    /**
+     * Replaces the content with the entries of [first, last), whose keys must
+     * be strictly increasing. Leaves and inner nodes are filled bottom-up
+     * without any search or split.
+     * @param first range of (key, value) pairs
+     * @param last range of (key, value) pairs
+     * @throws std::runtime_error if the keys are not sorted
+     */
+    template <typename Iter> void bulkLoad(Iter first, Iter last) {
+      std::vector<std::pair<Key, Value>> entries;
+      for (; first != last; ++first) {
+        if (!entries.empty() && !compare(entries.back().first, (*first).first))
+          throw std::runtime_error("BPlusTreeMap::bulkLoad requires strictly increasing keys");
+        entries.emplace_back((*first).first, (*first).second);
+      }
+      this->clear();
+      const size_t n = entries.size();
+      if (n == 0) return;
+
+      /// @note nodes of a level share the entries evenly, keeping every one at least half full
+      std::vector<std::pair<Node*, Key>> level;
+      const size_t numLeaves = (n + capacity - 1) / capacity;
+      for (size_t l = 0, offset = 0; l != numLeaves; ++l) {
+        const size_t num = n / numLeaves + (l < n % numLeaves ? 1 : 0);
+        auto leaf = new Leaf();
+        for (size_t i = 0; i != num; ++i) {
+          leaf->keys[i] = std::move(entries[offset + i].first);
+          leaf->values[i] = std::move(entries[offset + i].second);
+        }
+        leaf->size = (int)num;
+        linkAfter(this->header->prev, leaf);
+        level.emplace_back(leaf, leaf->keys[num - 1]);
+        offset += num;
+      }
+      while (level.size() > 1) {
+        const size_t m = level.size(), numNodes = (m + capacity) / (capacity + 1);
+        std::vector<std::pair<Node*, Key>> upper;
+        for (size_t l = 0, offset = 0; l != numNodes; ++l) {
+          const size_t num = m / numNodes + (l < m % numNodes ? 1 : 0);
+          auto inner = new Inner();
+          for (size_t i = 0; i != num; ++i) {
+            inner->children[i] = level[offset + i].first;
+            if (i + 1 != num) inner->keys[i] = level[offset + i].second;
+          }
+          inner->size = (int)num - 1;
+          upper.emplace_back(inner, std::move(level[offset + num - 1].second));
+          offset += num;
+        }
+        level = std::move(upper);
+      }
+      this->root = level[0].first;
+      this->cnt = n;
+    }
+
+    /**
+     * Returns the value to which the specified key is mapped; If this map
+     * contains no mapping for the key, a {@code NoSuchMappingException} will
+     * be thrown.
+     * @param key
+     * @return BPlusTreeMap<Key, Value>::Value
+     * @throws NoSuchMappingException
+     */
+    Value get(K key) const {
+      auto [leaf, pos] = this->locate(key);
+      if (leaf == nullptr || pos == leaf->size || compare(key, leaf->keys[pos]))
+        throw NoSuchMappingException("Invalid key");
+      return leaf->values[pos];
+    }
+
+    /**
+     * Returns the value to which the specified key is mapped; If this map
+     * contains no mapping for the key, a new mapping with a default value
+     * will be inserted.
+     * @param key
+     * @return BPlusTreeMap<Key, Value>::Value &
+     */
+    Value& getOrDefault(K key) {
+      auto [leaf, pos] = this->emplace(key, nullptr);
+      return leaf->values[pos];
+    }
+
+    /**
+     * Returns true if this map contains a mapping for the specified key.
+     * @param key
+     * @return size_t
+     */
+    size_t count(K key) const {
+      auto [leaf, pos] = this->locate(key);
+      return leaf != nullptr && pos != leaf->size && !compare(key, leaf->keys[pos]) ? 1 : 0;
+    }
+
+    /**
+     * Associates the specified value with the specified key in this map.
+     * @param key
+     * @param value
+     */
+    void insert(K key, V value) { this->emplace(key, &value); }
+
+    Value at(K key) const { return this->get(key); }
+    Value& operator[](K key) { return this->getOrDefault(key); }
+
+    /**
+     * Returns an iterator to the entry of key, or end() if there is none.
+     * @param key
+     * @return BPlusTreeMap<Key, Value>::iterator
+     */
+    iterator find(K key) {
+      auto it = this->lower_bound(key);
+      return it == this->end() || compare(key, it->first) ? this->end() : it;
+    }
+    const_iterator find(K key) const {
+      auto it = this->lower_bound(key);
+      return it == this->cend() || compare(key, it->first) ? this->cend() : it;
+    }
+
+    /**
+     * Removes the element at position
+     * @param position iterator to the element to remove
+     * @return BPlusTreeMap<Key, Value>::iterator
+     */
+    iterator erase(const_iterator position) {
+      if (position == this->cend()) return this->end();
+      const Key key = position->first;
+      this->remove(key);
+      return this->upper_bound(key);
+    }
+    iterator erase(iterator position) { return this->erase(const_iterator{position}); }
+
+    /**
+     * Removes the elements in the range [first; last)
+     * @param first range of elements to remove
+     * @param last range of elements to remove
+     * @return BPlusTreeMap<Key, Value>::iterator
+     */
+    iterator erase(const_iterator first, const_iterator last) {
+      if (first == this->cbegin() && last == this->cend()) {
+        this->clear();
+        return this->end();
+      }
+      if (last == this->cend()) {
+        iterator it = this->erase(first);
+        while (it != this->end()) it = this->erase(it);
+        return it;
+      }
+      const Key stop = last->first;
+      iterator it = make_iterator<iterator_impl<false>>(const_cast<Leaf*>(first._leaf), first._idx);
+      while (compare(it->first, stop)) it = this->erase(it);
+      return it;
+    }
+    iterator erase(iterator first, iterator last) {
+      return this->erase(const_iterator{first}, const_iterator{last});
+    }
+
+    /**
+     * Removes the elements with the key value key
+     * @param key key value of the elements to remove
+     * @return size_t
+     */
+    size_t erase(K key) { return this->remove(key) ? 1 : 0; }
+
+    /**
+     * Returns an iterator pointing to the first element that is not less than key.
+     * @param key
+     * @return BPlusTreeMap<Key, Value>::iterator
+     */
+    iterator lower_bound(K key) {
+      auto [leaf, pos] = this->locate(key);
+      if (leaf == nullptr) return this->end();
+      if (pos == leaf->size) return make_iterator<iterator_impl<false>>(leaf->next, 0);
+      return make_iterator<iterator_impl<false>>(leaf, pos);
+    }
+    const_iterator lower_bound(K key) const {
+      return const_cast<BPlusTreeMap*>(this)->lower_bound(key);
+    }
+
+    /**
+     * Returns an iterator pointing to the first element that is greater than key.
+     * @param key
+     * @return BPlusTreeMap<Key, Value>::iterator
+     */
+    iterator upper_bound(K key) {
+      auto [leaf, pos] = this->locate(key);
+      if (leaf == nullptr) return this->end();
+      if (pos != leaf->size && !compare(key, leaf->keys[pos])) ++pos;
+      if (pos == leaf->size) return make_iterator<iterator_impl<false>>(leaf->next, 0);
+      return make_iterator<iterator_impl<false>>(leaf, pos);
+    }
+    const_iterator upper_bound(K key) const {
+      return const_cast<BPlusTreeMap*>(this)->upper_bound(key);
+    }
+
+    /**
+     * Remove all entries that satisfy the filter condition.
+     * @param filter
+     */
+    template <typename KeyValueFilterF> void removeAll(KeyValueFilterF&& filter) {
+      std::vector<Key> keys;
+      this->forEach([&](K key, V value) {
+        if (filter(key, value)) keys.push_back(key);
+      });
+      for (const Key& key : keys) this->remove(key);
+    }
+
+    /**
+     * Performs the given action for each key and value entry in this map.
+     * The value is immutable for the action.
+     * @param action
+     */
+    template <typename KeyValueConsumerF> void forEach(KeyValueConsumerF&& action) const {
+      for (const Leaf* leaf = header->next; leaf != header; leaf = leaf->next)
+        for (int i = 0; i != leaf->size; ++i) action(leaf->keys[i], leaf->values[i]);
+    }
+
+    /**
+     * Performs the given action for each key and value entry in this map.
+     * The value is mutable for the action.
+     * @param action
+     */
+    template <typename MutKeyValueConsumerF> void forEachMut(MutKeyValueConsumerF&& action) {
+      for (Leaf* leaf = header->next; leaf != header; leaf = leaf->next)
+        for (int i = 0; i != leaf->size; ++i) action(leaf->keys[i], leaf->values[i]);
+    }
+
+    /**
+     * Performs the given action for each entry whose key lies in [lo, hi),
+     * scanning the linked leaves from the leaf of lo.
+     * The value is immutable for the action.
+     * @param lo inclusive lower bound
+     * @param hi exclusive upper bound
+     * @param action
+     */
+    template <typename KeyValueConsumerF>
+    void forEachInRange(K lo, K hi, KeyValueConsumerF&& action) const {
+      const_cast<BPlusTreeMap*>(this)->forEachInRangeMut(
+          lo, hi, [&action](K key, Value& value) { action(key, (V)value); });
+    }
+
+    /**
+     * Performs the given action for each entry whose key lies in [lo, hi).
+     * The value is mutable for the action.
+     * @param lo inclusive lower bound
+     * @param hi exclusive upper bound
+     * @param action
+     */
+    template <typename MutKeyValueConsumerF>
+    void forEachInRangeMut(K lo, K hi, MutKeyValueConsumerF&& action) {
+      auto [leaf, pos] = this->locate(lo);
+      if (leaf == nullptr) return;
+      for (; leaf != header; leaf = leaf->next, pos = 0) {
+        /// @note the whole leaf is visited without comparisons if its last key is below hi
+        const int ed = compare(leaf->keys[leaf->size - 1], hi) ? leaf->size
+                                                                 : rank(leaf->keys, leaf->size, hi);
+        for (int i = pos; i < ed; ++i) action(leaf->keys[i], leaf->values[i]);
+        if (ed != leaf->size) return;
+      }
+    }
+
+  private:
+    static void linkAfter(Leaf* pos, Leaf* leaf) noexcept {
+      leaf->prev = pos;
+      leaf->next = pos->next;
+      pos->next->prev = leaf;
+      pos->next = leaf;
+    }
+    static void unlink(Leaf* leaf) noexcept {
+      leaf->prev->next = leaf->next;
+      leaf->next->prev = leaf->prev;
+    }
+    static void release(Node* node) noexcept {
+      if (node->isLeaf) {
+        delete static_cast<Leaf*>(node);
+      } else {
+        auto inner = static_cast<Inner*>(node);
+        for (int i = 0; i <= inner->size; ++i) release(inner->children[i]);
+        delete inner;
+      }
+    }
+
+    /// @brief the leaf whose key range covers [key], and the rank of [key] within it
+    std::pair<Leaf*, int> locate(K key) const {
+      if (this->root == nullptr) return {nullptr, 0};
+      Node* node = this->root;
+      while (!node->isLeaf) {
+        auto inner = static_cast<Inner*>(node);
+        node = inner->children[rank(inner->keys, inner->size, key)];
+      }
+      auto leaf = static_cast<Leaf*>(node);
+      return {leaf, rank(leaf->keys, leaf->size, key)};
+    }
+
+    /// @brief moves the entries [st, size) of [from] to the front of the empty leaf [to]
+    static void moveTail(Leaf* from, int st, Leaf* to) {
+      for (int i = st; i != from->size; ++i) {
+        to->keys[i - st] = std::move(from->keys[i]);
+        to->values[i - st] = std::move(from->values[i]);
+        from->keys[i] = padding();
+        from->values[i] = Value{};
+      }
+      to->size = from->size - st;
+      from->size = st;
+    }
+    template <typename KeyT, typename ValueT>
+    static void insertEntry(Leaf* leaf, int pos, KeyT&& key, ValueT&& value) {
+      for (int i = leaf->size; i > pos; --i) {
+        leaf->keys[i] = std::move(leaf->keys[i - 1]);
+        leaf->values[i] = std::move(leaf->values[i - 1]);
+      }
+      leaf->keys[pos] = std::forward<KeyT>(key);
+      leaf->values[pos] = std::forward<ValueT>(value);
+      ++leaf->size;
+    }
+    static void eraseEntry(Leaf* leaf, int pos) {
+      for (int i = pos + 1; i < leaf->size; ++i) {
+        leaf->keys[i - 1] = std::move(leaf->keys[i]);
+        leaf->values[i - 1] = std::move(leaf->values[i]);
+      }
+      --leaf->size;
+      leaf->keys[leaf->size] = padding();
+      leaf->values[leaf->size] = Value{};
+    }
+    /// @brief inserts [child] right after children[pos], separated by [key]
+    static void insertChild(Inner* inner, int pos, Key key, Node* child) {
+      for (int i = inner->size; i > pos; --i) {
+        inner->keys[i] = std::move(inner->keys[i - 1]);
+        inner->children[i + 1] = inner->children[i];
+      }
+      inner->keys[pos] = std::move(key);
+      inner->children[pos + 1] = child;
+      ++inner->size;
+    }
+    /// @brief removes keys[keyPos] and children[childPos]
+    static void eraseChild(Inner* inner, int keyPos, int childPos) {
+      for (int i = keyPos + 1; i < inner->size; ++i) inner->keys[i - 1] = std::move(inner->keys[i]);
+      for (int i = childPos + 1; i <= inner->size; ++i) inner->children[i - 1] = inner->children[i];
+      --inner->size;
+      inner->keys[inner->size] = padding();
+      inner->children[inner->size + 1] = nullptr;
+    }
+
+    /// @brief the slot of [key], inserted with [value] (or a default one) if absent
+    /// @note an existing mapping is overwritten if [value] is given
+    std::pair<Leaf*, int> emplace(K key, const Value* value) {
+      if (this->root == nullptr) {
+        auto leaf = new Leaf();
+        linkAfter(this->header, leaf);
+        this->root = leaf;
+      }
+      PathEntry path[max_depth];
+      int depth = 0;
+      Node* node = this->root;
+      while (!node->isLeaf) {
+        auto inner = static_cast<Inner*>(node);
+        const int child = rank(inner->keys, inner->size, key);
+        path[depth++] = PathEntry{inner, child};
+        node = inner->children[child];
+      }
+      auto leaf = static_cast<Leaf*>(node);
+      const int pos = rank(leaf->keys, leaf->size, key);
+      if (pos != leaf->size && !compare(key, leaf->keys[pos])) {
+        if (value) leaf->values[pos] = *value;
+        return {leaf, pos};
+      }
+      this->cnt += 1;
+      const auto insertAt = [&key, value](Leaf* leaf, int pos) {
+        if (value)
+          insertEntry(leaf, pos, key, *value);
+        else
+          insertEntry(leaf, pos, key, Value{});
+      };
+      if (leaf->size < capacity) {
+        insertAt(leaf, pos);
+        return {leaf, pos};
+      }
+
+      /// @note split the full leaf, the upper half moves to a new right sibling
+      auto right = new Leaf();
+      linkAfter(leaf, right);
+      const int numLeft = (capacity + 1) / 2;
+      std::pair<Leaf*, int> ret;
+      if (pos < numLeft) {
+        moveTail(leaf, numLeft - 1, right);
+        ret = {leaf, pos};
+      } else {
+        moveTail(leaf, numLeft, right);
+        ret = {right, pos - numLeft};
+      }
+      insertAt(ret.first, ret.second);
+
+      /// @note propagate the split upwards, the separator is the largest key of the left part
+      Key separator = leaf->keys[leaf->size - 1];
+      Node* sibling = right;
+      while (depth > 0) {
+        auto [parent, child] = path[--depth];
+        if (parent->size < capacity) {
+          insertChild(parent, child, std::move(separator), sibling);
+          return ret;
+        }
+        auto upper = new Inner();
+        const int mid = capacity / 2;
+        Key promoted = std::move(parent->keys[mid]);
+        for (int i = mid + 1; i < capacity; ++i) {
+          upper->keys[i - mid - 1] = std::move(parent->keys[i]);
+          parent->keys[i] = padding();
+        }
+        for (int i = mid + 1; i <= capacity; ++i) {
+          upper->children[i - mid - 1] = parent->children[i];
+          parent->children[i] = nullptr;
+        }
+        parent->keys[mid] = padding();
+        upper->size = capacity - mid - 1;
+        parent->size = mid;
+        if (child <= mid)
+          insertChild(parent, child, std::move(separator), sibling);
+        else
+          insertChild(upper, child - mid - 1, std::move(separator), sibling);
+        separator = std::move(promoted);
+        sibling = upper;
+      }
+      auto newRoot = new Inner();
+      newRoot->keys[0] = std::move(separator);
+      newRoot->children[0] = this->root;
+      newRoot->children[1] = sibling;
+      newRoot->size = 1;
+      this->root = newRoot;
+      return ret;
+    }
+
+    bool remove(K key) {
+      if (this->root == nullptr) return false;
+      PathEntry path[max_depth];
+      int depth = 0;
+      Node* node = this->root;
+      while (!node->isLeaf) {
+        auto inner = static_cast<Inner*>(node);
+        const int child = rank(inner->keys, inner->size, key);
+        path[depth++] = PathEntry{inner, child};
+        node = inner->children[child];
+      }
+      auto leaf = static_cast<Leaf*>(node);
+      const int pos = rank(leaf->keys, leaf->size, key);
+      if (pos == leaf->size || compare(key, leaf->keys[pos])) return false;
+      eraseEntry(leaf, pos);
+      this->cnt -= 1;
+
+      if (depth == 0) {
+        if (leaf->size == 0) {
+          unlink(leaf);
+          delete leaf;
+          this->root = nullptr;
+        }
+        return true;
+      }
+      if (leaf->size >= leaf_min) return true;
+
+      /// @note refill the leaf from a sibling, or merge with it
+      {
+        auto [parent, child] = path[depth - 1];
+        auto left = child > 0 ? static_cast<Leaf*>(parent->children[child - 1]) : nullptr;
+        auto right
+            = child < parent->size ? static_cast<Leaf*>(parent->children[child + 1]) : nullptr;
+        if (left && left->size > leaf_min) {
+          insertEntry(leaf, 0, std::move(left->keys[left->size - 1]),
+                      std::move(left->values[left->size - 1]));
+          eraseEntry(left, left->size - 1);
+          parent->keys[child - 1] = left->keys[left->size - 1];
+          return true;
+        }
+        if (right && right->size > leaf_min) {
+          insertEntry(leaf, leaf->size, std::move(right->keys[0]), std::move(right->values[0]));
+          eraseEntry(right, 0);
+          parent->keys[child] = leaf->keys[leaf->size - 1];
+          return true;
+        }
+        auto [dst, src, sep] = left ? std::make_tuple(left, leaf, child - 1)
+                                    : std::make_tuple(leaf, right, child);
+        for (int i = 0; i != src->size; ++i) {
+          dst->keys[dst->size + i] = std::move(src->keys[i]);
+          dst->values[dst->size + i] = std::move(src->values[i]);
+        }
+        dst->size += src->size;
+        unlink(src);
+        delete src;
+        eraseChild(parent, sep, sep + 1);
+      }
+
+      /// @note inner nodes emptied below half capacity are fixed the same way, bottom-up
+      for (int d = depth - 1; d > 0; --d) {
+        Inner* inner = path[d].node;
+        if (inner->size >= inner_min) return true;
+        auto [parent, child] = path[d - 1];
+        auto left = child > 0 ? static_cast<Inner*>(parent->children[child - 1]) : nullptr;
+        auto right
+            = child < parent->size ? static_cast<Inner*>(parent->children[child + 1]) : nullptr;
+        if (left && left->size > inner_min) {
+          for (int i = inner->size; i > 0; --i) inner->keys[i] = std::move(inner->keys[i - 1]);
+          for (int i = inner->size + 1; i > 0; --i) inner->children[i] = inner->children[i - 1];
+          inner->keys[0] = std::move(parent->keys[child - 1]);
+          inner->children[0] = left->children[left->size];
+          ++inner->size;
+          parent->keys[child - 1] = std::move(left->keys[left->size - 1]);
+          left->children[left->size] = nullptr;
+          left->keys[--left->size] = padding();
+          return true;
+        }
+        if (right && right->size > inner_min) {
+          inner->keys[inner->size] = std::move(parent->keys[child]);
+          inner->children[inner->size + 1] = right->children[0];
+          ++inner->size;
+          parent->keys[child] = std::move(right->keys[0]);
+          for (int i = 1; i < right->size; ++i) right->keys[i - 1] = std::move(right->keys[i]);
+          for (int i = 1; i <= right->size; ++i) right->children[i - 1] = right->children[i];
+          right->children[right->size] = nullptr;
+          right->keys[--right->size] = padding();
+          return true;
+        }
+        auto [dst, src, sep] = left ? std::make_tuple(left, inner, child - 1)
+                                    : std::make_tuple(inner, right, child);
+        dst->keys[dst->size] = std::move(parent->keys[sep]);
+        for (int i = 0; i != src->size; ++i)
+          dst->keys[dst->size + 1 + i] = std::move(src->keys[i]);
+        for (int i = 0; i <= src->size; ++i) dst->children[dst->size + 1 + i] = src->children[i];
+        dst->size += src->size + 1;
+        delete src;
+        eraseChild(parent, sep, sep + 1);
+      }
+      /// @note a root left with a single child is dropped
+      if (auto top = path[0].node; top->size == 0) {
+        this->root = top->children[0];
+        delete top;
+      }
+      return true;
+    }
+  };
+}  // namespace zs
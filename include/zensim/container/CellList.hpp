@@ -0,0 +1,603 @@
+#pragma once
+
+#include <sstream>
+
+#include "zensim/container/Vector.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/math/Vec.h"
+#include "zensim/math/bit/Bits.h"
+
+namespace zs {
+
+  /// @brief uniform-grid cell list over a point set, an alternative to SpatialHash for
+  /// neighbor searches among points
+  /// @note points are reordered by the morton code of their cell, so that each cell (and
+  /// spatially nearby cells) occupy a contiguous range of [_points]. When the morton key range
+  /// of the bounding grid is small enough, cell ranges are built by a counting sort and looked up
+  /// directly by key; otherwise keys are radix sorted and occupied cells are binary searched.
+  template <int dim_ = 3, typename Index = int, typename ValueT = zs::f32,
+            typename AllocatorT = zs::ZSPmrAllocator<>>
+  struct CellList {
+    static constexpr int dim = dim_;
+    using allocator_type = AllocatorT;
+    using value_type = ValueT;
+    using index_type = zs::make_signed_t<Index>;
+    using size_type = zs::make_unsigned_t<Index>;
+    using key_type = zs::u64;
+    static_assert(is_floating_point_v<value_type>, "value_type should be floating point");
+    static_assert(is_integral_v<index_type>, "index_type should be an integral");
+    static_assert(dim >= 1 && dim <= 3, "cell list supports 1d, 2d and 3d point sets");
+
+    using coord_type = zs::vec<value_type, dim>;
+    using integer_coord_type = zs::vec<int, dim>;
+    using indices_type = zs::Vector<index_type, allocator_type>;
+    using keys_type = zs::Vector<key_type, allocator_type>;
+    using points_type = zs::Vector<coord_type, allocator_type>;
+
+    /// morton bits per axis, limited by the 64-bit key
+    static constexpr int max_bits = 63 / dim > 21 ? 21 : 63 / dim;
+
+    constexpr decltype(auto) memoryLocation() const noexcept { return _indices.memoryLocation(); }
+    constexpr zs::ProcID devid() const noexcept { return _indices.devid(); }
+    constexpr zs::memsrc_e memspace() const noexcept { return _indices.memspace(); }
+    decltype(auto) get_allocator() const noexcept { return _indices.get_allocator(); }
+
+    CellList() = default;
+
+    CellList clone(const allocator_type &allocator) const {
+      CellList ret{};
+      ret._dx = _dx;
+      ret._origin = _origin;
+      ret._extents = _extents;
+      ret._bits = _bits;
+      ret._keys = _keys.clone(allocator);
+      ret._indices = _indices.clone(allocator);
+      ret._points = _points.clone(allocator);
+      ret._cellStarts = _cellStarts.clone(allocator);
+      ret._cellKeys = _cellKeys.clone(allocator);
+      return ret;
+    }
+    CellList clone(const zs::MemoryLocation &mloc) const {
+      return clone(_indices.get_default_allocator(mloc.memspace(), mloc.devid()));
+    }
+
+    size_type size() const { return _indices.size(); }
+    /// @brief whether cell ranges are indexed directly by morton key
+    bool isDense() const { return _cellKeys.size() == 0; }
+
+    template <typename Policy>
+    void build(Policy &&, value_type dx, const zs::Vector<coord_type> &points);
+    /// @brief re-sorts [points] (same count, same order as the last build) upon the current grid
+    /// @note points keeping their cells retain their order; the few that changed cells are sorted
+    /// and merged in. Falls back to a full build if a point leaves the grid or more than
+    /// [maxMovedRatio] of the points changed cells.
+    /// @return false if a full build took place
+    template <typename Policy>
+    bool update(Policy &&, const zs::Vector<coord_type> &points, value_type maxMovedRatio = 0.05);
+
+    static constexpr integer_coord_type cell_coord(const coord_type &p, const coord_type &origin,
+                                                   value_type dxinv) noexcept {
+      return integer_coord_type::init([&](int d) -> int {
+        return lower_trunc((p[d] - origin[d]) * dxinv, zs::wrapt<int>{});
+      });
+    }
+    static constexpr key_type cell_key(const integer_coord_type &c, int bits) noexcept {
+      if constexpr (dim == 3)
+        return (expand_bits_64((u32)c[0]) << 2) | (expand_bits_64((u32)c[1]) << 1)
+               | expand_bits_64((u32)c[2]);
+      else {
+        key_type key = 0;
+        for (int b = 0; b != bits; ++b)
+          for (int d = 0; d != dim; ++d)
+            key |= (key_type)((c[d] >> b) & 1) << (b * dim + (dim - 1 - d));
+        return key;
+      }
+    }
+
+    /// @brief cell side length
+    value_type _dx{0};
+    /// @brief lower corner of cell (0, ..., 0)
+    coord_type _origin{};
+    /// @brief number of cells along each axis
+    integer_coord_type _extents{};
+    /// @brief morton bits per axis
+    int _bits{0};
+    /// @brief morton key of each sorted point
+    keys_type _keys{};
+    /// @brief original index of each sorted point
+    indices_type _indices{};
+    /// @brief positions in sorted order
+    points_type _points{};
+    /// @brief first sorted point of each cell (dense: per key; sparse: per occupied cell)
+    indices_type _cellStarts{};
+    /// @brief morton keys of the occupied cells (sparse layout only)
+    keys_type _cellKeys{};
+
+  private:
+    template <typename Policy> void buildSparseCells(Policy &&policy);
+    template <typename Policy> void buildDenseCells(Policy &&policy);
+    template <typename Policy> void gatherPoints(Policy &&policy, const zs::Vector<coord_type> &);
+  };
+
+  namespace detail {
+    /// first position in the sorted [keys] of [count] entries not less than [key]
+    template <typename KeysView, typename Ti, typename Key>
+    constexpr Ti cell_list_lower_bound(const KeysView &keys, Ti count, Key key) noexcept {
+      Ti lo = 0;
+      while (count > 0) {
+        Ti step = count / 2;
+        if (keys[lo + step] < key) {
+          lo += step + 1;
+          count -= step + 1;
+        } else
+          count = step;
+      }
+      return lo;
+    }
+    /// first position in the sorted [keys] of [count] entries greater than [key]
+    template <typename KeysView, typename Ti, typename Key>
+    constexpr Ti cell_list_upper_bound(const KeysView &keys, Ti count, Key key) noexcept {
+      Ti lo = 0;
+      while (count > 0) {
+        Ti step = count / 2;
+        if (!(key < keys[lo + step])) {
+          lo += step + 1;
+          count -= step + 1;
+        } else
+          count = step;
+      }
+      return lo;
+    }
+  }  // namespace detail
+
+  template <zs::execspace_e, typename ClT, typename = void> struct CellListView;
+
+  /// proxy to work within each backends
+  template <zs::execspace_e Space, typename ClT> struct CellListView<Space, ClT> {
+    static constexpr auto space = Space;
+    using container_type = remove_const_t<ClT>;
+    static constexpr int dim = ClT::dim;
+    using index_type = typename ClT::index_type;
+    using size_type = typename ClT::size_type;
+    using value_type = typename ClT::value_type;
+    using key_type = typename ClT::key_type;
+    using coord_type = typename ClT::coord_type;
+    using integer_coord_type = typename ClT::integer_coord_type;
+    using indices_view_type
+        = RM_REF_T(proxy<space>(declval<const typename ClT::indices_type &>()));
+    using keys_view_type = RM_REF_T(proxy<space>(declval<const typename ClT::keys_type &>()));
+    using points_view_type = RM_REF_T(proxy<space>(declval<const typename ClT::points_type &>()));
+
+    constexpr CellListView() = default;
+    ~CellListView() = default;
+
+    explicit CellListView(ClT &cl)
+        : _dx{cl._dx},
+          _origin{cl._origin},
+          _extents{cl._extents},
+          _bits{cl._bits},
+          _numCellKeys{(index_type)cl._cellKeys.size()},
+          _indices{zs::proxy<space>(cl._indices)},
+          _points{zs::proxy<space>(cl._points)},
+          _cellStarts{zs::proxy<space>(cl._cellStarts)},
+          _cellKeys{zs::proxy<space>(cl._cellKeys)} {}
+
+    /// @brief [st, ed) range of sorted points within cell [c] (inside the grid)
+    constexpr void cell_range(const integer_coord_type &c, index_type &st,
+                              index_type &ed) const {
+      const auto key = ClT::cell_key(c, _bits);
+      if (_numCellKeys == 0) {
+        st = _cellStarts[key];
+        ed = _cellStarts[key + 1];
+        return;
+      }
+      auto no = detail::cell_list_lower_bound(_cellKeys, _numCellKeys, key);
+      if (no == _numCellKeys || _cellKeys[no] != key) {
+        st = ed = 0;
+        return;
+      }
+      st = _cellStarts[no];
+      ed = _cellStarts[no + 1];
+    }
+
+    /// @brief visits every point within [radius] of [p] as f(original index, squared distance)
+    template <typename VecT, class F>
+    constexpr void iter_neighbors(const VecInterface<VecT> &p, value_type radius, F &&f) const {
+      integer_coord_type lo{}, hi{};
+      if (!cell_box(p, radius, lo, hi)) return;
+      const auto r2 = radius * radius;
+      auto range = Collapse(integer_coord_type::init([&](int d) { return hi[d] - lo[d] + 1; }));
+      for (auto loc : range) {
+        const integer_coord_type c = lo + make_vec<int>(loc);
+        if (cell_distance2(p, c) > r2) continue;
+        index_type st{}, ed{};
+        cell_range(c, st, ed);
+        for (index_type no = st; no != ed; ++no) {
+          const auto d2 = (_points[no] - p).l2NormSqr();
+          if (d2 <= r2) f(_indices[no], d2);
+        }
+      }
+    }
+
+    /// @brief the (at most) K nearest points within [radius] of [p], ordered by distance
+    /// @return number of neighbors written to [ids] and [dist2s] (squared distances)
+    template <int K, typename VecT>
+    constexpr int knn(const VecInterface<VecT> &p, value_type radius, index_type (&ids)[K],
+                      value_type (&dist2s)[K]) const {
+      static_assert(K > 0, "at least one neighbor should be queried");
+      int cnt = 0;
+      for (int d = 0; d != dim; ++d)
+        if (_extents[d] <= 0) return cnt;
+      // the cell holding [p], clamped into the grid
+      const auto c0 = integer_coord_type::init([&](int d) -> int {
+        auto v = (p[d] - _origin[d]) / _dx;
+        return v < 0 ? 0 : v >= _extents[d] ? _extents[d] - 1 : (int)v;
+      });
+      int maxRing = 0;
+      for (int d = 0; d != dim; ++d) {
+        maxRing = math::max(maxRing, c0[d]);
+        maxRing = math::max(maxRing, _extents[d] - 1 - c0[d]);
+      }
+      const auto r2 = radius * radius;
+      for (int ring = 0; ring <= maxRing; ++ring) {
+        // points in ring [ring] are at least (ring - 1) cells away
+        const auto worst = cnt == K ? dist2s[K - 1] : r2;
+        const auto bound = (ring - 1) * _dx;
+        if (ring > 1 && bound * bound > worst) break;
+        const auto lo = integer_coord_type::init(
+            [&](int d) -> int { return math::max(c0[d] - ring, 0); });
+        const auto hi = integer_coord_type::init(
+            [&](int d) -> int { return math::min(c0[d] + ring, _extents[d] - 1); });
+        auto range = Collapse(integer_coord_type::init([&](int d) { return hi[d] - lo[d] + 1; }));
+        for (auto loc : range) {
+          const integer_coord_type c = lo + make_vec<int>(loc);
+          int cheb = 0;
+          for (int d = 0; d != dim; ++d) {
+            const int off = c[d] > c0[d] ? c[d] - c0[d] : c0[d] - c[d];
+            cheb = off > cheb ? off : cheb;
+          }
+          if (cheb != ring) continue;
+          if (cell_distance2(p, c) > (cnt == K ? dist2s[K - 1] : r2)) continue;
+          index_type st{}, ed{};
+          cell_range(c, st, ed);
+          for (index_type no = st; no != ed; ++no) {
+            const auto d2 = (_points[no] - p).l2NormSqr();
+            if (d2 > r2 || (cnt == K && d2 >= dist2s[K - 1])) continue;
+            int pos = cnt < K ? cnt++ : K - 1;
+            for (; pos > 0 && dist2s[pos - 1] > d2; --pos) {
+              dist2s[pos] = dist2s[pos - 1];
+              ids[pos] = ids[pos - 1];
+            }
+            dist2s[pos] = d2;
+            ids[pos] = _indices[no];
+          }
+        }
+      }
+      return cnt;
+    }
+
+    /// @brief cells overlapping the axis-aligned box of [p] +- [radius], clipped to the grid
+    template <typename VecT>
+    constexpr bool cell_box(const VecInterface<VecT> &p, value_type radius, integer_coord_type &lo,
+                            integer_coord_type &hi) const {
+      for (int d = 0; d != dim; ++d) {
+        auto l = (p[d] - radius - _origin[d]) / _dx;
+        auto h = (p[d] + radius - _origin[d]) / _dx;
+        if (h < 0 || l >= _extents[d]) return false;
+        lo[d] = l < 0 ? 0 : (int)l;
+        hi[d] = h >= _extents[d] ? _extents[d] - 1 : (int)h;
+      }
+      return true;
+    }
+    /// @brief squared distance from [p] to cell [c]
+    template <typename VecT>
+    constexpr value_type cell_distance2(const VecInterface<VecT> &p,
+                                        const integer_coord_type &c) const {
+      value_type ret = 0;
+      for (int d = 0; d != dim; ++d) {
+        const auto lo = _origin[d] + c[d] * _dx;
+        auto t = lo - p[d];
+        if (t < 0) t = p[d] - (lo + _dx);
+        if (t > 0) ret += t * t;
+      }
+      return ret;
+    }
+
+    value_type _dx;
+    coord_type _origin;
+    integer_coord_type _extents;
+    int _bits;
+    index_type _numCellKeys;
+    indices_view_type _indices;
+    points_view_type _points;
+    indices_view_type _cellStarts;
+    keys_view_type _cellKeys;
+  };
+
+  template <zs::execspace_e space, int dim, typename Ti, typename T, typename Allocator>
+  decltype(auto) proxy(const CellList<dim, Ti, T, Allocator> &cl) {
+    return CellListView<space, const CellList<dim, Ti, T, Allocator>>{cl};
+  }
+
+  template <int dim, typename Index, typename Value, typename Allocator> template <typename Policy>
+  void CellList<dim, Index, Value, Allocator>::build(Policy &&policy, value_type dx,
+                                                     const zs::Vector<coord_type> &points) {
+    using namespace zs;
+    using T = value_type;
+    using Ti = index_type;
+    constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+
+    _dx = dx;
+    if (_dx < detail::deduce_numeric_epsilon<value_type>() * 10)
+      throw std::runtime_error("cell side_length for cell list should be greater than zero.");
+
+    const size_type n = points.size();
+    auto allocator = points.get_allocator();
+    _keys = keys_type{allocator, n};
+    _indices = indices_type{allocator, n};
+    _points = points_type{allocator, n};
+    _cellKeys = keys_type{allocator, 0};
+    if (n == 0) {
+      _origin = coord_type::zeros();
+      _extents = integer_coord_type::zeros();
+      _bits = 0;
+      _cellStarts = indices_type{allocator, 0};
+      return;
+    }
+
+    /// bounding grid, padded by one cell on each side to absorb small motions in update()
+    {
+      Vector<T> coords{allocator, n}, bounds{allocator, dim * 2};
+      for (int d = 0; d != dim; ++d) {
+        policy(range(n), [points = proxy<space>(points), coords = proxy<space>(coords),
+                          d] ZS_LAMBDA(size_type i) mutable { coords[i] = points[i][d]; });
+        reduce(policy, std::begin(coords), std::end(coords), std::begin(bounds) + d,
+               detail::deduce_numeric_max<T>(), getmin<T>{});
+        reduce(policy, std::begin(coords), std::end(coords), std::begin(bounds) + dim + d,
+               detail::deduce_numeric_lowest<T>(), getmax<T>{});
+      }
+      T bs[dim * 2];
+      bounds.retrieveVals(bs);
+      int maxExtent = 0;
+      for (int d = 0; d != dim; ++d) {
+        const double cells = ((double)bs[dim + d] - (double)bs[d]) / (double)_dx + 3;
+        if (!(cells < (double)((size_t)1 << max_bits))) {
+          std::ostringstream oss;
+          oss << "using dx[" << dx << "] as the cell side_length results in excessive ("
+              << cells << ") cells along axis " << d << " of the cell list!";
+          throw std::runtime_error(oss.str());
+        }
+        _origin[d] = bs[d] - _dx;
+        _extents[d] = (int)cells;
+        maxExtent = math::max(maxExtent, _extents[d]);
+      }
+      _bits = (int)bit_count((u32)maxExtent);
+    }
+
+    keys_type keys{allocator, n};
+    policy(range(n), [points = proxy<space>(points), keys = proxy<space>(keys), origin = _origin,
+                      dxinv = 1 / _dx, bits = _bits] ZS_LAMBDA(size_type i) mutable {
+      keys[i] = cell_key(cell_coord(points[i], origin, dxinv), bits);
+    });
+
+    const size_t keyRange = (size_t)1 << (dim * _bits);
+    if (keyRange <= math::max((size_t)n * 4, (size_t)1 << 20)) {
+      /// counting sort, cell starts are indexed by morton key
+      indices_type counts{allocator, keyRange + 1}, ranks{allocator, n};
+      counts.reset(0);
+      policy(range(n), [keys = proxy<space>(keys), counts = proxy<space>(counts),
+                        ranks = proxy<space>(ranks),
+                        tag = wrapv<space>{}] ZS_LAMBDA(size_type i) mutable {
+        ranks[i] = atomic_add(tag, &counts[keys[i]], (Ti)1);
+      });
+      _cellStarts = indices_type{allocator, keyRange + 1};
+      exclusive_scan(policy, std::begin(counts), std::end(counts), std::begin(_cellStarts));
+      policy(range(n), [keys = proxy<space>(keys), ranks = proxy<space>(ranks),
+                        cellStarts = proxy<space>(_cellStarts), sortedKeys = proxy<space>(_keys),
+                        indices = proxy<space>(_indices)] ZS_LAMBDA(size_type i) mutable {
+        const auto key = keys[i];
+        const auto dst = cellStarts[key] + ranks[i];
+        sortedKeys[dst] = key;
+        indices[dst] = (Ti)i;
+      });
+    } else {
+      /// sparse occupancy, sort upon the significant morton bits only
+      indices_type ids{allocator, n};
+      policy(range(n),
+             [ids = proxy<space>(ids)] ZS_LAMBDA(size_type i) mutable { ids[i] = (Ti)i; });
+      radix_sort_pair(policy, keys.begin(), ids.begin(), _keys.begin(), _indices.begin(), n, 0,
+                      dim * _bits);
+      buildSparseCells(policy);
+    }
+    gatherPoints(policy, points);
+  }
+
+  template <int dim, typename Index, typename Value, typename Allocator> template <typename Policy>
+  bool CellList<dim, Index, Value, Allocator>::update(Policy &&policy,
+                                                      const zs::Vector<coord_type> &points,
+                                                      value_type maxMovedRatio) {
+    using namespace zs;
+    using Ti = index_type;
+    constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+
+    const size_type n = points.size();
+    if (n == 0 || n != size()) {
+      build(policy, _dx, points);
+      return false;
+    }
+    auto allocator = _indices.get_allocator();
+
+    /// positions in the current sorted order. The gather is kept apart from the key evaluation,
+    /// so that its (random) loads overlap.
+    gatherPoints(policy, points);
+
+    /// new keys in the current sorted order, flagging points that changed cells
+    keys_type newKeys{allocator, n};
+    indices_type moved{allocator, n + 1}, movedOffsets{allocator, n + 1}, numOutside{allocator, 1};
+    numOutside.setVal(0);
+    policy(range(n + 1), [keys = proxy<space>(_keys), sortedPoints = proxy<space>(_points),
+                          newKeys = proxy<space>(newKeys), moved = proxy<space>(moved),
+                          numOutside = proxy<space>(numOutside), origin = _origin,
+                          extents = _extents, dxinv = 1 / _dx, bits = _bits, n,
+                          tag = wrapv<space>{}] ZS_LAMBDA(size_type no) mutable {
+      if (no == n) {
+        moved[no] = 0;
+        return;
+      }
+      const auto c = cell_coord(sortedPoints[no], origin, dxinv);
+      for (int d = 0; d != dim; ++d)
+        if (c[d] < 0 || c[d] >= extents[d]) {
+          atomic_add(tag, &numOutside[0], (Ti)1);
+          newKeys[no] = keys[no];
+          moved[no] = 0;
+          return;
+        }
+      const auto key = cell_key(c, bits);
+      newKeys[no] = key;
+      moved[no] = key != keys[no] ? 1 : 0;
+    });
+    if (numOutside.getVal() != 0) {
+      build(policy, _dx, points);
+      return false;
+    }
+    exclusive_scan(policy, std::begin(moved), std::end(moved), std::begin(movedOffsets));
+    const size_type numMoved = movedOffsets.getVal(n);
+    if (numMoved > maxMovedRatio * n) {
+      build(policy, _dx, points);
+      return false;
+    }
+
+    if (numMoved != 0) {
+      const size_type numStay = n - numMoved;
+      keys_type moverKeys{allocator, numMoved}, sortedMoverKeys{allocator, numMoved};
+      indices_type moverIds{allocator, numMoved}, sortedMoverIds{allocator, numMoved};
+      policy(range(n), [newKeys = proxy<space>(newKeys), indices = proxy<space>(_indices),
+                        moved = proxy<space>(moved), movedOffsets = proxy<space>(movedOffsets),
+                        moverKeys = proxy<space>(moverKeys),
+                        moverIds = proxy<space>(moverIds)] ZS_LAMBDA(size_type no) mutable {
+        if (moved[no]) {
+          const auto mo = movedOffsets[no];
+          moverKeys[mo] = newKeys[no];
+          moverIds[mo] = indices[no];
+        }
+      });
+      radix_sort_pair(policy, moverKeys.begin(), moverIds.begin(), sortedMoverKeys.begin(),
+                      sortedMoverIds.begin(), numMoved, 0, dim * _bits);
+
+      /// merge: the keys of the points staying put are unchanged, hence still sorted within the
+      /// old sequence. Each mover goes after the stayers not greater than itself, each stayer is
+      /// shifted by the number of movers inserted before it.
+      indices_type insertions{allocator, numStay + 2}, shifts{allocator, numStay + 2},
+          moverDsts{allocator, numMoved};
+      insertions.reset(0);
+      policy(range(numMoved),
+             [keys = proxy<space>(_keys), movedOffsets = proxy<space>(movedOffsets),
+              moverKeys = proxy<space>(sortedMoverKeys), moverDsts = proxy<space>(moverDsts),
+              insertions = proxy<space>(insertions), n,
+              tag = wrapv<space>{}] ZS_LAMBDA(size_type j) mutable {
+               const auto no = detail::cell_list_upper_bound(keys, n, moverKeys[j]);
+               const auto pos = no - movedOffsets[no];  // stayers before [no]
+               moverDsts[j] = (Ti)(j + pos);
+               atomic_add(tag, &insertions[pos + 1], (Ti)1);
+             });
+      exclusive_scan(policy, std::begin(insertions), std::end(insertions), std::begin(shifts));
+
+      keys_type keys{allocator, n};
+      indices_type indices{allocator, n};
+      points_type sortedPoints{allocator, n};
+      policy(range(n), [oldKeys = proxy<space>(_keys), oldIndices = proxy<space>(_indices),
+                        oldPoints = proxy<space>(_points), moved = proxy<space>(moved),
+                        movedOffsets = proxy<space>(movedOffsets), shifts = proxy<space>(shifts),
+                        keys = proxy<space>(keys), indices = proxy<space>(indices),
+                        sortedPoints
+                        = proxy<space>(sortedPoints)] ZS_LAMBDA(size_type no) mutable {
+        if (moved[no]) return;
+        const auto j = no - movedOffsets[no];
+        const auto dst = j + shifts[j + 2];
+        keys[dst] = oldKeys[no];
+        indices[dst] = oldIndices[no];
+        sortedPoints[dst] = oldPoints[no];
+      });
+      policy(range(numMoved),
+             [points = proxy<space>(points), moverKeys = proxy<space>(sortedMoverKeys),
+              moverIds = proxy<space>(sortedMoverIds), moverDsts = proxy<space>(moverDsts),
+              keys = proxy<space>(keys), indices = proxy<space>(indices),
+              sortedPoints = proxy<space>(sortedPoints)] ZS_LAMBDA(size_type j) mutable {
+               const auto dst = moverDsts[j];
+               keys[dst] = moverKeys[j];
+               indices[dst] = moverIds[j];
+               sortedPoints[dst] = points[moverIds[j]];
+             });
+      _keys = zs::move(keys);
+      _indices = zs::move(indices);
+      _points = zs::move(sortedPoints);
+
+      if (isDense())
+        buildDenseCells(policy);
+      else
+        buildSparseCells(policy);
+    }
+    return true;
+  }
+
+  template <int dim, typename Index, typename Value, typename Allocator> template <typename Policy>
+  void CellList<dim, Index, Value, Allocator>::buildSparseCells(Policy &&policy) {
+    using namespace zs;
+    using Ti = index_type;
+    constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+    const size_type n = _keys.size();
+    auto allocator = _indices.get_allocator();
+
+    indices_type heads{allocator, n + 1}, cellIds{allocator, n + 1};
+    policy(range(n + 1), [keys = proxy<space>(_keys), heads = proxy<space>(heads),
+                          n] ZS_LAMBDA(size_type no) mutable {
+      heads[no] = no != n && (no == 0 || keys[no] != keys[no - 1]) ? 1 : 0;
+    });
+    exclusive_scan(policy, std::begin(heads), std::end(heads), std::begin(cellIds));
+    const size_type numCells = cellIds.getVal(n);
+
+    _cellKeys = keys_type{allocator, numCells};
+    _cellStarts = indices_type{allocator, numCells + 1};
+    policy(range(n + 1), [keys = proxy<space>(_keys), heads = proxy<space>(heads),
+                          cellIds = proxy<space>(cellIds), cellKeys = proxy<space>(_cellKeys),
+                          cellStarts = proxy<space>(_cellStarts),
+                          n] ZS_LAMBDA(size_type no) mutable {
+      if (no == n)
+        cellStarts[cellIds[no]] = (Ti)n;
+      else if (heads[no]) {
+        cellKeys[cellIds[no]] = keys[no];
+        cellStarts[cellIds[no]] = (Ti)no;
+      }
+    });
+  }
+
+  template <int dim, typename Index, typename Value, typename Allocator> template <typename Policy>
+  void CellList<dim, Index, Value, Allocator>::buildDenseCells(Policy &&policy) {
+    using namespace zs;
+    using Ti = index_type;
+    constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+    const size_type n = _keys.size();
+    const key_type keyRange = (key_type)_cellStarts.size() - 1;
+
+    /// sorted point [no] starts every key in (keys[no - 1], keys[no]]
+    policy(range(n + 1), [keys = proxy<space>(_keys), cellStarts = proxy<space>(_cellStarts), n,
+                          keyRange] ZS_LAMBDA(size_type no) mutable {
+      const key_type lo = no == 0 ? 0 : keys[no - 1] + 1;
+      const key_type hi = no == n ? keyRange : keys[no];
+      for (key_type key = lo; key <= hi; ++key) cellStarts[key] = (Ti)no;
+    });
+  }
+
+  template <int dim, typename Index, typename Value, typename Allocator> template <typename Policy>
+  void CellList<dim, Index, Value, Allocator>::gatherPoints(Policy &&policy,
+                                                            const zs::Vector<coord_type> &points) {
+    using namespace zs;
+    constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+    policy(range(_indices.size()),
+           [points = proxy<space>(points), sortedPoints = proxy<space>(_points),
+            indices = proxy<space>(_indices)] ZS_LAMBDA(size_type no) mutable {
+             sortedPoints[no] = points[indices[no]];
+           });
+  }
+
+}  // namespace zs
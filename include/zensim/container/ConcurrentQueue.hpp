@@ -75,6 +75,19 @@ namespace zs {
       return _queue.try_dequeue(item);
     }
 
+    /// @brief enqueues 'count' items (copied or moved through the iterator) in one reservation
+    /// @note all-or-nothing
+    template <typename It>
+    bool try_enqueue_bulk(It first, size_t count) {
+      return _queue.try_enqueue_bulk(first, count);
+    }
+
+    /// @return the number of dequeued items, at most 'maxCount'
+    template <typename It>
+    size_t try_dequeue_bulk(It first, size_t maxCount) {
+      return _queue.try_dequeue_bulk(first, maxCount);
+    }
+
     size_t size_approx() const noexcept { return _queue.size_approx(); }
 
     bool empty_approx() const noexcept { return size_approx() == 0; }
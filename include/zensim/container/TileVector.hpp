@@ -11,6 +11,86 @@
 
 namespace zs {
 
+  /// @brief property location resolved once on the host (TileVector::getPropertyHandle or
+  /// TileVectorView::propertyHandle), then passed to view accessors in place of the name
+  struct PropertyHandle {
+    int offset{-1};
+    int extent{0};
+    constexpr bool valid() const noexcept { return offset >= 0; }
+  };
+  /// @brief property location known at compile time (see PropertySchema)
+  template <int Offset, int Extent> struct StaticPropertyHandle {
+    static_assert(Offset >= 0 && Extent > 0, "invalid static property location");
+    static constexpr int offset = Offset;
+    static constexpr int extent = Extent;
+    constexpr bool valid() const noexcept { return true; }
+  };
+
+  template <typename T> struct is_property_handle : false_type {};
+  template <> struct is_property_handle<PropertyHandle> : true_type {};
+  template <int Offset, int Extent>
+  struct is_property_handle<StaticPropertyHandle<Offset, Extent>> : true_type {};
+  template <typename T> constexpr bool is_property_handle_v
+      = is_property_handle<remove_cvref_t<T>>::value;
+
+  /// @brief one entry of a PropertySchema
+  /// @note Name is a tag type providing 'static constexpr const char *name'
+  template <typename Name, int Extent> struct PropertyDecl {
+    using name_type = Name;
+    static constexpr int extent = Extent;
+  };
+
+  /// @brief compile-time channel layout of a tilevector
+  /// @note properties are laid out contiguously in declaration order, exactly as the TileVector
+  /// constructor does with the tags returned by 'tags()'
+  /// @note 'handle<Name>' resolves to a StaticPropertyHandle, thus named access within kernels
+  /// costs the same as positional access
+  template <typename... Decls> struct PropertySchema {
+    static constexpr int num_properties = sizeof...(Decls);
+    static constexpr int num_channels = (0 + ... + Decls::extent);
+
+  private:
+    template <typename Name> static constexpr int index_of() noexcept {
+      constexpr bool matches[] = {false, is_same_v<typename Decls::name_type, Name>...};
+      for (int i = 0; i != num_properties; ++i)
+        if (matches[i + 1]) return i;
+      return -1;
+    }
+    template <typename Name> static constexpr int offset_of() noexcept {
+      constexpr int extents[] = {0, Decls::extent...};
+      int offset = 0;
+      for (int i = 0; i != index_of<Name>(); ++i) offset += extents[i + 1];
+      return offset;
+    }
+    template <typename Name> static constexpr int extent_of() noexcept {
+      constexpr int extents[] = {0, Decls::extent...};
+      return extents[index_of<Name>() + 1];
+    }
+
+  public:
+    template <typename Name> static constexpr bool has_property = index_of<Name>() >= 0;
+    template <typename Name> static constexpr auto get_handle() noexcept {
+      static_assert(has_property<Name>, "property not declared within this schema");
+      return StaticPropertyHandle<offset_of<Name>(), extent_of<Name>()>{};
+    }
+    template <typename Name> static constexpr auto handle = get_handle<Name>();
+
+    /// @brief tags for constructing a tilevector of this layout
+    static std::vector<PropertyTag> tags() {
+      return std::vector<PropertyTag>{PropertyTag{Decls::name_type::name, Decls::extent}...};
+    }
+    /// @brief throws if the tilevector layout differs from this schema
+    template <typename TileVectorT> static void validate(const TileVectorT &tv) {
+      const auto &tvTags = tv.getPropertyTags();
+      const auto expected = tags();
+      bool match = tvTags.size() == expected.size();
+      for (size_t i = 0; match && i != expected.size(); ++i)
+        match = tvTags[i].name == expected[i].name.asChars()
+                && tvTags[i].numChannels == expected[i].numChannels;
+      if (!match) throw std::runtime_error("tilevector layout does not match the property schema");
+    }
+  };
+
   template <typename T_, size_t Length = 8, typename AllocatorT = ZSPmrAllocator<>>
   struct TileVector {
     static_assert(is_zs_allocator<AllocatorT>::value,
@@ -492,6 +572,9 @@ namespace zs {
     template <typename Policy> void reset(Policy &&policy, value_type val);
     template <typename Policy, typename MapRange, bool Scatter = true>
     void reorderTiles(Policy &&pol, MapRange &&mapR, wrapv<Scatter> = {});
+    /// @note element-wise, gather by default (consistent with Vector::reorder)
+    template <typename Policy, typename MapRange, bool Scatter = false>
+    void reorder(Policy &&pol, MapRange &&mapR, wrapv<Scatter> = {});
 
     constexpr channel_counter_type numProperties() const noexcept { return _tags.size(); }
 
@@ -533,6 +616,17 @@ namespace zs {
       }
       return -1;
     }
+    /// @brief resolve a property once, outside of kernels
+    PropertyHandle getPropertyHandle(const SmallString &str) const {
+      channel_counter_type offset = 0;
+      for (auto &&tag : _tags) {
+        if (str == tag.name) return PropertyHandle{offset, tag.numChannels};
+        offset += tag.numChannels;
+      }
+      std::ostringstream oss;
+      oss << "getPropertyHandle: property[" << str.asChars() << "] does not exist.";
+      throw std::runtime_error(oss.str());
+    }
     constexpr PropertyTag getPropertyTag(size_t i = 0) const { return _tags[i]; }
     constexpr const auto &getPropertyTags() const { return _tags; }
 
@@ -693,6 +787,41 @@ namespace zs {
     *this = zs::move(orderedTiles);
   }
 
+  template <typename TileVectorView, bool Scatter> struct TileVectorReorder {
+    using size_type = typename TileVectorView::size_type;
+    using channel_counter_type = typename TileVectorView::channel_counter_type;
+    TileVectorReorder(TileVectorView tv, TileVectorView orderedTv) : tv{tv}, orderedTv{orderedTv} {}
+    constexpr void operator()(size_type i, size_type j) {
+      const auto nchns = tv.numChannels();
+      if constexpr (Scatter)  // scatter
+        for (channel_counter_type d = 0; d != nchns; ++d) orderedTv(d, j) = tv(d, i);
+      else  // gather
+        for (channel_counter_type d = 0; d != nchns; ++d) orderedTv(d, i) = tv(d, j);
+    }
+    TileVectorView tv, orderedTv;
+  };
+  template <typename T, size_t Length, typename Allocator>
+  template <typename Policy, typename MapRange, bool Scatter>
+  void TileVector<T, Length, Allocator>::reorder(Policy &&pol, MapRange &&mapR, wrapv<Scatter>) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    using Ti = RM_CVREF_T(*zs::begin(mapR));
+    static_assert(is_integral_v<Ti>,
+                  "index mapping range\'s dereferenced type is not an integral.");
+
+    const size_type sz = size();
+    if (range_size(mapR) != sz) throw std::runtime_error("index mapping range size mismatch");
+    if (!valid_memspace_for_execution(pol, get_allocator()))
+      throw std::runtime_error("current memory location not compatible with the execution policy");
+
+    TileVector ordered{get_allocator(), getPropertyTags(), sz};
+    {
+      auto tv = view<space>(*this);
+      auto orderedTv = view<space>(ordered);
+      pol(enumerate(mapR), TileVectorReorder<RM_CVREF_T(tv), Scatter>{tv, orderedTv});
+    }
+    *this = zs::move(ordered);
+  }
+
   template <execspace_e Space, typename TileVectorT, bool WithinTile, bool Base = false,
             typename = void>
   struct TileVectorUnnamedView {
@@ -1059,6 +1188,115 @@ namespace zs {
                         make_index_sequence<(Ns * ...)>{});
     }
 
+    /// @brief property handle based access, i.e. no name lookup upon each invocation
+    /// @note accepts both PropertyHandle and StaticPropertyHandle (see PropertySchema)
+    template <typename Prop, bool V = is_const_structure, typename TT = value_type,
+              enable_if_all<is_property_handle_v<Prop>, !V, sizeof(TT) == sizeof(value_type),
+                            is_same_v<TT, remove_cvref_t<TT>>, (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr std::add_lvalue_reference_t<TT> operator()(const Prop &prop,
+                                                         const channel_counter_type chn,
+                                                         const size_type i,
+                                                         wrapt<TT> = {}) noexcept {
+      checkPropertyChannels(prop, chn, 1);
+      return (*this)(static_cast<channel_counter_type>(prop.offset + chn), i, wrapt<TT>{});
+    }
+    template <typename Prop, typename TT = value_type,
+              enable_if_all<is_property_handle_v<Prop>, sizeof(TT) == sizeof(value_type),
+                            is_same_v<TT, remove_cvref_t<TT>>, (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr TT operator()(const Prop &prop, const channel_counter_type chn, const size_type i,
+                            wrapt<TT> = {}) const noexcept {
+      checkPropertyChannels(prop, chn, 1);
+      return (*this)(static_cast<channel_counter_type>(prop.offset + chn), i, wrapt<TT>{});
+    }
+    template <typename Prop, bool V = is_const_structure, typename TT = value_type,
+              enable_if_all<is_property_handle_v<Prop>, !V, sizeof(TT) == sizeof(value_type),
+                            is_same_v<TT, remove_cvref_t<TT>>, (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr std::add_lvalue_reference_t<TT> operator()(const Prop &prop, const size_type i,
+                                                         wrapt<TT> = {}) noexcept {
+      return (*this)(static_cast<channel_counter_type>(prop.offset), i, wrapt<TT>{});
+    }
+    template <typename Prop, typename TT = value_type,
+              enable_if_all<is_property_handle_v<Prop>, sizeof(TT) == sizeof(value_type),
+                            is_same_v<TT, remove_cvref_t<TT>>, (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr TT operator()(const Prop &prop, const size_type i, wrapt<TT> = {}) const noexcept {
+      return (*this)(static_cast<channel_counter_type>(prop.offset), i, wrapt<TT>{});
+    }
+
+    template <auto... Ns, typename Prop, typename TT = value_type,
+              enable_if_all<is_property_handle_v<Prop>, sizeof(TT) == sizeof(value_type),
+                            is_same_v<TT, remove_cvref_t<TT>>, (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr auto pack(value_seq<Ns...>, const Prop &prop, const channel_counter_type chn,
+                        const size_type i, wrapt<TT> = {}) const noexcept {
+      checkPropertyChannels(prop, chn, (Ns * ...));
+      return pack(dim_c<Ns...>, static_cast<channel_counter_type>(prop.offset + chn), i,
+                  wrapt<TT>{});
+    }
+    template <auto... Ns, typename Prop, typename TT = value_type,
+              enable_if_all<is_property_handle_v<Prop>, sizeof(TT) == sizeof(value_type),
+                            is_same_v<TT, remove_cvref_t<TT>>, (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr auto pack(value_seq<Ns...>, const Prop &prop, const size_type i,
+                        wrapt<TT> = {}) const noexcept {
+      if constexpr (!is_same_v<Prop, PropertyHandle>)
+        static_assert((Ns * ...) <= Prop::extent, "packing beyond the static property extent");
+      return pack(dim_c<Ns...>, prop, (channel_counter_type)0, i, wrapt<TT>{});
+    }
+    template <auto... Ns, typename Prop, typename TT = value_type,
+              enable_if_all<is_property_handle_v<Prop>, sizeof(TT) == sizeof(value_type),
+                            is_same_v<TT, remove_cvref_t<TT>>, (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr auto pack(const Prop &prop, const size_type i, wrapt<TT> = {}) const noexcept {
+      return pack(dim_c<Ns...>, prop, (channel_counter_type)0, i, wrapt<TT>{});
+    }
+
+    template <auto... Ns, typename Prop, typename TT = value_type,
+              enable_if_all<is_property_handle_v<Prop>, sizeof(TT) == sizeof(value_type),
+                            is_same_v<TT, remove_cvref_t<TT>>, (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr auto tuple(value_seq<Ns...>, const Prop &prop, const channel_counter_type chn,
+                         const size_type i, wrapt<TT> = {}) const noexcept {
+      checkPropertyChannels(prop, chn, (Ns * ...));
+      return tuple(dim_c<Ns...>, static_cast<channel_counter_type>(prop.offset + chn), i,
+                   wrapt<TT>{});
+    }
+    template <auto... Ns, typename Prop, typename TT = value_type,
+              enable_if_all<is_property_handle_v<Prop>, sizeof(TT) == sizeof(value_type),
+                            is_same_v<TT, remove_cvref_t<TT>>, (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr auto tuple(value_seq<Ns...>, const Prop &prop, const size_type i,
+                         wrapt<TT> = {}) const noexcept {
+      if constexpr (!is_same_v<Prop, PropertyHandle>)
+        static_assert((Ns * ...) <= Prop::extent, "tieing beyond the static property extent");
+      return tuple(dim_c<Ns...>, prop, (channel_counter_type)0, i, wrapt<TT>{});
+    }
+    template <auto d, typename Prop, typename TT = value_type,
+              enable_if_all<is_property_handle_v<Prop>, sizeof(TT) == sizeof(value_type),
+                            is_same_v<TT, remove_cvref_t<TT>>, (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr auto tuple(const Prop &prop, const size_type i, wrapt<TT> = {}) const noexcept {
+      return tuple(dim_c<d>, prop, (channel_counter_type)0, i, wrapt<TT>{});
+    }
+
+  protected:
+    /// @note static extents are additionally asserted at compile time when no chn offset is given
+    template <typename Prop>
+    constexpr void checkPropertyChannels([[maybe_unused]] const Prop &prop,
+                                         [[maybe_unused]] const channel_counter_type chn,
+                                         [[maybe_unused]] const channel_counter_type n) const
+        noexcept {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (chn < 0 || chn + n > prop.extent)
+        printf("tilevector [%s] ofb! accessing property chn [%d, %d) out of [0, %d)\n",
+               _nameTag.asChars(), (int)chn, (int)(chn + n), (int)prop.extent);
+#endif
+    }
+
+  public:
     constexpr size_type size() const noexcept { return _dims.size(); }
     constexpr channel_counter_type numChannels() const noexcept { return _dims._numChannels; }
 
@@ -1225,6 +1463,12 @@ namespace zs {
     constexpr bool hasProperty(const SmallString &propName) const noexcept {
       return propertyIndex(propName) != _N;
     }
+    /// @brief resolve a property once (e.g. before a loop), invalid if not found
+    constexpr PropertyHandle propertyHandle(const SmallString &propName) const noexcept {
+      auto propNo = propertyIndex(propName);
+      if (propNo == _N) return PropertyHandle{};
+      return PropertyHandle{_tagOffsets[propNo], _tagSizes[propNo]};
+    }
 
     using base_t::operator();
     using base_t::mount;
@@ -3,10 +3,14 @@
 #include <vector>
 
 #include "zensim/ZpcAsync.hpp"
+#include "zensim/ZpcResource.hpp"
 #include "zensim/memory/Allocator.h"
 
 namespace zs {
   namespace detail {
+    /// @brief backing store of the async slab pools
+    /// @note host allocations are thread-safe by themselves, slabs are requested rarely (once per
+    /// 'BlocksPerSlab' objects of a thread), thus no lock is taken here
     class AsyncMemoryArena {
     public:
       AsyncMemoryArena() = default;
@@ -17,33 +21,76 @@ namespace zs {
       }
 
       void *allocate(size_t bytes, size_t alignment) {
-        _mutex.lock();
         void *ptr = zs::allocate(mem_host, bytes, alignment);
-        _mutex.unlock();
+        _numAllocations.fetch_add(1);
         return ptr;
       }
 
       void deallocate(void *ptr, size_t bytes, size_t alignment) {
-        _mutex.lock();
         zs::deallocate(mem_host, ptr, bytes, alignment);
-        _mutex.unlock();
+        _numDeallocations.fetch_add(1);
       }
 
+      size_t numAllocations() const noexcept { return _numAllocations.load(); }
+      size_t numDeallocations() const noexcept { return _numDeallocations.load(); }
+
     private:
-      Mutex _mutex{};
+      Atomic<size_t> _numAllocations{0}, _numDeallocations{0};
     };
 
+    /// @brief per-thread slab pool of fixed-size objects
+    /// @note every thread acquiring from the pool owns a heap of slabs. acquire only touches the
+    /// heap of the calling thread; releasing an object owned by another heap pushes it onto that
+    /// heap's remote list (multi-producer, drained at once by the owner), so neither path locks
+    /// and the lists are free of ABA.
+    /// @note slabs are aligned to their (power-of-two) size, the owning heap is found by masking the
+    /// object address. heaps of exited threads are adopted by the next thread touching the pool.
+    /// @note the pool mutex is only taken when a thread first uses the pool.
     template <typename T, size_t BlocksPerSlab = 256>
     class AsyncObjectPool {
+      union Slot {
+        Slot *next;
+        alignas(T) byte storage[sizeof(T)];
+      };
+
+      struct Heap {
+        /// owner thread only
+        Slot *local{nullptr};
+        size_t numSlabs{0};
+        /// pushed by other threads, taken as a whole by the owner
+        alignas(64) Atomic<Slot *> remote{nullptr};
+        Atomic<bool> abandoned{false};
+        Atomic<bool> retired{false};
+      };
+
+      struct SlabHeader {
+        Heap *owner;
+        SlabHeader *next;
+      };
+
+      static constexpr size_t round_up_(size_t v, size_t a) noexcept { return (v + a - 1) / a * a; }
+      static constexpr size_t next_pow2_(size_t v) noexcept {
+        size_t r = 1;
+        while (r < v) r <<= 1;
+        return r;
+      }
+
     public:
-      AsyncObjectPool() = default;
+      static constexpr size_t header_bytes = round_up_(sizeof(SlabHeader), alignof(Slot));
+      static constexpr size_t slab_bytes = next_pow2_(header_bytes + sizeof(Slot) * BlocksPerSlab);
+      static constexpr size_t slots_per_slab = (slab_bytes - header_bytes) / sizeof(Slot);
+
+      AsyncObjectPool() : _id{next_pool_id_()} {}
 
       ~AsyncObjectPool() {
-        auto &cache = local_cache_();
-        if (cache.owner == this) flush_local_cache_(cache);
-        for (void *slab : _slabs)
-          AsyncMemoryArena::instance().deallocate(slab, sizeof(Slot) * BlocksPerSlab,
-                                                  alignof(Slot));
+        for (auto &heap : _heaps) heap->retired.store(true);
+        if (_lastHeap.id == _id) _lastHeap = LastHeap{0, nullptr, _lastHeap.threadExited};
+        SlabHeader *slab = _slabs.load();
+        while (slab) {
+          SlabHeader *next = slab->next;
+          AsyncMemoryArena::instance().deallocate(slab, slab_bytes, slab_bytes);
+          slab = next;
+        }
       }
 
       AsyncObjectPool(const AsyncObjectPool &) = delete;
@@ -51,130 +98,202 @@ namespace zs {
 
       template <typename... Args>
       T *acquire(Args &&...args) {
-        auto &cache = local_cache_();
-        bind_local_cache_(cache);
-
-        Slot *slot = local_pop_(cache);
-        if (!slot) slot = refill_local_cache_(cache);
-        if (!slot) {
-          grow_();
-          slot = refill_local_cache_(cache);
+        Slot *slot = nullptr;
+        if (Heap *heap = find_local_heap_())
+          slot = take_(*heap);
+        else if (!_lastHeap.threadExited)
+          slot = take_(local_heap_());
+        else {
+          /// the calling thread is past its heaps (e.g. within another thread_local destructor),
+          /// borrow an abandoned heap for this one slot
+          auto heap = adopt_heap_();
+          slot = take_(*heap);
+          heap->abandoned.store(true);
         }
-        if (!slot) return nullptr;
         return ::new (static_cast<void *>(slot->storage)) T(zs::forward<Args>(args)...);
       }
 
       void release(T *ptr) noexcept {
         if (!ptr) return;
         ptr->~T();
+        auto *slot = reinterpret_cast<Slot *>(ptr);
+        Heap *owner = slab_of_(ptr)->owner;
+        if (owner == find_local_heap_()) {
+          slot->next = owner->local;
+          owner->local = slot;
+          return;
+        }
+        Slot *head = owner->remote.load();
+        do {
+          slot->next = head;
+        } while (!owner->remote.compare_exchange_weak(head, slot));
+      }
 
-        auto &cache = local_cache_();
-        bind_local_cache_(cache);
-        local_push_(cache, reinterpret_cast<Slot *>(ptr));
-
-        if (cache.count >= kLocalCacheLimit) flush_local_cache_(cache, kLocalCacheLimit / 2);
+      /// @brief number of slabs requested from the arena so far
+      size_t numSlabs() const noexcept { return _numSlabs.load(); }
+      /// @brief number of per-thread heaps (live and abandoned)
+      size_t numHeaps() const {
+        std::lock_guard<Mutex> lk{_mutex};
+        return _heaps.size();
       }
 
     private:
-      union Slot {
-        Slot *next;
-        alignas(T) byte storage[sizeof(T)];
+      /// heaps of the calling thread, keyed by pool id (ids are never reused)
+      struct ThreadHeaps {
+        ~ThreadHeaps() {
+          /// later calls of this thread must not reach the heaps, other threads may adopt them
+          _lastHeap = LastHeap{0, nullptr, true};
+          for (auto &entry : entries) entry.second->abandoned.store(true);
+        }
+        std::vector<std::pair<u64, SharedPtr<Heap>>> entries{};
       };
-
-      struct LocalCache {
-        AsyncObjectPool *owner{nullptr};
-        Slot *head{nullptr};
-        Slot *tail{nullptr};
-        size_t count{0};
+      /// trivially destructible, hence no tls guard upon the hot path
+      struct LastHeap {
+        u64 id{0};
+        Heap *heap{nullptr};
+        /// set once _threadHeaps is destroyed
+        bool threadExited{false};
       };
+      inline static thread_local ThreadHeaps _threadHeaps{};
+      inline static thread_local LastHeap _lastHeap{};
 
-      static constexpr size_t kLocalCacheLimit = BlocksPerSlab < 32 ? BlocksPerSlab : 32;
-      inline static thread_local LocalCache _localCache{};
-
-      Slot *pop_() noexcept {
-        Slot *head = _freeList.load();
-        while (head) {
-          Slot *next = head->next;
-          if (_freeList.compare_exchange_weak(head, next)) return head;
-        }
-        return nullptr;
+      static u64 next_pool_id_() noexcept {
+        static Atomic<u64> s_nextId{0};
+        return s_nextId.fetch_add(1) + 1;
       }
 
-      void push_(Slot *slot) noexcept {
-        Slot *head = _freeList.load();
-        do {
-          slot->next = head;
-        } while (!_freeList.compare_exchange_weak(head, slot));
+      static SlabHeader *slab_of_(const void *ptr) noexcept {
+        return reinterpret_cast<SlabHeader *>(reinterpret_cast<uintptr_t>(ptr)
+                                              & ~(uintptr_t)(slab_bytes - 1));
       }
 
-      static LocalCache &local_cache_() noexcept { return _localCache; }
-
-      void bind_local_cache_(LocalCache &cache) noexcept {
-        if (cache.owner == this) return;
-        if (cache.owner && cache.head) cache.owner->flush_local_cache_(cache);
-        cache.owner = this;
-        cache.head = nullptr;
-        cache.tail = nullptr;
-        cache.count = 0;
+      Heap *find_local_heap_() noexcept {
+        if (_lastHeap.id == _id && !_lastHeap.heap->abandoned.load())
+          return _lastHeap.heap;
+        if (_lastHeap.threadExited) return nullptr;
+        for (auto &entry : _threadHeaps.entries)
+          if (entry.first == _id) {
+            _lastHeap = LastHeap{_id, entry.second.get()};
+            return _lastHeap.heap;
+          }
+        return nullptr;
       }
 
-      Slot *local_pop_(LocalCache &cache) noexcept {
-        Slot *slot = cache.head;
-        if (!slot) return nullptr;
-        cache.head = slot->next;
-        if (!cache.head) cache.tail = nullptr;
-        slot->next = nullptr;
-        --cache.count;
-        return slot;
-      }
+      /// @note the calling thread has no heap of this pool yet
+      Heap &local_heap_() {
+        auto &tls = _threadHeaps;
+        /// forget heaps of destroyed pools
+        for (size_t i = 0; i < tls.entries.size();)
+          if (tls.entries[i].second->retired.load()) {
+            tls.entries[i] = zs::move(tls.entries.back());
+            tls.entries.pop_back();
+          } else
+            ++i;
 
-      void local_push_(LocalCache &cache, Slot *slot) noexcept {
-        slot->next = cache.head;
-        cache.head = slot;
-        if (!cache.tail) cache.tail = slot;
-        ++cache.count;
+        auto heap = adopt_heap_();
+        tls.entries.emplace_back(_id, heap);
+        _lastHeap = LastHeap{_id, heap.get()};
+        return *heap;
       }
 
-      Slot *refill_local_cache_(LocalCache &cache) noexcept {
-        while (cache.count < kLocalCacheLimit) {
-          Slot *slot = pop_();
-          if (!slot) break;
-          local_push_(cache, slot);
+      /// an abandoned heap (now owned by the caller), or a new one
+      SharedPtr<Heap> adopt_heap_() {
+        std::lock_guard<Mutex> lk{_mutex};
+        for (auto &candidate : _heaps) {
+          bool expected = true;
+          if (candidate->abandoned.compare_exchange_strong(expected, false)) return candidate;
         }
-        return local_pop_(cache);
+        auto heap = zs::make_shared<Heap>();
+        _heaps.push_back(heap);
+        return heap;
       }
 
-      void flush_local_cache_(LocalCache &cache, size_t retain = 0) noexcept {
-        while (cache.count > retain) {
-          Slot *slot = local_pop_(cache);
-          if (!slot) break;
-          push_(slot);
-        }
+      Slot *take_(Heap &heap) {
+        Slot *slot = heap.local;
+        if (!slot) slot = heap.remote.exchange(nullptr);
+        if (!slot) slot = grow_(heap);
+        heap.local = slot->next;
+        return slot;
       }
 
-      void grow_() {
-        _slabMutex.lock();
-        if (_freeList.load()) {
-          _slabMutex.unlock();
-          return;
-        }
-
-        void *slab = AsyncMemoryArena::instance().allocate(sizeof(Slot) * BlocksPerSlab, alignof(Slot));
-        _slabs.push_back(slab);
-        auto *slots = reinterpret_cast<Slot *>(slab);
-        for (size_t i = 0; i < BlocksPerSlab; ++i) push_(&slots[i]);
-        _slabMutex.unlock();
+      Slot *grow_(Heap &heap) {
+        void *mem = AsyncMemoryArena::instance().allocate(slab_bytes, slab_bytes);
+        if (!mem) throw std::bad_alloc{};
+        auto *slab = ::new (mem) SlabHeader{&heap, nullptr};
+        auto *slots = reinterpret_cast<Slot *>(static_cast<byte *>(mem) + header_bytes);
+        for (size_t i = 0; i + 1 < slots_per_slab; ++i) slots[i].next = &slots[i + 1];
+        slots[slots_per_slab - 1].next = nullptr;
+        /// push-only registration, only traversed upon destruction
+        SlabHeader *head = _slabs.load();
+        do {
+          slab->next = head;
+        } while (!_slabs.compare_exchange_weak(head, slab));
+        ++heap.numSlabs;
+        _numSlabs.fetch_add(1);
+        return slots;
       }
 
-      Atomic<Slot *> _freeList{nullptr};
-      Mutex _slabMutex{};
-      std::vector<void *> _slabs{};
+      u64 _id;
+      Atomic<SlabHeader *> _slabs{nullptr};
+      Atomic<size_t> _numSlabs{0};
+      mutable Mutex _mutex{};
+      std::vector<SharedPtr<Heap>> _heaps{};
     };
 
+    /// @brief process-wide pool, intentionally leaked so that objects released during static
+    /// destruction still find their slabs
     template <typename T, size_t BlocksPerSlab = 256>
     AsyncObjectPool<T, BlocksPerSlab> &async_pool() {
-      static AsyncObjectPool<T, BlocksPerSlab> pool;
-      return pool;
+      static auto *pool = new AsyncObjectPool<T, BlocksPerSlab>();
+      return *pool;
     }
+
+    /// @brief raw storage block served by the async slab pools
+    template <size_t Bytes> struct alignas(64) AsyncBlock {
+      byte data[Bytes];
+    };
+
+    /// @brief mr-style allocator over size-classed async slab pools, suitable for allocate_shared
+    /// and coroutine frames
+    /// @note requests above 'max_pooled_bytes' (or over-aligned ones) go to the arena
+    struct AsyncBlockAllocator {
+      static constexpr size_t max_pooled_bytes = 4096;
+
+      void *allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        if (alignment <= 64) {
+          if (bytes <= 64) return async_pool<AsyncBlock<64>, 1024>().acquire();
+          if (bytes <= 128) return async_pool<AsyncBlock<128>, 512>().acquire();
+          if (bytes <= 256) return async_pool<AsyncBlock<256>, 256>().acquire();
+          if (bytes <= 512) return async_pool<AsyncBlock<512>, 128>().acquire();
+          if (bytes <= 1024) return async_pool<AsyncBlock<1024>, 64>().acquire();
+          if (bytes <= 2048) return async_pool<AsyncBlock<2048>, 32>().acquire();
+          if (bytes <= 4096) return async_pool<AsyncBlock<4096>, 16>().acquire();
+        }
+        return AsyncMemoryArena::instance().allocate(bytes, alignment);
+      }
+
+      void deallocate(void *p, size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        if (alignment <= 64) {
+          if (bytes <= 64) return async_pool<AsyncBlock<64>, 1024>().release(
+              static_cast<AsyncBlock<64> *>(p));
+          if (bytes <= 128) return async_pool<AsyncBlock<128>, 512>().release(
+              static_cast<AsyncBlock<128> *>(p));
+          if (bytes <= 256) return async_pool<AsyncBlock<256>, 256>().release(
+              static_cast<AsyncBlock<256> *>(p));
+          if (bytes <= 512) return async_pool<AsyncBlock<512>, 128>().release(
+              static_cast<AsyncBlock<512> *>(p));
+          if (bytes <= 1024) return async_pool<AsyncBlock<1024>, 64>().release(
+              static_cast<AsyncBlock<1024> *>(p));
+          if (bytes <= 2048) return async_pool<AsyncBlock<2048>, 32>().release(
+              static_cast<AsyncBlock<2048> *>(p));
+          if (bytes <= 4096) return async_pool<AsyncBlock<4096>, 16>().release(
+              static_cast<AsyncBlock<4096> *>(p));
+        }
+        AsyncMemoryArena::instance().deallocate(p, bytes, alignment);
+      }
+
+      bool operator==(const AsyncBlockAllocator &) const noexcept { return true; }
+      bool operator!=(const AsyncBlockAllocator &) const noexcept { return false; }
+    };
   }  // namespace detail
-}  // namespace zs
\ No newline at end of file
+}  // namespace zs
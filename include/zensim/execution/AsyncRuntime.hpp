@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <iterator>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -7,7 +9,9 @@
 #include "zensim/ZpcAsync.hpp"
 #include "zensim/ZpcFunction.hpp"
 #include "zensim/container/ConcurrentQueue.hpp"
+#include "zensim/execution/AsyncMemoryPool.hpp"
 #include "zensim/execution/ConcurrencyPrimitive.hpp"
+#include "zensim/execution/CpuTopology.hpp"
 #include "zensim/execution/Intrinsics.hpp"
 #include "zensim/execution/ManagedThread.hpp"
 #include "zensim/types/ImplPattern.hpp"
@@ -117,16 +121,18 @@ namespace zs {
   public:
     using callback_t = function<void()>;
 
-    AsyncEvent() : _state{zs::make_shared<SharedState>()} {}
+    AsyncEvent() : _state{zs::allocate_shared<SharedState>(detail::AsyncBlockAllocator{})} {}
 
     static AsyncEvent create() { return AsyncEvent{}; }
 
     void wait() const {
+      std::lock_guard<Mutex> lock(_state->mutex);
       _state->cv.wait(_state->mutex,
                       [state = _state.get()] { return is_terminal(state->status.load()); });
     }
 
     bool wait_for(i64 timeoutMs) const {
+      std::lock_guard<Mutex> lock(_state->mutex);
       return _state->cv.wait_for(_state->mutex, timeoutMs,
                                  [state = _state.get()] { return is_terminal(state->status.load()); });
     }
@@ -215,6 +221,11 @@ namespace zs {
     virtual AsyncBackend backend() const noexcept = 0;
     virtual std::string_view name() const noexcept = 0;
     virtual AsyncEvent submit(Shared<AsyncSubmissionState> state) = 0;
+    /// @brief submits states whose prerequisites are all satisfied
+    /// @note executors with a cheaper bulk path (one queue reservation, one wake-up) override this
+    virtual void submit_bulk(const Shared<AsyncSubmissionState> *states, size_t count) {
+      for (size_t i = 0; i != count; ++i) submit(states[i]);
+    }
   };
 
   struct AsyncSubmissionState {
@@ -278,7 +289,8 @@ namespace zs {
 
   class AsyncThreadPoolExecutor : public AsyncExecutor {
   public:
-    explicit AsyncThreadPoolExecutor(std::string executorName = "thread_pool", size_t workerCount = 1);
+    explicit AsyncThreadPoolExecutor(std::string executorName = "thread_pool", size_t workerCount = 1,
+                                     cpu_affinity_e affinity = affinity_none, i32 numaNode = -1);
     ~AsyncThreadPoolExecutor() override;
 
     AsyncThreadPoolExecutor(const AsyncThreadPoolExecutor &) = delete;
@@ -287,6 +299,7 @@ namespace zs {
     AsyncBackend backend() const noexcept override { return AsyncBackend::thread_pool; }
     std::string_view name() const noexcept override { return _name; }
     AsyncEvent submit(Shared<AsyncSubmissionState> state) override;
+    void submit_bulk(const Shared<AsyncSubmissionState> *states, size_t count) override;
     void shutdown() noexcept;
 
   private:
@@ -307,6 +320,12 @@ namespace zs {
     std::vector<Unique<ManagedThread>> _workers{};
   };
 
+  /// @brief intra-batch ordering, 'dependent' runs after 'prerequisite' (indices into the batch)
+  struct AsyncBatchDependency {
+    u32 prerequisite{0};
+    u32 dependent{0};
+  };
+
   class AsyncRuntime {
   public:
     explicit AsyncRuntime(size_t workerCount = 1);
@@ -315,13 +334,47 @@ namespace zs {
     bool contains_executor(const std::string &name) const;
     void register_executor(std::string name, Shared<AsyncExecutor> executor);
     AsyncSubmissionHandle submit(AsyncSubmission submission);
+    /// @brief submits 'count' submissions at once, the submissions are moved from
+    /// @note executors are resolved and the dependencies validated (indices, acyclicity) once for
+    /// the whole batch before anything is dispatched, ready items are handed over to their
+    /// executor in bulk (a single queue enqueue for the thread pool)
+    /// @note intra-batch dependencies share one preallocated counter array, and each prerequisite
+    /// registers a single completion callback no matter how many dependents it has
+    /// @return handles in submission order
+    std::vector<AsyncSubmissionHandle> submit_batch(AsyncSubmission *submissions, size_t count,
+                                                    const AsyncBatchDependency *dependencies
+                                                    = nullptr,
+                                                    size_t numDependencies = 0);
+    std::vector<AsyncSubmissionHandle> submit_batch(
+        std::vector<AsyncSubmission> &submissions,
+        const std::vector<AsyncBatchDependency> &dependencies = {});
     bool resume(const AsyncSubmissionHandle &handle);
     static AsyncPollStatus run_step(const Shared<AsyncSubmissionState> &state);
 
   private:
+    struct BatchState {
+      struct Counter {
+        Atomic<u32> remaining{0};
+        atomic_bool failed{false};
+        atomic_bool cancelled{false};
+      };
+      explicit BatchState(size_t count) : states(count), executors(count), counters(count) {}
+
+      std::vector<Shared<AsyncSubmissionState>> states;
+      std::vector<Shared<AsyncExecutor>> executors;
+      std::vector<Counter> counters;
+      std::vector<u8> stopOnFailure{};
+      /// dependents of item i: dependents[dependentOffsets[i], dependentOffsets[i + 1])
+      std::vector<u32> dependentOffsets{}, dependents{};
+    };
+
+    Shared<AsyncSubmissionState> make_state(AsyncSubmission &submission, u64 id) const;
     Shared<AsyncExecutor> get_executor(const SmallString &name) const;
     void dispatch(const Shared<AsyncSubmissionState> &state,
                   const Shared<AsyncExecutor> &executor) const;
+    /// @return true if the item became ready and was neither failed nor cancelled
+    bool release_batch_item(BatchState &batch, u32 i, AsyncTaskStatus prerequisite,
+                            bool dispatchWhenReady) const;
 
     mutable Mutex _mutex{};
     std::unordered_map<std::string, Shared<AsyncExecutor>> _executors{};
@@ -339,14 +392,17 @@ namespace zs {
     return state->event;
   }
 
-  inline AsyncThreadPoolExecutor::AsyncThreadPoolExecutor(std::string executorName, size_t workerCount)
+  inline AsyncThreadPoolExecutor::AsyncThreadPoolExecutor(std::string executorName, size_t workerCount,
+                                                          cpu_affinity_e affinity, i32 numaNode)
       : _name{zs::move(executorName)} {
     if (workerCount == 0) workerCount = 1;
     if (workerCount > 16) workerCount = 16;
     _workerCount = workerCount;
     _workers.reserve(workerCount);
+    const auto cpus = CpuTopology::instance().placement(affinity, (u32)workerCount, numaNode);
     for (size_t i = 0; i != workerCount; ++i) {
       auto worker = zs::make_unique<ManagedThread>();
+      if (!cpus.empty()) worker->set_affinity(static_cast<i32>(cpus[i]));
       worker->start([this](ManagedThread &thread) { worker_loop(thread); }, "async-worker");
       _workers.push_back(zs::move(worker));
     }
@@ -395,6 +451,35 @@ namespace zs {
     return state->event;
   }
 
+  inline void AsyncThreadPoolExecutor::submit_bulk(const Shared<AsyncSubmissionState> *states,
+                                                    size_t count) {
+    std::vector<WorkItem> items;
+    items.reserve(count);
+    for (size_t i = 0; i != count; ++i) {
+      const auto &state = states[i];
+      if (!state) continue;
+      if (!_running.load()) {
+        state->event.mark_failed();
+        state->inFlight.store(false);
+      } else if (state->cancellation.stop_requested()
+                 || state->cancellation.interrupt_requested()) {
+        state->event.mark_cancelled();
+        state->inFlight.store(false);
+      } else
+        items.push_back(WorkItem{state});
+    }
+    if (items.empty()) return;
+    if (!_queue.try_enqueue_bulk(std::make_move_iterator(items.begin()), items.size())) {
+      /// no room for the whole range, fall back to the retrying single-item path
+      for (auto &item : items) submit(zs::move(item.state));
+      return;
+    }
+    if (items.size() >= _workerCount)
+      wake_all();
+    else
+      for (size_t i = 0; i != items.size(); ++i) wake_one();
+  }
+
   inline void AsyncThreadPoolExecutor::wake_one() noexcept {
     _signal.fetch_add(1);
     Futex::wake(&_signal, 1);
@@ -487,17 +572,25 @@ namespace zs {
     executor->submit(state);
   }
 
-  inline AsyncSubmissionHandle AsyncRuntime::submit(AsyncSubmission submission) {
-    auto executor = get_executor(submission.executor);
-    if (!executor) throw StaticException();
-
-    auto state = zs::make_shared<AsyncSubmissionState>();
-    state->id = _nextSubmissionId.fetch_add(1) + 1;
+  inline Shared<AsyncSubmissionState> AsyncRuntime::make_state(AsyncSubmission &submission,
+                                                               u64 id) const {
+    /// submission states, their events and dependency counters come from the async slab pools,
+    /// work items are queued by value, so steady-state submission does not hit the heap
+    auto state = zs::allocate_shared<AsyncSubmissionState>(detail::AsyncBlockAllocator{});
+    state->id = id;
     state->executor = submission.executor;
     state->desc = submission.desc;
     state->endpoint = submission.endpoint;
     state->cancellation = submission.cancellation;
     state->step = zs::move(submission.step);
+    return state;
+  }
+
+  inline AsyncSubmissionHandle AsyncRuntime::submit(AsyncSubmission submission) {
+    auto executor = get_executor(submission.executor);
+    if (!executor) throw StaticException();
+
+    auto state = make_state(submission, _nextSubmissionId.fetch_add(1) + 1);
 
     AsyncSubmissionHandle handle{state};
     if (submission.prerequisites.empty()) {
@@ -511,7 +604,7 @@ namespace zs {
       atomic_bool cancelled{false};
     };
 
-    auto dependencyState = zs::make_shared<DependencyState>();
+    auto dependencyState = zs::allocate_shared<DependencyState>(detail::AsyncBlockAllocator{});
     dependencyState->remaining.store(submission.prerequisites.size());
 
     for (const auto &prerequisite : submission.prerequisites) {
@@ -539,6 +632,139 @@ namespace zs {
     return handle;
   }
 
+  inline bool AsyncRuntime::release_batch_item(BatchState &batch, u32 i,
+                                               AsyncTaskStatus prerequisite,
+                                               bool dispatchWhenReady) const {
+    auto &counter = batch.counters[i];
+    if (batch.stopOnFailure[i]) {
+      if (prerequisite == AsyncTaskStatus::failed)
+        counter.failed.store(true);
+      else if (prerequisite == AsyncTaskStatus::cancelled)
+        counter.cancelled.store(true);
+    }
+    if (counter.remaining.fetch_sub(1) != 1) return false;
+    const auto &state = batch.states[i];
+    if (counter.failed.load()) {
+      state->event.mark_failed();
+      return false;
+    }
+    if (counter.cancelled.load()) {
+      state->event.mark_cancelled();
+      return false;
+    }
+    if (dispatchWhenReady) dispatch(state, batch.executors[i]);
+    return true;
+  }
+
+  inline std::vector<AsyncSubmissionHandle> AsyncRuntime::submit_batch(
+      AsyncSubmission *submissions, size_t count, const AsyncBatchDependency *dependencies,
+      size_t numDependencies) {
+    std::vector<AsyncSubmissionHandle> handles;
+    if (count == 0) return handles;
+
+    /// validation, nothing is dispatched before the whole batch is known to be well-formed
+    auto batch = zs::make_shared<BatchState>(count);
+    {
+      std::lock_guard<Mutex> lock(_mutex);
+      const SmallString *lastName = nullptr;
+      Shared<AsyncExecutor> lastExecutor{};
+      for (size_t i = 0; i != count; ++i) {
+        const auto &name = submissions[i].executor;
+        if (!lastName || std::string_view{lastName->asChars()} != name.asChars()) {
+          auto it = _executors.find(name.asChars());
+          if (it == _executors.end()) throw StaticException();
+          lastName = &name;
+          lastExecutor = it->second;
+        }
+        batch->executors[i] = lastExecutor;
+      }
+    }
+    auto &offsets = batch->dependentOffsets;
+    offsets.assign(count + 1, 0);
+    std::vector<u32> indegree(count, 0);
+    for (size_t e = 0; e != numDependencies; ++e) {
+      const auto &dep = dependencies[e];
+      if (dep.prerequisite >= count || dep.dependent >= count || dep.prerequisite == dep.dependent)
+        throw StaticException();
+      ++offsets[dep.prerequisite + 1];
+      ++indegree[dep.dependent];
+    }
+    for (size_t i = 0; i != count; ++i) offsets[i + 1] += offsets[i];
+    batch->dependents.resize(numDependencies);
+    {
+      std::vector<u32> cursor(offsets.begin(), offsets.end() - 1);
+      for (size_t e = 0; e != numDependencies; ++e)
+        batch->dependents[cursor[dependencies[e].prerequisite]++] = dependencies[e].dependent;
+    }
+    {
+      /// kahn, an intra-batch cycle would never be released
+      std::vector<u32> pending(indegree), stack;
+      for (u32 i = 0; i != count; ++i)
+        if (pending[i] == 0) stack.push_back(i);
+      size_t visited = 0;
+      while (!stack.empty()) {
+        const auto i = stack.back();
+        stack.pop_back();
+        ++visited;
+        for (auto k = offsets[i]; k != offsets[i + 1]; ++k)
+          if (--pending[batch->dependents[k]] == 0) stack.push_back(batch->dependents[k]);
+      }
+      if (visited != count) throw StaticException();
+    }
+
+    /// states and counters, each item holds one extra guard count until wiring is complete
+    const auto firstId = _nextSubmissionId.fetch_add(count) + 1;
+    batch->stopOnFailure.resize(count);
+    handles.reserve(count);
+    for (size_t i = 0; i != count; ++i) {
+      auto &submission = submissions[i];
+      batch->states[i] = make_state(submission, firstId + i);
+      batch->stopOnFailure[i] = submission.stopOnPrerequisiteFailure;
+      batch->counters[i].remaining.store(
+          static_cast<u32>(submission.prerequisites.size()) + indegree[i] + 1);
+      handles.push_back(AsyncSubmissionHandle{batch->states[i]});
+    }
+
+    for (u32 i = 0; i != count; ++i) {
+      if (offsets[i] != offsets[i + 1])
+        batch->states[i]->event.on_complete([batch, i, this] {
+          const auto status = batch->states[i]->event.status();
+          for (auto k = batch->dependentOffsets[i]; k != batch->dependentOffsets[i + 1]; ++k)
+            release_batch_item(*batch, batch->dependents[k], status, true);
+        });
+      for (const auto &prerequisite : submissions[i].prerequisites)
+        prerequisite.on_complete([batch, i, prerequisite, this] {
+          release_batch_item(*batch, i, prerequisite.status(), true);
+        });
+    }
+
+    /// drop the guards, ready items are grouped per executor and handed over in bulk
+    std::vector<std::pair<AsyncExecutor *, std::vector<Shared<AsyncSubmissionState>>>> ready;
+    for (u32 i = 0; i != count; ++i) {
+      if (!release_batch_item(*batch, i, AsyncTaskStatus::completed, false)) continue;
+      const auto &state = batch->states[i];
+      bool expected = false;
+      if (!state->inFlight.compare_exchange_strong(expected, true)) continue;
+      auto *executor = batch->executors[i].get();
+      auto it = std::find_if(ready.begin(), ready.end(),
+                             [executor](const auto &group) { return group.first == executor; });
+      if (it == ready.end()) {
+        ready.emplace_back(executor, std::vector<Shared<AsyncSubmissionState>>{});
+        it = ready.end() - 1;
+      }
+      it->second.push_back(state);
+    }
+    for (auto &[executor, states] : ready) executor->submit_bulk(states.data(), states.size());
+    return handles;
+  }
+
+  inline std::vector<AsyncSubmissionHandle> AsyncRuntime::submit_batch(
+      std::vector<AsyncSubmission> &submissions,
+      const std::vector<AsyncBatchDependency> &dependencies) {
+    return submit_batch(submissions.data(), submissions.size(), dependencies.data(),
+                        dependencies.size());
+  }
+
   inline bool AsyncRuntime::resume(const AsyncSubmissionHandle &handle) {
     if (!handle._state) return false;
     const auto current = handle._state->event.status();
@@ -11,8 +11,10 @@
 #include "zensim/ZpcFunction.hpp"
 #include "zensim/container/ConcurrentQueue.hpp"
 #include "zensim/execution/AsyncMemoryPool.hpp"
+#include "zensim/execution/CpuTopology.hpp"
 #include "zensim/execution/Intrinsics.hpp"
 #include "zensim/execution/ManagedThread.hpp"
+#include "zensim/profile/KernelProfiler.hpp"
 
 namespace zs {
 
@@ -32,10 +34,44 @@ namespace zs {
     }
 
     ~CoroTaskNode() {
+      reset_callable();
       release_edges_(_preds);
       release_edges_(_succs);
     }
 
+    /// @brief turns this node into a plain callable node (no coroutine frame)
+    /// @note callables up to 'inline_callable_bytes' are stored in the node, larger ones in a
+    /// pooled block
+    template <typename F> void set_callable(F &&f) {
+      using Fn = decay_t<F>;
+      reset_callable();
+      if constexpr (sizeof(Fn) <= inline_callable_bytes
+                    && alignof(Fn) <= alignof(std::max_align_t)) {
+        _callable = ::new (static_cast<void *>(_callableStorage)) Fn(zs::forward<F>(f));
+        _destroyCallable = [](void *p) noexcept { static_cast<Fn *>(p)->~Fn(); };
+      } else {
+        void *mem = detail::AsyncBlockAllocator{}.allocate(sizeof(Fn), alignof(Fn));
+        _callable = ::new (mem) Fn(zs::forward<F>(f));
+        _destroyCallable = [](void *p) noexcept {
+          static_cast<Fn *>(p)->~Fn();
+          detail::AsyncBlockAllocator{}.deallocate(p, sizeof(Fn), alignof(Fn));
+        };
+      }
+      _invokeCallable = [](void *p) { (*static_cast<Fn *>(p))(); };
+    }
+
+    void reset_callable() noexcept {
+      if (_destroyCallable) _destroyCallable(_callable);
+      _callable = nullptr;
+      _invokeCallable = nullptr;
+      _destroyCallable = nullptr;
+    }
+
+    bool has_callable() const noexcept { return _invokeCallable != nullptr; }
+
+    /// @brief the exception escaping the last run of a callable node, if any
+    std::exception_ptr exception() const noexcept { return _exception; }
+
     enum state_e : u8 { idle = 0, planned, scheduled, running, done };
 
     template <typename Fn>
@@ -55,10 +91,34 @@ namespace zs {
     Atomic<int> _numDeps{0};
     Future<void> _task{};
     BasicSmallString<> _tag{};
+    /// interned upon the first profiled run
+    u32 _profileSite{KernelProfiler::invalid_site};
 
     Atomic<state_e> _state{idle};
 
+    static constexpr size_t inline_callable_bytes = 48;
+
   private:
+    friend struct AsyncScheduler;
+
+    /// @return false if the callable threw
+    bool invoke_callable_() noexcept {
+      try {
+        _invokeCallable(_callable);
+        _exception = nullptr;
+        return true;
+      } catch (...) {
+        _exception = std::current_exception();
+        return false;
+      }
+    }
+
+    alignas(std::max_align_t) byte _callableStorage[inline_callable_bytes];
+    void *_callable{nullptr};
+    void (*_invokeCallable)(void *){nullptr};
+    void (*_destroyCallable)(void *) noexcept {nullptr};
+    std::exception_ptr _exception{};
+
     void append_edge_(Atomic<CoroTaskEdge *> &head, CoroTaskNode *node, atomic_size_t &count) {
       auto *edge = detail::async_pool<CoroTaskEdge, 1024>().acquire();
       edge->node = node;
@@ -167,9 +227,18 @@ namespace zs {
       ConcurrentQueue<TaskHandle, 256> localQueue{};
       Atomic<u32> status{2};
       i32 index{-1};
+      /// pinned logical cpu (-1 if unpinned)
+      i32 cpu{-1};
+      /// victims ordered by distance (same L3 domain, same package, others), 'tierEnds' delimits
+      /// the tiers within which the start is rotated
+      u8 stealOrder[kMaxWorkers]{};
+      u8 tierEnds[3]{};
     };
 
-    explicit AsyncScheduler(size_t numThreads = 4);
+    /// @param affinity pins the workers according to CpuTopology::placement
+    /// @param numaNode restricts the workers to a numa node (a node-local pool), -1 for all
+    explicit AsyncScheduler(size_t numThreads = 4, cpu_affinity_e affinity = affinity_none,
+                            i32 numaNode = -1);
     ~AsyncScheduler();
 
     AsyncScheduler(const AsyncScheduler &) = delete;
@@ -194,6 +263,9 @@ namespace zs {
     void shutdown();
 
     size_t numWorkers() const noexcept { return _numWorkers; }
+    i32 worker_cpu(size_t workerId) const noexcept {
+      return workerId < _numWorkers ? _workers[workerId].cpu : -1;
+    }
     size_t numJobsRemaining() const noexcept { return _remainingJobs.load(); }
     bool idle() const noexcept { return numJobsRemaining() == 0; }
     i32 current_worker_id() const noexcept {
@@ -216,6 +288,7 @@ namespace zs {
     void enqueue_(TaskHandle &&task, i32 workerId = -1);
     void process_(Worker &worker, TaskHandle &task);
     void worker_loop_(ManagedThread &self, i32 workerIndex);
+    void setup_steal_order_();
     bool try_steal_(Worker &thief, TaskHandle &out);
     void wake_worker_(Worker &worker) noexcept;
     void wake_any_worker_() noexcept;
@@ -228,14 +301,24 @@ namespace zs {
     Atomic<u32> _pauseState{0};
   };
 
-  inline AsyncScheduler::AsyncScheduler(size_t numThreads) {
+  inline AsyncScheduler::AsyncScheduler(size_t numThreads, cpu_affinity_e affinity,
+                                        i32 numaNode) {
     if (numThreads == 0) numThreads = 1;
     if (numThreads > kMaxWorkers) numThreads = kMaxWorkers;
     _numWorkers = numThreads;
     _workers = new Worker[numThreads];
 
+    const auto cpus = CpuTopology::instance().placement(affinity, (u32)numThreads, numaNode);
     for (size_t i = 0; i < numThreads; ++i) {
       _workers[i].index = static_cast<i32>(i);
+      if (!cpus.empty()) {
+        _workers[i].cpu = static_cast<i32>(cpus[i]);
+        _workers[i].thread.set_affinity(_workers[i].cpu);
+      }
+    }
+    setup_steal_order_();
+
+    for (size_t i = 0; i < numThreads; ++i) {
       _workers[i].thread.start(
           [this, i](ManagedThread &self) { worker_loop_(self, static_cast<i32>(i)); },
           "sched-worker");
@@ -334,6 +417,32 @@ namespace zs {
   }
 
   inline void AsyncScheduler::process_(Worker &worker, TaskHandle &task) {
+    u32 site = KernelProfiler::invalid_site;
+    if (auto &profiler = KernelProfiler::instance(); profiler.enabled()) {
+      static const u32 fnSite = profiler.intern("task", "AsyncScheduler");
+      static const u32 coroSite = profiler.intern("coroutine", "AsyncScheduler");
+      static const u32 nodeSite = profiler.intern("task node", "AsyncScheduler");
+      switch (task.kind()) {
+        case TaskHandle::normal_fn:
+          site = fnSite;
+          break;
+        case TaskHandle::once_coro:
+          site = coroSite;
+          break;
+        case TaskHandle::task_node:
+          if (auto *node = task.as_node(); node && node->_tag.size()) {
+            if (node->_profileSite == KernelProfiler::invalid_site)
+              node->_profileSite = profiler.intern(node->_tag.asChars(), "AsyncScheduler");
+            site = node->_profileSite;
+          } else
+            site = nodeSite;
+          break;
+        default:
+          break;
+      }
+    }
+    ProfileScope profileScope{site};
+
     switch (task.kind()) {
       case TaskHandle::normal_fn:
         if (task.as_fn()) task.as_fn()();
@@ -347,7 +456,16 @@ namespace zs {
 
       case TaskHandle::task_node: {
         auto *node = task.as_node();
-        if (node && node->_task.getHandle()) {
+        if (node && node->has_callable()) {
+          node->_state.store(CoroTaskNode::running);
+          node->invoke_callable_();
+          node->_state.store(CoroTaskNode::done);
+          node->for_each_successor([&](CoroTaskNode *successor) {
+            if (successor->_numDeps.fetch_sub(1) == 1) {
+              enqueue_(TaskHandle{successor});
+            }
+          });
+        } else if (node && node->_task.getHandle()) {
           node->_state.store(CoroTaskNode::running);
           node->_task.getHandle().resume();
 
@@ -421,17 +539,38 @@ namespace zs {
     }
   }
 
+  inline void AsyncScheduler::setup_steal_order_() {
+    const auto &topology = CpuTopology::instance();
+    /// unpinned workers (or unknown cpus) are all considered near each other
+    auto tier = [&topology](const Worker &a, const Worker &b) -> u32 {
+      const auto *ca = a.cpu >= 0 ? topology.find(static_cast<u32>(a.cpu)) : nullptr;
+      const auto *cb = b.cpu >= 0 ? topology.find(static_cast<u32>(b.cpu)) : nullptr;
+      if (!ca || !cb || ca->l3Domain == cb->l3Domain) return 0;
+      return ca->package == cb->package ? 1 : 2;
+    };
+    for (size_t i = 0; i < _numWorkers; ++i) {
+      auto &thief = _workers[i];
+      size_t n = 0;
+      for (u32 t = 0; t != 3; ++t) {
+        for (size_t j = 0; j < _numWorkers; ++j)
+          if (j != i && tier(thief, _workers[j]) == t) thief.stealOrder[n++] = static_cast<u8>(j);
+        thief.tierEnds[t] = static_cast<u8>(n);
+      }
+    }
+  }
+
   inline bool AsyncScheduler::try_steal_(Worker &thief, TaskHandle &out) {
     if (_numWorkers <= 1) return false;
 
-    const size_t start = _stealCounter.fetch_add(1) % _numWorkers;
-    const size_t thiefIndex = static_cast<size_t>(thief.index);
-    for (size_t offset = 0; offset < _numWorkers; ++offset) {
-      const size_t victimIndex = (start + offset) % _numWorkers;
-      if (victimIndex == thiefIndex) continue;
-
-      auto &victim = _workers[victimIndex];
-      if (victim.localQueue.try_dequeue(out)) return true;
+    const size_t start = _stealCounter.fetch_add(1);
+    size_t tierBegin = 0;
+    for (u32 t = 0; t != 3; ++t) {
+      const size_t tierSize = thief.tierEnds[t] - tierBegin;
+      for (size_t offset = 0; offset < tierSize; ++offset) {
+        auto &victim = _workers[thief.stealOrder[tierBegin + (start + offset) % tierSize]];
+        if (victim.localQueue.try_dequeue(out)) return true;
+      }
+      tierBegin = thief.tierEnds[t];
     }
     return false;
   }
@@ -0,0 +1,204 @@
+#include "CpuTopology.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <string>
+#include <tuple>
+
+#include "ManagedThread.hpp"
+
+#if defined(__linux__)
+#  include <sched.h>
+#endif
+
+namespace zs {
+
+  namespace {
+
+#if defined(__linux__)
+    bool read_line(const std::string &path, std::string &line) {
+      std::ifstream is{path};
+      if (!is || !std::getline(is, line)) return false;
+      return true;
+    }
+    bool read_u32(const std::string &path, u32 &v) {
+      std::string line;
+      if (!read_line(path, line)) return false;
+      try {
+        v = (u32)std::stoul(line);
+      } catch (...) {
+        return false;
+      }
+      return true;
+    }
+    /// "0-3,8,10-11"
+    std::vector<u32> parse_cpu_list(const std::string &list) {
+      std::vector<u32> ret;
+      size_t pos = 0;
+      while (pos < list.size()) {
+        auto end = list.find(',', pos);
+        if (end == std::string::npos) end = list.size();
+        const auto item = list.substr(pos, end - pos);
+        pos = end + 1;
+        if (item.empty() || item[0] < '0' || item[0] > '9') continue;
+        try {
+          const auto dash = item.find('-');
+          u32 lo = (u32)std::stoul(item.substr(0, dash));
+          u32 hi = dash == std::string::npos ? lo : (u32)std::stoul(item.substr(dash + 1));
+          for (u32 c = lo; c <= hi; ++c) ret.push_back(c);
+        } catch (...) {
+        }
+      }
+      return ret;
+    }
+#endif
+
+    /// dense relabeling of arbitrary ids
+    template <typename Key> struct DenseIds {
+      u32 operator()(const Key &key) { return ids.emplace(key, (u32)ids.size()).first->second; }
+      u32 size() const noexcept { return (u32)ids.size(); }
+      std::map<Key, u32> ids{};
+    };
+
+  }  // namespace
+
+  const CpuTopology &CpuTopology::instance() {
+    static const CpuTopology s_topology = discover();
+    return s_topology;
+  }
+
+  CpuTopology CpuTopology::flat(u32 numCpus) {
+    CpuTopology ret{};
+    if (numCpus == 0) numCpus = 1;
+    ret.cpus.resize(numCpus);
+    for (u32 i = 0; i != numCpus; ++i) ret.cpus[i].cpu = ret.cpus[i].core = i;
+    ret.finalize_();
+    return ret;
+  }
+
+  CpuTopology CpuTopology::discover() {
+#if defined(__linux__)
+    const std::string root = "/sys/devices/system/cpu/";
+    std::string line;
+    if (!read_line(root + "online", line)) return flat(ManagedThread::hardware_concurrency());
+    auto online = parse_cpu_list(line);
+
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    const bool hasMask = sched_getaffinity(0, sizeof(mask), &mask) == 0;
+
+    CpuTopology ret{};
+    /// (package, core_id) -> dense core, (package, first cpu sharing the L3) -> dense domain
+    DenseIds<std::pair<u32, u32>> cores, l3s;
+    std::vector<std::pair<u32, u32>> coreKeys;
+    for (auto cpu : online) {
+      if (hasMask && cpu < CPU_SETSIZE && !CPU_ISSET(cpu, &mask)) continue;
+      const auto dir = root + "cpu" + std::to_string(cpu) + "/";
+      CpuInfo info{};
+      info.cpu = cpu;
+      u32 coreId = cpu;
+      read_u32(dir + "topology/physical_package_id", info.package);
+      read_u32(dir + "topology/core_id", coreId);
+      info.core = cores({info.package, coreId});
+
+      /// the highest cache level shared by this cpu (L3 on most parts, L2 on some)
+      u32 bestLevel = 0, l3Leader = cpu;
+      for (u32 index = 0;; ++index) {
+        const auto cacheDir = dir + "cache/index" + std::to_string(index) + "/";
+        u32 level = 0;
+        if (!read_u32(cacheDir + "level", level)) break;
+        if (level < bestLevel || !read_line(cacheDir + "shared_cpu_list", line)) continue;
+        auto shared = parse_cpu_list(line);
+        if (shared.empty()) continue;
+        bestLevel = level;
+        l3Leader = *std::min_element(shared.begin(), shared.end());
+      }
+      if (bestLevel == 0) l3Leader = (u32)-1;  // unknown, one domain per package
+      info.l3Domain = l3s({info.package, l3Leader});
+      ret.cpus.push_back(info);
+    }
+    if (ret.cpus.empty()) return flat(ManagedThread::hardware_concurrency());
+
+    /// numa nodes
+    const std::string nodeRoot = "/sys/devices/system/node/";
+    if (read_line(nodeRoot + "online", line)) {
+      DenseIds<u32> nodes;
+      for (auto node : parse_cpu_list(line)) {
+        std::string cpuList;
+        if (!read_line(nodeRoot + "node" + std::to_string(node) + "/cpulist", cpuList)) continue;
+        for (auto cpu : parse_cpu_list(cpuList))
+          for (auto &info : ret.cpus)
+            if (info.cpu == cpu) info.numaNode = nodes(node);
+      }
+    }
+    ret.finalize_();
+    return ret;
+#else
+    return flat(ManagedThread::hardware_concurrency());
+#endif
+  }
+
+  void CpuTopology::finalize_() {
+    std::sort(cpus.begin(), cpus.end(),
+              [](const CpuInfo &a, const CpuInfo &b) { return a.cpu < b.cpu; });
+    /// smt rank follows the os index within each core
+    std::map<u32, u32> coreThreads;
+    u32 maxPackage = 0, maxNode = 0, maxL3 = 0, maxCore = 0;
+    for (auto &info : cpus) {
+      info.smtIndex = coreThreads[info.core]++;
+      maxPackage = std::max(maxPackage, info.package);
+      maxNode = std::max(maxNode, info.numaNode);
+      maxL3 = std::max(maxL3, info.l3Domain);
+      maxCore = std::max(maxCore, info.core);
+    }
+    _numCores = cpus.empty() ? 0 : maxCore + 1;
+    _numPackages = cpus.empty() ? 0 : maxPackage + 1;
+    _numNumaNodes = cpus.empty() ? 0 : maxNode + 1;
+    _numL3Domains = cpus.empty() ? 0 : maxL3 + 1;
+  }
+
+  const CpuInfo *CpuTopology::find(u32 cpu) const noexcept {
+    auto it = std::lower_bound(cpus.begin(), cpus.end(), cpu,
+                               [](const CpuInfo &info, u32 c) { return info.cpu < c; });
+    return it != cpus.end() && it->cpu == cpu ? &(*it) : nullptr;
+  }
+
+  std::vector<u32> CpuTopology::placement(cpu_affinity_e policy, u32 numThreads,
+                                          i32 numaNode) const {
+    std::vector<u32> ret;
+    if (policy == affinity_none || numThreads == 0) return ret;
+    std::vector<CpuInfo> candidates;
+    for (const auto &info : cpus)
+      if (numaNode < 0 || info.numaNode == (u32)numaNode) candidates.push_back(info);
+    if (candidates.empty()) return ret;
+
+    if (policy == affinity_compact) {
+      std::sort(candidates.begin(), candidates.end(), [](const CpuInfo &a, const CpuInfo &b) {
+        return std::tie(a.numaNode, a.package, a.l3Domain, a.core, a.smtIndex)
+               < std::tie(b.numaNode, b.package, b.l3Domain, b.core, b.smtIndex);
+      });
+    } else {
+      /// per L3 domain, physical cores before SMT siblings, then interleave the domains
+      std::sort(candidates.begin(), candidates.end(), [](const CpuInfo &a, const CpuInfo &b) {
+        return std::tie(a.smtIndex, a.core) < std::tie(b.smtIndex, b.core);
+      });
+      std::map<u32, std::vector<CpuInfo>> domains;
+      for (const auto &info : candidates) domains[info.l3Domain].push_back(info);
+      candidates.clear();
+      for (size_t k = 0;; ++k) {
+        bool any = false;
+        for (auto &[domain, members] : domains)
+          if (k < members.size()) {
+            candidates.push_back(members[k]);
+            any = true;
+          }
+        if (!any) break;
+      }
+    }
+    ret.resize(numThreads);
+    for (u32 i = 0; i != numThreads; ++i) ret[i] = candidates[i % candidates.size()].cpu;
+    return ret;
+  }
+
+}  // namespace zs
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+
+#include "zensim/Platform.hpp"
+#include "zensim/TypeAlias.hpp"
+
+namespace zs {
+
+  /// @brief worker placement onto logical cpus
+  /// @note compact: consecutive workers share cores and L3 domains (fills SMT siblings first)
+  /// @note scatter: consecutive workers are spread round-robin over L3 domains, physical cores
+  /// first and SMT siblings last
+  enum cpu_affinity_e : u8 { affinity_none = 0, affinity_compact, affinity_scatter };
+
+  /// @brief a logical cpu usable by this process
+  struct CpuInfo {
+    u32 cpu{0};        ///< os index
+    u32 core{0};       ///< dense physical core index
+    u32 package{0};    ///< socket
+    u32 numaNode{0};
+    u32 l3Domain{0};   ///< dense index of the L3 cache shared by this cpu
+    u32 smtIndex{0};   ///< rank among the hardware threads of its core
+  };
+
+  /// @brief hwloc-free cpu topology
+  /// @note discovered from /sys/devices/system/{cpu,node} on linux and restricted to the cpus in
+  /// the affinity mask of the process, other platforms (or unreadable sysfs) get a flat topology
+  /// where every cpu is a core of a single package/numa node/L3 domain
+  struct ZPC_CORE_API CpuTopology {
+    /// @brief discovered once upon the first call
+    static const CpuTopology &instance();
+    static CpuTopology discover();
+    static CpuTopology flat(u32 numCpus);
+
+    u32 numCpus() const noexcept { return (u32)cpus.size(); }
+    u32 numCores() const noexcept { return _numCores; }
+    u32 numPackages() const noexcept { return _numPackages; }
+    u32 numNumaNodes() const noexcept { return _numNumaNodes; }
+    u32 numL3Domains() const noexcept { return _numL3Domains; }
+
+    /// @brief the entry of the given os cpu index, nullptr if not usable
+    const CpuInfo *find(u32 cpu) const noexcept;
+
+    /// @brief os cpu indices for 'numThreads' workers (wrapping around when oversubscribed)
+    /// @param numaNode restricts the placement to a single numa node (per-node pools), -1 for all
+    /// @return empty for affinity_none or when the numa node has no usable cpu
+    std::vector<u32> placement(cpu_affinity_e policy, u32 numThreads, i32 numaNode = -1) const;
+
+    std::vector<CpuInfo> cpus{};  ///< sorted by os index
+
+  private:
+    void finalize_();
+
+    u32 _numCores{0}, _numPackages{0}, _numNumaNodes{0}, _numL3Domains{0};
+  };
+
+}  // namespace zs
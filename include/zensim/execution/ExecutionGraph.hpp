@@ -50,6 +50,7 @@
 #include "zensim/ZpcFunction.hpp"
 #include "zensim/execution/AsyncRuntime.hpp"
 #include "zensim/execution/ConcurrencyPrimitive.hpp"
+#include "zensim/profile/KernelProfiler.hpp"
 #include "zensim/types/ImplPattern.hpp"
 
 namespace zs {
@@ -316,6 +317,10 @@ namespace zs {
     /// If not explicitly set (userProvided == false), the compiler
     /// auto-deduces from declared resource accesses at compile() time.
     PassCostHint costHint{};
+
+    /// Profiling site interned by ExecutionGraph::compile() (while the
+    /// profiler is enabled), so that executing the pass needs no lookup.
+    mutable u32 _profileSite{KernelProfiler::invalid_site};
   };
 
   // ═══════════════════════════════════════════════════════════════════════
@@ -509,6 +514,12 @@ namespace zs {
       const size_t N = _passes.size();
       if (N == 0) return result;
 
+      // ── 0. Intern the profiling sites (off the execution path) ──────
+      if (KernelProfiler::instance().enabled())
+        for (const auto &pass : _passes)
+          if (pass._profileSite == KernelProfiler::invalid_site)
+            pass._profileSite = internProfileSite(pass);
+
       // ── 1. Build adjacency from resource hazard analysis ──────────
       //
       // For each resource, walk the passes in declaration order and
@@ -849,11 +860,27 @@ namespace zs {
       AsyncExecutionContext ctx{};
       for (u32 passIdx : compiled.sortedPassIndices) {
         const auto &pass = _passes[passIdx];
+        ProfileScope profileScope{profileSite(pass)};
         if (pass.callback) pass.callback(ctx);
       }
     }
 
+    /// Profiling site of a pass (labelled after the pass), or
+    /// KernelProfiler::invalid_site when profiling is disabled.
+    /// @note the site is normally interned by compile(); passes compiled
+    /// before the profiler was enabled fall back to interning here.
+    static u32 profileSite(const PassNode &pass) {
+      if (!KernelProfiler::instance().enabled()) return KernelProfiler::invalid_site;
+      if (pass._profileSite != KernelProfiler::invalid_site) return pass._profileSite;
+      return internProfileSite(pass);
+    }
+
   private:
+    static u32 internProfileSite(const PassNode &pass) {
+      return KernelProfiler::instance().intern(
+          pass.label.size() ? pass.label.asChars() : "unnamed pass", "ExecutionGraph");
+    }
+
     struct ResourceEntry {
       ResourceHandle handle{};
       ResourceDescriptor desc{};
@@ -939,7 +966,10 @@ namespace zs {
           // Execute the pass.
           AsyncExecutionContext ctx{};
           const auto &pass = graph.pass(passIdx);
-          if (pass.callback) pass.callback(ctx);
+          {
+            ProfileScope profileScope{ExecutionGraph::profileSite(pass)};
+            if (pass.callback) pass.callback(ctx);
+          }
 
           // Decrement successors.
           for (u32 s : (*succs)[passIdx]) {
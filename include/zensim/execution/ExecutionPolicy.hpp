@@ -9,6 +9,7 @@
 #include "zensim/container/Vector.hpp"
 #include "zensim/memory/MemoryResource.h"
 #include "zensim/profile/CppTimers.hpp"
+#include "zensim/profile/KernelProfiler.hpp"
 #include "zensim/resource/Resource.h"
 #include "zensim/types/Iterator.h"
 #include "zensim/types/Polymorphism.h"
@@ -147,7 +148,7 @@ namespace zs {
           [](auto t) -> decltype((void)std::begin(declval<typename decltype(t)::type>())) {});
       constexpr auto hasEnd = is_valid(
           [](auto t) -> decltype((void)std::end(declval<typename decltype(t)::type>())) {});
-      CppTimer timer;
+      KernelTimer timer;
       if (shouldProfile()) timer.tick();
       if constexpr (!hasBegin(wrapt<Range>{}) || !hasEnd(wrapt<Range>{})) {
         /// for iterator-like range (e.g. openvdb)
@@ -173,12 +174,7 @@ namespace zs {
             static_assert(always_false<F>, "unable to handle this callable and the range.");
         }
       }
-      if (shouldProfile()) {
-        std::ostringstream oss;
-        oss << "[Seq Exec | File " << loc.file_name() << ", Ln " << loc.line() << ", Col "
-            << loc.column() << "]";
-        timer.tock(oss.str());
-      }
+      if (shouldProfile()) timer.tock(loc, "Seq Exec");
     }
     template <typename Range, typename ParamTuple, typename F,
               enable_if_t<is_tuple_v<remove_cvref_t<ParamTuple>>> = 0>
@@ -188,7 +184,7 @@ namespace zs {
           [](auto t) -> decltype((void)std::begin(declval<typename decltype(t)::type>())) {});
       constexpr auto hasEnd = is_valid(
           [](auto t) -> decltype((void)std::end(declval<typename decltype(t)::type>())) {});
-      CppTimer timer;
+      KernelTimer timer;
       if (shouldProfile()) timer.tick();
       if constexpr (!hasBegin(wrapt<Range>{}) || !hasEnd(wrapt<Range>{})) {
         /// for iterator-like range (e.g. openvdb)
@@ -215,12 +211,7 @@ namespace zs {
             static_assert(always_false<F>, "unable to handle this callable and the range.");
         }
       }
-      if (shouldProfile()) {
-        std::ostringstream oss;
-        oss << "[Seq Exec | File " << loc.file_name() << ", Ln " << loc.line() << ", Col "
-            << loc.column() << "]";
-        timer.tock(oss.str());
-      }
+      if (shouldProfile()) timer.tock(loc, "Seq Exec");
     }
 
     template <zs::size_t I, size_t... Is, typename... Iters, typename... Policies,
@@ -326,7 +317,7 @@ namespace zs {
       using KeyT = typename std::iterator_traits<KeyIterT>::value_type;
       using ValueT = typename std::iterator_traits<ValueIterT>::value_type;
 
-      CppTimer timer;
+      KernelTimer timer;
       if (shouldProfile()) timer.tick();
 
       auto allocator = get_temporary_memory_source(*this);
@@ -440,12 +431,7 @@ namespace zs {
         }
       }
 
-      if (shouldProfile()) {
-        std::ostringstream oss;
-        oss << "[Seq merge_sort_pair | File " << loc.file_name() << ", Ln " << loc.line()
-            << ", Col " << loc.column() << "]";
-        timer.tock(oss.str());
-      }
+      if (shouldProfile()) timer.tock(loc, "Seq merge_sort_pair");
     }
     template <typename KeyIter, typename ValueIter,
               typename CompareOpT
@@ -9,6 +9,8 @@
 #  include <unistd.h>
 #endif
 
+#include "CpuTopology.hpp"
+
 namespace zs {
 
 #if defined(ZS_PLATFORM_WINDOWS)
@@ -48,6 +50,65 @@ namespace zs {
 #endif
   }
 
+  namespace {
+#if defined(ZS_PLATFORM_WINDOWS)
+    bool set_thread_affinity(HANDLE handle, i32 cpu) noexcept {
+      DWORD_PTR mask = 0;
+      if (cpu < 0) {
+        DWORD_PTR systemMask = 0;
+        if (!GetProcessAffinityMask(GetCurrentProcess(), &mask, &systemMask)) return false;
+      } else if (cpu < (i32)(sizeof(DWORD_PTR) * 8))
+        mask = (DWORD_PTR)1 << cpu;
+      else
+        return false;
+      return SetThreadAffinityMask(handle, mask) != 0;
+    }
+#elif defined(__linux__)
+    bool set_thread_affinity(pthread_t handle, i32 cpu) noexcept {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      if (cpu < 0) {
+        for (const auto &info : CpuTopology::instance().cpus) CPU_SET(info.cpu, &set);
+      } else if (cpu < CPU_SETSIZE)
+        CPU_SET(cpu, &set);
+      else
+        return false;
+      return pthread_setaffinity_np(handle, sizeof(set), &set) == 0;
+    }
+#else
+    /// no thread affinity api (e.g. macos only offers affinity tags as hints)
+    bool set_thread_affinity(pthread_t, i32 cpu) noexcept { return cpu < 0; }
+#endif
+  }  // namespace
+
+  bool ManagedThread::pin_current(i32 cpu) noexcept {
+#if defined(ZS_PLATFORM_WINDOWS)
+    return set_thread_affinity(GetCurrentThread(), cpu);
+#else
+    return set_thread_affinity(pthread_self(), cpu);
+#endif
+  }
+
+  i32 ManagedThread::current_cpu() noexcept {
+#if defined(ZS_PLATFORM_WINDOWS)
+    return static_cast<i32>(GetCurrentProcessorNumber());
+#elif defined(__linux__)
+    return static_cast<i32>(sched_getcpu());
+#else
+    return -1;
+#endif
+  }
+
+  bool ManagedThread::set_affinity(i32 cpu) noexcept {
+    _cpu.store(cpu);
+    if (!joinable()) return true;
+#if defined(ZS_PLATFORM_WINDOWS)
+    return set_thread_affinity(reinterpret_cast<HANDLE>(_handle), cpu);
+#else
+    return set_thread_affinity(*reinterpret_cast<pthread_t *>(_handle), cpu);
+#endif
+  }
+
   bool ManagedThread::start(entry_fn entry, SmallString label) {
     if (joinable() || !entry) return false;
     _entry = zs::move(entry);
@@ -122,6 +183,7 @@ namespace zs {
 
   void ManagedThread::thread_entry_(ManagedThread *self) noexcept {
     if (!self) return;
+    if (const auto cpu = self->_cpu.load(); cpu >= 0) pin_current(cpu);
     run_entry(*self);
   }
 
@@ -32,8 +32,15 @@ namespace zs {
     u64 id() const noexcept { return _id; }
     SmallString label() const noexcept { return _label; }
     void *native_handle() const noexcept { return _handle; }
+    /// @brief pins the thread onto a logical cpu (os index), -1 lifts the restriction
+    /// @note may be issued before 'start', the thread then pins itself upon entry
+    bool set_affinity(i32 cpu) noexcept;
+    i32 affinity() const noexcept { return _cpu.load(); }
     static void yield_current() noexcept;
     static u32 hardware_concurrency() noexcept;
+    static bool pin_current(i32 cpu) noexcept;
+    /// @brief the logical cpu the calling thread currently runs on, -1 if unknown
+    static i32 current_cpu() noexcept;
     static void thread_entry_(ManagedThread *self) noexcept;
 
   private:
@@ -48,6 +55,7 @@ namespace zs {
     AsyncStopSource _stop{};
     Atomic<u32> _joinable{0};
     Atomic<u32> _running{0};
+    Atomic<i32> _cpu{-1};
   };
 
 }  // namespace zs
\ No newline at end of file
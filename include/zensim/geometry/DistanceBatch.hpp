@@ -0,0 +1,547 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "zensim/container/Vector.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/geometry/Distance.hpp"
+#include "zensim/math/FloatLanes.hpp"
+
+namespace zs {
+
+  /// @brief lane-batched point-triangle / edge-edge distances and additive ccd for contact pairs
+  /// @note candidate pairs are SoA id arrays, e.g. the (_primIds, _nodeIds) of a BvttFront or the
+  /// pairs gathered from lbvh queries. types follow pt_distance_type / ee_distance_type. gradients
+  /// and hessians are those of the squared distance of the classified sub-primitive (as in
+  /// dist_grad_pe, dist_hess_pt, ...), scattered into the 4-vertex stencil (p, t0, t1, t2) or
+  /// (ea0, ea1, eb0, eb1), with zeros for the vertices the type does not involve.
+  /// @note host (sequential/openmp) policies only, each task evaluates one batch of
+  /// math::detail::native_float_lanes pairs.
+
+  namespace detail {
+    /// @brief float lanes closed under the arithmetic of the generated distance derivatives
+    /// @note allows instantiating g_PT, H_EE, ... for a whole batch at once
+    template <int W> struct distance_lanes {
+      using lanes_type = math::detail::float_lanes<W>;
+      lanes_type v;
+
+      distance_lanes() noexcept : v{lanes_type::broadcast(0.f)} {}
+      distance_lanes(double s) noexcept : v{lanes_type::broadcast((float)s)} {}
+      distance_lanes(const lanes_type &l) noexcept : v{l} {}
+
+      friend distance_lanes operator+(const distance_lanes &a, const distance_lanes &b) noexcept {
+        return {a.v + b.v};
+      }
+      friend distance_lanes operator-(const distance_lanes &a, const distance_lanes &b) noexcept {
+        return {a.v - b.v};
+      }
+      friend distance_lanes operator*(const distance_lanes &a, const distance_lanes &b) noexcept {
+        return {a.v * b.v};
+      }
+      friend distance_lanes operator/(const distance_lanes &a, const distance_lanes &b) noexcept {
+        return {a.v / b.v};
+      }
+      friend distance_lanes operator-(const distance_lanes &a) noexcept { return {-a.v}; }
+      distance_lanes &operator+=(const distance_lanes &o) noexcept { return *this = *this + o; }
+      distance_lanes &operator-=(const distance_lanes &o) noexcept { return *this = *this - o; }
+      distance_lanes &operator*=(const distance_lanes &o) noexcept { return *this = *this * o; }
+      distance_lanes &operator/=(const distance_lanes &o) noexcept { return *this = *this / o; }
+    };
+
+    /// @brief 3d vector of lanes
+    template <typename P> struct lanes_vec3_ {
+      P v[3];
+
+      friend lanes_vec3_ operator+(const lanes_vec3_ &a, const lanes_vec3_ &b) noexcept {
+        return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2]}};
+      }
+      friend lanes_vec3_ operator-(const lanes_vec3_ &a, const lanes_vec3_ &b) noexcept {
+        return {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2]}};
+      }
+      friend lanes_vec3_ operator*(const P &s, const lanes_vec3_ &a) noexcept {
+        return {{s * a.v[0], s * a.v[1], s * a.v[2]}};
+      }
+      P dot(const lanes_vec3_ &o) const noexcept {
+        return v[0] * o.v[0] + v[1] * o.v[1] + v[2] * o.v[2];
+      }
+      P l2NormSqr() const noexcept { return dot(*this); }
+      lanes_vec3_ cross(const lanes_vec3_ &o) const noexcept {
+        return {{v[1] * o.v[2] - v[2] * o.v[1], v[2] * o.v[0] - v[0] * o.v[2],
+                 v[0] * o.v[1] - v[1] * o.v[0]}};
+      }
+    };
+
+    template <typename P> typename P::mask_type lanes_equal_(const P &a, float b) noexcept {
+      const P s = P::broadcast(b);
+      return P::mask_and(a >= s, a <= s);
+    }
+
+    /// @brief squared distance and pt_distance_type of P::width point-triangle pairs
+    /// @note all seven candidates are evaluated, the classification (same tests as
+    /// pt_distance_type) picks one per lane
+    template <typename P>
+    void pt_dist2_lanes_(const lanes_vec3_<P> &p, const lanes_vec3_<P> &t0,
+                         const lanes_vec3_<P> &t1, const lanes_vec3_<P> &t2, P &dist2,
+                         P &type) noexcept {
+      using V = lanes_vec3_<P>;
+      const P zero = P::broadcast(0.f), one = P::broadcast(1.f);
+      const V ts[3] = {t0, t1, t2};
+      const V n = (t1 - t0).cross(t2 - t0);
+      /// s: projection parameter onto edge k (t_k t_k+1), h: side of edge k within the plane
+      P s[3], h[3], pp[3], pe[3];
+      for (int k = 0; k != 3; ++k) {
+        const V e = ts[(k + 1) % 3] - ts[k];
+        const V r = p - ts[k];
+        const P ee = e.l2NormSqr();
+        s[k] = r.dot(e) / ee;
+        h[k] = r.dot(e.cross(n));
+        pp[k] = r.l2NormSqr();
+        pe[k] = r.cross(p - ts[(k + 1) % 3]).l2NormSqr() / ee;
+      }
+      const P aTb = (p - t0).dot(n);
+      dist2 = aTb * aTb / n.l2NormSqr();
+      type = P::broadcast(6.f);
+      /// lowest priority first
+      const auto assign = [&](const typename P::mask_type &m, const P &d, float t) {
+        dist2 = P::select(m, d, dist2);
+        type = P::select(m, P::broadcast(t), type);
+      };
+      assign(P::mask_and(s[2] <= zero, s[1] >= one), pp[2], 2.f);
+      assign(P::mask_and(s[1] <= zero, s[0] >= one), pp[1], 1.f);
+      assign(P::mask_and(s[0] <= zero, s[2] >= one), pp[0], 0.f);
+      for (int k = 2; k >= 0; --k)
+        assign(P::mask_and(P::mask_and(s[k] > zero, s[k] < one), h[k] >= zero), pe[k],
+               3.f + k);
+    }
+
+    /// @brief squared distance and ee_distance_type of P::width edge-edge pairs
+    template <typename P>
+    void ee_dist2_lanes_(const lanes_vec3_<P> &ea0, const lanes_vec3_<P> &ea1,
+                         const lanes_vec3_<P> &eb0, const lanes_vec3_<P> &eb1, P &dist2,
+                         P &type) noexcept {
+      using V = lanes_vec3_<P>;
+      const P zero = P::broadcast(0.f);
+      const V u = ea1 - ea0, v = eb1 - eb0, w = ea0 - eb0;
+      const P a = u.l2NormSqr(), b = u.dot(v), c = v.l2NormSqr(), d = u.dot(w), e = v.dot(w);
+      const P D = a * c - b * b;
+      const P sN = b * e - c * d;
+      const P halfD = D * P::broadcast(0.5f);
+      const V uxv = u.cross(v);
+      P tN = a * e - b * d, tD = D;
+      type = P::broadcast(8.f);
+      {
+        /// nearly parallel interior solutions fall back to the s = 0 or s = 1 edge
+        const P uxvw = uxv.dot(w);
+        const auto parallel = P::mask_and(
+            P::mask_and(P::mask_and(tN > zero, tN < D), P::mask_and(sN > zero, sN < D)),
+            P::mask_or(P::mask_and(uxvw <= zero, uxvw >= zero),
+                       uxv.l2NormSqr() < P::broadcast(1.0e-20f) * a * c));
+        const auto s0 = P::mask_or(sN <= zero, P::mask_and(parallel, sN < halfD));
+        const auto s1 = P::mask_or(P::mask_and(sN > zero, sN >= D),
+                                   P::mask_and(parallel, sN >= halfD));
+        tN = P::select(s0, e, P::select(s1, e + b, tN));
+        tD = P::select(P::mask_or(s0, s1), c, tD);
+        type = P::select(s0, P::broadcast(2.f), P::select(s1, P::broadcast(5.f), type));
+      }
+      {
+        const P nd = -d, ndb = b - d;
+        const P onT1 = P::select(ndb <= zero, P::broadcast(1.f),
+                                 P::select(ndb >= a, P::broadcast(4.f), P::broadcast(7.f)));
+        const P onT0 = P::select(nd <= zero, P::broadcast(0.f),
+                                 P::select(nd >= a, P::broadcast(3.f), P::broadcast(6.f)));
+        type = P::select(tN >= tD, onT1, type);
+        type = P::select(tN <= zero, onT0, type);
+      }
+
+      const auto pe = [](const V &p, const V &e0, const V &e1) {
+        return (e0 - p).cross(e1 - p).l2NormSqr() / (e1 - e0).l2NormSqr();
+      };
+      const P aTb = (eb0 - ea0).dot(uxv);
+      dist2 = aTb * aTb / uxv.l2NormSqr();
+      const P candidates[8] = {(ea0 - eb0).l2NormSqr(), (ea0 - eb1).l2NormSqr(),
+                               pe(ea0, eb0, eb1),       (ea1 - eb0).l2NormSqr(),
+                               (ea1 - eb1).l2NormSqr(), pe(ea1, eb0, eb1),
+                               pe(eb0, ea0, ea1),       pe(eb1, ea0, ea1)};
+      for (int k = 0; k != 8; ++k)
+        dist2 = P::select(lanes_equal_(type, (float)k), candidates[k], dist2);
+    }
+
+    /// @brief sub-primitive evaluated for a distance type
+    /// @note kind 0: point-point, 1: point-edge, 2: point-triangle, 3: edge-edge. slots are the
+    /// stencil vertices of the sub-primitive, in the argument order of the scalar functions
+    struct distance_stencil_ {
+      int kind;
+      int slots[4];
+    };
+    constexpr distance_stencil_ pt_distance_stencils_[7]
+        = {{0, {0, 1}},    {0, {0, 2}},    {0, {0, 3}},      {1, {0, 1, 2}},
+           {1, {0, 2, 3}}, {1, {0, 3, 1}}, {2, {0, 1, 2, 3}}};
+    constexpr distance_stencil_ ee_distance_stencils_[9]
+        = {{0, {0, 2}},    {0, {0, 3}},    {1, {0, 2, 3}}, {0, {1, 2}},      {0, {1, 3}},
+           {1, {1, 2, 3}}, {1, {2, 0, 1}}, {1, {3, 0, 1}}, {3, {0, 1, 2, 3}}};
+    constexpr int distance_kind_vertices_(int kind) noexcept {
+      return kind == 0 ? 2 : (kind == 1 ? 3 : 4);
+    }
+
+    /// @brief gradient (and hessian) of the squared distance of a sub-primitive, per lane
+    template <int Kind, int W, int N = distance_kind_vertices_(Kind)>
+    void dist2_derivatives_lanes_(const distance_lanes<W> (&x)[4][3],
+                                  vec<distance_lanes<W>, N * 3> &g,
+                                  vec<distance_lanes<W>, N * 3, N * 3> *h) noexcept {
+      if constexpr (Kind == 0) {
+        for (int d = 0; d != 3; ++d) {
+          g.val(d) = (x[0][d] - x[1][d]) * 2.0;
+          g.val(3 + d) = -g.val(d);
+        }
+        if (h)
+          for (int d = 0; d != 3; ++d) {
+            (*h)(d, d) = (*h)(3 + d, 3 + d) = 2.0;
+            (*h)(d, 3 + d) = (*h)(3 + d, d) = -2.0;
+          }
+      } else if constexpr (Kind == 1) {
+        g_PE3D(x[0][0], x[0][1], x[0][2], x[1][0], x[1][1], x[1][2], x[2][0], x[2][1], x[2][2],
+               g);
+        if (h)
+          H_PE3D(x[0][0], x[0][1], x[0][2], x[1][0], x[1][1], x[1][2], x[2][0], x[2][1],
+                 x[2][2], *h);
+      } else if constexpr (Kind == 2) {
+        g_PT(x[0][0], x[0][1], x[0][2], x[1][0], x[1][1], x[1][2], x[2][0], x[2][1], x[2][2],
+             x[3][0], x[3][1], x[3][2], g);
+        if (h)
+          H_PT(x[0][0], x[0][1], x[0][2], x[1][0], x[1][1], x[1][2], x[2][0], x[2][1], x[2][2],
+               x[3][0], x[3][1], x[3][2], *h);
+      } else {
+        g_EE(x[0][0], x[0][1], x[0][2], x[1][0], x[1][1], x[1][2], x[2][0], x[2][1], x[2][2],
+             x[3][0], x[3][1], x[3][2], g);
+        if (h)
+          H_EE(x[0][0], x[0][1], x[0][2], x[1][0], x[1][1], x[1][2], x[2][0], x[2][1], x[2][2],
+               x[3][0], x[3][1], x[3][2], *h);
+      }
+    }
+
+    /// @brief loads the 4-vertex stencils of [count] pairs into lanes, padding with the last one
+    template <typename P, typename StencilF, typename PairF>
+    void gather_stencil_lanes_(const vec<float, 3> *xs, const StencilF &stencilOf,
+                               const PairF &pairOf, size_t count,
+                               lanes_vec3_<P> (&x)[4]) noexcept {
+      constexpr int W = P::width;
+      float buf[4][3][W];
+      for (int l = 0; l != W; ++l) {
+        const auto vs = stencilOf(pairOf((size_t)l < count ? (size_t)l : count - 1));
+        for (int v = 0; v != 4; ++v) {
+          const auto &xv = xs[vs[v]];
+          for (int d = 0; d != 3; ++d) buf[v][d][l] = xv[d];
+        }
+      }
+      for (int v = 0; v != 4; ++v)
+        for (int d = 0; d != 3; ++d) x[v].v[d] = P::load(buf[v][d]);
+    }
+
+    template <typename Policy, typename... Ts>
+    void require_host_distance_batch_(Policy &&pol, const Ts &...vs) {
+      constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+      static_assert(space == execspace_e::host || space == execspace_e::openmp,
+                    "lane-batched distances are only available for host execution policies.");
+      if (!(valid_memspace_for_execution(pol, vs.get_allocator()) && ...))
+        throw std::runtime_error("current memory location not compatible with the execution policy");
+    }
+
+    /// @brief derivatives of the pairs sorted[first, last) sharing the distance type [stencil]
+    template <int Kind, typename Policy, typename StencilF>
+    void dist2_derivatives_batch_(Policy &&pol, const vec<float, 3> *xs, const StencilF &stencilOf,
+                                  const int *sorted, size_t first, size_t last,
+                                  const distance_stencil_ &stencil, vec<float, 12> *grads,
+                                  vec<float, 12, 12> *hessians) {
+      constexpr int W = math::detail::native_float_lanes;
+      constexpr int N = distance_kind_vertices_(Kind);
+      using P = math::detail::float_lanes<W>;
+      using L = distance_lanes<W>;
+      pol(range((last - first + W - 1) / W), [&](size_t b) {
+        const size_t st = first + b * W;
+        const size_t count = last - st < (size_t)W ? last - st : (size_t)W;
+        lanes_vec3_<P> x[4];
+        gather_stencil_lanes_(
+            xs, stencilOf, [&](size_t l) { return sorted[st + l]; }, count, x);
+        L sx[4][3];
+        for (int v = 0; v != N; ++v)
+          for (int d = 0; d != 3; ++d) sx[v][d] = L{x[stencil.slots[v]].v[d]};
+
+        vec<L, N * 3> g{};
+        vec<L, N * 3, N * 3> h{};
+        dist2_derivatives_lanes_<Kind>(sx, g, hessians ? &h : nullptr);
+
+        /// transposed into per-pair stencil blocks, so every output is written once
+        const auto dof = [&stencil](int i) { return stencil.slots[i / 3] * 3 + i % 3; };
+        if (grads) {
+          float buf[N * 3][W];
+          for (int i = 0; i != N * 3; ++i) g.val(i).v.store(buf[i]);
+          for (size_t l = 0; l != count; ++l) {
+            auto grad = vec<float, 12>::zeros();
+            for (int i = 0; i != N * 3; ++i) grad.val(dof(i)) = buf[i][l];
+            grads[sorted[st + l]] = grad;
+          }
+        }
+        if (hessians) {
+          float buf[N * 3][N * 3][W];
+          for (int i = 0; i != N * 3; ++i)
+            for (int j = 0; j != N * 3; ++j) h(i, j).v.store(buf[i][j]);
+          for (size_t l = 0; l != count; ++l) {
+            auto hess = vec<float, 12, 12>::zeros();
+            for (int i = 0; i != N * 3; ++i)
+              for (int j = 0; j != N * 3; ++j) hess(dof(i), dof(j)) = buf[i][j][l];
+            hessians[sorted[st + l]] = hess;
+          }
+        }
+      });
+    }
+
+    template <bool IsEE, typename Policy, typename StencilF>
+    void primitive_distance_batch_(Policy &&pol, const Vector<vec<float, 3>> &xs,
+                                   const StencilF &stencilOf, size_t numPairs, Vector<int> &types,
+                                   Vector<float> &dist2s, Vector<vec<float, 12>> *grads,
+                                   Vector<vec<float, 12, 12>> *hessians) {
+      constexpr int W = math::detail::native_float_lanes;
+      using P = math::detail::float_lanes<W>;
+      if (types.size() < numPairs) types.resize(numPairs);
+      if (dist2s.size() < numPairs) dist2s.resize(numPairs);
+      if (numPairs == 0) return;
+
+      const vec<float, 3> *xsPtr = xs.data();
+      int *typesPtr = types.data();
+      float *dist2sPtr = dist2s.data();
+      pol(range((numPairs + W - 1) / W), [&](size_t b) {
+        const size_t st = b * W;
+        const size_t count = numPairs - st < (size_t)W ? numPairs - st : (size_t)W;
+        lanes_vec3_<P> x[4];
+        gather_stencil_lanes_(
+            xsPtr, stencilOf, [st](size_t l) { return st + l; }, count, x);
+        P d2, t;
+        if constexpr (IsEE)
+          ee_dist2_lanes_(x[0], x[1], x[2], x[3], d2, t);
+        else
+          pt_dist2_lanes_(x[0], x[1], x[2], x[3], d2, t);
+        float dbuf[W], tbuf[W];
+        d2.store(dbuf);
+        t.store(tbuf);
+        for (size_t l = 0; l != count; ++l) {
+          dist2sPtr[st + l] = dbuf[l];
+          typesPtr[st + l] = (int)tbuf[l];
+        }
+      });
+      if (!grads && !hessians) return;
+
+      /// bucket the pairs by type, so that every batch runs a single derivative kernel
+      if (grads && grads->size() < numPairs) grads->resize(numPairs);
+      if (hessians && hessians->size() < numPairs) hessians->resize(numPairs);
+      auto allocator = get_temporary_memory_source(pol);
+      Vector<int> indices{allocator, numPairs}, sortedTypes{allocator, numPairs},
+          sorted{allocator, numPairs};
+      pol(enumerate(indices), [](int i, int &id) { id = i; });
+      radix_sort_pair(pol, std::begin(types), std::begin(indices), std::begin(sortedTypes),
+                      std::begin(sorted), numPairs, 0, 4);
+
+      constexpr int numTypes = IsEE ? 9 : 7;
+      const int *sortedTypesPtr = sortedTypes.data();
+      size_t offsets[numTypes + 1];
+      for (int t = 0; t <= numTypes; ++t)
+        offsets[t] = std::lower_bound(sortedTypesPtr, sortedTypesPtr + numPairs, t) - sortedTypesPtr;
+      vec<float, 12> *gradsPtr = grads ? grads->data() : nullptr;
+      vec<float, 12, 12> *hessiansPtr = hessians ? hessians->data() : nullptr;
+      for (int t = 0; t != numTypes; ++t) {
+        if (offsets[t] == offsets[t + 1]) continue;
+        const auto &stencil = IsEE ? ee_distance_stencils_[t] : pt_distance_stencils_[t];
+        const auto launch = [&](auto kind) {
+          dist2_derivatives_batch_<RM_CVREF_T(kind)::value>(pol, xsPtr, stencilOf, sorted.data(),
+                                                             offsets[t], offsets[t + 1], stencil,
+                                                             gradsPtr, hessiansPtr);
+        };
+        switch (stencil.kind) {
+          case 0:
+            launch(wrapv<0>{});
+            break;
+          case 1:
+            launch(wrapv<1>{});
+            break;
+          default:
+            if constexpr (IsEE)
+              launch(wrapv<3>{});
+            else
+              launch(wrapv<2>{});
+            break;
+        }
+      }
+    }
+
+    /// @brief lane-batched additive ccd (Li et al. 2021, codim-ipc), see pt_accd_batch
+    /// @note [numSrc] leading stencil vertices form one primitive, the rest the other
+    template <int NumSrc, typename P, typename Dist2F>
+    P accd_lanes_(lanes_vec3_<P> (&x)[4], lanes_vec3_<P> (&dx)[4], const Dist2F &dist2Of,
+                  float eta, float thickness, float tocUpperBound, int maxIters) noexcept {
+      const P zero = P::broadcast(0.f);
+      const P thick = P::broadcast(thickness), thick2 = P::broadcast(thickness * thickness);
+      {
+        const auto mov = P::broadcast(0.25f) * (dx[0] + dx[1] + dx[2] + dx[3]);
+        for (auto &v : dx) v = v - mov;
+      }
+      P maxDispMag2[2] = {zero, zero};
+      for (int v = 0; v != 4; ++v)
+        maxDispMag2[v < NumSrc ? 0 : 1] = P::max(maxDispMag2[v < NumSrc ? 0 : 1], dx[v].l2NormSqr());
+      const P maxDispMag = P::sqrt(maxDispMag2[0]) + P::sqrt(maxDispMag2[1]);
+      P dist2 = dist2Of(x), dist = P::sqrt(dist2);
+      const P gap = P::broadcast(eta) * (dist2 - thick2) / (dist + thick);
+      P toc = zero, ret = P::broadcast(tocUpperBound);
+      /// static pairs never collide, touching ones already did
+      ret = P::select(dist2 <= thick2, zero, ret);
+      auto active = P::mask_and(maxDispMag > zero, dist2 > thick2);
+      const P tocUpper = P::broadcast(tocUpperBound);
+      for (int iter = 0; iter != maxIters && P::any(active); ++iter) {
+        const P lb = P::select(active,
+                               P::broadcast(1.f - eta) * (dist2 - thick2)
+                                   / ((dist + thick) * maxDispMag),
+                               zero);
+        for (int v = 0; v != 4; ++v) x[v] = x[v] + lb * dx[v];
+        dist2 = dist2Of(x);
+        dist = P::sqrt(dist2);
+        const auto hit
+            = P::mask_and(P::mask_and(active, toc > zero), (dist2 - thick2) / (dist + thick) < gap);
+        ret = P::select(hit, toc, ret);
+        active = P::mask_and(active, P::mask_or(toc <= zero, (dist2 - thick2) / (dist + thick) >= gap));
+        toc = P::select(active, toc + lb, toc);
+        active = P::mask_and(active, toc <= tocUpper);
+      }
+      /// out of iterations, the accumulated lower bound is still a safe step
+      return P::select(active, toc, ret);
+    }
+
+    template <int NumSrc, typename Policy, typename StencilF, typename Dist2F>
+    void accd_batch_(Policy &&pol, const Vector<vec<float, 3>> &xs,
+                     const Vector<vec<float, 3>> &dxs, const StencilF &stencilOf, size_t numPairs,
+                     Vector<float> &tois, float eta, float thickness, float tocUpperBound,
+                     int maxIters, const Dist2F &dist2Of) {
+      constexpr int W = math::detail::native_float_lanes;
+      using P = math::detail::float_lanes<W>;
+      if (xs.size() != dxs.size())
+        throw std::runtime_error("positions and displacements differ in size");
+      if (tois.size() < numPairs) tois.resize(numPairs);
+      const vec<float, 3> *xsPtr = xs.data(), *dxsPtr = dxs.data();
+      float *toisPtr = tois.data();
+      pol(range((numPairs + W - 1) / W), [&](size_t b) {
+        const size_t st = b * W;
+        const size_t count = numPairs - st < (size_t)W ? numPairs - st : (size_t)W;
+        const auto pairOf = [st](size_t l) { return st + l; };
+        lanes_vec3_<P> x[4], dx[4];
+        gather_stencil_lanes_(xsPtr, stencilOf, pairOf, count, x);
+        gather_stencil_lanes_(dxsPtr, stencilOf, pairOf, count, dx);
+        float buf[W];
+        accd_lanes_<NumSrc>(x, dx, dist2Of, eta, thickness, tocUpperBound, maxIters).store(buf);
+        for (size_t l = 0; l != count; ++l) toisPtr[st + l] = buf[l];
+      });
+    }
+  }  // namespace detail
+
+  /// @brief squared distances (and types) of the point-triangle pairs (pointIds[i], triIds[i])
+  /// @note [grads], [hessians] (optional) receive the derivatives w.r.t. the stencil (p, t0, t1, t2)
+  template <typename Policy>
+  void pt_distance_batch(Policy &&pol, const Vector<vec<float, 3>> &xs,
+                         const Vector<vec<int, 3>> &tris, const Vector<int> &pointIds,
+                         const Vector<int> &triIds, size_t numPairs, Vector<int> &types,
+                         Vector<float> &dist2s, Vector<vec<float, 12>> *grads = nullptr,
+                         Vector<vec<float, 12, 12>> *hessians = nullptr) {
+    detail::require_host_distance_batch_(pol, xs, tris, pointIds, triIds, types, dist2s);
+    if (pointIds.size() < numPairs || triIds.size() < numPairs)
+      throw std::runtime_error("fewer candidate ids than pairs");
+    const int *ps = pointIds.data(), *ts = triIds.data();
+    const vec<int, 3> *tis = tris.data();
+    detail::primitive_distance_batch_<false>(
+        pol, xs,
+        [ps, ts, tis](size_t i) {
+          const auto &tri = tis[ts[i]];
+          return vec<int, 4>{ps[i], tri[0], tri[1], tri[2]};
+        },
+        numPairs, types, dist2s, grads, hessians);
+  }
+
+  /// @brief squared distances (and types) of the edge-edge pairs (eaIds[i], ebIds[i])
+  /// @note [grads], [hessians] (optional) receive the derivatives w.r.t. the stencil
+  /// (ea0, ea1, eb0, eb1)
+  template <typename Policy>
+  void ee_distance_batch(Policy &&pol, const Vector<vec<float, 3>> &xs,
+                         const Vector<vec<int, 2>> &edges, const Vector<int> &eaIds,
+                         const Vector<int> &ebIds, size_t numPairs, Vector<int> &types,
+                         Vector<float> &dist2s, Vector<vec<float, 12>> *grads = nullptr,
+                         Vector<vec<float, 12, 12>> *hessians = nullptr) {
+    detail::require_host_distance_batch_(pol, xs, edges, eaIds, ebIds, types, dist2s);
+    if (eaIds.size() < numPairs || ebIds.size() < numPairs)
+      throw std::runtime_error("fewer candidate ids than pairs");
+    const int *as = eaIds.data(), *bs = ebIds.data();
+    const vec<int, 2> *eis = edges.data();
+    detail::primitive_distance_batch_<true>(
+        pol, xs,
+        [as, bs, eis](size_t i) {
+          const auto &ea = eis[as[i]];
+          const auto &eb = eis[bs[i]];
+          return vec<int, 4>{ea[0], ea[1], eb[0], eb[1]};
+        },
+        numPairs, types, dist2s, grads, hessians);
+  }
+
+  /// @brief conservative time of impact of the point-triangle pairs moving along [dxs]
+  /// @note additive ccd: tois[i] is (1 - eta) of the way to the first contact at distance
+  /// [thickness], or [tocUpperBound] if none happens before
+  template <typename Policy>
+  void pt_accd_batch(Policy &&pol, const Vector<vec<float, 3>> &xs,
+                     const Vector<vec<float, 3>> &dxs, const Vector<vec<int, 3>> &tris,
+                     const Vector<int> &pointIds, const Vector<int> &triIds, size_t numPairs,
+                     Vector<float> &tois, float eta = 0.1f, float thickness = 0.f,
+                     float tocUpperBound = 1.f, int maxIters = 1000) {
+    using P = math::detail::float_lanes<math::detail::native_float_lanes>;
+    detail::require_host_distance_batch_(pol, xs, dxs, tris, pointIds, triIds, tois);
+    if (pointIds.size() < numPairs || triIds.size() < numPairs)
+      throw std::runtime_error("fewer candidate ids than pairs");
+    const int *ps = pointIds.data(), *ts = triIds.data();
+    const vec<int, 3> *tis = tris.data();
+    detail::accd_batch_<1>(
+        pol, xs, dxs,
+        [ps, ts, tis](size_t i) {
+          const auto &tri = tis[ts[i]];
+          return vec<int, 4>{ps[i], tri[0], tri[1], tri[2]};
+        },
+        numPairs, tois, eta, thickness, tocUpperBound, maxIters,
+        [](const detail::lanes_vec3_<P>(&x)[4]) {
+          P d2, t;
+          detail::pt_dist2_lanes_(x[0], x[1], x[2], x[3], d2, t);
+          return d2;
+        });
+  }
+
+  /// @brief conservative time of impact of the edge-edge pairs moving along [dxs]
+  /// @note see pt_accd_batch
+  template <typename Policy>
+  void ee_accd_batch(Policy &&pol, const Vector<vec<float, 3>> &xs,
+                     const Vector<vec<float, 3>> &dxs, const Vector<vec<int, 2>> &edges,
+                     const Vector<int> &eaIds, const Vector<int> &ebIds, size_t numPairs,
+                     Vector<float> &tois, float eta = 0.1f, float thickness = 0.f,
+                     float tocUpperBound = 1.f, int maxIters = 1000) {
+    using P = math::detail::float_lanes<math::detail::native_float_lanes>;
+    detail::require_host_distance_batch_(pol, xs, dxs, edges, eaIds, ebIds, tois);
+    if (eaIds.size() < numPairs || ebIds.size() < numPairs)
+      throw std::runtime_error("fewer candidate ids than pairs");
+    const int *as = eaIds.data(), *bs = ebIds.data();
+    const vec<int, 2> *eis = edges.data();
+    detail::accd_batch_<2>(
+        pol, xs, dxs,
+        [as, bs, eis](size_t i) {
+          const auto &ea = eis[as[i]];
+          const auto &eb = eis[bs[i]];
+          return vec<int, 4>{ea[0], ea[1], eb[0], eb[1]};
+        },
+        numPairs, tois, eta, thickness, tocUpperBound, maxIters,
+        [](const detail::lanes_vec3_<P>(&x)[4]) {
+          P d2, t;
+          detail::ee_dist2_lanes_(x[0], x[1], x[2], x[3], d2, t);
+          return d2;
+        });
+  }
+
+}  // namespace zs
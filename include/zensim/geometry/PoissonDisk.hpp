@@ -1,23 +1,392 @@
 #pragma once
-#if ZS_ENABLE_OPENMP
-#  include "zensim/omp/Omp.h"
-#endif
 #include <algorithm>
-#include <fstream>
-#include <iostream>
-#include <sstream>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
 
 #include "zensim/container/DenseGrid.hpp"
+#include "zensim/container/TileVector.hpp"
+#include "zensim/container/Vector.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/execution/Intrinsics.hpp"
 #include "zensim/math/RandomNumber.hpp"
 #include "zensim/math/Vec.h"
-// #include <taskflow/taskflow.hpp>
-#include "zensim/execution/Concurrency.h"
-#include "zensim/execution/ManagedThread.hpp"
+#include "zensim/math/probability/Random.hpp"
 #include "zensim/geometry/LevelSetInterface.h"
-#include "zensim/io/Filesystem.hpp"
+#if ZS_ENABLE_OPENMP
+#  include "zensim/omp/execution/ExecutionPolicy.hpp"
+#endif
 
 namespace zs {
 
+  /// @brief minimum sample distance yielding [ppc] particles per cell of side [dx] when sampled
+  /// (near) maximally
+  template <int dim, typename T> T poisson_disk_distance_by_ppc(T dx, T ppc) noexcept {
+    double v = std::pow((double)dx, dim) / ppc;
+    if constexpr (dim == 2)
+      return (T)std::sqrt(v * ((double)2 / 3));
+    else if constexpr (dim == 3)
+      return (T)std::pow(v * ((double)13 / 18), (double)1 / 3);
+    else
+      return (T)v;
+  }
+
+  namespace detail {
+    /// uniform variate in [0, 1) from a counter-based pcg state
+    template <typename T> constexpr T poisson_disk_variate(u64 &state) noexcept {
+      return (T)(PCG::pcg32_random_r(state) >> 8) * ((T)1 / (T)16777216);
+    }
+
+    /// @brief phase-group parallel dart throwing upon a block-sparse background grid
+    /// @note background cells of side r/sqrt(dim) hold at most one sample, and two conflicting
+    /// samples are at most two cells apart. Cells congruent modulo 3 along every axis (one of the
+    /// 3^dim phase groups) thus throw darts concurrently without any synchronization. Each pass
+    /// visits the phase groups in a random order and throws one dart per empty cell.
+    /// @note each dart lands in a random live sub-cell (4^dim per cell). A rejected dart drops
+    /// the sub-cells found covered by the neighboring disks (or lying outside [mayIntersect]),
+    /// cells without live sub-cells retire. Most of the void thus retires within a few passes,
+    /// and the remaining darts rarely hit covered space.
+    /// @note only background blocks (and cells) accepted by [mayIntersect] (min/max corners) are
+    /// allocated (and visited), [feasible] then decides upon each dart.
+    /// @return samples, ordered block by block
+    template <typename Policy, typename T, int dim, typename Feasible, typename BlockFilter>
+    Vector<vec<T, dim>> poisson_disk_sample_cells(Policy &&pol, const vec<T, dim> &minCorner,
+                                                  const vec<T, dim> &maxCorner, T minDistance,
+                                                  Feasible feasible, BlockFilter mayIntersect,
+                                                  u64 seed, int maxPasses) {
+      static_assert(dim >= 1 && dim <= 3, "poisson disk sampling supports up to 3 dimensions");
+      using TV = vec<T, dim>;
+      using IV = vec<int, dim>;
+      constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+      /// a multiple of the phase period, so that every block holds (side / 3)^dim cells of each
+      /// phase group
+      constexpr int block_side = 6;
+      constexpr int block_size = math::pow_integral(block_side, dim);
+      constexpr int phase_cells = 1 << dim;
+      constexpr int num_phases = math::pow_integral(3, dim);
+      constexpr int sub_side = 4;
+      constexpr int num_subcells = math::pow_integral(sub_side, dim);
+      constexpr int lattice_points = math::pow_integral(sub_side + 1, dim);
+      constexpr int max_neighbors = math::pow_integral(5, dim);
+      constexpr T empty_cell = detail::deduce_numeric_max<T>();
+      constexpr T retired_cell = -detail::deduce_numeric_max<T>();
+      if (!(minDistance > 0))
+        throw std::runtime_error("poisson disk sampling requires a positive minimum distance");
+      auto allocator = get_temporary_memory_source(pol);
+      const T h = minDistance / zs::sqrt((T)dim);
+      IV cellExts{}, blockExts{};
+      size_t numBlocks = 1;
+      for (int d = 0; d != dim; ++d) {
+        const double cells = std::ceil(((double)maxCorner[d] - (double)minCorner[d]) / h);
+        if (!(cells < (double)(1 << 30)))
+          throw std::runtime_error("poisson disk sampling domain is excessive for its distance");
+        cellExts[d] = cells < 1 ? 1 : (int)cells;
+        blockExts[d] = (cellExts[d] + block_side - 1) / block_side;
+        numBlocks *= blockExts[d];
+      }
+      if (numBlocks >= (size_t)detail::deduce_numeric_max<int>())
+        throw std::runtime_error("poisson disk sampling domain is excessive for its distance");
+
+      /// activate background blocks
+      Vector<int> blockIds{allocator, numBlocks + 1}, blockOffsets{allocator, numBlocks + 1};
+      pol(range(numBlocks + 1),
+          [blockIds = proxy<space>(blockIds), blockExts, minCorner, h, numBlocks,
+           mayIntersect] ZS_LAMBDA(size_t b) mutable {
+            if (b == numBlocks) {
+              blockIds[b] = 0;
+              return;
+            }
+            TV lo{}, hi{};
+            IV bc{};
+            for (int d = dim - 1, rem = (int)b; d >= 0; --d) {
+              bc[d] = rem % blockExts[d];
+              rem /= blockExts[d];
+            }
+            for (int d = 0; d != dim; ++d) {
+              lo[d] = minCorner[d] + bc[d] * block_side * h;
+              hi[d] = lo[d] + block_side * h;
+            }
+            blockIds[b] = mayIntersect(lo, hi) ? 1 : 0;
+          });
+      exclusive_scan(pol, std::begin(blockIds), std::end(blockIds), std::begin(blockOffsets));
+      const int numActive = blockOffsets.getVal(numBlocks);
+      Vector<int> activeBlocks{allocator, (size_t)numActive};
+      pol(range(numBlocks), [blockIds = proxy<space>(blockIds),
+                             blockOffsets = proxy<space>(blockOffsets),
+                             activeBlocks = proxy<space>(activeBlocks)] ZS_LAMBDA(size_t b) mutable {
+        if (blockIds[b]) {
+          blockIds[b] = blockOffsets[b];
+          activeBlocks[blockOffsets[b]] = (int)b;
+        } else
+          blockIds[b] = -1;
+      });
+
+      Vector<TV> cells{allocator, (size_t)numActive * block_size};
+      pol(range(cells.size()),
+          [cells = proxy<space>(cells), activeBlocks = proxy<space>(activeBlocks), blockExts,
+           minCorner, h, mayIntersect, empty = empty_cell,
+           retired = retired_cell] ZS_LAMBDA(size_t i) mutable {
+            TV lo{}, hi{};
+            for (int d = dim - 1, rem = activeBlocks[i / block_size], local = i % block_size;
+                 d >= 0; --d) {
+              lo[d] = minCorner[d]
+                      + (rem % blockExts[d] * block_side + local % block_side) * h;
+              hi[d] = lo[d] + h;
+              rem /= blockExts[d];
+              local /= block_side;
+            }
+            cells[i] = TV::constant(mayIntersect(lo, hi) ? empty : retired);
+          });
+
+      /// sub-cells of each cell not yet covered by a single disk, they only ever shrink
+      Vector<u64> uncoveredMasks{allocator, cells.size()};
+      pol(range(cells.size()), [uncoveredMasks = proxy<space>(uncoveredMasks)] ZS_LAMBDA(
+                                   size_t i) mutable {
+        uncoveredMasks[i] = num_subcells == 64 ? ~(u64)0 : ((u64)1 << num_subcells) - 1;
+      });
+
+      Vector<int> numAccepted{allocator, 1};
+      u64 phaseState = seed ^ 0x5851f42d4c957f2dull;
+      int phases[num_phases];
+      for (int p = 0; p != num_phases; ++p) phases[p] = p;
+      for (int pass = 0; pass != maxPasses; ++pass) {
+        for (int p = num_phases - 1; p > 0; --p)
+          std::swap(phases[p], phases[PCG::pcg32_random_r(phaseState) % (u32)(p + 1)]);
+        numAccepted.setVal(0);
+        for (int p = 0; p != num_phases; ++p) {
+          IV phase{};
+          for (int d = dim - 1, rem = phases[p]; d >= 0; --d, rem /= 3) phase[d] = rem % 3;
+          pol(range((size_t)numActive * phase_cells),
+              [cells = proxy<space>(cells), uncoveredMasks = proxy<space>(uncoveredMasks),
+               blockIds = proxy<space>(blockIds),
+               activeBlocks = proxy<space>(activeBlocks), numAccepted = proxy<space>(numAccepted),
+               blockExts, cellExts, phase, minCorner, maxCorner, h, r2 = minDistance * minDistance,
+               seed, pass, feasible, mayIntersect, tag = wrapv<space>{}] ZS_LAMBDA(size_t t) mutable {
+                const int slot = (int)(t >> dim);
+                IV c{};
+                for (int d = dim - 1, rem = activeBlocks[slot]; d >= 0; --d) {
+                  c[d] = rem % blockExts[d] * block_side + phase[d] + 3 * ((int)(t >> d) & 1);
+                  rem /= blockExts[d];
+                }
+                int local = 0;
+                u64 cellNo = 0;
+                for (int d = 0; d != dim; ++d) {
+                  if (c[d] >= cellExts[d]) return;
+                  local = local * block_side + c[d] % block_side;
+                  cellNo = cellNo * (u64)cellExts[d] + (u64)c[d];
+                }
+                const size_t cellId = (size_t)slot * block_size + local;
+                auto &cell = cells[cellId];
+                if (cell[0] != empty_cell) return;
+
+                /// samples within reach, the 5^dim neighborhood spans at most two blocks along
+                /// each axis
+                IV baseBlock{};
+                int axisLocal[dim][5], axisBlock[dim][5];
+                for (int d = 0; d != dim; ++d) {
+                  baseBlock[d] = c[d] < 2 ? 0 : (c[d] - 2) / block_side;
+                  for (int o = 0; o != 5; ++o) {
+                    const int nc = c[d] + o - 2;
+                    const bool valid = nc >= 0 && nc < cellExts[d];
+                    axisLocal[d][o] = valid ? nc % block_side : -1;
+                    axisBlock[d][o] = valid ? nc / block_side - baseBlock[d] : 0;
+                  }
+                }
+                int slots[phase_cells];
+                for (int k = 0; k != phase_cells; ++k) {
+                  int nblock = 0;
+                  for (int d = 0; d != dim; ++d) {
+                    const int bc = baseBlock[d] + ((k >> (dim - 1 - d)) & 1);
+                    if (bc >= blockExts[d]) {
+                      nblock = -1;
+                      break;
+                    }
+                    nblock = nblock * blockExts[d] + bc;
+                  }
+                  slots[k] = nblock < 0 ? -1 : blockIds[nblock];
+                }
+                TV neighbors[max_neighbors];
+                int numNeighbors = 0;
+                IV loc{};
+                for (int n = 0; n != max_neighbors; ++n) {
+                  int corner = 0, nlocal = 0, gap = 0;
+                  bool inside = true;
+                  for (int d = 0; d != dim; ++d) {
+                    inside = inside && axisLocal[d][loc[d]] >= 0;
+                    corner = corner * 2 + axisBlock[d][loc[d]];
+                    nlocal = nlocal * block_side + axisLocal[d][loc[d]];
+                    if (loc[d] == 0 || loc[d] == 4) ++gap;
+                  }
+                  for (int d = dim - 1; d >= 0 && ++loc[d] == 5; --d) loc[d] = 0;
+                  /// cells apart by two along every axis are out of reach
+                  if (!inside || gap == dim || slots[corner] < 0) continue;
+                  const TV s = cells[(size_t)slots[corner] * block_size + nlocal];
+                  if (s[0] == empty_cell || s[0] == retired_cell) continue;
+                  T near2 = 0;
+                  for (int d = 0; d != dim; ++d) {
+                    const T lo = minCorner[d] + c[d] * h;
+                    const T e = s[d] < lo ? lo - s[d] : (s[d] > lo + h ? s[d] - lo - h : 0);
+                    near2 += e * e;
+                  }
+                  if (near2 < r2) neighbors[numNeighbors++] = s;
+                }
+
+                const T sh = h / sub_side;
+                u64 uncovered = uncoveredMasks[cellId];
+                u64 state = (cellNo + 1) * 0x9e3779b97f4a7c15ull
+                            ^ (seed + (u64)pass * 0xbf58476d1ce4e5b9ull);
+                PCG::pcg32_random_r(state);
+                int sc = 0;
+                for (int pick = PCG::pcg32_random_r(state) % (u32)count_ones(uncovered, tag);;
+                     ++sc)
+                  if (((uncovered >> sc) & 1) && pick-- == 0) break;
+                TV x{}, subLo{};
+                bool outside = false;
+                for (int d = dim - 1, rem = sc; d >= 0; --d, rem /= sub_side) {
+                  subLo[d] = minCorner[d] + c[d] * h + (rem % sub_side) * sh;
+                  x[d] = subLo[d] + poisson_disk_variate<T>(state) * sh;
+                  outside = outside || x[d] > maxCorner[d];
+                }
+                if (outside || !feasible(x)) {
+                  /// only sub-cells straddling the boundary remain
+                  for (int sc = 0; sc != num_subcells; ++sc) {
+                    if (!((uncovered >> sc) & 1)) continue;
+                    for (int d = dim - 1, rem = sc; d >= 0; --d, rem /= sub_side)
+                      subLo[d] = minCorner[d] + c[d] * h + (rem % sub_side) * sh;
+                    if (!mayIntersect(subLo, subLo + sh)) uncovered ^= (u64)1 << sc;
+                  }
+                  uncoveredMasks[cellId] = uncovered;
+                  if (uncovered == 0) cell[0] = retired_cell;
+                  return;
+                }
+
+                bool conflict = false;
+                for (int k = 0; k != numNeighbors && !conflict; ++k)
+                  conflict = (x - neighbors[k]).l2NormSqr() < r2;
+                if (conflict) {
+                  signed char latticeCovered[lattice_points];
+                  /// drop sub-cells entirely within a single disk, i.e. whose farthest corner
+                  /// lies within it
+                  for (int k = 0; k != numNeighbors && uncovered; ++k) {
+                    T far2[dim][sub_side], least = 0;
+                    for (int d = 0; d != dim; ++d) {
+                      T m = detail::deduce_numeric_max<T>();
+                      for (int i = 0; i != sub_side; ++i) {
+                        const T lo = minCorner[d] + c[d] * h + i * sh;
+                        const T a = neighbors[k][d] - lo, b = lo + sh - neighbors[k][d];
+                        far2[d][i] = a > b ? a * a : b * b;
+                        if (far2[d][i] < m) m = far2[d][i];
+                      }
+                      least += m;
+                    }
+                    if (least > r2) continue;
+                    for (int sc = 0; sc != num_subcells; ++sc) {
+                      if (!((uncovered >> sc) & 1)) continue;
+                      T sum = 0;
+                      for (int d = dim - 1, rem = sc; d >= 0; --d, rem /= sub_side)
+                        sum += far2[d][rem % sub_side];
+                      if (sum <= r2) uncovered ^= (u64)1 << sc;
+                    }
+                  }
+                  /// also drop sub-cells whose center and corners all lie within the union of
+                  /// the disks, the slivers possibly left uncovered are negligible
+                  auto covered = [&](const TV &p) {
+                    for (int k = 0; k != numNeighbors; ++k)
+                      if ((p - neighbors[k]).l2NormSqr() < r2) return true;
+                    return false;
+                  };
+                  for (auto &v : latticeCovered) v = -1;
+                  for (int sc = 0; sc != num_subcells && uncovered; ++sc) {
+                    if (!((uncovered >> sc) & 1)) continue;
+                    IV sub{};
+                    TV center{};
+                    for (int d = dim - 1, rem = sc; d >= 0; --d, rem /= sub_side) {
+                      sub[d] = rem % sub_side;
+                      center[d] = minCorner[d] + c[d] * h + (sub[d] + (T)0.5) * sh;
+                    }
+                    if (!covered(center)) continue;
+                    bool all = true;
+                    for (int corner = 0; corner != (1 << dim) && all; ++corner) {
+                      int lp = 0;
+                      TV p{};
+                      for (int d = 0; d != dim; ++d) {
+                        const int i = sub[d] + ((corner >> d) & 1);
+                        lp = lp * (sub_side + 1) + i;
+                        p[d] = minCorner[d] + c[d] * h + i * sh;
+                      }
+                      if (latticeCovered[lp] < 0) latticeCovered[lp] = covered(p) ? 1 : 0;
+                      all = latticeCovered[lp] == 1;
+                    }
+                    if (all) uncovered ^= (u64)1 << sc;
+                  }
+                  uncoveredMasks[cellId] = uncovered;
+                  if (uncovered == 0) cell[0] = retired_cell;
+                  return;
+                }
+                cell = x;
+                atomic_add(tag, &numAccepted[0], 1);
+              });
+        }
+        if (numAccepted.getVal() == 0) break;
+      }
+
+      /// compaction
+      const size_t numCells = cells.size();
+      Vector<int> marks{allocator, numCells + 1}, offsets{allocator, numCells + 1};
+      pol(range(numCells + 1), [cells = proxy<space>(cells), marks = proxy<space>(marks),
+                                numCells] ZS_LAMBDA(size_t i) mutable {
+        marks[i] = i != numCells && cells[i][0] != empty_cell && cells[i][0] != retired_cell;
+      });
+      exclusive_scan(pol, std::begin(marks), std::end(marks), std::begin(offsets));
+      Vector<TV> samples{allocator, (size_t)offsets.getVal(numCells)};
+      pol(range(numCells), [cells = proxy<space>(cells), marks = proxy<space>(marks),
+                            offsets = proxy<space>(offsets),
+                            samples = proxy<space>(samples)] ZS_LAMBDA(size_t i) mutable {
+        if (marks[i]) samples[offsets[i]] = cells[i];
+      });
+      return samples;
+    }
+  }  // namespace detail
+
+  /// @brief poisson-disk samples the interior (negative signed distance) of a level set (view),
+  /// e.g. an analytic level set or a SparseLevelSetView, into the [xTag] property of [tv]
+  /// @note [tv] is resized to the number of samples, other properties are left uninitialized.
+  /// Results only depend on [seed], not on the execution policy.
+  /// @return number of samples
+  template <typename Policy, typename LsT, typename T, size_t Length, typename Allocator>
+  size_t poisson_disk_sample(Policy &&pol, const LevelSetInterface<LsT> &ls, T minDistance,
+                             TileVector<T, Length, Allocator> &tv, const SmallString &xTag = "x",
+                             u64 seed = 0, int maxPasses = 30) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    constexpr int dim = LsT::dim;
+    using TV = vec<T, dim>;
+    static_assert(is_same_v<typename LsT::value_type, T>,
+                  "level set and tilevector should share the value type");
+    if (tv.getPropertySize(xTag) != dim)
+      throw std::runtime_error("poisson disk sampling requires a position property of extent dim");
+    if (!valid_memspace_for_execution(pol, tv.get_allocator()))
+      throw std::runtime_error("current memory location not compatible with the execution policy");
+
+    const auto &lsv = static_cast<const LsT &>(ls);
+    auto [lo, hi] = ls.getBoundingBox();
+    auto samples = detail::poisson_disk_sample_cells(
+        pol, lo, hi, minDistance,
+        [lsv] ZS_LAMBDA(const TV &x) { return lsv.getSignedDistance(x) < 0; },
+        [lsv] ZS_LAMBDA(const TV &blo, const TV &bhi) {
+          return lsv.getSignedDistance((blo + bhi) / 2) < (bhi - blo).length() / 2;
+        },
+        seed, maxPasses);
+
+    const size_t n = samples.size();
+    tv.resize(n);
+    pol(range(n), [tvv = view<space>({}, tv), samples = proxy<space>(samples),
+                   offset = tv.getPropertyOffset(xTag)] ZS_LAMBDA(size_t i) mutable {
+      tvv.tuple(dim_c<dim>, offset, i) = samples[i];
+    });
+    return n;
+  }
+
   template <typename T, int dim> struct PoissonDisk {
     using TV = vec<T, dim>;
     using IV = vec<int, dim>;
@@ -29,11 +398,7 @@ namespace zs {
     bool periodic{false};
 
     void setDistanceByPpc(T dx, T ppc) noexcept {
-      T v = std::pow((double)dx, dim) / ppc;
-      if constexpr (dim == 2)
-        minDistance = std::sqrt(v * ((double)2 / 3));
-      else if constexpr (dim == 3)
-        minDistance = std::pow(v * ((double)13 / 18), (double)1 / 3);
+      minDistance = poisson_disk_distance_by_ppc<dim>(dx, ppc);
     }
 
     TV generateRandomPointAroundAnnulus(const TV &center) noexcept {
@@ -120,117 +485,25 @@ namespace zs {
         return true;
     }
     /**
-      Faster sampling based on particles-1000k.dat file. The function assumes that
-      this file is saved in Data/MpmParticles/particles-1000k.dat. _minDistance =
-      mimimum distance between particles. A few information about
-      particles-1000k.dat:
-        - Samples count: 1001436
-        - _minDistance = 1	_h=0.57735
-        - min_point =      -60 -59.9999 -59.9998
-        - max_point = 59.9999      60 59.9999
-      The file is generated by Projects/pdsampler/pdsampler.cpp.
+      Samples [minCorner, maxCorner] where [feasible] holds, using the phase-group parallel dart
+      throwing of poisson_disk_sample (maxAttempts passes). The periodic 2d case keeps the serial
+      Bridson sampler.
        */
     template <typename Predicate> decltype(auto) sample(Predicate &&feasible) {
       std::vector<std::array<T, dim>> samples{};
-      if constexpr (dim == 3) {
-        // Figure out the number of offsets
-        TV scaled_ref_box_length{120.0, 120.0, 120.0};
-        scaled_ref_box_length = scaled_ref_box_length * minDistance;
-        TV sideLength = maxCorner - minCorner;
-        IV offset_number;
-        for (int d = 0; d < dim; ++d)
-          offset_number[d] = std::ceil(sideLength[d] / scaled_ref_box_length[d]) + 1;
-
-#if RESOURCE_AT_RELATIVE_PATH
-        auto loc = abs_exe_directory() + "/resource/particles-1000k.dat";
-#else
-        auto loc = std::string{AssetDirPath} + "/resource/particles-1000k.dat";
-#endif
-        // Read std vector
-        std::ifstream is(loc, std::ios::in | std::ios::binary);
-        if (!is) {
-          std::ostringstream oss;
-          oss << "particle-1000k.dat file not found at [" << loc << "]!";
-          throw std::runtime_error(oss.str());
-        }
-        std::size_t cnt, tmp;
-        is.read((char *)&cnt, sizeof(std::size_t));
-        auto estimate = cnt * (sideLength.prod() / scaled_ref_box_length.prod());
-        std::cout << "try reserving " << estimate << " entries, cnt " << cnt
-                  << ", minDistance: " << minDistance << ", box: [" << minCorner[0] << ", "
-                  << minCorner[1] << ", " << minCorner[2] << " ~ " << maxCorner[0] << ", "
-                  << maxCorner[1] << ", " << maxCorner[2] << "], sidelen: " << sideLength[0] << ", "
-                  << sideLength[1] << ", " << sideLength[2]
-                  << ", scaledlen: " << scaled_ref_box_length[0] << ", "
-                  << scaled_ref_box_length[1] << ", " << scaled_ref_box_length[2] << "\n";
-        if (estimate < 100000) samples.reserve((i64)estimate);
-
-        is.read((char *)&tmp, sizeof(size_t));  ///< neglect this
-        // Read from file as float
-        std::vector<vec<float, dim>> data(cnt);
-        is.read((char *)data.data(), cnt * sizeof(vec<float, dim>));
-
-#if 1
-        puts("begin parallel sampling!");
-        const auto nworkers = ManagedThread::hardware_concurrency();
-        std::vector<std::vector<std::array<T, dim>>> localSamples(nworkers);
-#  if ZS_ENABLE_OPENMP
-        omp_set_num_threads(nworkers);
-#    pragma omp parallel for
-#  endif
-        for (int id = 0; id < nworkers; id++) {
-          if (estimate < 100000) localSamples[id].reserve(estimate / nworkers);
-          for (int i = id; i < cnt; i += nworkers) {
-            const auto &new_point_read = data[i];
-            TV new_point, offset_center, offset_new_point;
-            for (int d = 0; d < dim; ++d)
-              new_point[d] = (minDistance * new_point_read[d]) + minCorner[d];
-            IV index{};
-            for (index[0] = 0; index[0] < offset_number[0]; ++index[0])
-              for (index[1] = 0; index[1] < offset_number[1]; ++index[1])
-                for (index[2] = 0; index[2] < offset_number[2]; ++index[2]) {
-                  for (int d = 0; d < dim; ++d)
-                    offset_center[d] = (index[d] /*+ (T).5*/) * scaled_ref_box_length[d];
-                  offset_new_point = new_point + offset_center;
-                  bool inside = true;
-                  for (int d = 0; d < dim; ++d)
-                    if (offset_new_point[d] < minCorner[d] || offset_new_point[d] > maxCorner[d])
-                      inside = false;
-                  if (feasible(offset_new_point) && inside)
-                    localSamples[id].emplace_back(std::array<T, 3>{
-                        offset_new_point[0], offset_new_point[1], offset_new_point[2]});
-                }
-          }
-        }
-        for (int id = 0; id < nworkers; id++)
-          samples.insert(samples.end(), localSamples[id].begin(), localSamples[id].end());
-        puts("done parallel sampling!");
+      if (dim != 2 || !periodic) {
+#if ZS_ENABLE_OPENMP
+        auto pol = omp_exec();
 #else
-        for (size_t i = 0; i < cnt; ++i) {
-          const auto &new_point_read = data[i];
-          TV new_point, offset_center, offset_new_point;
-          for (int d = 0; d < dim; ++d)
-            new_point[d] = (minDistance * new_point_read[d]) + minCorner[d];
-          IV index{};
-          for (index[0] = 0; index[0] < offset_number[0]; ++index[0])
-            for (index[1] = 0; index[1] < offset_number[1]; ++index[1])
-              for (index[2] = 0; index[2] < offset_number[2]; ++index[2]) {
-                for (int d = 0; d < dim; ++d)
-                  offset_center[d] = (index[d] /*+ (T).5*/) * scaled_ref_box_length[d];
-                offset_new_point = new_point + offset_center;
-                bool inside = true;
-                for (int d = 0; d < dim; ++d)
-                  if (offset_new_point[d] < minCorner[d] || offset_new_point[d] > maxCorner[d])
-                    inside = false;
-                if (feasible(offset_new_point) && inside)
-                  samples.emplace_back(std::array<T, 3>{offset_new_point[0], offset_new_point[1],
-                                                        offset_new_point[2]});
-              }
-        }
+        auto pol = seq_exec();
 #endif
-        std::cout << "[PoissonDiskSampling]\tcnt: " << samples.size() << "\n";
-
-      } else if (dim == 2) {
+        auto pts = detail::poisson_disk_sample_cells(
+            pol, minCorner, maxCorner, minDistance,
+            [&feasible](const TV &x) -> bool { return feasible(x); },
+            [](const TV &, const TV &) { return true; }, (u64)rnd.generator(), maxAttempts);
+        samples.resize(pts.size());
+        for (size_t i = 0; i != pts.size(); ++i) samples[i] = pts[i].to_array();
+      } else if constexpr (dim == 2) {
         const T h = minDistance / std::sqrt((T)dim);
         /**
           Set up background grid
@@ -244,8 +517,6 @@ namespace zs {
         for (int d = 0; d < dim; ++d) cell_numbers[d] = std::ceil(cell_numbers_candidate[d] / h);
 
         DenseGrid<int, int, dim> grid{cell_numbers, -1};
-        printf("len(%d, %d) coord(%d, %d) index(%d) val(%d)\n", cell_numbers[0], cell_numbers[1], 2,
-               3, grid.offset(vec<int, dim>{2, 3}), grid(vec<int, dim>{2, 3}));
         // Set up active list
         std::vector<int> active_list{};
         {
@@ -4,6 +4,19 @@
 
 namespace zs {
 
+  namespace detail {
+    /// @brief bijective u32 mixing of a vertex id, yields distinct weights for the
+    /// independent set selections below
+    constexpr u32 coloring_vertex_weight(u32 v) noexcept {
+      v ^= v >> 16;
+      v *= 0x7feb352du;
+      v ^= v >> 15;
+      v *= 0x846ca68bu;
+      v ^= v >> 16;
+      return v;
+    }
+  }  // namespace detail
+
   /// @note assume the graph is undirected
   template <typename Policy, typename T, bool RowMajor, typename Ti, typename Tn,
             typename AllocatorT, typename WeightRangeT, typename ColorRangeT>
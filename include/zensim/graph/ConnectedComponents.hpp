@@ -1,11 +1,17 @@
 #pragma once
+#include <algorithm>
+#include <stdexcept>
+
+#include "zensim/container/Vector.hpp"
 #include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/math/Hash.hpp"
 
 namespace zs {
 
   /// @note ref: https://userweb.cs.txstate.edu/~burtscher/research/ECL-CC/
+  /// @note every edge is hooked in a single pass, see union_find for the sampling variant
   template <typename Policy, typename SpMatT, typename FaRange>
-  void union_find(Policy&& pol, const SpMatT& spm, FaRange&& faRange) {
+  void union_find_ecl(Policy&& pol, const SpMatT& spm, FaRange&& faRange) {
     using SpmvT = RM_CVREF_T(spm);
     using Ti = typename SpmvT::index_type;
 
@@ -62,7 +68,7 @@ namespace zs {
   }
 
   template <typename Policy, typename SpMatT, typename FaRange, typename Predicate>
-  void union_find(Policy&& pol, const SpMatT& spm, FaRange&& faRange, Predicate&& skipPred) {
+  void union_find_ecl(Policy&& pol, const SpMatT& spm, FaRange&& faRange, Predicate&& skipPred) {
     using SpmvT = RM_CVREF_T(spm);
     using Ti = typename SpmvT::index_type;
 
@@ -122,4 +128,144 @@ namespace zs {
     });
   }
 
-}  // namespace zs
\ No newline at end of file
+  namespace detail {
+    struct afforest_keep_edges {
+      template <typename SpmvT, typename Tn>
+      constexpr bool operator()(const SpmvT&, Tn) const noexcept {
+        return false;
+      }
+    };
+    template <typename Predicate> struct afforest_skip_edges {
+      template <typename SpmvT, typename Tn>
+      constexpr bool operator()(const SpmvT& spmv, Tn i) const {
+        return skipPred(spmv._vals[i]);
+      }
+      Predicate skipPred;
+    };
+
+    /// @brief hooks the higher of the two roots under the lower one
+    template <typename ExecTag, typename FaIter, typename Ti>
+    constexpr void afforest_link(ExecTag execTag, FaIter& fas, Ti u, Ti v) {
+      Ti p1 = fas[u], p2 = fas[v];
+      while (p1 != p2) {
+        const Ti high = p1 > p2 ? p1 : p2;
+        const Ti low = p1 + p2 - high;
+        const Ti pHigh = fas[high];
+        /// already linked by another thread
+        if (pHigh == low) break;
+        if (pHigh == high && atomic_cas(execTag, &fas[high], high, low) == high) break;
+        p1 = fas[fas[high]];
+        p2 = fas[low];
+      }
+    }
+
+    template <typename Policy, typename FaIter, typename Ti>
+    void afforest_compress(Policy&& pol, FaIter fas, Ti n) {
+      pol(range(n), [fas] ZS_LAMBDA(Ti v) mutable {
+        while (fas[v] != fas[fas[v]]) fas[v] = fas[fas[v]];
+      });
+    }
+
+    /// @note ref: Sutton et al. 2018, Optimizing Parallel Graph Connectivity Computation via
+    /// Subgraph Sampling
+    template <typename Policy, typename SpMatT, typename FaIter, typename SkipF>
+    void afforest(Policy&& pol, const SpMatT& spm, FaIter fas, SkipF skip, int numRounds) {
+      using SpmvT = RM_CVREF_T(spm);
+      using Ti = typename SpmvT::index_type;
+
+      constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+      const Ti n = spm.outerSize();
+      if (n == 0) return;
+      pol(range(n), [fas] ZS_LAMBDA(Ti v) mutable { fas[v] = v; });
+
+      /// @note link the first few neighbors of every vertex, most vertices end up in the
+      /// component that will be the largest
+      for (int r = 0; r < numRounds; ++r) {
+        pol(range(n), [spmv = view<space>(spm), fas, skip, r,
+                       execTag = wrapv<space>{}] ZS_LAMBDA(Ti v) mutable {
+          const auto i = spmv._ptrs[v] + r;
+          if (i < spmv._ptrs[v + 1] && !skip(spmv, i))
+            afforest_link(execTag, fas, v, (Ti)spmv._inds[i]);
+        });
+        afforest_compress(pol, fas, n);
+      }
+
+      /// @note most frequent root among a fixed set of sampled vertices
+      constexpr Ti numSamples = 1024;
+      auto allocator = get_temporary_memory_source(pol);
+      Vector<Ti> samples{allocator, (size_t)numSamples};
+      pol(range(numSamples), [samples = view<space>(samples), fas, n] ZS_LAMBDA(Ti i) mutable {
+        samples[i] = fas[(Ti)(zs::hash((u32)i) % (u32)n)];
+      });
+      auto hostSamples = samples.clone({memsrc_e::host, -1});
+      std::sort(std::begin(hostSamples), std::end(hostSamples));
+      Ti giant = hostSamples[0];
+      for (Ti i = 0, cnt = 0, best = 0; i != numSamples; ++i) {
+        cnt = (i != 0 && hostSamples[i] == hostSamples[i - 1]) ? cnt + 1 : 1;
+        if (cnt > best) {
+          best = cnt;
+          giant = hostSamples[i];
+        }
+      }
+
+      /// @note the remaining edges, skipping vertices of the giant component. its edges to other
+      /// components are still linked from the other side (the adjacency is symmetric).
+      pol(range(n), [spmv = view<space>(spm), fas, skip, giant, numRounds,
+                     execTag = wrapv<space>{}] ZS_LAMBDA(Ti v) mutable {
+        if (fas[v] == giant) return;
+        for (auto i = spmv._ptrs[v] + numRounds; i < spmv._ptrs[v + 1]; ++i)
+          if (!skip(spmv, i)) afforest_link(execTag, fas, v, (Ti)spmv._inds[i]);
+      });
+      afforest_compress(pol, fas, n);
+    }
+  }  // namespace detail
+
+  /// @brief connected components of the (structurally symmetric) spmat graph
+  /// @note afforest: a few sampled neighbors per vertex are linked first, then the edges of the
+  /// largest intermediate component are skipped, avoiding the contention on its root
+  /// @note on return fas[v] is the smallest vertex index of v's component (fully compressed)
+  template <typename Policy, typename SpMatT, typename FaRange>
+  void union_find(Policy&& pol, const SpMatT& spm, FaRange&& faRange, int numRounds = 2) {
+    detail::afforest(pol, spm, std::begin(faRange), detail::afforest_keep_edges{}, numRounds);
+  }
+
+  /// @brief connected components ignoring the entries whose values satisfy [skipPred]
+  template <typename Policy, typename SpMatT, typename FaRange, typename Predicate,
+            enable_if_t<is_invocable_v<Predicate&, const typename SpMatT::value_type&>> = 0>
+  void union_find(Policy&& pol, const SpMatT& spm, FaRange&& faRange, Predicate&& skipPred,
+                  int numRounds = 2) {
+    detail::afforest(pol, spm, std::begin(faRange),
+                     detail::afforest_skip_edges<RM_CVREF_T(skipPred)>{skipPred}, numRounds);
+  }
+
+  /// @brief maps the union_find forest [faRange] to contiguous component ids
+  /// @note components are numbered by their smallest vertex index. returns the number of
+  /// components
+  template <typename Policy, typename FaRange, typename LabelRange>
+  auto relabel_components(Policy&& pol, FaRange&& faRange, LabelRange&& labelRange) {
+    using Ti = RM_CVREF_T(*std::begin(faRange));
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    const Ti n = range_size(faRange);
+    if (range_size(labelRange) != n)
+      throw std::runtime_error("forest and label ranges differ in size");
+    if (n == 0) return (Ti)0;
+
+    auto allocator = get_temporary_memory_source(pol);
+    Vector<Ti> isRoot{allocator, (size_t)n + 1}, compIds{allocator, (size_t)n + 1};
+    pol(range(n), [fas = std::begin(faRange), labels = std::begin(labelRange),
+                   isRoot = view<space>(isRoot)] ZS_LAMBDA(Ti v) mutable {
+      Ti r = fas[v];
+      while (fas[r] != r) r = fas[r];
+      labels[v] = r;
+      isRoot[v] = r == v ? 1 : 0;
+    });
+    isRoot.setVal(0, n);
+    exclusive_scan(pol, std::begin(isRoot), std::end(isRoot), std::begin(compIds));
+    pol(range(n), [labels = std::begin(labelRange),
+                   compIds = view<space>(compIds)] ZS_LAMBDA(Ti v) mutable {
+      labels[v] = compIds[labels[v]];
+    });
+    return compIds.getVal(n);
+  }
+
+}  // namespace zs
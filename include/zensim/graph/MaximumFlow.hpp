@@ -1,222 +1,229 @@
 #pragma once
-/// @credits Lu Shuliang
+#include <stdexcept>
+
 #include "zensim/container/Bht.hpp"
 #include "zensim/container/Vector.hpp"
 #include "zensim/execution/ExecutionPolicy.hpp"
 #include "zensim/math/matrix/SparseMatrix.hpp"
 
-// #include <queue>
-// #include <vector>
-
 namespace zs {
 
-  struct kernel_check_empty_frontier {
-    template <typename ParamsT>
-    constexpr void operator()(const int &isFrontier, ParamsT &params) noexcept {
-      auto &[isFrontierEmpty] = params;
-      if (isFrontier) isFrontierEmpty[0] = 0;
-    }
-  };
-
-  struct kernel_bfs_augmented_path {
-    template <typename ParamsT> constexpr void operator()(int vi, ParamsT &params) noexcept {
-      auto &[visited, potentialFlows, sink, parents, frontier, isSinkFound, capacity, exec_tag]
-          = params;
-      if (!frontier[vi]) return;
-      frontier[vi] = 0;
-      for (int i = capacity._ptrs[vi]; i < capacity._ptrs[vi + 1]; ++i) {
-        int nvi = capacity._inds[i];
-        if (capacity._vals[i] <= 0) continue;
-        if (atomic_cas(exec_tag, &visited[nvi], 0, 1) == 1) continue;
-
-        frontier[nvi] = 1;
-        parents[nvi] = vi;
-        potentialFlows[nvi]
-            = capacity._vals[i] < potentialFlows[vi] ? capacity._vals[i] : potentialFlows[vi];
-        if (nvi == sink) isSinkFound[0] = 1;
-      }
+  namespace detail {
+
+    /// @brief rev[j] is the entry of (w, v) for the entry j of (v, w)
+    /// @note returns false if some reverse entry is missing from the sparsity pattern
+    template <typename Policy, typename SpMat, typename RevVector>
+    bool max_flow_reverse_entries(Policy &&pol, const SpMat &capacity, RevVector &rev) {
+      using Ti = typename SpMat::index_type;
+      using Tn = RM_CVREF_T(rev[0]);
+      constexpr auto space = RM_CVREF_T(pol)::exec_tag::value;
+      auto allocator = get_temporary_memory_source(pol);
+      const Ti n = capacity.outerSize();
+
+      auto hash = bht<Ti, 2, int>(allocator, capacity.nnz());
+      Vector<Tn> entries{allocator, (size_t)capacity.nnz()};
+      pol(range(n), [spmv = proxy<space>(capacity), h = proxy<space>(hash),
+                     entries = view<space>(entries)] ZS_LAMBDA(Ti v) mutable {
+        for (auto j = spmv._ptrs[v]; j < spmv._ptrs[v + 1]; ++j)
+          entries[h.insert({v, spmv._inds[j]})] = j;
+      });
+      Vector<int> missing{allocator, 1};
+      missing.setVal(0);
+      pol(range(n), [spmv = proxy<space>(capacity), h = proxy<space>(hash),
+                     entries = view<space>(entries), rev = view<space>(rev),
+                     missing = view<space>(missing)] ZS_LAMBDA(Ti v) mutable {
+        for (auto j = spmv._ptrs[v]; j < spmv._ptrs[v + 1]; ++j) {
+          auto id = h.query({spmv._inds[j], v});
+          if (id == RM_CVREF_T(h)::sentinel_v) {
+            missing[0] = 1;
+            rev[j] = j;
+          } else
+            rev[j] = entries[id];
+        }
+      });
+      return missing.getVal() == 0;
     }
-  };
 
-  template <typename Policy, typename SpMat, typename T = typename SpMat::value_type,
-            typename Ti = typename SpMat::index_type>
-  bool find_augmented_path(Policy &&pol, Ti source, Ti sink, const SpMat &capacity,
-                           Vector<int> &parents, Vector<int> &visited, Vector<int> &frontier,
-                           Vector<T> &potentialFlows) {
-    constexpr auto space = RM_CVREF_T(pol)::exec_tag::value;
-    constexpr auto exec_tag = wrapv<space>{};
-
-    auto allocator = get_temporary_memory_source(pol);
-
-    visited.reset(0);
-    visited.setVal(1, source);
-    frontier.reset(0);
-    frontier.setVal(1, source);
-    parents.setVal(-1, source);
-    potentialFlows.reset(0);
-    potentialFlows.setVal(std::numeric_limits<T>::max(), source);
-
-    auto isFrontierEmpty = Vector<int>(allocator, 1);
-    auto isSinkFound = Vector<int>(allocator, 1);
-
-    while (true) {
-      isFrontierEmpty.setVal(1);
-      {
-        auto &params = zs::make_tuple(view<space>(isFrontierEmpty));
-        pol(zs::range(frontier), params, kernel_check_empty_frontier{});
-      }
-      if (isFrontierEmpty.getVal()) break;
-
-      isSinkFound.setVal(0);
-      {
-        auto params = zs::make_tuple(view<space>(visited), view<space>(potentialFlows), sink,
-                                     view<space>(parents), view<space>(frontier),
-                                     view<space>(isSinkFound), proxy<space>(capacity), exec_tag);
-        pol(zs::range(capacity.outerSize()), params, kernel_bfs_augmented_path{});
+    /// @brief level-synchronous bfs over the residual graph, labels[seed] = level, the vertices
+    /// reached get level + distance (to the seed along residual edges when [ToSeed], otherwise
+    /// from the seed). vertices whose label is not [unvisited] block the traversal.
+    template <bool ToSeed, typename Policy, typename SpMat, typename RevVector,
+              typename LabelVector, typename Ti>
+    void max_flow_residual_bfs(Policy &&pol, const SpMat &capacity, const RevVector &rev,
+                               LabelVector &labels, Ti seed, Ti level, Ti unvisited,
+                               wrapv<ToSeed> = {}) {
+      constexpr auto space = RM_CVREF_T(pol)::exec_tag::value;
+      auto allocator = get_temporary_memory_source(pol);
+      const Ti n = capacity.outerSize();
+      Vector<Ti> frontier{allocator, (size_t)n}, next{allocator, (size_t)n};
+      Vector<Ti> nextSize{allocator, 1};
+      labels.setVal(level, seed);
+      frontier.setVal(seed);
+      for (Ti size = 1; size != 0;) {
+        nextSize.setVal(0);
+        pol(range(size), [spmv = proxy<space>(capacity), rev = view<space>(rev),
+                          labels = view<space>(labels), frontier = view<space>(frontier),
+                          next = view<space>(next), nextSize = view<space>(nextSize),
+                          l = level + 1, unvisited,
+                          execTag = wrapv<space>{}] ZS_LAMBDA(Ti i) mutable {
+          const Ti w = frontier[i];
+          for (auto j = spmv._ptrs[w]; j < spmv._ptrs[w + 1]; ++j) {
+            const Ti u = spmv._inds[j];
+            if (!(spmv._vals[ToSeed ? rev[j] : j] > 0)) continue;
+            if (labels[u] == unvisited
+                && atomic_cas(execTag, &labels[u], unvisited, l) == unvisited)
+              next[atomic_add(execTag, &nextSize[0], (Ti)1)] = u;
+          }
+        });
+        size = nextSize.getVal();
+        frontier.swap(next);
+        ++level;
       }
-      if (isSinkFound.getVal()) break;
     }
-    return potentialFlows.getVal(sink) > 0;
-  }
 
-  struct kernel_initialize_hashtable {
-    template <typename ParamT> constexpr void operator()(int vi, ParamT &params) noexcept {
-      auto &[capacity, h, hashBuffer] = params;
-      for (int j = capacity._ptrs[vi]; j < capacity._ptrs[vi + 1]; ++j) {
-        auto nvi = capacity._inds[j];
-        auto cnt = h.insert({vi, nvi});
-        hashBuffer[cnt] = j;
-      }
+    /// @brief exact distance labels: to the sink, or n + distance to the source for the vertices
+    /// already cut off from the sink, or 2n if neither is reachable
+    template <typename Policy, typename SpMat, typename RevVector, typename HeightVector,
+              typename Ti>
+    void max_flow_global_relabel(Policy &&pol, const SpMat &capacity, const RevVector &rev,
+                                 HeightVector &heights, Ti source, Ti sink) {
+      constexpr auto space = RM_CVREF_T(pol)::exec_tag::value;
+      const Ti n = capacity.outerSize();
+      pol(range(n), [heights = view<space>(heights), inf = 2 * n] ZS_LAMBDA(Ti v) mutable {
+        heights[v] = inf;
+      });
+      heights.setVal(n, source);
+      max_flow_residual_bfs(pol, capacity, rev, heights, sink, (Ti)0, 2 * n, true_c);
+      max_flow_residual_bfs(pol, capacity, rev, heights, source, n, 2 * n, true_c);
     }
-  };
 
-  template <typename Policy, typename SpMat, typename T = typename SpMat::value_type,
-            typename Ti = typename SpMat::index_type,
+  }  // namespace detail
+
+  /// @brief maximum flow from [source] to [sink], [capacity] holds the residual capacities on
+  /// return. [cutRange][v] is set to 1 for the source side of a minimum cut (the vertices still
+  /// reachable from the source in the residual graph), 0 for the rest.
+  /// @note the sparsity pattern must be structurally symmetric, the reverse of an edge may be
+  /// stored with zero capacity
+  /// @note lock-free push-relabel (ref: Hong 2008, A Lock-free Multi-threaded Algorithm for the
+  /// Maximum Flow Problem). every active vertex pushes to its lowest residual neighbor or
+  /// relabels, reading possibly stale heights of its neighbors. the heights are recomputed by a
+  /// parallel bfs (global relabel) once about n relabels accumulated.
+  template <typename Policy, typename SpMat, typename CutRange,
+            typename T = typename SpMat::value_type, typename Ti = typename SpMat::index_type,
             enable_if_all<!is_const_v<SpMat>, is_spmat_v<remove_cv_t<SpMat>>> = 0>
-  inline void maximum_flow(Policy &&pol, Ti source, Ti sink, SpMat &capacity, T &res) {
+  void maximum_flow(Policy &&pol, Ti source, Ti sink, SpMat &capacity, T &res,
+                    CutRange &&cutRange) {
+    using Tn = typename SpMat::size_type;
     constexpr auto space = RM_CVREF_T(pol)::exec_tag::value;
+    constexpr auto execTag = wrapv<space>{};
+    const Ti n = capacity.outerSize();
+    if (range_size(cutRange) != n)
+      throw std::runtime_error("min-cut range size differs from the number of vertices");
+    if (source < 0 || source >= n || sink < 0 || sink >= n || source == sink)
+      throw std::runtime_error("invalid source or sink vertex for maximum_flow");
 
     auto allocator = get_temporary_memory_source(pol);
-
-    size_t n = capacity.outerSize();
-    auto visited = Vector<int>(allocator, n);
-    auto frontier = Vector<int>(allocator, n);
-    auto potentialFlows = Vector<T>(allocator, n);
-    auto parents = Vector<int>(allocator, n);
-
-    res = 0;
-    parents.setVal(-1, source);
-
-    auto hash = bht<int, 2>(allocator, capacity.nnz());
-    auto hashBuffer = Vector<int>(allocator, capacity.nnz());
-
-    auto &params
-        = zs::make_tuple(proxy<space>(capacity), proxy<space>(hash), proxy<space>(hashBuffer));
-    pol(range(n), params, kernel_initialize_hashtable{});
-
-    hash = hash.clone({memsrc_e::host});
-    auto hashView = proxy<execspace_e::host>(hash);
-
-    while (find_augmented_path(pol, source, sink, capacity, parents, visited, frontier,
-                               potentialFlows)) {
-      auto minFlow = potentialFlows.getVal(sink);
-      res += minFlow;
-
-      for (int vi = sink; parents.getVal(vi) >= 0; vi = parents.getVal(vi)) {
-        int pvi = parents.getVal(vi);
-        int edge_id = hashBuffer.getVal(hashView.query({pvi, vi}));
-        int reverse_edge_id = hashBuffer.getVal(hashView.query({vi, pvi}));
-
-        capacity._vals.setVal(capacity._vals.getVal(edge_id) - minFlow, edge_id);
-        capacity._vals.setVal(capacity._vals.getVal(reverse_edge_id) + minFlow, reverse_edge_id);
-      }
+    Vector<Tn> rev{allocator, (size_t)capacity.nnz()};
+    if (!detail::max_flow_reverse_entries(pol, capacity, rev))
+      throw std::runtime_error("maximum_flow requires a structurally symmetric capacity matrix");
+
+    Vector<T> excess{allocator, (size_t)n};
+    Vector<Ti> heights{allocator, (size_t)n}, actives{allocator, (size_t)n};
+    Vector<Ti> counters{allocator, 2};  // [0]: active vertices, [1]: relabels
+    excess.reset(0);
+
+    /// @note saturate the edges leaving the source
+    {
+      const Tn st = capacity._ptrs.getVal(source), ed = capacity._ptrs.getVal(source + 1);
+      pol(range(ed - st), [spmv = proxy<space>(capacity), rev = view<space>(rev),
+                           excess = view<space>(excess), st, source,
+                           execTag] ZS_LAMBDA(Tn i) mutable {
+        const auto j = st + i;
+        const Ti w = spmv._inds[j];
+        const T c = spmv._vals[j];
+        if (w == source || !(c > 0)) return;
+        spmv._vals[j] = 0;
+        atomic_add(execTag, &spmv._vals[rev[j]], c);
+        atomic_add(execTag, &excess[w], c);
+      });
     }
-  }
-
-  /*
-  inline int maximum_flow(const std::vector<std::array<int, 3>> &DAG, int nmNodes,
-                          int source, int sink) {
-    std::vector<std::vector<int>> topology(nmNodes);
-    std::vector<std::vector<int>> capacity(nmNodes);
 
-    for (const auto &edge_capacity : DAG) {
-      topology[edge_capacity[0]].push_back(edge_capacity[1]);
-      capacity[edge_capacity[0]].push_back(edge_capacity[2]);
-
-      topology[edge_capacity[1]].push_back(edge_capacity[0]);
-      capacity[edge_capacity[1]].push_back(0);
-    }
-
-    std::vector<bool> visited(nmNodes, false);
-    std::vector<int> potentialFlows(nmNodes, 0);
-    std::vector<int> parents(nmNodes, -1);
-
-    int minFlow = 0;
-
-    while (true) {
-      std::fill(visited.begin(), visited.end(), false);
-
-      std::fill(potentialFlows.begin(), potentialFlows.end(), 0);
-      potentialFlows[source] = std::numeric_limits<int>::max();
-      std::fill(parents.begin(), parents.end(), -1);
-
-      std::queue<int> q;
-      q.push(source);
-
-      visited[source] = true;
-      bool find_sink = false;
-
-      while (!q.empty() && !find_sink) {
-        auto node = q.front();
-        q.pop();
-        for (int i = 0; i != topology[node].size(); ++i) {
-          int nnode = topology[node][i];
-          if (visited[nnode])
-            continue;
-          if (capacity[node][i] == 0)
-            continue;
-          visited[nnode] = true;
-          parents[nnode] = node;
-          potentialFlows[nnode] =
-              std::min(potentialFlows[node], capacity[node][i]);
-
-          if (nnode == sink) {
-            find_sink = true;
-            break;
-          }
-          q.push(nnode);
-        }
+    const auto collectActives = [&]() {
+      counters.setVal(0, 0);
+      pol(range(n), [excess = view<space>(excess), heights = view<space>(heights),
+                     actives = view<space>(actives), counters = view<space>(counters), source,
+                     sink, inf = 2 * n, execTag] ZS_LAMBDA(Ti v) mutable {
+        if (v != source && v != sink && excess[v] > 0 && heights[v] < inf)
+          actives[atomic_add(execTag, &counters[0], (Ti)1)] = v;
+      });
+      return counters.getVal(0);
+    };
+
+    detail::max_flow_global_relabel(pol, capacity, rev, heights, source, sink);
+    counters.setVal(0, 1);
+    for (Ti numActives = collectActives(); numActives != 0; numActives = collectActives()) {
+      if (counters.getVal(1) >= n) {
+        detail::max_flow_global_relabel(pol, capacity, rev, heights, source, sink);
+        counters.setVal(0, 1);
+        if ((numActives = collectActives()) == 0) break;
       }
-
-      if (find_sink) {
-        int sinkFlow = potentialFlows[sink];
-        minFlow += sinkFlow;
-        for (int node = sink; parents[node] >= 0; node = parents[node]) {
-          int parentNode = parents[node];
-          for (int i = 0; i != capacity[node].size(); ++i) {
-            if (topology[node][i] == parentNode) {
-              capacity[node][i] += sinkFlow;
-              break;
+      /// @note a few push/relabel steps per active vertex before the next synchronization
+      pol(range(numActives), [spmv = proxy<space>(capacity), rev = view<space>(rev),
+                              excess = view<space>(excess), heights = view<space>(heights),
+                              actives = view<space>(actives), counters = view<space>(counters),
+                              inf = 2 * n, execTag] ZS_LAMBDA(Ti i) mutable {
+        constexpr int cycles = 8;
+        const Ti v = actives[i];
+        Ti numRelabels = 0;
+        for (int c = 0; c != cycles; ++c) {
+          const T e = excess[v];
+          const Ti h = heights[v];
+          if (!(e > 0) || h >= inf) break;
+          Ti hmin = inf;
+          Tn jmin = 0;
+          for (auto j = spmv._ptrs[v]; j < spmv._ptrs[v + 1]; ++j) {
+            const Ti w = spmv._inds[j];
+            if (w == v || !(spmv._vals[j] > 0)) continue;
+            const Ti hw = heights[w];
+            if (hw < hmin) {
+              hmin = hw;
+              jmin = j;
             }
           }
-          for (int i = 0; i != capacity[parentNode].size(); ++i) {
-            if (topology[parentNode][i] == node) {
-              capacity[parentNode][i] -= sinkFlow;
-              break;
-            }
+          if (h > hmin) {
+            /// @note only v decreases the residual of (v, w), others may only increase it
+            const T cf = spmv._vals[jmin];
+            const T delta = e < cf ? e : cf;
+            atomic_add(execTag, &spmv._vals[jmin], -delta);
+            atomic_add(execTag, &spmv._vals[rev[jmin]], delta);
+            atomic_add(execTag, &excess[v], -delta);
+            atomic_add(execTag, &excess[spmv._inds[jmin]], delta);
+          } else {
+            heights[v] = hmin < inf ? hmin + 1 : inf;
+            ++numRelabels;
           }
-
-          assert(capacity[pnode][local_id] >= 0 &&
-                 capacity[node][reverse_local_id] >= 0);
         }
-
-      } else {
-        break;
-      }
+        if (numRelabels) atomic_add(execTag, &counters[1], numRelabels);
+      });
     }
+    res = excess.getVal(sink);
+
+    /// @note minimum cut
+    Vector<Ti> reached{allocator, (size_t)n};
+    pol(range(n), [reached = view<space>(reached), n] ZS_LAMBDA(Ti v) mutable { reached[v] = n; });
+    detail::max_flow_residual_bfs(pol, capacity, rev, reached, source, (Ti)0, n, false_c);
+    pol(range(n), [reached = view<space>(reached), cut = std::begin(cutRange),
+                   n] ZS_LAMBDA(Ti v) mutable { cut[v] = reached[v] != n ? 1 : 0; });
+  }
 
-    return minFlow;
+  /// @brief maximum flow from [source] to [sink], [capacity] holds the residual capacities on
+  /// return
+  template <typename Policy, typename SpMat, typename T = typename SpMat::value_type,
+            typename Ti = typename SpMat::index_type,
+            enable_if_all<!is_const_v<SpMat>, is_spmat_v<remove_cv_t<SpMat>>> = 0>
+  inline void maximum_flow(Policy &&pol, Ti source, Ti sink, SpMat &capacity, T &res) {
+    auto cut = Vector<int>{get_temporary_memory_source(pol), (size_t)capacity.outerSize()};
+    maximum_flow(pol, source, sink, capacity, res, cut);
   }
-  */
 
 }  // namespace zs
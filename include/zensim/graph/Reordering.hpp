@@ -0,0 +1,358 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+
+#include "zensim/container/Vector.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/graph/ConnectedComponents.hpp"
+#include "zensim/math/matrix/SparseMatrix.hpp"
+
+namespace zs {
+
+  /// @brief bandwidth/fill reducing orderings of a (structurally symmetric) sparse matrix graph
+  /// @note permutation convention: perm[newId] = oldId, invPerm[oldId] = newId
+  /// @note the per-domain traversals are sequential, parallelism comes from independent domains
+  /// (connected components for rcm, sibling subdomains for nested dissection)
+
+  namespace detail {
+
+    template <typename SpmvT, typename Ti> struct reorder_graph_context {
+      /// @note marks: 0 unvisited, > 0 bfs stamp, -1 placed
+      static constexpr int placed_v = -1;
+
+      constexpr Ti degree(Ti v) const noexcept {
+        return (Ti)(spmv._ptrs[v + 1] - spmv._ptrs[v]);
+      }
+      constexpr bool inDomain(Ti v, Ti label) const noexcept { return labels[v] == label; }
+
+      /// @brief level structure rooted at [root] restricted to the domain [label]
+      /// @return number of visited vertices, [queue] holds the vertices in bfs (level) order
+      Ti bfs(Ti root, Ti label, int stamp, Ti *queue, Ti &depth, Ti &lastLevelBegin) const {
+        Ti head = 0, tail = 1, levelEnd = 1;
+        depth = 0;
+        lastLevelBegin = 0;
+        queue[0] = root;
+        marks[root] = stamp;
+        if (levels) levels[root] = 0;
+        while (head != tail) {
+          if (head == levelEnd) {
+            ++depth;
+            lastLevelBegin = head;
+            levelEnd = tail;
+          }
+          Ti u = queue[head++];
+          for (auto k = spmv._ptrs[u]; k != spmv._ptrs[u + 1]; ++k) {
+            Ti nbr = spmv._inds[k];
+            if (!inDomain(nbr, label) || marks[nbr] == stamp || marks[nbr] == placed_v) continue;
+            marks[nbr] = stamp;
+            if (levels) levels[nbr] = depth + 1;
+            queue[tail++] = nbr;
+          }
+        }
+        return tail;
+      }
+
+      /// @brief George-Liu pseudo-peripheral node finder
+      /// @note on return, [queue] holds the level structure of the returned root
+      Ti pseudoPeripheral(Ti start, Ti label, int &stamp, Ti *queue, Ti &numVisited,
+                          Ti &depth) const {
+        Ti root = start, lastLevelBegin = 0;
+        numVisited = bfs(root, label, ++stamp, queue, depth, lastLevelBegin);
+        for (int iter = 0; iter != 8; ++iter) {
+          Ti cand = queue[lastLevelBegin];
+          for (Ti i = lastLevelBegin + 1; i < numVisited; ++i)
+            if (degree(queue[i]) < degree(cand)) cand = queue[i];
+          Ti candDepth, candLastLevelBegin;
+          auto candVisited = bfs(cand, label, ++stamp, queue, candDepth, candLastLevelBegin);
+          if (candDepth > depth) {
+            root = cand;
+            depth = candDepth;
+            lastLevelBegin = candLastLevelBegin;
+            numVisited = candVisited;
+          } else {
+            /// @note restore the level structure of the current root
+            numVisited = bfs(root, label, ++stamp, queue, depth, lastLevelBegin);
+            break;
+          }
+        }
+        return root;
+      }
+
+      /// @brief reverse cuthill-mckee ordering of the domain vertices [verts, verts + n)
+      /// @note the result is written to [out, out + n), which also serves as the bfs queue
+      void rcm(const Ti *verts, Ti n, Ti label, Ti *out) const {
+        for (Ti i = 0; i != n; ++i) marks[verts[i]] = 0;
+        int stamp = 0;
+        Ti numPlaced = 0;
+        for (Ti i = 0; i != n; ++i) {
+          Ti v = verts[i];
+          if (marks[v] == placed_v) continue;
+          Ti numVisited, depth;
+          Ti root = pseudoPeripheral(v, label, stamp, out + numPlaced, numVisited, depth);
+          /// cuthill-mckee sweep of this component
+          Ti head = numPlaced, tail = numPlaced;
+          out[tail++] = root;
+          marks[root] = placed_v;
+          while (head != tail) {
+            Ti u = out[head++];
+            Ti st = tail;
+            for (auto k = spmv._ptrs[u]; k != spmv._ptrs[u + 1]; ++k) {
+              Ti nbr = spmv._inds[k];
+              if (!inDomain(nbr, label) || marks[nbr] == placed_v) continue;
+              marks[nbr] = placed_v;
+              out[tail++] = nbr;
+            }
+            std::sort(out + st, out + tail, [this](Ti a, Ti b) {
+              auto da = degree(a), db = degree(b);
+              return da < db || (da == db && a < b);
+            });
+          }
+          numPlaced = tail;
+        }
+        std::reverse(out, out + n);
+      }
+
+      SpmvT spmv;
+      const Ti *labels;
+      int *marks;
+      Ti *levels;
+    };
+
+    template <typename Ti> struct nested_dissection_domain {
+      Ti offset, size, label;
+    };
+
+  }  // namespace detail
+
+  /// @brief perm -> invPerm
+  template <typename Policy, typename PermRangeT, typename InvPermRangeT>
+  void inverse_permutation(Policy &&policy, PermRangeT &&perm, InvPermRangeT &&invPerm) {
+    using Ti = RM_CVREF_T(*std::begin(perm));
+    static_assert(is_integral_v<Ti>, "permutation index type should be integral");
+    auto n = range_size(perm);
+    if (n != range_size(invPerm)) throw std::runtime_error("permutation size mismatch");
+    policy(range(n), [perm = std::begin(perm), invPerm = std::begin(invPerm)] ZS_LAMBDA(
+                         Ti newId) mutable { invPerm[perm[newId]] = newId; });
+  }
+
+  /// @brief reverse cuthill-mckee ordering, components are ordered concurrently
+  /// @note assume the graph is undirected (symmetric sparsity pattern)
+  template <typename Policy, typename T, bool RowMajor, typename Ti, typename Tn,
+            typename AllocatorT, typename PermRangeT>
+  void reverse_cuthill_mckee(Policy &&policy,
+                             const SparseMatrix<T, RowMajor, Ti, Tn, AllocatorT> &spmat,
+                             PermRangeT &&perm) {
+    constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+    static_assert(space == execspace_e::host || space == execspace_e::openmp,
+                  "graph reordering is only available for host execution policies.");
+    static_assert(is_same_v<RM_CVREF_T(*std::begin(perm)), Ti>,
+                  "permutation index type should be the same as the spmat index type");
+
+    const Ti n = spmat.outerSize();
+    if (spmat.rows() != spmat.cols()) throw std::runtime_error("rcm requires a square spmat");
+    if (range_size(perm) != n) throw std::runtime_error("spmat and permutation size mismatch");
+    if (!valid_memspace_for_execution(policy, spmat.get_allocator()))
+      throw std::runtime_error("current memory location not compatible with the execution policy");
+    if (n == 0) return;
+
+    auto allocator = get_temporary_memory_source(policy);
+    /// @brief connected components
+    Vector<Ti> fas{allocator, (size_t)n}, labels{allocator, (size_t)n};
+    union_find(policy, spmat, fas);
+    policy(range(n), [fas = view<space>(fas), labels = view<space>(labels)] ZS_LAMBDA(
+                         Ti v) mutable {
+      Ti r = fas[v];
+      while (fas[r] != r) r = fas[r];
+      labels[v] = r;
+    });
+
+    /// @brief group vertices by component
+    Vector<Ti> indices{allocator, (size_t)n}, sortedLabels{allocator, (size_t)n},
+        verts{allocator, (size_t)n};
+    policy(enumerate(indices), [] ZS_LAMBDA(Ti i, Ti & id) { id = i; });
+    radix_sort_pair(policy, std::begin(labels), std::begin(indices), std::begin(sortedLabels),
+                    std::begin(verts), n, 0, std::max((int)bit_count(n), 1));
+
+    Vector<Ti> heads{allocator, (size_t)n + 1}, compIds{allocator, (size_t)n + 1};
+    policy(range(n), [sortedLabels = view<space>(sortedLabels), heads = view<space>(heads)] ZS_LAMBDA(
+                         Ti i) mutable {
+      heads[i] = (i == 0 || sortedLabels[i] != sortedLabels[i - 1]) ? 1 : 0;
+    });
+    heads.setVal(0, n);
+    exclusive_scan(policy, std::begin(heads), std::end(heads), std::begin(compIds));
+    const Ti numComps = compIds.getVal(n);
+    Vector<Ti> compOffsets{allocator, (size_t)numComps + 1};
+    policy(range(n), [heads = view<space>(heads), compIds = view<space>(compIds),
+                      compOffsets = view<space>(compOffsets)] ZS_LAMBDA(Ti i) mutable {
+      if (heads[i]) compOffsets[compIds[i]] = i;
+    });
+    compOffsets.setVal(n, numComps);
+
+    /// @brief order each component
+    Vector<int> marks{allocator, (size_t)n};
+    detail::reorder_graph_context<RM_CVREF_T(view<space>(spmat)), Ti> ctx{
+        view<space>(spmat), labels.data(), marks.data(), nullptr};
+    policy(range(numComps), [&, out = &*std::begin(perm)](Ti compId) {
+      auto st = compOffsets[compId];
+      auto ed = compOffsets[compId + 1];
+      ctx.rcm(verts.data() + st, ed - st, sortedLabels[st], &out[st]);
+    });
+  }
+
+  /// @brief nested dissection ordering by recursive level-structure bisection
+  /// @note assume the graph is undirected (symmetric sparsity pattern)
+  /// @note separators are numbered after their subdomains, leaves are rcm-ordered
+  template <typename Policy, typename T, bool RowMajor, typename Ti, typename Tn,
+            typename AllocatorT, typename PermRangeT>
+  void nested_dissection(Policy &&policy,
+                         const SparseMatrix<T, RowMajor, Ti, Tn, AllocatorT> &spmat,
+                         PermRangeT &&perm, Ti leafSize = 64) {
+    constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+    static_assert(space == execspace_e::host || space == execspace_e::openmp,
+                  "graph reordering is only available for host execution policies.");
+    static_assert(is_same_v<RM_CVREF_T(*std::begin(perm)), Ti>,
+                  "permutation index type should be the same as the spmat index type");
+
+    const Ti n = spmat.outerSize();
+    if (spmat.rows() != spmat.cols())
+      throw std::runtime_error("nested dissection requires a square spmat");
+    if (range_size(perm) != n) throw std::runtime_error("spmat and permutation size mismatch");
+    if (!valid_memspace_for_execution(policy, spmat.get_allocator()))
+      throw std::runtime_error("current memory location not compatible with the execution policy");
+    if (n == 0) return;
+    if (leafSize < 1) leafSize = 1;
+
+    auto allocator = get_temporary_memory_source(policy);
+    Vector<Ti> labels{allocator, (size_t)n}, levels{allocator, (size_t)n},
+        verts{allocator, (size_t)n}, queue{allocator, (size_t)n};
+    Vector<int> marks{allocator, (size_t)n};
+    labels.reset(0);
+    policy(enumerate(verts), [] ZS_LAMBDA(Ti i, Ti & id) { id = i; });
+
+    detail::reorder_graph_context<RM_CVREF_T(view<space>(spmat)), Ti> ctx{
+        view<space>(spmat), labels.data(), marks.data(), levels.data()};
+    using domain_t = detail::nested_dissection_domain<Ti>;
+    std::vector<domain_t> domains{domain_t{0, n, 0}}, children;
+    Ti nextLabel = 1;
+    while (domains.size()) {
+      children.assign(domains.size() * 2, domain_t{0, 0, 0});
+      policy(range(domains.size()), [&, out = &*std::begin(perm)](size_t domainNo) {
+        const Ti offset = domains[domainNo].offset;
+        const Ti size = domains[domainNo].size;
+        const Ti label = domains[domainNo].label;
+        Ti *vs = verts.data() + offset;
+        Ti *q = queue.data() + offset;
+        auto finalizeAsLeaf = [&]() { ctx.rcm(vs, size, label, &out[offset]); };
+        if (size <= leafSize) {
+          finalizeAsLeaf();
+          return;
+        }
+        for (Ti i = 0; i != size; ++i) marks[vs[i]] = 0;
+        int stamp = 0;
+        Ti numVisited, depth;
+        ctx.pseudoPeripheral(vs[0], label, stamp, q, numVisited, depth);
+
+        Ti sizeA = 0, sizeB = 0;
+        if (numVisited < size) {
+          /// @note disconnected: reached component | the rest, no separator needed
+          Ti cnt = numVisited;
+          for (Ti i = 0; i != size; ++i)
+            if (marks[vs[i]] != stamp) q[cnt++] = vs[i];
+          for (Ti i = 0; i != size; ++i) vs[i] = q[i];
+          sizeA = numVisited;
+          sizeB = size - numVisited;
+        } else if (depth < 2) {
+          finalizeAsLeaf();
+          return;
+        } else {
+          /// @note split at the median level, the level itself being the separator
+          Ti m = levels[q[size / 2]];
+          if (m == 0) m = 1;
+          if (m == depth) m = depth - 1;
+          auto inSeparator = [&](Ti v) {
+            if (levels[v] != m) return false;
+            for (auto k = ctx.spmv._ptrs[v]; k != ctx.spmv._ptrs[v + 1]; ++k) {
+              Ti nbr = ctx.spmv._inds[k];
+              if (ctx.inDomain(nbr, label) && levels[nbr] == m + 1) return true;
+            }
+            return false;
+          };
+          Ti cnt = 0;
+          for (Ti i = 0; i != size; ++i)
+            if (levels[q[i]] <= m && !inSeparator(q[i])) vs[cnt++] = q[i];
+          sizeA = cnt;
+          for (Ti i = 0; i != size; ++i)
+            if (levels[q[i]] > m) vs[cnt++] = q[i];
+          sizeB = cnt - sizeA;
+          for (Ti i = 0; i != size; ++i)
+            if (inSeparator(q[i])) vs[cnt++] = q[i];
+          /// separator vertices are numbered last within this domain
+          for (Ti i = sizeA + sizeB; i != size; ++i) out[offset + i] = vs[i];
+        }
+        const Ti labelA = nextLabel + (Ti)domainNo * 2, labelB = labelA + 1;
+        for (Ti i = 0; i != sizeA; ++i) labels[vs[i]] = labelA;
+        for (Ti i = sizeA; i != sizeA + sizeB; ++i) labels[vs[i]] = labelB;
+        children[domainNo * 2] = domain_t{offset, sizeA, labelA};
+        children[domainNo * 2 + 1] = domain_t{offset + sizeA, sizeB, labelB};
+      });
+      nextLabel += (Ti)domains.size() * 2;
+      domains.clear();
+      for (const auto &child : children)
+        if (child.size) domains.push_back(child);
+    }
+  }
+
+  /// @brief B = P A P^T, i.e. B(i, j) = A(perm[i], perm[j])
+  /// @note inner indices of the result are sorted
+  template <typename Policy, typename T, bool RowMajor, typename Ti, typename Tn,
+            typename AllocatorT, typename PermRangeT>
+  auto symmetric_permute(Policy &&policy,
+                         const SparseMatrix<T, RowMajor, Ti, Tn, AllocatorT> &spmat,
+                         PermRangeT &&perm) {
+    using spmat_t = SparseMatrix<T, RowMajor, Ti, Tn, AllocatorT>;
+    using size_type = typename spmat_t::size_type;
+    constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+
+    const Ti n = spmat.outerSize();
+    if (spmat.rows() != spmat.cols())
+      throw std::runtime_error("symmetric permutation requires a square spmat");
+    if (range_size(perm) != n) throw std::runtime_error("spmat and permutation size mismatch");
+    if (!valid_memspace_for_execution(policy, spmat.get_allocator()))
+      throw std::runtime_error("current memory location not compatible with the execution policy");
+
+    auto allocator = get_temporary_memory_source(policy);
+    Vector<Ti> invPerm{allocator, (size_t)n};
+    inverse_permutation(policy, perm, invPerm);
+
+    spmat_t ret{spmat.get_allocator(), spmat.rows(), spmat.cols()};
+    Vector<size_type> cnts{allocator, (size_t)n + 1};
+    policy(range(n), [cnts = view<space>(cnts), spmat = view<space>(spmat),
+                      perm = std::begin(perm)] ZS_LAMBDA(Ti i) mutable {
+      auto src = perm[i];
+      cnts[i] = spmat._ptrs[src + 1] - spmat._ptrs[src];
+    });
+    cnts.setVal(0, n);
+    ret._ptrs.resize((size_t)n + 1);
+    exclusive_scan(policy, std::begin(cnts), std::end(cnts), std::begin(ret._ptrs));
+
+    const auto nnz = ret._ptrs.getVal(n);
+    const bool hasValues = spmat.hasValues();
+    ret._inds.resize(nnz);
+    if (hasValues) ret._vals.resize(nnz);
+    policy(range(n),
+           [spmat = view<space>(spmat), ptrs = view<space>(ret._ptrs),
+            inds = view<space>(ret._inds), vals = view<space>(ret._vals),
+            invPerm = view<space>(invPerm), perm = std::begin(perm), hasValues] ZS_LAMBDA(
+               Ti i) mutable {
+             auto src = perm[i];
+             auto dst = ptrs[i];
+             for (auto k = spmat._ptrs[src]; k != spmat._ptrs[src + 1]; ++k, ++dst) {
+               inds[dst] = invPerm[spmat._inds[k]];
+               if (hasValues) vals[dst] = spmat._vals[k];
+             }
+           });
+    ret.localOrdering(policy);
+    return ret;
+  }
+
+}  // namespace zs
@@ -0,0 +1,289 @@
+#include "ByteStream.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+#if defined(ZS_PLATFORM_WINDOWS)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace zs {
+
+  namespace {
+    /// single transfers are capped so that the byte count fits the native (signed 32-bit) types
+    constexpr size_t s_max_transfer = (size_t)1 << 30;
+
+#if defined(ZS_PLATFORM_WINDOWS)
+    int64_t read_handle(HANDLE handle, void *dst, size_t maxBytes) {
+      size_t done = 0;
+      while (done < maxBytes) {
+        const DWORD request = (DWORD)std::min(maxBytes - done, s_max_transfer);
+        DWORD got = 0;
+        if (!ReadFile(handle, (char *)dst + done, request, &got, nullptr))
+          return done ? (int64_t)done : -1;
+        if (got == 0) break;
+        done += got;
+      }
+      return (int64_t)done;
+    }
+    int64_t write_handle(HANDLE handle, const void *src, size_t bytes) {
+      size_t done = 0;
+      while (done < bytes) {
+        const DWORD request = (DWORD)std::min(bytes - done, s_max_transfer);
+        DWORD put = 0;
+        if (!WriteFile(handle, (const char *)src + done, request, &put, nullptr) || put == 0)
+          return -1;
+        done += put;
+      }
+      return (int64_t)done;
+    }
+#else
+    /// retries interrupted and short transfers, stops early only at the end of the input
+    int64_t read_fd(int fd, void *dst, size_t maxBytes) {
+      size_t done = 0;
+      while (done < maxBytes) {
+        const auto got = ::read(fd, (char *)dst + done, std::min(maxBytes - done, s_max_transfer));
+        if (got < 0) {
+          if (errno == EINTR) continue;
+          return done ? (int64_t)done : -1;
+        }
+        if (got == 0) break;
+        done += (size_t)got;
+      }
+      return (int64_t)done;
+    }
+    int64_t write_fd(int fd, const void *src, size_t bytes) {
+      size_t done = 0;
+      while (done < bytes) {
+        const auto put
+            = ::write(fd, (const char *)src + done, std::min(bytes - done, s_max_transfer));
+        if (put < 0) {
+          if (errno == EINTR) continue;
+          return -1;
+        }
+        done += (size_t)put;
+      }
+      return (int64_t)done;
+    }
+#endif
+  }  // namespace
+
+  // ── FileStream ─────────────────────────────────────────────────────────
+
+#if defined(ZS_PLATFORM_WINDOWS)
+
+  FileStream::FileStream(const std::string &path, FileOpenMode mode) : _path{path}, _mode{mode} {
+    DWORD access = GENERIC_READ, disposition = OPEN_EXISTING;
+    switch (mode) {
+      case FileOpenMode::read:       access = GENERIC_READ; disposition = OPEN_EXISTING; break;
+      case FileOpenMode::write:      access = GENERIC_WRITE; disposition = CREATE_ALWAYS; break;
+      case FileOpenMode::read_write:
+        access = GENERIC_READ | GENERIC_WRITE;
+        disposition = OPEN_EXISTING;
+        break;
+      case FileOpenMode::append:     access = FILE_APPEND_DATA; disposition = OPEN_ALWAYS; break;
+    }
+    HANDLE handle = CreateFileA(path.c_str(), access, FILE_SHARE_READ, nullptr, disposition,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle != INVALID_HANDLE_VALUE) _handle = handle;
+  }
+
+  FileStream::FileStream(FileStream &&o) noexcept
+      : _path{std::move(o._path)}, _mode{o._mode}, _handle{std::exchange(o._handle, nullptr)} {}
+
+  FileStream &FileStream::operator=(FileStream &&o) noexcept {
+    if (this == &o) return *this;
+    close();
+    _path = std::move(o._path);
+    _mode = o._mode;
+    _handle = std::exchange(o._handle, nullptr);
+    return *this;
+  }
+
+  bool FileStream::is_open() const noexcept { return _handle != nullptr; }
+
+  int64_t FileStream::read(void *dst, size_t maxBytes) {
+    if (!is_readable()) return -1;
+    return read_handle((HANDLE)_handle, dst, maxBytes);
+  }
+
+  int64_t FileStream::write(const void *src, size_t bytes) {
+    if (!is_writable()) return -1;
+    return write_handle((HANDLE)_handle, src, bytes);
+  }
+
+  int64_t FileStream::seek(int64_t offset, SeekOrigin origin) {
+    if (!is_open()) return -1;
+    const DWORD method = origin == SeekOrigin::begin     ? FILE_BEGIN
+                         : origin == SeekOrigin::current ? FILE_CURRENT
+                                                         : FILE_END;
+    LARGE_INTEGER distance{}, position{};
+    distance.QuadPart = offset;
+    if (!SetFilePointerEx((HANDLE)_handle, distance, &position, method)) return -1;
+    return (int64_t)position.QuadPart;
+  }
+
+  int64_t FileStream::tell() const {
+    if (!is_open()) return -1;
+    LARGE_INTEGER distance{}, position{};
+    if (!SetFilePointerEx((HANDLE)_handle, distance, &position, FILE_CURRENT)) return -1;
+    return (int64_t)position.QuadPart;
+  }
+
+  int64_t FileStream::size() const {
+    if (!is_open()) return -1;
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx((HANDLE)_handle, &size)) return -1;
+    return (int64_t)size.QuadPart;
+  }
+
+  void FileStream::close() {
+    if (_handle) CloseHandle((HANDLE)_handle);
+    _handle = nullptr;
+  }
+
+#else
+
+  FileStream::FileStream(const std::string &path, FileOpenMode mode) : _path{path}, _mode{mode} {
+    int flags = O_RDONLY;
+    switch (mode) {
+      case FileOpenMode::read:       flags = O_RDONLY; break;
+      case FileOpenMode::write:      flags = O_WRONLY | O_CREAT | O_TRUNC; break;
+      case FileOpenMode::read_write: flags = O_RDWR; break;
+      case FileOpenMode::append:     flags = O_WRONLY | O_CREAT | O_APPEND; break;
+    }
+#  ifdef O_CLOEXEC
+    flags |= O_CLOEXEC;
+#  endif
+    _fd = ::open(path.c_str(), flags, 0644);
+  }
+
+  FileStream::FileStream(FileStream &&o) noexcept
+      : _path{std::move(o._path)}, _mode{o._mode}, _fd{std::exchange(o._fd, -1)} {}
+
+  FileStream &FileStream::operator=(FileStream &&o) noexcept {
+    if (this == &o) return *this;
+    close();
+    _path = std::move(o._path);
+    _mode = o._mode;
+    _fd = std::exchange(o._fd, -1);
+    return *this;
+  }
+
+  bool FileStream::is_open() const noexcept { return _fd >= 0; }
+
+  int64_t FileStream::read(void *dst, size_t maxBytes) {
+    if (!is_readable()) return -1;
+    return read_fd(_fd, dst, maxBytes);
+  }
+
+  int64_t FileStream::write(const void *src, size_t bytes) {
+    if (!is_writable()) return -1;
+    return write_fd(_fd, src, bytes);
+  }
+
+  int64_t FileStream::seek(int64_t offset, SeekOrigin origin) {
+    if (!is_open()) return -1;
+    const int whence = origin == SeekOrigin::begin     ? SEEK_SET
+                       : origin == SeekOrigin::current ? SEEK_CUR
+                                                       : SEEK_END;
+    return (int64_t)::lseek(_fd, (off_t)offset, whence);
+  }
+
+  int64_t FileStream::tell() const {
+    if (!is_open()) return -1;
+    return (int64_t)::lseek(_fd, 0, SEEK_CUR);
+  }
+
+  int64_t FileStream::size() const {
+    if (!is_open()) return -1;
+    struct stat st {};
+    if (::fstat(_fd, &st) != 0) return -1;
+    return (int64_t)st.st_size;
+  }
+
+  void FileStream::close() {
+    if (_fd >= 0) ::close(_fd);
+    _fd = -1;
+  }
+
+#endif
+
+  FileStream::~FileStream() { close(); }
+
+  bool FileStream::is_readable() const noexcept {
+    return is_open() && (_mode == FileOpenMode::read || _mode == FileOpenMode::read_write);
+  }
+
+  bool FileStream::is_writable() const noexcept { return is_open() && _mode != FileOpenMode::read; }
+
+  /// writes are unbuffered, whatever was written already sits in the OS page cache
+  bool FileStream::flush() { return is_open(); }
+
+  // ── StdioStream ────────────────────────────────────────────────────────
+
+  StdioStream::StdioStream(StdioKind kind) noexcept : _kind{kind} {}
+
+  bool StdioStream::is_readable() const noexcept { return _kind == StdioKind::stdin_stream; }
+
+  bool StdioStream::is_writable() const noexcept { return _kind != StdioKind::stdin_stream; }
+
+#if defined(ZS_PLATFORM_WINDOWS)
+
+  int64_t StdioStream::read(void *dst, size_t maxBytes) {
+    if (!is_readable()) return -1;
+    /// a console or pipe delivers what is available, do not block for the full amount
+    DWORD got = 0;
+    if (!ReadFile(GetStdHandle(STD_INPUT_HANDLE), dst, (DWORD)std::min(maxBytes, s_max_transfer),
+                  &got, nullptr))
+      return -1;
+    return (int64_t)got;
+  }
+
+  int64_t StdioStream::write(const void *src, size_t bytes) {
+    if (!is_writable()) return -1;
+    /// keep the order with whatever was printed through the C runtime
+    fflush(_kind == StdioKind::stdout_stream ? stdout : stderr);
+    return write_handle(
+        GetStdHandle(_kind == StdioKind::stdout_stream ? STD_OUTPUT_HANDLE : STD_ERROR_HANDLE), src,
+        bytes);
+  }
+
+#else
+
+  int64_t StdioStream::read(void *dst, size_t maxBytes) {
+    if (!is_readable()) return -1;
+    /// a terminal or pipe delivers what is available, do not block for the full amount
+    for (;;) {
+      const auto got = ::read(STDIN_FILENO, dst, std::min(maxBytes, s_max_transfer));
+      if (got >= 0 || errno != EINTR) return (int64_t)got;
+    }
+  }
+
+  int64_t StdioStream::write(const void *src, size_t bytes) {
+    if (!is_writable()) return -1;
+    /// keep the order with whatever was printed through the C runtime
+    fflush(_kind == StdioKind::stdout_stream ? stdout : stderr);
+    return write_fd(_kind == StdioKind::stdout_stream ? STDOUT_FILENO : STDERR_FILENO, src, bytes);
+  }
+
+#endif
+
+  bool StdioStream::flush() {
+    if (_kind == StdioKind::stdin_stream) return true;
+    return fflush(_kind == StdioKind::stdout_stream ? stdout : stderr) == 0;
+  }
+
+}  // namespace zs
@@ -1,4 +1,6 @@
 #pragma once
+#include <atomic>
+
 #include "zensim/ZpcFunction.hpp"
 #include "zensim/execution/Concurrency.h"
 #include "zensim/execution/ManagedThread.hpp"
@@ -29,7 +31,12 @@ namespace zs {
     }
     ~IO() {
       while (!jobs.empty()) cv.notify_all();
-      bRunning = false;
+      {
+        /// the worker may be waiting already, it has to observe the stop request under the lock
+        std::lock_guard<std::mutex> lk{mut};
+        bRunning = false;
+      }
+      cv.notify_all();
       if (th.joinable()) th.join();
     }
 
@@ -44,7 +51,8 @@ namespace zs {
     }
 
   private:
-    bool bRunning;
+    /// read by the worker outside the lock, written under it (see ~IO)
+    std::atomic<bool> bRunning;
     std::mutex mut;
     std::condition_variable cv;
     threadsafe_queue<zs::function<void()>> jobs;
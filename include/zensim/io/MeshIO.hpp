@@ -1,29 +1,367 @@
 #pragma once
 #include <array>
 #include <cassert>
+#include <cctype>
 #include <cstdio>
-#include <fstream>
-#include <sstream>
+#include <future>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include "zensim/container/TileVector.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
 #include "zensim/geometry/Mesh.hpp"
+#include "zensim/io/ByteStream.hpp"
+#include "zensim/io/IO.h"
+#include "zensim/io/MeshParsing.hpp"
+#include "zensim/io/MeshWriting.hpp"
 #include "zensim/math/Vec.h"
+#include "zensim/memory/MappedFile.hpp"
 #include "zensim/types/Optional.h"
+#if ZS_ENABLE_OPENMP
+#  include "zensim/omp/execution/ExecutionPolicy.hpp"
+#endif
 
 namespace zs {
 
+  /// @brief loads positions, per-vertex normals and uvs, and triangles of an obj file
+  /// @note parsed by the same (parallel, memory-mapped) obj parser as read_mesh
+  /// @note the outputs are appended to, triangle indices are offset by the positions already in
+  /// [pos] (they used to index the file's positions only). [nrm] and [uv] (optional) are resized
+  /// along with [pos], normals are computed from the triangles when the file has none.
+  /// @note the file must have an .obj extension, others are rejected (returns false).
   ZPC_API bool load_obj(std::string_view file, std::vector<std::array<float, 3>> *pos,
                         std::vector<std::array<float, 3>> *nrm,
                         std::vector<std::array<float, 2>> *uv,
                         std::vector<std::array<u32, 3>> *tris);
 
+  enum class mesh_file_e : unsigned char { unknown, obj, vtk, ply };
+
+  /// @brief mesh format deduced from the (case insensitive) file extension
+  inline mesh_file_e mesh_file_format(std::string_view file) noexcept {
+    const auto dot = file.find_last_of('.');
+    if (dot == std::string_view::npos) return mesh_file_e::unknown;
+    std::string ext{file.substr(dot + 1)};
+    for (auto &c : ext) c = (char)std::tolower((unsigned char)c);
+    if (ext == "obj") return mesh_file_e::obj;
+    if (ext == "vtk") return mesh_file_e::vtk;
+    if (ext == "ply") return mesh_file_e::ply;
+    return mesh_file_e::unknown;
+  }
+
+  namespace detail {
+
+    inline auto default_mesh_io_policy() {
+#if ZS_ENABLE_OPENMP
+      return omp_exec();
+#else
+      return seq_exec();
+#endif
+    }
+
+    /// @brief maps [file] and parses it (by extension) into [sink]
+    template <typename Policy, typename Sink>
+    mesh_file_info read_mesh_file(Policy &&pol, const std::string &file, Sink &sink,
+                                  size_t chunkBytes) {
+      const auto format = mesh_file_format(file);
+      if (format == mesh_file_e::unknown)
+        throw std::runtime_error("unrecognized mesh file extension");
+      MappedFile mapping{file};
+      if (!mapping.is_mapped()) throw std::runtime_error("file missing, empty or not mappable");
+      /// the whole file is read, ask for read-ahead
+      mapping.commit(0, mapping.file_size());
+      const char *data = static_cast<const char *>(mapping.address(0));
+      const size_t size = mapping.file_size();
+      switch (format) {
+        case mesh_file_e::obj:
+          return parse_obj(pol, data, size, sink, chunkBytes);
+        case mesh_file_e::vtk:
+          return parse_vtk(pol, data, size, sink, chunkBytes);
+        default:
+          return parse_ply(pol, data, size, sink, chunkBytes);
+      }
+    }
+
+    /// @brief area weighted normals of the nodes [nodeBase, nodeBase + numNodes)
+    /// @note [tris] only reference those nodes, [nrms] points to the normal of node [nodeBase]
+    template <typename Policy, typename NodeT, typename TriT, typename NrmT>
+    void accumulate_vertex_normals(Policy &&pol, const NodeT *nodes, const TriT *tris,
+                                   size_t numTris, NrmT *nrms, size_t nodeBase, size_t numNodes) {
+      constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+      pol(range(numNodes), [nrms](size_t i) { nrms[i][0] = nrms[i][1] = nrms[i][2] = 0; });
+      pol(range(numTris), [nodes, tris, nrms, nodeBase, execTag = wrapv<space>{}](size_t t) {
+        const auto &tri = tris[t];
+        const auto &a = nodes[tri[0]];
+        const auto &b = nodes[tri[1]];
+        const auto &c = nodes[tri[2]];
+        zs::vec<float, 3> e0{(float)(b[0] - a[0]), (float)(b[1] - a[1]), (float)(b[2] - a[2])};
+        zs::vec<float, 3> e1{(float)(c[0] - a[0]), (float)(c[1] - a[1]), (float)(c[2] - a[2])};
+        auto n = cross(e0, e1);
+        for (int j = 0; j != 3; ++j) {
+          auto &n_i = nrms[(size_t)tri[j] - nodeBase];
+          for (int d = 0; d != 3; ++d) atomic_add(execTag, &n_i[d], n[d]);
+        }
+      });
+      pol(range(numNodes), [nrms](size_t i) {
+        auto &nrm = nrms[i];
+        const auto len = zs::vec<float, 3>{nrm[0], nrm[1], nrm[2]}.norm();
+        if (len > 0)
+          for (int d = 0; d != 3; ++d) nrm[d] /= len;
+      });
+    }
+
+    /// appends to the node, element (and for triangle meshes, normal and uv) arrays of a Mesh
+    template <typename MeshT> struct mesh_sink {
+      using value_type = typename MeshT::value_type;
+      using index_type = typename MeshT::index_type;
+      struct writer_t {
+        typename MeshT::Node *nodes;
+        typename MeshT::Elem *elems;
+        typename MeshT::Norm *norms;
+        typename MeshT::UV *uvs;
+        size_t nodeBase;
+        bool wants_normals() const noexcept { return norms != nullptr; }
+        bool wants_uvs() const noexcept { return uvs != nullptr; }
+        void set_position(size_t i, int d, double v) noexcept {
+          if (d < MeshT::dim) nodes[i][d] = (value_type)v;
+        }
+        void set_index(size_t e, int j, i64 id) noexcept {
+          elems[e][j] = (index_type)(id + (i64)nodeBase);
+        }
+        void set_normal(size_t i, int d, float v) noexcept { norms[i][d] = v; }
+        void set_uv(size_t i, int d, float v) noexcept { uvs[i][d] = v; }
+      };
+
+      MeshT &mesh;
+      bool attributes;
+      size_t nodeBase{0}, elemBase{0};
+      bool allocated{false};
+
+      constexpr int arity() const noexcept { return MeshT::dim_elem; }
+      writer_t allocate(const mesh_file_info &info) {
+        nodeBase = mesh.nodes.size();
+        elemBase = mesh.elems.size();
+        allocated = true;
+        mesh.nodes.resize(nodeBase + info.numNodes);
+        mesh.elems.resize(elemBase + info.numElems);
+        writer_t writer{mesh.nodes.data() + nodeBase, mesh.elems.data() + elemBase, nullptr,
+                        nullptr, nodeBase};
+        if (attributes) {
+          mesh.norms.resize(nodeBase + info.numNodes);
+          mesh.uvs.resize(nodeBase + info.numNodes);
+          writer.norms = mesh.norms.data() + nodeBase;
+          writer.uvs = mesh.uvs.data() + nodeBase;
+        }
+        return writer;
+      }
+      /// drops whatever a failed parse appended
+      void discard() {
+        if (!allocated) return;
+        mesh.nodes.resize(nodeBase);
+        mesh.elems.resize(elemBase);
+        if (attributes) {
+          mesh.norms.resize(std::min(mesh.norms.size(), nodeBase));
+          mesh.uvs.resize(std::min(mesh.uvs.size(), nodeBase));
+        }
+      }
+    };
+
+    /// appends to a vertex and an element TileVector, indices are stored bit-cast to integers
+    template <execspace_e space, typename TileVectorT> struct tile_vector_mesh_sink {
+      using value_type = typename TileVectorT::value_type;
+      using index_type = conditional_t<sizeof(value_type) == 8, i64, i32>;
+      using view_t = RM_CVREF_T(proxy<space>(declval<TileVectorT &>()));
+      struct writer_t {
+        view_t verts, elems;
+        PropertyHandle pos, inds, nrm, uv;
+        size_t nodeBase, elemBase;
+        bool wants_normals() const noexcept { return nrm.valid(); }
+        bool wants_uvs() const noexcept { return uv.valid(); }
+        void set_position(size_t i, int d, double v) {
+          if (d < pos.extent) verts(pos, d, nodeBase + i) = (value_type)v;
+        }
+        void set_index(size_t e, int j, i64 id) {
+          elems(inds, j, elemBase + e, wrapt<index_type>{}) = (index_type)(id + (i64)nodeBase);
+        }
+        void set_normal(size_t i, int d, float v) { verts(nrm, d, nodeBase + i) = (value_type)v; }
+        void set_uv(size_t i, int d, float v) { verts(uv, d, nodeBase + i) = (value_type)v; }
+      };
+
+      TileVectorT &verts, &elems;
+      PropertyHandle pos, inds, nrm, uv;
+      size_t nodeBase{0}, elemBase{0};
+      bool allocated{false};
+
+      int arity() const noexcept { return inds.extent; }
+      writer_t allocate(const mesh_file_info &info) {
+        nodeBase = verts.size();
+        elemBase = elems.size();
+        allocated = true;
+        verts.resize(nodeBase + info.numNodes);
+        elems.resize(elemBase + info.numElems);
+        return writer_t{proxy<space>(verts), proxy<space>(elems), pos, inds, nrm, uv,
+                        nodeBase, elemBase};
+      }
+      void discard() {
+        if (!allocated) return;
+        verts.resize(nodeBase);
+        elems.resize(elemBase);
+      }
+    };
+
+    /// reads the nodes, elements and (when complete) normals and uvs of a Mesh
+    template <typename MeshT> struct mesh_source {
+      using value_type = typename MeshT::value_type;
+      static_assert(is_floating_point_v<value_type>, "mesh positions should be reals");
+
+      const MeshT &mesh;
+
+      size_t num_nodes() const noexcept { return mesh.nodes.size(); }
+      size_t num_elems() const noexcept { return mesh.elems.size(); }
+      constexpr int dim() const noexcept { return MeshT::dim; }
+      constexpr int arity() const noexcept { return MeshT::dim_elem; }
+      bool has_normals() const noexcept {
+        return num_nodes() != 0 && mesh.norms.size() == num_nodes();
+      }
+      bool has_uvs() const noexcept { return num_nodes() != 0 && mesh.uvs.size() == num_nodes(); }
+      value_type position(size_t i, int d) const noexcept { return mesh.nodes[i][d]; }
+      i64 index(size_t e, int j) const noexcept { return (i64)mesh.elems[e][j]; }
+      float normal(size_t i, int d) const noexcept { return mesh.norms[i][d]; }
+      float uv(size_t i, int d) const noexcept { return mesh.uvs[i][d]; }
+    };
+
+    /// reads a vertex and an element TileVector, the layout of tile_vector_mesh_sink
+    template <execspace_e space, typename TileVectorT> struct tile_vector_mesh_source {
+      using value_type = typename TileVectorT::value_type;
+      using index_type = conditional_t<sizeof(value_type) == 8, i64, i32>;
+      using view_t = RM_CVREF_T(proxy<space>(declval<const TileVectorT &>()));
+      static_assert(is_floating_point_v<value_type>, "tilevector values should be reals");
+
+      view_t verts, elems;
+      PropertyHandle pos, inds, nrms, uvs;
+      size_t numNodes, numElems;
+
+      size_t num_nodes() const noexcept { return numNodes; }
+      size_t num_elems() const noexcept { return numElems; }
+      int dim() const noexcept { return pos.extent; }
+      int arity() const noexcept { return inds.extent; }
+      bool has_normals() const noexcept { return nrms.valid(); }
+      bool has_uvs() const noexcept { return uvs.valid(); }
+      value_type position(size_t i, int d) const { return verts(pos, d, i); }
+      i64 index(size_t e, int j) const { return (i64)elems(inds, j, e, wrapt<index_type>{}); }
+      float normal(size_t i, int d) const { return (float)verts(nrms, d, i); }
+      float uv(size_t i, int d) const { return (float)verts(uvs, d, i); }
+    };
+
+    /// @brief writes [src] in [format] to [out]
+    template <typename Policy, typename Source>
+    void write_mesh_stream(Policy &&pol, ByteStream &out, mesh_file_e format, const Source &src,
+                           bool binary, size_t chunkBytes) {
+      if (!out.is_writable()) throw std::runtime_error("output stream not writable");
+      switch (format) {
+        case mesh_file_e::obj:
+          if (binary) throw std::runtime_error("obj has no binary encoding");
+          emit_obj(pol, out, src, chunkBytes);
+          break;
+        case mesh_file_e::vtk:
+          emit_vtk(pol, out, src, binary, chunkBytes);
+          break;
+        case mesh_file_e::ply:
+          emit_ply(pol, out, src, binary, chunkBytes);
+          break;
+        default:
+          throw std::runtime_error("unrecognized mesh file format");
+      }
+      if (!out.flush()) throw std::runtime_error("failed to flush the output stream");
+    }
+    /// @brief creates (or truncates) [file] and writes [src] in the format of its extension
+    template <typename Policy, typename Source>
+    void write_mesh_file(Policy &&pol, const std::string &file, const Source &src, bool binary,
+                         size_t chunkBytes) {
+      const auto format = mesh_file_format(file);
+      if (format == mesh_file_e::unknown)
+        throw std::runtime_error("unrecognized mesh file extension");
+      FileStream out{file, FileOpenMode::write};
+      if (!out.is_open()) throw std::runtime_error("failed to create file");
+      write_mesh_stream(pol, out, format, src, binary, chunkBytes);
+    }
+
+  }  // namespace detail
+
+  /// @brief appends the nodes and elements of an obj, ply (ascii or binary) or legacy vtk (ascii
+  /// or binary) file to [mesh], parsing in parallel under [pol]
+  /// @note obj and ply faces are fan-triangulated (dimE must be 3), their normals and uvs are
+  /// loaded as well, normals being computed from the triangles when the file has none. vtk cells
+  /// must all have dimE vertices. Returns false (with [mesh] unchanged) on failure.
+  template <typename Policy, typename T, int dim, typename Tn, int dimE>
+  bool read_mesh(Policy &&pol, const std::string &file, Mesh<T, dim, Tn, dimE> &mesh,
+                 size_t chunkBytes = detail::s_mesh_chunk_bytes) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    static_assert(space == execspace_e::host || space == execspace_e::openmp,
+                  "mesh loading is only available for host execution policies.");
+    detail::mesh_sink<Mesh<T, dim, Tn, dimE>> sink{mesh, dimE == 3};
+    const size_t nodeBase = mesh.nodes.size(), elemBase = mesh.elems.size();
+    try {
+      const auto info = detail::read_mesh_file(pol, file, sink, chunkBytes);
+      if constexpr (dim == 3 && dimE == 3)
+        if (!info.hasNormals)
+          detail::accumulate_vertex_normals(pol, mesh.nodes.data(), mesh.elems.data() + elemBase,
+                                            info.numElems, mesh.norms.data() + nodeBase,
+                                            nodeBase, info.numNodes);
+    } catch (const std::exception &e) {
+      sink.discard();
+      fprintf(stderr, "failed to read mesh %s: %s\n", file.c_str(), e.what());
+      return false;
+    }
+    return true;
+  }
+
+  /// @brief appends the nodes of a mesh file to [verts] and its elements to [elems]
+  /// @note positions go to [posTag], element indices (bit-cast to an integer of the value size)
+  /// to [indsTag], whose channel count sets the element arity. "nrm" (3 channels) and "uv" (2
+  /// channels) of [verts] are filled from the file when present (zeros otherwise).
+  template <typename Policy, typename T, size_t Length, typename Allocator>
+  bool read_mesh(Policy &&pol, const std::string &file, TileVector<T, Length, Allocator> &verts,
+                 TileVector<T, Length, Allocator> &elems, const SmallString &posTag = "x",
+                 const SmallString &indsTag = "inds",
+                 size_t chunkBytes = detail::s_mesh_chunk_bytes) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    static_assert(space == execspace_e::host || space == execspace_e::openmp,
+                  "mesh loading is only available for host execution policies.");
+    using TV = TileVector<T, Length, Allocator>;
+    const auto optional_property = [&verts](const char *tag, int extent) {
+      return verts.hasProperty(tag) && verts.getPropertySize(tag) == extent
+                 ? verts.getPropertyHandle(tag)
+                 : PropertyHandle{};
+    };
+    const auto nrm = optional_property("nrm", 3), uv = optional_property("uv", 2);
+    detail::tile_vector_mesh_sink<space, TV> sink{verts,
+                                                  elems,
+                                                  verts.getPropertyHandle(posTag),
+                                                  elems.getPropertyHandle(indsTag),
+                                                  nrm,
+                                                  uv};
+    try {
+      if (!valid_memspace_for_execution(pol, verts.get_allocator())
+          || !valid_memspace_for_execution(pol, elems.get_allocator()))
+        throw std::runtime_error("tilevector memory not accessible by the execution policy");
+      if (!sink.pos.valid() || !sink.inds.valid())
+        throw std::runtime_error("position or index property missing");
+      detail::read_mesh_file(pol, file, sink, chunkBytes);
+    } catch (const std::exception &e) {
+      sink.discard();
+      fprintf(stderr, "failed to read mesh %s: %s\n", file.c_str(), e.what());
+      return false;
+    }
+    return true;
+  }
+
   template <typename T, int dim, typename Tn>
   bool read_tri_mesh_obj(const std::string &file, Mesh<T, dim, Tn, 3> &mesh) {
     auto nV = mesh.nodes.size();
     auto nE = mesh.elems.size();
-    bool ret = load_obj(file, &mesh.nodes, &mesh.norms, &mesh.uvs, &mesh.elems);
+    bool ret = read_mesh(detail::default_mesh_io_policy(), file, mesh);
     printf("mesh append: pos, tri [%zd, %zd] -> [%zd, %zd]\n", nV, nE, mesh.nodes.size(),
            mesh.elems.size());
     return ret;
@@ -31,136 +369,131 @@ namespace zs {
 
   template <typename T, typename Tn>
   bool read_tet_mesh_vtk(const std::string &file, Mesh<T, 3, Tn, 4> &mesh) {
-    // TetMesh
-    std::ifstream in(file);
-    if (!in || file.empty()) {
-      printf("%s not found!\n", file.c_str());
+    auto nV = mesh.nodes.size();
+    auto nE = mesh.elems.size();
+    bool ret = read_mesh(detail::default_mesh_io_policy(), file, mesh);
+    printf("positions, tetrahedra [%d, %d] -> [%d, %d]\n", (int)nV, (int)nE,
+           (int)mesh.nodes.size(), (int)mesh.elems.size());
+    return ret;
+  }
+
+
+  /// @brief writes [mesh] to [out] as an obj, a legacy vtk unstructured grid or a ply file,
+  /// formatting chunks of records in parallel under [pol]
+  /// @note [binary] selects binary vtk (big endian) or ply (little endian), obj is text only.
+  /// Normals and uvs are written (obj, ply) when there is one per node. Returns false on failure.
+  template <typename Policy, typename T, int dim, typename Tn, int dimE>
+  bool write_mesh(Policy &&pol, ByteStream &out, mesh_file_e format,
+                  const Mesh<T, dim, Tn, dimE> &mesh, bool binary = false,
+                  size_t chunkBytes = detail::s_mesh_chunk_bytes) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    static_assert(space == execspace_e::host || space == execspace_e::openmp,
+                  "mesh writing is only available for host execution policies.");
+    try {
+      detail::write_mesh_stream(pol, out, format,
+                                detail::mesh_source<Mesh<T, dim, Tn, dimE>>{mesh}, binary,
+                                chunkBytes);
+    } catch (const std::exception &e) {
+      fprintf(stderr, "failed to write mesh: %s\n", e.what());
       return false;
     }
-
-    using Node = typename Mesh<T, 3, Tn, 4>::Node;
-    using Elem = typename Mesh<T, 3, Tn, 4>::Elem;
-    auto &X = mesh.nodes;
-    auto &indices = mesh.elems;
-
-    Tn initial_X_size = X.size();
-    Tn initial_indices_size = indices.size();
-
-    std::string line;
-    Node position;
-
-    bool reading_points = false;
-    bool reading_tets = false;
-    size_t n_points = 0;
-    size_t n_tets = 0;
-
-    while (std::getline(in, line)) {
-      std::stringstream ss(line);
-      if (line.size() == (size_t)(0)) {
-      } else if (line.substr(0, 6) == "POINTS") {
-        reading_points = true;
-        reading_tets = false;
-        ss.ignore(128, ' ');  // ignore "POINTS"
-        ss >> n_points;
-      } else if (line.substr(0, 5) == "CELLS") {
-        reading_points = false;
-        reading_tets = true;
-        ss.ignore(128, ' ');  // ignore "CELLS"
-        ss >> n_tets;
-      } else if (line.substr(0, 10) == "CELL_TYPES") {
-        reading_points = false;
-        reading_tets = false;
-      } else if (reading_points) {
-        for (int i = 0; i < 3; i++) ss >> position[i];
-        X.emplace_back(position);
-      } else if (reading_tets) {
-        ss.ignore(128, ' ');  // ignore "4"
-        Elem tet;
-        for (int i = 0; i < 4; i++) {
-          ss >> tet[i];
-          tet[i] += initial_X_size;
-        }
-        indices.emplace_back(tet);
-      }
+    return true;
+  }
+  /// @brief writes [mesh] to [file] in the format given by its extension
+  template <typename Policy, typename T, int dim, typename Tn, int dimE>
+  bool write_mesh(Policy &&pol, const std::string &file, const Mesh<T, dim, Tn, dimE> &mesh,
+                  bool binary = false, size_t chunkBytes = detail::s_mesh_chunk_bytes) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    static_assert(space == execspace_e::host || space == execspace_e::openmp,
+                  "mesh writing is only available for host execution policies.");
+    try {
+      detail::write_mesh_file(pol, file, detail::mesh_source<Mesh<T, dim, Tn, dimE>>{mesh},
+                              binary, chunkBytes);
+    } catch (const std::exception &e) {
+      fprintf(stderr, "failed to write mesh %s: %s\n", file.c_str(), e.what());
+      return false;
     }
-    in.close();
+    return true;
+  }
 
-    assert((n_points == X.size() - initial_X_size) && "vtk read X count doesn't match.");
-    assert((n_tets == indices.size() - initial_indices_size)
-           && "vtk read element count doesn't match.");
-    printf("positions, tetrahedra [%d, %d] -> [%d, %d]\n", initial_X_size, initial_indices_size,
-           (int)X.size(), (int)indices.size());
+  /// @brief writes the nodes of [verts] and the elements of [elems] to [file]
+  /// @note the layout is that of read_mesh: positions in [posTag], element indices (bit-cast to
+  /// an integer of the value size) in [indsTag], and "nrm" (3 channels) and "uv" (2 channels) of
+  /// [verts] when present.
+  template <typename Policy, typename T, size_t Length, typename Allocator>
+  bool write_mesh(Policy &&pol, const std::string &file,
+                  const TileVector<T, Length, Allocator> &verts,
+                  const TileVector<T, Length, Allocator> &elems, const SmallString &posTag = "x",
+                  const SmallString &indsTag = "inds", bool binary = false,
+                  size_t chunkBytes = detail::s_mesh_chunk_bytes) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    static_assert(space == execspace_e::host || space == execspace_e::openmp,
+                  "mesh writing is only available for host execution policies.");
+    using TV = TileVector<T, Length, Allocator>;
+    const auto optional_property = [&verts](const char *tag, int extent) {
+      return verts.hasProperty(tag) && verts.getPropertySize(tag) == extent
+                 ? verts.getPropertyHandle(tag)
+                 : PropertyHandle{};
+    };
+    try {
+      if (!valid_memspace_for_execution(pol, verts.get_allocator())
+          || !valid_memspace_for_execution(pol, elems.get_allocator()))
+        throw std::runtime_error("tilevector memory not accessible by the execution policy");
+      if (!verts.hasProperty(posTag) || !elems.hasProperty(indsTag))
+        throw std::runtime_error("position or index property missing");
+      detail::tile_vector_mesh_source<space, TV> src{proxy<space>(verts),
+                                                     proxy<space>(elems),
+                                                     verts.getPropertyHandle(posTag),
+                                                     elems.getPropertyHandle(indsTag),
+                                                     optional_property("nrm", 3),
+                                                     optional_property("uv", 2),
+                                                     verts.size(),
+                                                     elems.size()};
+      detail::write_mesh_file(pol, file, src, binary, chunkBytes);
+    } catch (const std::exception &e) {
+      fprintf(stderr, "failed to write mesh %s: %s\n", file.c_str(), e.what());
+      return false;
+    }
     return true;
   }
 
+  /// @brief queues the export of [mesh] to [file] on the zs::IO worker
+  /// @note the mesh is taken by value (move it in to avoid the copy), so the caller may go on
+  /// modifying its own. The future reports the result of write_mesh.
+  template <typename T, int dim, typename Tn, int dimE>
+  std::future<bool> write_mesh_async(std::string file, Mesh<T, dim, Tn, dimE> mesh,
+                                     bool binary = false) {
+    auto job = std::make_shared<std::packaged_task<bool()>>(
+        [file = std::move(file), mesh = std::move(mesh), binary]() {
+          return write_mesh(detail::default_mesh_io_policy(), file, mesh, binary);
+        });
+    auto ret = job->get_future();
+    IO::insert_job([job]() { (*job)(); });
+    return ret;
+  }
+
   template <typename T, int dim, typename Tn>
   bool write_tri_mesh_obj(const std::string &filename, const Mesh<T, dim, Tn, 3> &mesh) {
-    std::ofstream out(filename.c_str(), std::ios::out);
-    if (!out) {
+    FileStream out{filename, FileOpenMode::write};
+    if (!out.is_open()) {
       printf("failed to create file %s\n", filename.c_str());
       return false;
     }
-    const auto &nodes = mesh.nodes;
-    const auto &faces = mesh.elems;
-    for (const auto &node : nodes) {
-      out << "v";
-      for (int d = 0; d < dim; ++d) out << " " << node[d];
-      if constexpr (dim == 2)
-        out << " 0\n";
-      else if constexpr (dim == 3)
-        out << '\n';
-    }
-    out << "\n";
-    for (const auto &face : faces)
-      out << "f " << face[0] + 1 << " " << face[1] + 1 << " " << face[2] + 1 << "\n";
-
-    out.close();
-    printf("done writing to %s\n", filename.c_str());
-    return true;
+    bool ret = write_mesh(detail::default_mesh_io_policy(), out, mesh_file_e::obj, mesh);
+    if (ret) printf("done writing to %s\n", filename.c_str());
+    return ret;
   }
 
   template <typename T, typename Tn>
   bool write_tet_mesh_vtk(const std::string &filename, const Mesh<T, 3, Tn, 4> &mesh) {
-    assert((mesh.nodes.size() != (size_t)0) && "The X array for writing tetmesh vtk is empty.");
-    assert((mesh.elems.size() != (size_t)0)
-           && "The tet mesh data structure for writing tetmesh vtk is empty.");
-
-    std::ofstream os(filename);
-    if (!os) {
+    FileStream out{filename, FileOpenMode::write};
+    if (!out.is_open()) {
       printf("failed to create file %s\n", filename.c_str());
       return false;
     }
-
-    using Node = typename Mesh<T, 3, Tn, 4>::Node;
-    using Elem = typename Mesh<T, 3, Tn, 4>::Elem;
-    auto &X = mesh.nodes;
-    auto &indices = mesh.elems;
-
-    os << "# vtk DataFile Version 2.0\n";
-    os << "Unstructured Grid\n";
-    os << "ASCII\n";
-    os << "DATASET UNSTRUCTURED_GRID\n";
-
-    os << "POINTS " << X.size() << " ";
-    if (std::is_same<T, float>::value)
-      os << "float\n";
-    else
-      os << "double\n";
-
-    for (const auto &x : X) os << x[0] << " " << x[1] << " " << x[2] << "\n";
-    os << "\n";
-
-    os << "CELLS " << indices.size() << " " << 5 * indices.size() << "\n";
-    for (const auto &m : indices)
-      os << 4 << " " << m[0] << " " << m[1] << " " << m[2] << " " << m[3] << "\n";
-    os << "\n";
-
-    os << "CELL_TYPES " << indices.size() << "\n";
-    for (int i = 0; i < indices.size(); i++) os << 10 << "\n";
-
-    os.close();
-    printf("done writing to %s\n", filename.c_str());
-    return true;
+    bool ret = write_mesh(detail::default_mesh_io_policy(), out, mesh_file_e::vtk, mesh);
+    if (ret) printf("done writing to %s\n", filename.c_str());
+    return ret;
   }
 
 }  // namespace zs
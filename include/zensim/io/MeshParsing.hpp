@@ -0,0 +1,1099 @@
+#pragma once
+/// @file MeshParsing.hpp
+/// @brief Chunked, parallel parsers for obj, legacy vtk and ply meshes held in memory.
+///
+/// The whole file is expected to be addressable (typically a MappedFile). Text formats are split
+/// into line (or token) aligned chunks that are counted in a first parallel pass, prefix-summed,
+/// then parsed in a second parallel pass straight into the destination storage. Binary layouts
+/// are decoded element-wise.
+///
+/// Parsers write through a sink:
+/// @code
+///   struct Sink {
+///     int arity() const;                         // indices per destination element
+///     Writer allocate(const mesh_file_info &);   // called once, before any write
+///   };
+///   struct Writer {
+///     bool wants_normals() const;
+///     bool wants_uvs() const;
+///     void set_position(size_t node, int d, double v);
+///     void set_index(size_t elem, int j, i64 node);  // file-relative node index
+///     void set_normal(size_t node, int d, float v);
+///     void set_uv(size_t node, int d, float v);
+///   };
+/// @endcode
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "zensim/execution/Atomics.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+
+namespace zs {
+
+  /// @brief summary of a mesh file, handed to the sink before anything is written
+  struct mesh_file_info {
+    size_t numNodes{0}, numElems{0};
+    bool hasNormals{false}, hasUvs{false};
+  };
+
+  namespace detail {
+
+    constexpr size_t s_mesh_chunk_bytes = (size_t)1 << 20;
+
+    constexpr bool text_is_blank(char c) noexcept { return c == ' ' || c == '\t' || c == '\r'; }
+    constexpr bool text_is_space(char c) noexcept {
+      return text_is_blank(c) || c == '\n' || c == '\v' || c == '\f';
+    }
+    constexpr bool text_is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+    inline const char *skip_text_blanks(const char *p, const char *end) noexcept {
+      while (p != end && text_is_blank(*p)) ++p;
+      return p;
+    }
+    inline const char *skip_text_spaces(const char *p, const char *end) noexcept {
+      while (p != end && text_is_space(*p)) ++p;
+      return p;
+    }
+    inline const char *text_token_end(const char *p, const char *end) noexcept {
+      while (p != end && !text_is_space(*p)) ++p;
+      return p;
+    }
+    /// position of the '\n' ending the line at [p], or [end]
+    inline const char *text_line_end(const char *p, const char *end) noexcept {
+      auto nl = static_cast<const char *>(std::memchr(p, '\n', (size_t)(end - p)));
+      return nl ? nl : end;
+    }
+    inline const char *text_next_line(const char *p, const char *end) noexcept {
+      p = text_line_end(p, end);
+      return p == end ? end : p + 1;
+    }
+    /// whitespace separated words of a (header) line
+    inline std::vector<std::string_view> split_text_words(const char *p, const char *end) {
+      std::vector<std::string_view> words;
+      for (p = skip_text_spaces(p, end); p != end; p = skip_text_spaces(p, end)) {
+        const char *e = text_token_end(p, end);
+        words.emplace_back(p, (size_t)(e - p));
+        p = e;
+      }
+      return words;
+    }
+
+    /// @brief parses a decimal real at [p] (leading blanks are skipped)
+    /// @note significands of at most 53 bits scaled by 10^[-22, 22] are exact in double
+    /// arithmetic (Clinger's fast path). Longer significands, larger exponents, nan and inf go
+    /// through strtod.
+    /// @return the position past the number, nullptr if there is none
+    inline const char *parse_real_text(const char *p, const char *end, double &out) {
+      constexpr double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                  1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                  1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+      p = skip_text_blanks(p, end);
+      const char *const start = p;
+      bool neg = false;
+      if (p != end && (*p == '-' || *p == '+')) neg = *p++ == '-';
+      u64 mant = 0;
+      int numDigits = 0, exp10 = 0;
+      const char *digits = p;
+      for (; p != end && text_is_digit(*p); ++p)
+        if (numDigits < 19) {
+          mant = mant * 10 + (u64)(*p - '0');
+          numDigits += mant != 0;
+        } else
+          ++exp10;
+      bool any = p != digits;
+      if (p != end && *p == '.') {
+        digits = ++p;
+        for (; p != end && text_is_digit(*p); ++p)
+          if (numDigits < 19) {
+            mant = mant * 10 + (u64)(*p - '0');
+            numDigits += mant != 0;
+            --exp10;
+          }
+        any |= p != digits;
+      }
+      if (any && p != end && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+        bool negExp = false;
+        if (q != end && (*q == '-' || *q == '+')) negExp = *q++ == '-';
+        if (q != end && text_is_digit(*q)) {
+          int e = 0;
+          for (; q != end && text_is_digit(*q); ++q)
+            if (e < 100000) e = e * 10 + (*q - '0');
+          exp10 += negExp ? -e : e;
+          p = q;
+        }
+      }
+      if (any && (mant == 0 || (mant <= ((u64)1 << 53) && exp10 >= -22 && exp10 <= 22))) {
+        double v = (double)mant;
+        if (mant != 0) v = exp10 < 0 ? v / pow10[-exp10] : v * pow10[exp10];
+        out = neg ? -v : v;
+        return p;
+      }
+      /// slow path on a null-terminated copy of the token
+      const size_t len = (size_t)(text_token_end(start, end) - start);
+      char buf[128];
+      std::string longToken;
+      const char *s = buf;
+      if (len < sizeof(buf)) {
+        std::memcpy(buf, start, len);
+        buf[len] = '\0';
+      } else {
+        longToken.assign(start, len);
+        s = longToken.c_str();
+      }
+      char *stop = nullptr;
+      out = std::strtod(s, &stop);
+      if (stop == s) return nullptr;
+      return start + (stop - s);
+    }
+
+    /// @return the position past the integer, nullptr if there is none
+    inline const char *parse_integer_text(const char *p, const char *end, i64 &out) noexcept {
+      p = skip_text_blanks(p, end);
+      bool neg = false;
+      if (p != end && (*p == '-' || *p == '+')) neg = *p++ == '-';
+      const char *digits = p;
+      i64 v = 0;
+      for (; p != end && text_is_digit(*p); ++p) v = v * 10 + (i64)(*p - '0');
+      if (p == digits) return nullptr;
+      out = neg ? -v : v;
+      return p;
+    }
+
+    /// @brief boundaries 0 = o_0 < o_1 < ... < o_n = size of chunks of about [chunkBytes] each,
+    /// every o_i (0 < i < n) starts a line
+    inline std::vector<size_t> line_aligned_chunks(const char *data, size_t size,
+                                                   size_t chunkBytes) {
+      std::vector<size_t> bounds{0};
+      if (chunkBytes == 0) chunkBytes = 1;
+      for (size_t next = chunkBytes; next < size; next = bounds.back() + chunkBytes) {
+        auto nl = static_cast<const char *>(std::memchr(data + next, '\n', size - next));
+        if (nl == nullptr || (size_t)(nl - data) + 1 == size) break;
+        bounds.push_back((size_t)(nl - data) + 1);
+      }
+      if (size) bounds.push_back(size);
+      return bounds;
+    }
+    /// @brief same as line_aligned_chunks, but o_i only needs to be a whitespace position
+    inline std::vector<size_t> token_aligned_chunks(const char *data, size_t size,
+                                                    size_t chunkBytes) {
+      std::vector<size_t> bounds{0};
+      if (chunkBytes == 0) chunkBytes = 1;
+      for (size_t next = chunkBytes; next < size; next = bounds.back() + chunkBytes) {
+        while (next < size && !text_is_space(data[next])) ++next;
+        if (next >= size) break;
+        bounds.push_back(next);
+      }
+      if (size) bounds.push_back(size);
+      return bounds;
+    }
+
+    /// @brief invokes f(tokenNo, tokenBegin, tokenEnd) in parallel on the first [limit]
+    /// whitespace separated tokens of [begin, end)
+    /// @return the total number of tokens
+    template <typename Policy, typename F>
+    size_t for_each_text_token(Policy &&pol, const char *begin, const char *end, size_t limit,
+                               size_t chunkBytes, F &&f) {
+      const auto bounds = token_aligned_chunks(begin, (size_t)(end - begin), chunkBytes);
+      const size_t nc = bounds.size() - 1;
+      if (nc == 0) return 0;
+      std::vector<size_t> offsets(nc + 1, 0);
+      pol(range(nc), [&](size_t c) {
+        size_t cnt = 0;
+        const char *e = begin + bounds[c + 1];
+        for (const char *p = skip_text_spaces(begin + bounds[c], e); p != e;
+             p = skip_text_spaces(text_token_end(p, e), e))
+          ++cnt;
+        offsets[c + 1] = cnt;
+      });
+      for (size_t c = 0; c != nc; ++c) offsets[c + 1] += offsets[c];
+      pol(range(nc), [&](size_t c) {
+        size_t t = offsets[c];
+        const char *e = begin + bounds[c + 1];
+        for (const char *p = skip_text_spaces(begin + bounds[c], e); p != e && t < limit; ++t) {
+          const char *te = text_token_end(p, e);
+          f(t, p, te);
+          p = skip_text_spaces(te, e);
+        }
+      });
+      return offsets[nc];
+    }
+
+    /// first failure reported from within a parallel pass (messages are string literals)
+    struct mesh_parse_status {
+      std::atomic<const char *> message{nullptr};
+      void fail(const char *msg) noexcept {
+        const char *expected = nullptr;
+        message.compare_exchange_strong(expected, msg);
+      }
+      void check() const {
+        if (const char *msg = message.load()) throw std::runtime_error(msg);
+      }
+    };
+
+    /// binary scalar types of ply and legacy vtk files
+    enum class mesh_scalar_e : unsigned char {
+      i8, u8, i16, u16, i32, u32, i64, u64, f32, f64, none
+    };
+
+    inline mesh_scalar_e mesh_scalar_from_name(std::string_view name) noexcept {
+      if (name == "char" || name == "int8") return mesh_scalar_e::i8;
+      if (name == "uchar" || name == "uint8" || name == "unsigned_char") return mesh_scalar_e::u8;
+      if (name == "short" || name == "int16") return mesh_scalar_e::i16;
+      if (name == "ushort" || name == "uint16" || name == "unsigned_short")
+        return mesh_scalar_e::u16;
+      if (name == "int" || name == "int32" || name == "vtktypeint32") return mesh_scalar_e::i32;
+      if (name == "uint" || name == "uint32" || name == "unsigned_int" || name == "vtktypeuint32")
+        return mesh_scalar_e::u32;
+      if (name == "int64" || name == "vtktypeint64" || name == "vtkIdType")
+        return mesh_scalar_e::i64;
+      if (name == "uint64" || name == "vtktypeuint64") return mesh_scalar_e::u64;
+      if (name == "float" || name == "float32") return mesh_scalar_e::f32;
+      if (name == "double" || name == "float64") return mesh_scalar_e::f64;
+      return mesh_scalar_e::none;
+    }
+    constexpr size_t mesh_scalar_bytes(mesh_scalar_e type) noexcept {
+      switch (type) {
+        case mesh_scalar_e::i8:
+        case mesh_scalar_e::u8:
+          return 1;
+        case mesh_scalar_e::i16:
+        case mesh_scalar_e::u16:
+          return 2;
+        case mesh_scalar_e::i32:
+        case mesh_scalar_e::u32:
+        case mesh_scalar_e::f32:
+          return 4;
+        case mesh_scalar_e::i64:
+        case mesh_scalar_e::u64:
+        case mesh_scalar_e::f64:
+          return 8;
+        default:
+          return 0;
+      }
+    }
+
+    inline bool host_is_big_endian() noexcept {
+      const u16 probe = 1;
+      unsigned char first;
+      std::memcpy(&first, &probe, 1);
+      return first == 0;
+    }
+    template <typename T> inline T load_binary_scalar(const char *p, bool bigEndian) noexcept {
+      unsigned char bytes[sizeof(T)];
+      std::memcpy(bytes, p, sizeof(T));
+      if (bigEndian != host_is_big_endian())
+        for (size_t i = 0; i != sizeof(T) / 2; ++i) {
+          const auto b = bytes[i];
+          bytes[i] = bytes[sizeof(T) - 1 - i];
+          bytes[sizeof(T) - 1 - i] = b;
+        }
+      T v;
+      std::memcpy(&v, bytes, sizeof(T));
+      return v;
+    }
+    template <typename T>
+    inline T load_binary_value(const char *p, mesh_scalar_e type, bool bigEndian) noexcept {
+      switch (type) {
+        case mesh_scalar_e::i8:
+          return (T)load_binary_scalar<i8>(p, bigEndian);
+        case mesh_scalar_e::u8:
+          return (T)load_binary_scalar<u8>(p, bigEndian);
+        case mesh_scalar_e::i16:
+          return (T)load_binary_scalar<i16>(p, bigEndian);
+        case mesh_scalar_e::u16:
+          return (T)load_binary_scalar<u16>(p, bigEndian);
+        case mesh_scalar_e::i32:
+          return (T)load_binary_scalar<i32>(p, bigEndian);
+        case mesh_scalar_e::u32:
+          return (T)load_binary_scalar<u32>(p, bigEndian);
+        case mesh_scalar_e::i64:
+          return (T)load_binary_scalar<i64>(p, bigEndian);
+        case mesh_scalar_e::u64:
+          return (T)load_binary_scalar<u64>(p, bigEndian);
+        case mesh_scalar_e::f32:
+          return (T)load_binary_scalar<float>(p, bigEndian);
+        case mesh_scalar_e::f64:
+          return (T)load_binary_scalar<double>(p, bigEndian);
+        default:
+          return (T)0;
+      }
+    }
+
+    ///
+    /// wavefront obj
+    ///
+    enum class obj_line_e : unsigned char { other, v, vn, vt, f };
+    /// classifies the line [p, le) and moves [p] past its keyword
+    inline obj_line_e classify_obj_line(const char *&p, const char *le) noexcept {
+      p = skip_text_blanks(p, le);
+      const auto keyword_end = [le](const char *q) { return q == le || text_is_blank(*q); };
+      if (p == le) return obj_line_e::other;
+      if (p[0] == 'v') {
+        if (keyword_end(p + 1)) return ++p, obj_line_e::v;
+        if (p[1] == 'n' && keyword_end(p + 2)) return p += 2, obj_line_e::vn;
+        if (p[1] == 't' && keyword_end(p + 2)) return p += 2, obj_line_e::vt;
+      } else if (p[0] == 'f' && keyword_end(p + 1))
+        return ++p, obj_line_e::f;
+      return obj_line_e::other;
+    }
+
+    /// @brief wavefront obj: positions, faces (fan triangulated), per-vertex normals and uvs
+    /// @note a vertex whose corners carry different normals (uvs) takes the ones of the last face
+    /// referencing it, independent of the chunking
+    template <typename Policy, typename Sink>
+    mesh_file_info parse_obj(Policy &&pol, const char *data, size_t size, Sink &sink,
+                             size_t chunkBytes = s_mesh_chunk_bytes) {
+      constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+      if (sink.arity() != 3)
+        throw std::runtime_error("obj: faces are loaded as triangles, element arity should be 3");
+
+      const auto bounds = line_aligned_chunks(data, size, chunkBytes);
+      const size_t nc = bounds.size() - 1;
+      /// v, vn, vt lines and triangles per chunk
+      std::vector<std::array<size_t, 4>> offsets(nc + 1, std::array<size_t, 4>{0, 0, 0, 0});
+      pol(range(nc), [&](size_t c) {
+        std::array<size_t, 4> cnt{0, 0, 0, 0};
+        const char *e = data + bounds[c + 1];
+        for (const char *p = data + bounds[c]; p != e;) {
+          const char *le = text_line_end(p, e);
+          switch (classify_obj_line(p, le)) {
+            case obj_line_e::v:
+              ++cnt[0];
+              break;
+            case obj_line_e::vn:
+              ++cnt[1];
+              break;
+            case obj_line_e::vt:
+              ++cnt[2];
+              break;
+            case obj_line_e::f: {
+              /// corners are delimited like tokens, i.e. by any whitespace ('\v' and '\f' too)
+              size_t corners = 0;
+              for (p = skip_text_spaces(p, le); p != le;
+                   p = skip_text_spaces(text_token_end(p, le), le))
+                ++corners;
+              if (corners > 2) cnt[3] += corners - 2;
+              break;
+            }
+            default:
+              break;
+          }
+          p = le == e ? e : le + 1;
+        }
+        offsets[c + 1] = cnt;
+      });
+      for (size_t c = 0; c != nc; ++c)
+        for (int k = 0; k != 4; ++k) offsets[c + 1][k] += offsets[c][k];
+
+      mesh_file_info info{};
+      info.numNodes = offsets[nc][0];
+      info.numElems = offsets[nc][3];
+      const size_t numNormals = offsets[nc][1], numUvs = offsets[nc][2];
+      info.hasNormals = numNormals != 0;
+      info.hasUvs = numUvs != 0;
+      auto writer = sink.allocate(info);
+
+      /// per-vertex attributes are resolved after all faces have voted
+      const bool readNormals = writer.wants_normals() && info.hasNormals;
+      const bool readUvs = writer.wants_uvs() && info.hasUvs;
+      std::vector<float> normals(readNormals ? numNormals * 3 : 0), uvs(readUvs ? numUvs * 2 : 0);
+      /// (face order + 1) << 32 | attribute index of the latest corner, 0 if none
+      std::vector<u64> normalOwners(readNormals ? info.numNodes : 0),
+          uvOwners(readUvs ? info.numNodes : 0);
+
+      const i64 numNodes = (i64)info.numNodes;
+      mesh_parse_status status{};
+      pol(range(nc), [&](size_t c) {
+        const auto execTag = wrapv<space>{};
+        size_t iv = offsets[c][0], ivn = offsets[c][1], ivt = offsets[c][2], it = offsets[c][3];
+        const char *e = data + bounds[c + 1];
+        for (const char *p = data + bounds[c]; p != e;) {
+          const char *le = text_line_end(p, e);
+          switch (classify_obj_line(p, le)) {
+            case obj_line_e::v: {
+              for (int d = 0; d != 3; ++d) {
+                double x = 0;
+                const char *q = parse_real_text(p, le, x);
+                if (q == nullptr) {
+                  status.fail("obj: malformed vertex position");
+                  break;
+                }
+                writer.set_position(iv, d, x);
+                p = q;
+              }
+              ++iv;
+              break;
+            }
+            case obj_line_e::vn: {
+              for (int d = 0; d != 3 && readNormals; ++d) {
+                double x = 0;
+                if (const char *q = parse_real_text(p, le, x))
+                  normals[ivn * 3 + d] = (float)x, p = q;
+                else
+                  status.fail("obj: malformed vertex normal");
+              }
+              ++ivn;
+              break;
+            }
+            case obj_line_e::vt: {
+              for (int d = 0; d != 2 && readUvs; ++d) {
+                double x = 0;
+                if (const char *q = parse_real_text(p, le, x))
+                  uvs[ivt * 2 + d] = (float)x, p = q;
+                else if (d == 0)
+                  status.fail("obj: malformed texture coordinate");
+              }
+              ++ivt;
+              break;
+            }
+            case obj_line_e::f: {
+              const u64 faceKey = (u64)(it + 1) << 32;
+              i64 first = 0, prev = 0;
+              int corner = 0;
+              /// 1-based, or relative to the attributes defined so far when negative
+              const auto resolve = [](i64 id, size_t defined) -> i64 {
+                return id > 0 ? id - 1 : id < 0 ? (i64)defined + id : (i64)-1;
+              };
+              for (p = skip_text_spaces(p, le); p != le; p = skip_text_spaces(p, le), ++corner) {
+                const char *te = text_token_end(p, le);
+                i64 vi = 0, ti = 0, ni = 0;
+                const char *q = parse_integer_text(p, te, vi);
+                if (q && q != te && *q == '/') {
+                  ++q;
+                  if (q != te && *q != '/') q = parse_integer_text(q, te, ti);
+                  if (q && q != te && *q == '/') q = parse_integer_text(q + 1, te, ni);
+                }
+                p = te;
+                vi = resolve(vi, iv);
+                if (q != te || vi < 0 || vi >= numNodes) {
+                  status.fail("obj: malformed face or missing vertex");
+                  vi = 0;
+                }
+                if (ni && readNormals) {
+                  ni = resolve(ni, ivn);
+                  if (ni >= 0 && (size_t)ni < numNormals)
+                    atomic_max(execTag, &normalOwners[vi], faceKey | (u64)ni);
+                  else
+                    status.fail("obj: face references a missing normal");
+                }
+                if (ti && readUvs) {
+                  ti = resolve(ti, ivt);
+                  if (ti >= 0 && (size_t)ti < numUvs)
+                    atomic_max(execTag, &uvOwners[vi], faceKey | (u64)ti);
+                  else
+                    status.fail("obj: face references a missing texture coordinate");
+                }
+                if (corner == 0)
+                  first = vi;
+                else if (corner >= 2) {
+                  writer.set_index(it, 0, first);
+                  writer.set_index(it, 1, prev);
+                  writer.set_index(it, 2, vi);
+                  ++it;
+                }
+                prev = vi;
+              }
+              break;
+            }
+            default:
+              break;
+          }
+          p = le == e ? e : le + 1;
+        }
+      });
+      status.check();
+
+      if (writer.wants_normals() || writer.wants_uvs())
+        pol(range(info.numNodes), [&](size_t v) {
+          if (writer.wants_normals()) {
+            const u64 key = readNormals ? normalOwners[v] : (u64)0;
+            const float *n = key ? &normals[(key & 0xffffffffu) * 3] : nullptr;
+            for (int d = 0; d != 3; ++d) writer.set_normal(v, d, n ? n[d] : 0.f);
+          }
+          if (writer.wants_uvs()) {
+            const u64 key = readUvs ? uvOwners[v] : (u64)0;
+            const float *t = key ? &uvs[(key & 0xffffffffu) * 2] : nullptr;
+            for (int d = 0; d != 2; ++d) writer.set_uv(v, d, t ? t[d] : 0.f);
+          }
+        });
+      return info;
+    }
+
+    ///
+    /// legacy vtk (UNSTRUCTURED_GRID, POLYDATA), ascii and binary, classic and 5.x cell layouts
+    ///
+    struct vtk_section {
+      const char *begin{nullptr}, *end{nullptr};
+      mesh_scalar_e type{mesh_scalar_e::none};
+      size_t count{0};
+      explicit operator bool() const noexcept { return begin != nullptr; }
+    };
+
+    /// @brief nodes from POINTS, elements from the first CELLS or POLYGONS section
+    /// @note all cells must have sink.arity() vertices
+    template <typename Policy, typename Sink>
+    mesh_file_info parse_vtk(Policy &&pol, const char *data, size_t size, Sink &sink,
+                             size_t chunkBytes = s_mesh_chunk_bytes) {
+      const char *const end = data + size;
+      const auto words_of
+          = [end](const char *p) { return split_text_words(p, text_line_end(p, end)); };
+
+      /// header: version, title, ASCII|BINARY
+      const char *p = data;
+      if (std::string_view(p, size).substr(0, 5) != "# vtk")
+        throw std::runtime_error("vtk: missing '# vtk DataFile' header");
+      p = text_next_line(text_next_line(p, end), end);
+      const auto format = words_of(p);
+      if (format.size() != 1 || (format[0] != "ASCII" && format[0] != "BINARY"))
+        throw std::runtime_error("vtk: expected ASCII or BINARY on the third line");
+      const bool binary = format[0] == "BINARY";
+      p = text_next_line(p, end);
+
+      /// locate sections, keywords start lines with an upper case letter
+      vtk_section points{}, cells{}, offsets{}, connectivity{};
+      size_t numCells = 0, cellsSize = 0;
+      /// counts of the latest cell-like header, and whether it is the one being loaded
+      size_t lastCount = 0, lastSize = 0;
+      bool loading = false, datasetFound = false;
+      const auto parse_count = [](std::string_view word) {
+        i64 v = -1;
+        if (parse_integer_text(word.data(), word.data() + word.size(), v) == nullptr || v < 0)
+          throw std::runtime_error("vtk: malformed section size");
+        return (size_t)v;
+      };
+      /// @return binary payload bytes following the keyword line, or -1 to stop
+      const auto visit = [&](const std::vector<std::string_view> &words, const char *body,
+                             const char *bodyEnd) -> i64 {
+        const auto &key = words[0];
+        const auto require_words = [&words](size_t n) {
+          if (words.size() < n) throw std::runtime_error("vtk: incomplete section header");
+        };
+        if (key == "DATASET") {
+          require_words(2);
+          if (words[1] != "UNSTRUCTURED_GRID" && words[1] != "POLYDATA")
+            throw std::runtime_error("vtk: only UNSTRUCTURED_GRID and POLYDATA are supported");
+          datasetFound = true;
+          return 0;
+        }
+        if (key == "POINTS") {
+          require_words(3);
+          points = vtk_section{body, bodyEnd, mesh_scalar_from_name(words[2]),
+                               parse_count(words[1])};
+          if (binary && points.type != mesh_scalar_e::f32 && points.type != mesh_scalar_e::f64)
+            throw std::runtime_error("vtk: binary points should be float or double");
+          return (i64)(points.count * 3 * mesh_scalar_bytes(points.type));
+        }
+        if (key == "CELLS" || key == "POLYGONS" || key == "VERTICES" || key == "LINES"
+            || key == "TRIANGLE_STRIPS") {
+          require_words(3);
+          lastCount = parse_count(words[1]);
+          lastSize = parse_count(words[2]);
+          loading = (key == "CELLS" || key == "POLYGONS") && !cells && !offsets;
+          if (loading) numCells = lastCount, cellsSize = lastSize;
+          /// 5.x files follow up with OFFSETS and CONNECTIVITY arrays
+          const char *next = skip_text_spaces(body, end);
+          if (std::string_view(next, (size_t)(end - next)).substr(0, 7) == "OFFSETS") return 0;
+          if (loading) cells = vtk_section{body, bodyEnd, mesh_scalar_e::i32, lastSize};
+          return (i64)(lastSize * 4);
+        }
+        if (key == "OFFSETS" || key == "CONNECTIVITY") {
+          require_words(2);
+          vtk_section section{body, bodyEnd, mesh_scalar_from_name(words[1]),
+                              key == "OFFSETS" ? lastCount : lastSize};
+          if (binary && section.type == mesh_scalar_e::none)
+            throw std::runtime_error("vtk: unsupported offsets/connectivity type");
+          if (loading) (key == "OFFSETS" ? offsets : connectivity) = section;
+          return (i64)(section.count * mesh_scalar_bytes(section.type));
+        }
+        if (key == "CELL_TYPES") {
+          require_words(2);
+          loading = false;
+          return (i64)(parse_count(words[1]) * 4);
+        }
+        /// attributes (POINT_DATA, CELL_DATA, FIELD) are not loaded
+        return -1;
+      };
+
+      /// 5.x METADATA blocks are text lines up to an empty one
+      const auto skip_metadata = [end](const char *q) {
+        while (q != end && skip_text_blanks(q, end) != text_line_end(q, end))
+          q = text_next_line(q, end);
+        return q;
+      };
+      if (binary) {
+        for (p = skip_text_spaces(p, end); p != end; p = skip_text_spaces(p, end)) {
+          const auto words = words_of(p);
+          const char *body = text_next_line(p, end);
+          if (words[0] == "METADATA") {
+            p = skip_metadata(body);
+            continue;
+          }
+          /// binary sections are addressed by their start and element count
+          const i64 bytes = visit(words, body, nullptr);
+          if (bytes < 0) break;
+          if ((size_t)bytes > (size_t)(end - body))
+            throw std::runtime_error("vtk: truncated binary section");
+          p = body + bytes;
+        }
+      } else {
+        const auto bounds = line_aligned_chunks(p, (size_t)(end - p), chunkBytes);
+        const size_t nc = bounds.size() - 1;
+        std::vector<std::vector<const char *>> chunkKeywords(nc);
+        pol(range(nc), [&](size_t c) {
+          const char *e = p + bounds[c + 1];
+          for (const char *q = p + bounds[c]; q != e; q = text_next_line(q, e)) {
+            const char *w = skip_text_blanks(q, e);
+            if (w != e && *w >= 'A' && *w <= 'Z') chunkKeywords[c].push_back(w);
+          }
+        });
+        std::vector<const char *> keywords;
+        for (auto &ks : chunkKeywords) keywords.insert(keywords.end(), ks.begin(), ks.end());
+        for (size_t k = 0; k != keywords.size(); ++k) {
+          const auto words = words_of(keywords[k]);
+          const char *body = text_next_line(keywords[k], end);
+          if (words[0] == "METADATA") {
+            for (const char *metaEnd = skip_metadata(body);
+                 k + 1 != keywords.size() && keywords[k + 1] < metaEnd;)
+              ++k;
+            continue;
+          }
+          const char *bodyEnd = k + 1 != keywords.size() ? keywords[k + 1] : end;
+          if (bodyEnd < body) bodyEnd = body;
+          if (visit(words, body, bodyEnd) < 0) break;
+        }
+      }
+      if (!datasetFound) throw std::runtime_error("vtk: missing DATASET");
+      if (!points) throw std::runtime_error("vtk: missing POINTS");
+
+      const int arity = sink.arity();
+      const bool modern = (bool)offsets;
+      if (modern && !connectivity) throw std::runtime_error("vtk: OFFSETS without CONNECTIVITY");
+      mesh_file_info info{};
+      info.numNodes = points.count;
+      info.numElems = modern ? (offsets.count ? offsets.count - 1 : 0) : cells ? numCells : 0;
+      if (modern ? connectivity.count != info.numElems * arity
+                 : cells && cellsSize != numCells * (arity + 1))
+        throw std::runtime_error("vtk: every cell should have as many vertices as the element");
+      auto writer = sink.allocate(info);
+
+      mesh_parse_status status{};
+      const i64 numNodes = (i64)info.numNodes;
+      const auto write_index = [&](size_t e, int j, i64 id) {
+        if (id < 0 || id >= numNodes) return status.fail("vtk: cell references a missing point");
+        writer.set_index(e, j, id);
+      };
+      /// visits the [count] integers of an index section
+      const auto for_each_index = [&](const vtk_section &s, auto &&f) {
+        if (binary) {
+          const size_t stride = mesh_scalar_bytes(s.type);
+          pol(range(s.count), [&, stride](size_t i) {
+            f(i, load_binary_value<i64>(s.begin + i * stride, s.type, true));
+          });
+        } else if (for_each_text_token(pol, s.begin, s.end, s.count, chunkBytes,
+                                       [&](size_t t, const char *b, const char *e) {
+                                         i64 v = 0;
+                                         if (parse_integer_text(b, e, v) != e)
+                                           status.fail("vtk: malformed integer");
+                                         f(t, v);
+                                       })
+                   != s.count)
+          status.fail("vtk: unexpected number of cell entries");
+      };
+
+      if (binary) {
+        const size_t stride = mesh_scalar_bytes(points.type);
+        pol(range(info.numNodes * 3), [&, stride](size_t i) {
+          const char *x = points.begin + i * stride;
+          writer.set_position(i / 3, (int)(i % 3), load_binary_value<double>(x, points.type, true));
+        });
+      } else if (for_each_text_token(pol, points.begin, points.end, info.numNodes * 3, chunkBytes,
+                                     [&](size_t t, const char *b, const char *e) {
+                                       double v = 0;
+                                       if (parse_real_text(b, e, v) != e)
+                                         status.fail("vtk: malformed point coordinate");
+                                       writer.set_position(t / 3, (int)(t % 3), v);
+                                     })
+                 != info.numNodes * 3)
+        status.fail("vtk: unexpected number of point coordinates");
+
+      if (modern) {
+        for_each_index(offsets, [&](size_t i, i64 v) {
+          if (v != (i64)i * arity) status.fail("vtk: cells should all have the element arity");
+        });
+        for_each_index(connectivity,
+                       [&](size_t t, i64 v) { write_index(t / arity, (int)(t % arity), v); });
+      } else if (cells) {
+        for_each_index(cells, [&](size_t t, i64 v) {
+          const size_t e = t / (arity + 1);
+          const int j = (int)(t % (arity + 1));
+          if (j == 0) {
+            if (v != arity) status.fail("vtk: cells should all have the element arity");
+          } else
+            write_index(e, j - 1, v);
+        });
+      }
+      status.check();
+      return info;
+    }
+
+    ///
+    /// ply (ascii, binary little and big endian)
+    ///
+    struct ply_property {
+      std::string_view name{};
+      mesh_scalar_e type{mesh_scalar_e::none}, countType{mesh_scalar_e::none};
+      bool isList{false};
+    };
+    struct ply_element {
+      std::string_view name{};
+      size_t count{0};
+      std::vector<ply_property> props{};
+      int find(std::initializer_list<std::string_view> names) const noexcept {
+        for (auto name : names)
+          for (size_t i = 0; i != props.size(); ++i)
+            if (!props[i].isList && props[i].name == name) return (int)i;
+        return -1;
+      }
+      bool hasList() const noexcept {
+        for (auto &prop : props)
+          if (prop.isList) return true;
+        return false;
+      }
+    };
+
+    /// @brief nodes from the "vertex" element (x, y, z and optionally nx, ny, nz and u, v),
+    /// fan-triangulated faces from the index list of the "face" element
+    template <typename Policy, typename Sink>
+    mesh_file_info parse_ply(Policy &&pol, const char *data, size_t size, Sink &sink,
+                             size_t chunkBytes = s_mesh_chunk_bytes) {
+      if (sink.arity() != 3)
+        throw std::runtime_error("ply: faces are loaded as triangles, element arity should be 3");
+      const char *const end = data + size;
+      const auto words_of
+          = [end](const char *p) { return split_text_words(p, text_line_end(p, end)); };
+
+      /// header
+      const char *p = data;
+      if (words_of(p) != std::vector<std::string_view>{"ply"})
+        throw std::runtime_error("ply: missing 'ply' magic");
+      int encoding = -1;  // 0: ascii, 1: little endian, 2: big endian
+      std::vector<ply_element> elements;
+      for (p = text_next_line(p, end);; p = text_next_line(p, end)) {
+        if (p == end) throw std::runtime_error("ply: missing end_header");
+        const auto words = words_of(p);
+        if (words.empty() || words[0] == "comment" || words[0] == "obj_info") continue;
+        if (words[0] == "end_header") break;
+        if (words[0] == "format" && words.size() >= 2) {
+          encoding = words[1] == "ascii"                  ? 0
+                     : words[1] == "binary_little_endian" ? 1
+                     : words[1] == "binary_big_endian"    ? 2
+                                                          : -1;
+        } else if (words[0] == "element" && words.size() >= 3) {
+          i64 count = -1;
+          parse_integer_text(words[2].data(), words[2].data() + words[2].size(), count);
+          if (count < 0) throw std::runtime_error("ply: malformed element count");
+          elements.push_back(ply_element{words[1], (size_t)count, {}});
+        } else if (words[0] == "property" && !elements.empty()) {
+          ply_property prop{};
+          if (words.size() >= 5 && words[1] == "list")
+            prop = ply_property{words[4], mesh_scalar_from_name(words[3]),
+                                mesh_scalar_from_name(words[2]), true};
+          else if (words.size() >= 3)
+            prop = ply_property{words[2], mesh_scalar_from_name(words[1]), mesh_scalar_e::none,
+                                false};
+          if (prop.type == mesh_scalar_e::none
+              || (prop.isList && prop.countType == mesh_scalar_e::none))
+            throw std::runtime_error("ply: unsupported property declaration");
+          elements.back().props.push_back(prop);
+        } else
+          throw std::runtime_error("ply: unrecognized header line");
+      }
+      if (encoding < 0) throw std::runtime_error("ply: unsupported format");
+      const char *const body = text_next_line(p, end);
+      const bool bigEndian = encoding == 2;
+
+      const ply_element *vertex = nullptr, *face = nullptr;
+      for (auto &el : elements)
+        if (el.name == "vertex")
+          vertex = &el;
+        else if (el.name == "face")
+          face = &el;
+      if (vertex == nullptr) throw std::runtime_error("ply: missing vertex element");
+      if (vertex->hasList()) throw std::runtime_error("ply: list properties on vertices");
+      const int xyz[3] = {vertex->find({"x"}), vertex->find({"y"}), vertex->find({"z"})};
+      const int nxyz[3] = {vertex->find({"nx"}), vertex->find({"ny"}), vertex->find({"nz"})};
+      const int uv[2]
+          = {vertex->find({"u", "s", "texture_u"}), vertex->find({"v", "t", "texture_v"})};
+      if (xyz[0] < 0 || xyz[1] < 0) throw std::runtime_error("ply: missing vertex positions");
+      int listProp = -1;
+      if (face) {
+        for (size_t i = 0; i != face->props.size(); ++i)
+          if (face->props[i].isList) {
+            if (listProp >= 0) throw std::runtime_error("ply: more than one list on faces");
+            listProp = (int)i;
+          }
+        if (listProp < 0) throw std::runtime_error("ply: faces without an index list");
+      }
+
+      mesh_file_info info{};
+      info.numNodes = vertex->count;
+      info.hasNormals = nxyz[0] >= 0 && nxyz[1] >= 0 && nxyz[2] >= 0;
+      info.hasUvs = uv[0] >= 0 && uv[1] >= 0;
+      const size_t numFaces = face ? face->count : 0;
+      const i64 numNodes = (i64)info.numNodes;
+      mesh_parse_status status{};
+
+      /// fan triangulation of a face with [k] corners, starting at triangle [it]
+      const auto emit_face = [&](auto &writer, size_t it, i64 k, auto &&corner) {
+        i64 first = 0, prev = 0;
+        for (i64 j = 0; j != k; ++j) {
+          i64 vi = corner(j);
+          if (vi < 0 || vi >= numNodes) {
+            status.fail("ply: face references a missing vertex");
+            vi = 0;
+          }
+          if (j == 0)
+            first = vi;
+          else if (j >= 2) {
+            writer.set_index(it, 0, first);
+            writer.set_index(it, 1, prev);
+            writer.set_index(it, 2, vi);
+            ++it;
+          }
+          prev = vi;
+        }
+      };
+      const auto write_vertex_prop = [&](auto &writer, size_t v, int prop, double val) {
+        for (int d = 0; d != 3; ++d)
+          if (prop == xyz[d]) writer.set_position(v, d, val);
+        if (info.hasNormals && writer.wants_normals())
+          for (int d = 0; d != 3; ++d)
+            if (prop == nxyz[d]) writer.set_normal(v, d, (float)val);
+        if (info.hasUvs && writer.wants_uvs())
+          for (int d = 0; d != 2; ++d)
+            if (prop == uv[d]) writer.set_uv(v, d, (float)val);
+      };
+      const auto clear_missing = [&](auto &writer) {
+        const bool zeroZ = xyz[2] < 0, zeroNrm = writer.wants_normals() && !info.hasNormals,
+                   zeroUv = writer.wants_uvs() && !info.hasUvs;
+        if (zeroZ || zeroNrm || zeroUv)
+          pol(range(info.numNodes), [&](size_t v) {
+            if (zeroZ) writer.set_position(v, 2, 0.);
+            for (int d = 0; d != 3 && zeroNrm; ++d) writer.set_normal(v, d, 0.f);
+            for (int d = 0; d != 2 && zeroUv; ++d) writer.set_uv(v, d, 0.f);
+          });
+      };
+
+      if (encoding == 0) {
+        /// one non-blank line per element instance
+        const auto bounds = line_aligned_chunks(body, (size_t)(end - body), chunkBytes);
+        const size_t nc = bounds.size() - 1;
+        const auto for_each_line = [&](size_t c, auto &&f) {
+          const char *e = body + bounds[c + 1];
+          for (const char *q = body + bounds[c]; q != e;) {
+            const char *le = text_line_end(q, e);
+            const char *w = skip_text_blanks(q, le);
+            if (w != le) f(w, le);
+            q = le == e ? e : le + 1;
+          }
+        };
+        size_t vertexBase = 0, faceBase = 0;
+        for (size_t i = 0, base = 0; i != elements.size(); base += elements[i++].count)
+          if (&elements[i] == vertex)
+            vertexBase = base;
+          else if (&elements[i] == face)
+            faceBase = base;
+        /// k corners of the face line [w, le)
+        const auto face_corners = [&](const char *&w, const char *le) -> i64 {
+          for (int j = 0; j != listProp; ++j) w = text_token_end(skip_text_blanks(w, le), le);
+          i64 k = 0;
+          const char *q = parse_integer_text(w, le, k);
+          if (q == nullptr || k < 0) {
+            status.fail("ply: malformed face");
+            return 0;
+          }
+          w = q;
+          return k;
+        };
+
+        /// lines, then triangles per chunk
+        std::vector<size_t> lineOffsets(nc + 1, 0), triOffsets(nc + 1, 0);
+        pol(range(nc), [&](size_t c) {
+          size_t n = 0;
+          for_each_line(c, [&n](const char *, const char *) { ++n; });
+          lineOffsets[c + 1] = n;
+        });
+        for (size_t c = 0; c != nc; ++c) lineOffsets[c + 1] += lineOffsets[c];
+        pol(range(nc), [&](size_t c) {
+          size_t line = lineOffsets[c], n = 0;
+          for_each_line(c, [&](const char *w, const char *le) {
+            if (line - faceBase < numFaces) {
+              const i64 k = face_corners(w, le);
+              if (k > 2) n += (size_t)k - 2;
+            }
+            ++line;
+          });
+          triOffsets[c + 1] = n;
+        });
+        for (size_t c = 0; c != nc; ++c) triOffsets[c + 1] += triOffsets[c];
+        status.check();
+
+        info.numElems = triOffsets[nc];
+        auto writer = sink.allocate(info);
+        clear_missing(writer);
+        pol(range(nc), [&](size_t c) {
+          size_t line = lineOffsets[c], it = triOffsets[c];
+          for_each_line(c, [&](const char *w, const char *le) {
+            if (line - vertexBase < info.numNodes) {
+              const size_t v = line - vertexBase;
+              for (int j = 0; j != (int)vertex->props.size(); ++j) {
+                double val = 0;
+                const char *q = parse_real_text(w, le, val);
+                if (q == nullptr) {
+                  status.fail("ply: malformed vertex");
+                  break;
+                }
+                write_vertex_prop(writer, v, j, val);
+                w = q;
+              }
+            } else if (line - faceBase < numFaces) {
+              const i64 k = face_corners(w, le);
+              emit_face(writer, it, k, [&](i64) {
+                i64 vi = -1;
+                if (const char *q = parse_integer_text(w, le, vi)) w = q;
+                return vi;
+              });
+              if (k > 2) it += (size_t)k - 2;
+            }
+            ++line;
+          });
+        });
+        if (lineOffsets[nc] < std::max(vertexBase + info.numNodes, faceBase + numFaces))
+          status.fail("ply: fewer lines than declared elements");
+        status.check();
+        return info;
+      }
+
+      /// binary, elements are laid out back to back
+      const auto prop_bytes = [](const ply_property &prop) { return mesh_scalar_bytes(prop.type); };
+      const auto fixed_stride = [&](const ply_element &el) {
+        size_t stride = 0;
+        for (auto &prop : el.props) stride += prop_bytes(prop);
+        return stride;
+      };
+      /// bytes of [count] items of [each] bytes starting at [q], checked against the remaining
+      /// data before [q] is advanced (which thus never passes [end]), the product cannot overflow
+      const auto take_bytes = [end](const char *q, size_t count, size_t each) {
+        if (each != 0 && count > (size_t)(end - q) / each)
+          throw std::runtime_error("ply: truncated binary data");
+        return count * each;
+      };
+      const char *vertexData = nullptr, *faceData = nullptr;
+      size_t listOffset = 0, listTail = 0;  // bytes before and after the index list
+      if (face) {
+        for (int j = 0; j != (int)face->props.size(); ++j)
+          (j < listProp ? listOffset : listTail) += j == listProp ? 0 : prop_bytes(face->props[j]);
+      }
+      const ply_property *list = face ? &face->props[listProp] : nullptr;
+      const size_t countBytes = list ? mesh_scalar_bytes(list->countType) : 0,
+                   indexBytes = list ? prop_bytes(*list) : 0;
+      /// face row offsets and triangle offsets, computed serially unless all faces are triangles
+      std::vector<size_t> faceRows, faceTris;
+      bool allTriangles = false;
+
+      const char *q = body;
+      for (auto &el : elements) {
+        if (&el == vertex) vertexData = q;
+        if (&el == face) {
+          faceData = q;
+          const size_t stride3 = listOffset + countBytes + 3 * indexBytes + listTail;
+          if (el.count <= (size_t)(end - q) / stride3) {
+            std::atomic<bool> mixed{false};
+            pol(range(el.count), [&, stride3](size_t i) {
+              if (load_binary_value<i64>(q + i * stride3 + listOffset, list->countType, bigEndian)
+                  != 3)
+                mixed.store(true, std::memory_order_relaxed);
+            });
+            allTriangles = !mixed.load();
+          }
+          if (allTriangles) {
+            info.numElems = el.count;
+            q += el.count * stride3;
+            continue;
+          }
+          faceRows.resize(el.count + 1);
+          faceTris.resize(el.count + 1);
+          faceTris[0] = 0;
+          for (size_t i = 0; i != el.count; ++i) {
+            faceRows[i] = (size_t)(q - faceData);
+            size_t row = take_bytes(q, 1, listOffset + countBytes);
+            const i64 k = load_binary_value<i64>(q + listOffset, list->countType, bigEndian);
+            if (k < 0) throw std::runtime_error("ply: malformed face");
+            row += take_bytes(q + row, (size_t)k, indexBytes);
+            q += row + take_bytes(q + row, 1, listTail);
+            faceTris[i + 1] = faceTris[i] + (k > 2 ? (size_t)k - 2 : 0);
+          }
+          info.numElems = faceTris[el.count];
+          continue;
+        }
+        if (!el.hasList())
+          q += take_bytes(q, el.count, fixed_stride(el));
+        else if (vertexData && (faceData || !face))
+          break;  // nothing left to locate
+        else
+          for (size_t i = 0; i != el.count; ++i)
+            for (auto &prop : el.props) {
+              if (prop.isList) {
+                const size_t head = take_bytes(q, 1, mesh_scalar_bytes(prop.countType));
+                const i64 k = load_binary_value<i64>(q, prop.countType, bigEndian);
+                q += head;
+                q += take_bytes(q, (size_t)(k > 0 ? k : 0), prop_bytes(prop));
+              } else
+                q += take_bytes(q, 1, prop_bytes(prop));
+            }
+      }
+      const size_t vertexStride = fixed_stride(*vertex);
+      take_bytes(vertexData, info.numNodes, vertexStride);
+
+      auto writer = sink.allocate(info);
+      clear_missing(writer);
+      std::vector<size_t> propOffsets(vertex->props.size() + 1, 0);
+      for (size_t j = 0; j != vertex->props.size(); ++j)
+        propOffsets[j + 1] = propOffsets[j] + prop_bytes(vertex->props[j]);
+      pol(range(info.numNodes), [&](size_t v) {
+        const char *row = vertexData + v * vertexStride;
+        for (int j = 0; j != (int)vertex->props.size(); ++j)
+          if (j == xyz[0] || j == xyz[1] || j == xyz[2] || j == nxyz[0] || j == nxyz[1]
+              || j == nxyz[2] || j == uv[0] || j == uv[1])
+            write_vertex_prop(writer, v, j,
+                              load_binary_value<double>(row + propOffsets[j],
+                                                        vertex->props[j].type, bigEndian));
+      });
+      if (numFaces) {
+        const size_t stride3 = listOffset + countBytes + 3 * indexBytes + listTail;
+        pol(range(numFaces), [&, stride3](size_t f) {
+          const char *row = faceData + (allTriangles ? f * stride3 : faceRows[f]) + listOffset;
+          const i64 k = load_binary_value<i64>(row, list->countType, bigEndian);
+          row += countBytes;
+          emit_face(writer, allTriangles ? f : faceTris[f], k, [&](i64 j) {
+            return load_binary_value<i64>(row + j * indexBytes, list->type, bigEndian);
+          });
+        });
+      }
+      status.check();
+      return info;
+    }
+
+  }  // namespace detail
+
+}  // namespace zs
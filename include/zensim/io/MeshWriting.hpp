@@ -0,0 +1,383 @@
+#pragma once
+/// @file MeshWriting.hpp
+/// @brief Chunked, parallel writers for obj, legacy vtk and ply meshes.
+///
+/// Records (a vertex line, a face line, a binary row ...) are formatted by chunks of consecutive
+/// records into a staging buffer in parallel, then the chunks are handed in order to a
+/// ByteStream, coalesced into as few writes as possible. The staging buffer holds a bounded batch
+/// of chunks, hence meshes of any size are streamed with constant memory. Reals are printed with
+/// a locale independent, round-trip formatter; binary ply is little endian, binary vtk big endian
+/// as the format requires.
+///
+/// Writers read from a source:
+/// @code
+///   struct Source {
+///     using value_type = ...;                    // float or double positions
+///     size_t num_nodes() const;
+///     size_t num_elems() const;
+///     int dim() const;                           // position components (at most 3)
+///     int arity() const;                         // indices per element
+///     bool has_normals() const;
+///     bool has_uvs() const;
+///     value_type position(size_t node, int d) const;
+///     i64 index(size_t elem, int j) const;       // 0-based node index
+///     float normal(size_t node, int d) const;
+///     float uv(size_t node, int d) const;
+///   };
+/// @endcode
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/io/ByteStream.hpp"
+#include "zensim/io/MeshParsing.hpp"
+
+namespace zs {
+
+  namespace detail {
+
+    /// number of staged chunks formatted in parallel before they are written out
+    constexpr size_t s_mesh_write_batch_chunks = 32;
+    /// upper bound of the characters of a formatted real or integer
+    constexpr size_t s_max_number_chars = 32;
+
+    /// @brief shortest text that reads back to [v], independent of the C locale
+    template <typename T> inline char *format_real_text(char *p, T v) noexcept {
+      static_assert(is_floating_point_v<T>, "format_real_text expects a floating point value");
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+      return std::to_chars(p, p + s_max_number_chars, v).ptr;
+#else
+      /// enough significant digits to round trip, the decimal mark is forced to '.'
+      int n = std::snprintf(p, s_max_number_chars, "%.*g",
+                            std::numeric_limits<T>::max_digits10, (double)v);
+      if (n < 0) n = 0;
+      for (int i = 0; i != n; ++i)
+        if (p[i] == ',') p[i] = '.';
+      return p + n;
+#endif
+    }
+    inline char *format_integer_text(char *p, i64 v) noexcept {
+      return std::to_chars(p, p + s_max_number_chars, v).ptr;
+    }
+    inline void append_text(std::string &str, i64 v) {
+      char buf[s_max_number_chars];
+      str.append(buf, format_integer_text(buf, v));
+    }
+
+    template <typename T> inline char *store_binary_scalar(char *p, T v, bool bigEndian) noexcept {
+      unsigned char bytes[sizeof(T)];
+      std::memcpy(bytes, &v, sizeof(T));
+      if (bigEndian != host_is_big_endian())
+        for (size_t i = 0; i != sizeof(T) / 2; ++i) {
+          const auto b = bytes[i];
+          bytes[i] = bytes[sizeof(T) - 1 - i];
+          bytes[sizeof(T) - 1 - i] = b;
+        }
+      std::memcpy(p, bytes, sizeof(T));
+      return p + sizeof(T);
+    }
+
+    inline void write_stream_bytes(ByteStream &out, const void *src, size_t bytes) {
+      if (bytes != 0 && out.write(src, bytes) != (i64)bytes)
+        throw std::runtime_error("failed to write to the output stream");
+    }
+    inline void write_stream_text(ByteStream &out, const std::string &text) {
+      write_stream_bytes(out, text.data(), text.size());
+    }
+
+    /// @brief writes [count] records of at most [maxRecordBytes] bytes each to [out]
+    /// @note f(dst, i) formats record i at dst and returns its end. Chunks of about [chunkBytes]
+    /// are formatted in parallel, chunks that came out full are written together.
+    template <typename Policy, typename F>
+    void write_records(Policy &&pol, ByteStream &out, size_t count, size_t maxRecordBytes,
+                       size_t chunkBytes, F &&f) {
+      if (count == 0) return;
+      const size_t perChunk = std::max(chunkBytes / maxRecordBytes, (size_t)1);
+      const size_t chunkCap = perChunk * maxRecordBytes;
+      const size_t numChunks = (count + perChunk - 1) / perChunk;
+      const size_t batch = std::min(numChunks, s_mesh_write_batch_chunks);
+      std::vector<char> staging(batch * chunkCap);
+      std::vector<size_t> lengths(batch);
+      for (size_t c0 = 0; c0 < numChunks; c0 += batch) {
+        const size_t nc = std::min(batch, numChunks - c0);
+        pol(range(nc), [&](size_t c) {
+          char *const base = staging.data() + c * chunkCap;
+          char *p = base;
+          const size_t st = (c0 + c) * perChunk, ed = std::min(st + perChunk, count);
+          for (size_t i = st; i != ed; ++i) p = f(p, i);
+          lengths[c] = (size_t)(p - base);
+        });
+        for (size_t c = 0; c != nc;) {
+          const char *st = staging.data() + c * chunkCap;
+          size_t bytes = 0;
+          do {
+            bytes += lengths[c];
+          } while (lengths[c++] == chunkCap && c != nc);
+          write_stream_bytes(out, st, bytes);
+        }
+      }
+    }
+
+    ///
+    /// obj
+    ///
+    /// @brief "v", "vn", "vt" and (polygonal) "f" records, faces reference the normal and uv of
+    /// their nodes
+    template <typename Policy, typename Source>
+    void emit_obj(Policy &&pol, ByteStream &out, const Source &src,
+                  size_t chunkBytes = s_mesh_chunk_bytes) {
+      const size_t nn = src.num_nodes(), ne = src.num_elems();
+      const int dim = src.dim(), arity = src.arity();
+      const bool nrm = src.has_normals(), uv = src.has_uvs();
+      if (dim < 1 || dim > 3 || arity < 1) throw std::runtime_error("obj: unsupported mesh layout");
+      constexpr size_t realBytes = s_max_number_chars + 1;
+
+      write_records(pol, out, nn, 2 + 3 * realBytes, chunkBytes, [&](char *p, size_t i) {
+        *p++ = 'v';
+        for (int d = 0; d != 3; ++d) {
+          *p++ = ' ';
+          /// 2d meshes are written on the z = 0 plane
+          p = d < dim ? format_real_text(p, src.position(i, d)) : (*p = '0', p + 1);
+        }
+        *p++ = '\n';
+        return p;
+      });
+      if (nrm)
+        write_records(pol, out, nn, 3 + 3 * realBytes, chunkBytes, [&](char *p, size_t i) {
+          *p++ = 'v';
+          *p++ = 'n';
+          for (int d = 0; d != 3; ++d) {
+            *p++ = ' ';
+            p = format_real_text(p, src.normal(i, d));
+          }
+          *p++ = '\n';
+          return p;
+        });
+      if (uv)
+        write_records(pol, out, nn, 3 + 2 * realBytes, chunkBytes, [&](char *p, size_t i) {
+          *p++ = 'v';
+          *p++ = 't';
+          for (int d = 0; d != 2; ++d) {
+            *p++ = ' ';
+            p = format_real_text(p, src.uv(i, d));
+          }
+          *p++ = '\n';
+          return p;
+        });
+      const int refs = 1 + (int)nrm + (int)uv;
+      write_records(pol, out, ne, 2 + arity * refs * realBytes, chunkBytes,
+                    [&](char *p, size_t e) {
+                      *p++ = 'f';
+                      for (int j = 0; j != arity; ++j) {
+                        *p++ = ' ';
+                        const i64 id = src.index(e, j) + 1;
+                        p = format_integer_text(p, id);
+                        if (uv || nrm) {
+                          *p++ = '/';
+                          if (uv) p = format_integer_text(p, id);
+                          if (nrm) {
+                            *p++ = '/';
+                            p = format_integer_text(p, id);
+                          }
+                        }
+                      }
+                      *p++ = '\n';
+                      return p;
+                    });
+    }
+
+    ///
+    /// legacy vtk (unstructured grid, ascii or binary)
+    ///
+    /// vtk cell type of elements with [arity] nodes
+    inline int vtk_cell_type(int arity) {
+      switch (arity) {
+        case 1:
+          return 1;  // VTK_VERTEX
+        case 2:
+          return 3;  // VTK_LINE
+        case 3:
+          return 5;  // VTK_TRIANGLE
+        case 4:
+          return 10;  // VTK_TETRA
+        case 8:
+          return 12;  // VTK_HEXAHEDRON
+        default:
+          throw std::runtime_error("vtk: no cell type for this element arity");
+      }
+    }
+
+    template <typename Policy, typename Source>
+    void emit_vtk(Policy &&pol, ByteStream &out, const Source &src, bool binary,
+                  size_t chunkBytes = s_mesh_chunk_bytes) {
+      using value_type = typename Source::value_type;
+      const size_t nn = src.num_nodes(), ne = src.num_elems();
+      const int dim = src.dim(), arity = src.arity();
+      if (dim < 1 || dim > 3) throw std::runtime_error("vtk: unsupported node dimension");
+      const int cellType = vtk_cell_type(arity);
+      if (nn > (size_t)std::numeric_limits<i32>::max()
+          || ne * (size_t)(arity + 1) > (size_t)std::numeric_limits<i32>::max())
+        throw std::runtime_error("vtk: mesh too large for 32-bit cell indices");
+      constexpr size_t realBytes = s_max_number_chars + 1;
+
+      std::string header = "# vtk DataFile Version 2.0\nUnstructured Grid\n";
+      header += binary ? "BINARY\n" : "ASCII\n";
+      header += "DATASET UNSTRUCTURED_GRID\nPOINTS ";
+      append_text(header, (i64)nn);
+      header += is_same_v<value_type, double> ? " double\n" : " float\n";
+      write_stream_text(out, header);
+
+      if (binary)
+        write_records(pol, out, nn, 3 * sizeof(value_type), chunkBytes, [&](char *p, size_t i) {
+          for (int d = 0; d != 3; ++d)
+            p = store_binary_scalar(p, d < dim ? src.position(i, d) : (value_type)0, true);
+          return p;
+        });
+      else
+        write_records(pol, out, nn, 3 * realBytes, chunkBytes, [&](char *p, size_t i) {
+          for (int d = 0; d != 3; ++d) {
+            p = d < dim ? format_real_text(p, src.position(i, d)) : (*p = '0', p + 1);
+            *p++ = d != 2 ? ' ' : '\n';
+          }
+          return p;
+        });
+
+      std::string cells = "\nCELLS ";
+      append_text(cells, (i64)ne);
+      cells += ' ';
+      append_text(cells, (i64)(ne * (size_t)(arity + 1)));
+      cells += '\n';
+      write_stream_text(out, cells);
+      if (binary)
+        write_records(pol, out, ne, (size_t)(arity + 1) * sizeof(i32), chunkBytes,
+                      [&](char *p, size_t e) {
+                        p = store_binary_scalar(p, (i32)arity, true);
+                        for (int j = 0; j != arity; ++j)
+                          p = store_binary_scalar(p, (i32)src.index(e, j), true);
+                        return p;
+                      });
+      else
+        write_records(pol, out, ne, (size_t)(arity + 1) * realBytes, chunkBytes,
+                      [&](char *p, size_t e) {
+                        p = format_integer_text(p, arity);
+                        for (int j = 0; j != arity; ++j) {
+                          *p++ = ' ';
+                          p = format_integer_text(p, src.index(e, j));
+                        }
+                        *p++ = '\n';
+                        return p;
+                      });
+
+      std::string types = "\nCELL_TYPES ";
+      append_text(types, (i64)ne);
+      types += '\n';
+      write_stream_text(out, types);
+      if (binary)
+        write_records(pol, out, ne, sizeof(i32), chunkBytes, [&](char *p, size_t) {
+          return store_binary_scalar(p, (i32)cellType, true);
+        });
+      else
+        write_records(pol, out, ne, realBytes, chunkBytes, [&](char *p, size_t) {
+          p = format_integer_text(p, cellType);
+          *p++ = '\n';
+          return p;
+        });
+      if (binary) write_stream_text(out, "\n");
+    }
+
+    ///
+    /// ply (ascii or binary little endian)
+    ///
+    /// @brief "vertex" (x, y, z, optionally nx, ny, nz and u, v) and "face" (vertex_indices)
+    /// elements
+    template <typename Policy, typename Source>
+    void emit_ply(Policy &&pol, ByteStream &out, const Source &src, bool binary,
+                  size_t chunkBytes = s_mesh_chunk_bytes) {
+      using value_type = typename Source::value_type;
+      const size_t nn = src.num_nodes(), ne = src.num_elems();
+      const int dim = src.dim(), arity = src.arity();
+      const bool nrm = src.has_normals(), uv = src.has_uvs();
+      if (dim < 1 || dim > 3) throw std::runtime_error("ply: unsupported node dimension");
+      if (arity < 1 || arity > 255) throw std::runtime_error("ply: unsupported face arity");
+      if (nn > (size_t)std::numeric_limits<i32>::max())
+        throw std::runtime_error("ply: mesh too large for 32-bit vertex indices");
+      constexpr size_t realBytes = s_max_number_chars + 1;
+
+      const char *scalar = is_same_v<value_type, double> ? "double" : "float";
+      std::string header = "ply\nformat ";
+      header += binary ? "binary_little_endian 1.0\n" : "ascii 1.0\n";
+      header += "element vertex ";
+      append_text(header, (i64)nn);
+      header += '\n';
+      for (const char *name : {"x", "y", "z"})
+        header = header + "property " + scalar + " " + name + "\n";
+      if (nrm)
+        for (const char *name : {"nx", "ny", "nz"})
+          header = header + "property float " + name + "\n";
+      if (uv) header += "property float u\nproperty float v\n";
+      header += "element face ";
+      append_text(header, (i64)ne);
+      header += "\nproperty list uchar int vertex_indices\nend_header\n";
+      write_stream_text(out, header);
+
+      if (binary) {
+        const size_t rowBytes
+            = 3 * sizeof(value_type) + (nrm ? 3 * sizeof(float) : 0) + (uv ? 2 * sizeof(float) : 0);
+        write_records(pol, out, nn, rowBytes, chunkBytes, [&](char *p, size_t i) {
+          for (int d = 0; d != 3; ++d)
+            p = store_binary_scalar(p, d < dim ? src.position(i, d) : (value_type)0, false);
+          if (nrm)
+            for (int d = 0; d != 3; ++d) p = store_binary_scalar(p, src.normal(i, d), false);
+          if (uv)
+            for (int d = 0; d != 2; ++d) p = store_binary_scalar(p, src.uv(i, d), false);
+          return p;
+        });
+        write_records(pol, out, ne, 1 + (size_t)arity * sizeof(i32), chunkBytes,
+                      [&](char *p, size_t e) {
+                        *p++ = (char)(unsigned char)arity;
+                        for (int j = 0; j != arity; ++j)
+                          p = store_binary_scalar(p, (i32)src.index(e, j), false);
+                        return p;
+                      });
+      } else {
+        write_records(pol, out, nn, 8 * realBytes, chunkBytes, [&](char *p, size_t i) {
+          for (int d = 0; d != 3; ++d) {
+            if (d) *p++ = ' ';
+            p = d < dim ? format_real_text(p, src.position(i, d)) : (*p = '0', p + 1);
+          }
+          if (nrm)
+            for (int d = 0; d != 3; ++d) {
+              *p++ = ' ';
+              p = format_real_text(p, src.normal(i, d));
+            }
+          if (uv)
+            for (int d = 0; d != 2; ++d) {
+              *p++ = ' ';
+              p = format_real_text(p, src.uv(i, d));
+            }
+          *p++ = '\n';
+          return p;
+        });
+        write_records(pol, out, ne, (size_t)(arity + 1) * realBytes, chunkBytes,
+                      [&](char *p, size_t e) {
+                        p = format_integer_text(p, arity);
+                        for (int j = 0; j != arity; ++j) {
+                          *p++ = ' ';
+                          p = format_integer_text(p, src.index(e, j));
+                        }
+                        *p++ = '\n';
+                        return p;
+                      });
+      }
+    }
+
+  }  // namespace detail
+
+}  // namespace zs
@@ -0,0 +1,326 @@
+#pragma once
+
+#include "zensim/math/MathUtils.h"
+
+#if !defined(__CUDACC__) && !defined(__MUSACC__) \
+    && (defined(__SSE2__) || defined(_M_X64) || defined(__AVX__) || defined(__AVX512F__))
+#  define ZS_FLOAT_LANES_X86 1
+#  include <immintrin.h>
+#else
+#  define ZS_FLOAT_LANES_X86 0
+#endif
+
+namespace zs {
+  namespace math {
+
+    namespace detail {
+      /// @brief W floats evaluated in lock-step (portable fallback)
+      /// @note fixed trip-count loops, left to the auto-vectorizer
+      template <int W> struct float_lanes {
+        static constexpr int width = W;
+        struct mask_type {
+          int m[W];
+        };
+        float v[W];
+
+        static float_lanes load(const float *p) noexcept {
+          float_lanes r;
+          for (int i = 0; i != W; ++i) r.v[i] = p[i];
+          return r;
+        }
+        static float_lanes broadcast(float s) noexcept {
+          float_lanes r;
+          for (int i = 0; i != W; ++i) r.v[i] = s;
+          return r;
+        }
+        void store(float *p) const noexcept {
+          for (int i = 0; i != W; ++i) p[i] = v[i];
+        }
+        static float_lanes select(const mask_type &m, const float_lanes &a,
+                                  const float_lanes &b) noexcept {
+          float_lanes r;
+          for (int i = 0; i != W; ++i) r.v[i] = m.m[i] ? a.v[i] : b.v[i];
+          return r;
+        }
+        static float_lanes max(const float_lanes &a, const float_lanes &b) noexcept {
+          float_lanes r;
+          for (int i = 0; i != W; ++i) r.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i];
+          return r;
+        }
+        static float_lanes min(const float_lanes &a, const float_lanes &b) noexcept {
+          float_lanes r;
+          for (int i = 0; i != W; ++i) r.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i];
+          return r;
+        }
+        static float_lanes rsqrt(const float_lanes &a) noexcept {
+          float_lanes r;
+          for (int i = 0; i != W; ++i) r.v[i] = zs::rsqrt(a.v[i]);
+          return r;
+        }
+        static float_lanes sqrt(const float_lanes &a) noexcept {
+          float_lanes r;
+          for (int i = 0; i != W; ++i) r.v[i] = zs::sqrt(a.v[i]);
+          return r;
+        }
+        static mask_type mask_and(const mask_type &a, const mask_type &b) noexcept {
+          mask_type r;
+          for (int i = 0; i != W; ++i) r.m[i] = a.m[i] & b.m[i];
+          return r;
+        }
+        static mask_type mask_or(const mask_type &a, const mask_type &b) noexcept {
+          mask_type r;
+          for (int i = 0; i != W; ++i) r.m[i] = a.m[i] | b.m[i];
+          return r;
+        }
+        static bool any(const mask_type &m) noexcept {
+          int r = 0;
+          for (int i = 0; i != W; ++i) r |= m.m[i];
+          return r != 0;
+        }
+
+#define ZS_FLOAT_LANES_BINARY_OP(OP)                                              \
+  friend float_lanes operator OP(const float_lanes &a, const float_lanes &b) noexcept { \
+    float_lanes r;                                                                \
+    for (int i = 0; i != W; ++i) r.v[i] = a.v[i] OP b.v[i];                       \
+    return r;                                                                     \
+  }
+#define ZS_FLOAT_LANES_COMPARE_OP(OP)                                           \
+  friend mask_type operator OP(const float_lanes &a, const float_lanes &b) noexcept { \
+    mask_type r;                                                                \
+    for (int i = 0; i != W; ++i) r.m[i] = a.v[i] OP b.v[i] ? -1 : 0;            \
+    return r;                                                                   \
+  }
+        ZS_FLOAT_LANES_BINARY_OP(+)
+        ZS_FLOAT_LANES_BINARY_OP(-)
+        ZS_FLOAT_LANES_BINARY_OP(*)
+        ZS_FLOAT_LANES_BINARY_OP(/)
+        ZS_FLOAT_LANES_COMPARE_OP(>=)
+        ZS_FLOAT_LANES_COMPARE_OP(<=)
+        ZS_FLOAT_LANES_COMPARE_OP(<)
+        ZS_FLOAT_LANES_COMPARE_OP(>)
+#undef ZS_FLOAT_LANES_BINARY_OP
+#undef ZS_FLOAT_LANES_COMPARE_OP
+
+        friend float_lanes operator-(const float_lanes &a) noexcept {
+          float_lanes r;
+          for (int i = 0; i != W; ++i) r.v[i] = -a.v[i];
+          return r;
+        }
+      };
+
+#if ZS_FLOAT_LANES_X86
+      /// @note the hardware reciprocal square roots are refined by one newton step (~22 bits)
+      template <> struct float_lanes<4> {
+        static constexpr int width = 4;
+        struct mask_type {
+          __m128 m;
+        };
+        __m128 v;
+
+        static float_lanes load(const float *p) noexcept { return {_mm_loadu_ps(p)}; }
+        static float_lanes broadcast(float s) noexcept { return {_mm_set1_ps(s)}; }
+        void store(float *p) const noexcept { _mm_storeu_ps(p, v); }
+        static float_lanes select(const mask_type &m, const float_lanes &a,
+                                  const float_lanes &b) noexcept {
+          return {_mm_or_ps(_mm_and_ps(m.m, a.v), _mm_andnot_ps(m.m, b.v))};
+        }
+        static float_lanes max(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm_max_ps(a.v, b.v)};
+        }
+        static float_lanes min(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm_min_ps(a.v, b.v)};
+        }
+        static float_lanes rsqrt(const float_lanes &a) noexcept {
+          const __m128 r = _mm_rsqrt_ps(a.v);
+          const __m128 hx = _mm_mul_ps(_mm_set1_ps(0.5f), a.v);
+          return {_mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(hx, _mm_mul_ps(r, r))))};
+        }
+        static float_lanes sqrt(const float_lanes &a) noexcept { return {_mm_sqrt_ps(a.v)}; }
+        static mask_type mask_and(const mask_type &a, const mask_type &b) noexcept {
+          return {_mm_and_ps(a.m, b.m)};
+        }
+        static mask_type mask_or(const mask_type &a, const mask_type &b) noexcept {
+          return {_mm_or_ps(a.m, b.m)};
+        }
+        static bool any(const mask_type &m) noexcept { return _mm_movemask_ps(m.m) != 0; }
+        friend float_lanes operator+(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm_add_ps(a.v, b.v)};
+        }
+        friend float_lanes operator-(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm_sub_ps(a.v, b.v)};
+        }
+        friend float_lanes operator*(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm_mul_ps(a.v, b.v)};
+        }
+        friend float_lanes operator/(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm_div_ps(a.v, b.v)};
+        }
+        friend float_lanes operator-(const float_lanes &a) noexcept {
+          return {_mm_xor_ps(a.v, _mm_set1_ps(-0.f))};
+        }
+        friend mask_type operator>=(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm_cmpge_ps(a.v, b.v)};
+        }
+        friend mask_type operator<=(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm_cmple_ps(a.v, b.v)};
+        }
+        friend mask_type operator<(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm_cmplt_ps(a.v, b.v)};
+        }
+        friend mask_type operator>(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm_cmpgt_ps(a.v, b.v)};
+        }
+      };
+
+#  if defined(__AVX__)
+      template <> struct float_lanes<8> {
+        static constexpr int width = 8;
+        struct mask_type {
+          __m256 m;
+        };
+        __m256 v;
+
+        static float_lanes load(const float *p) noexcept { return {_mm256_loadu_ps(p)}; }
+        static float_lanes broadcast(float s) noexcept { return {_mm256_set1_ps(s)}; }
+        void store(float *p) const noexcept { _mm256_storeu_ps(p, v); }
+        static float_lanes select(const mask_type &m, const float_lanes &a,
+                                  const float_lanes &b) noexcept {
+          return {_mm256_blendv_ps(b.v, a.v, m.m)};
+        }
+        static float_lanes max(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm256_max_ps(a.v, b.v)};
+        }
+        static float_lanes min(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm256_min_ps(a.v, b.v)};
+        }
+        static float_lanes rsqrt(const float_lanes &a) noexcept {
+          const __m256 r = _mm256_rsqrt_ps(a.v);
+          const __m256 hx = _mm256_mul_ps(_mm256_set1_ps(0.5f), a.v);
+          return {_mm256_mul_ps(
+              r, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(hx, _mm256_mul_ps(r, r))))};
+        }
+        static float_lanes sqrt(const float_lanes &a) noexcept { return {_mm256_sqrt_ps(a.v)}; }
+        static mask_type mask_and(const mask_type &a, const mask_type &b) noexcept {
+          return {_mm256_and_ps(a.m, b.m)};
+        }
+        static mask_type mask_or(const mask_type &a, const mask_type &b) noexcept {
+          return {_mm256_or_ps(a.m, b.m)};
+        }
+        static bool any(const mask_type &m) noexcept { return _mm256_movemask_ps(m.m) != 0; }
+        friend float_lanes operator+(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm256_add_ps(a.v, b.v)};
+        }
+        friend float_lanes operator-(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm256_sub_ps(a.v, b.v)};
+        }
+        friend float_lanes operator*(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm256_mul_ps(a.v, b.v)};
+        }
+        friend float_lanes operator/(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm256_div_ps(a.v, b.v)};
+        }
+        friend float_lanes operator-(const float_lanes &a) noexcept {
+          return {_mm256_xor_ps(a.v, _mm256_set1_ps(-0.f))};
+        }
+        friend mask_type operator>=(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)};
+        }
+        friend mask_type operator<=(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ)};
+        }
+        friend mask_type operator<(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)};
+        }
+        friend mask_type operator>(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)};
+        }
+      };
+#  endif
+
+#  if defined(__AVX512F__)
+      template <> struct float_lanes<16> {
+        static constexpr int width = 16;
+        struct mask_type {
+          __mmask16 m;
+        };
+        __m512 v;
+
+        static float_lanes load(const float *p) noexcept { return {_mm512_loadu_ps(p)}; }
+        static float_lanes broadcast(float s) noexcept { return {_mm512_set1_ps(s)}; }
+        void store(float *p) const noexcept { _mm512_storeu_ps(p, v); }
+        static float_lanes select(const mask_type &m, const float_lanes &a,
+                                  const float_lanes &b) noexcept {
+          return {_mm512_mask_blend_ps(m.m, b.v, a.v)};
+        }
+        static float_lanes max(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm512_max_ps(a.v, b.v)};
+        }
+        static float_lanes min(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm512_min_ps(a.v, b.v)};
+        }
+        static float_lanes rsqrt(const float_lanes &a) noexcept {
+          const __m512 r = _mm512_rsqrt14_ps(a.v);
+          const __m512 hx = _mm512_mul_ps(_mm512_set1_ps(0.5f), a.v);
+          return {_mm512_mul_ps(
+              r, _mm512_sub_ps(_mm512_set1_ps(1.5f), _mm512_mul_ps(hx, _mm512_mul_ps(r, r))))};
+        }
+        static float_lanes sqrt(const float_lanes &a) noexcept { return {_mm512_sqrt_ps(a.v)}; }
+        static mask_type mask_and(const mask_type &a, const mask_type &b) noexcept {
+          return {(__mmask16)(a.m & b.m)};
+        }
+        static mask_type mask_or(const mask_type &a, const mask_type &b) noexcept {
+          return {(__mmask16)(a.m | b.m)};
+        }
+        static bool any(const mask_type &m) noexcept { return m.m != 0; }
+        friend float_lanes operator+(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm512_add_ps(a.v, b.v)};
+        }
+        friend float_lanes operator-(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm512_sub_ps(a.v, b.v)};
+        }
+        friend float_lanes operator*(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm512_mul_ps(a.v, b.v)};
+        }
+        friend float_lanes operator/(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm512_div_ps(a.v, b.v)};
+        }
+        friend float_lanes operator-(const float_lanes &a) noexcept {
+          return {_mm512_sub_ps(_mm512_setzero_ps(), a.v)};
+        }
+        friend mask_type operator>=(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_GE_OQ)};
+        }
+        friend mask_type operator<=(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_LE_OQ)};
+        }
+        friend mask_type operator<(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ)};
+        }
+        friend mask_type operator>(const float_lanes &a, const float_lanes &b) noexcept {
+          return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ)};
+        }
+      };
+#  endif
+#endif
+
+      /// @brief widest register (in floats) the translation unit is compiled for
+#if ZS_FLOAT_LANES_X86 && defined(__AVX512F__)
+      constexpr int native_float_lanes = 16;
+#elif ZS_FLOAT_LANES_X86 && defined(__AVX__)
+      constexpr int native_float_lanes = 8;
+#else
+      constexpr int native_float_lanes = 4;
+#endif
+
+      /// @brief widest batch not straddling the tiles of a lane_width 'Length' tilevector
+      template <size_t Length> constexpr int batch_float_lanes() noexcept {
+        int w = native_float_lanes;
+        while (w > 1 && Length % (size_t)w != 0) w >>= 1;
+        return w;
+      }
+    }  // namespace detail
+
+  }  // namespace math
+}  // namespace zs
+
+#undef ZS_FLOAT_LANES_X86
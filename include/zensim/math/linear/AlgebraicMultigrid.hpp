@@ -0,0 +1,469 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "zensim/container/Vector.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/graph/Coloring.hpp"
+#include "zensim/math/linear/MulticolorGaussSeidel.hpp"
+#include "zensim/math/matrix/SparseMatrixOperations.hpp"
+
+namespace zs {
+
+  enum struct amg_smoother_e { chebyshev = 0, multicolor_gauss_seidel };
+
+  /// @brief smoothed aggregation algebraic multigrid (scalar, symmetric positive (semi-)definite)
+  /// @note setup: strength filtering, distance-2 maximal independent set aggregation (seeded by
+  /// fast_independent_sets), damped-jacobi smoothed prolongation, galerkin coarse operators
+  /// @note solve: symmetric v-cycle with chebyshev (default) or multicolor gauss-seidel
+  /// smoothing, usable as a cg preconditioner
+  template <typename T = double, typename Ti = int, typename Tn = int,
+            typename AllocatorT = ZSPmrAllocator<>>
+  struct SmoothedAggregationAmg {
+    static_assert(is_floating_point_v<T>, "amg value_type should be floating point.");
+    using value_type = T;
+    using index_type = Ti;
+    using allocator_type = AllocatorT;
+    using spmat_type = SparseMatrix<T, true, Ti, Tn, AllocatorT>;
+    using size_type = typename spmat_type::size_type;
+    using vector_type = Vector<T, AllocatorT>;
+
+    struct Level {
+      spmat_type A, P, R;
+      vector_type invDiag, x, b, r, d;
+      T lambdaMax{1};
+      MulticolorGaussSeidel<T, Ti, Tn, AllocatorT> gs{};
+    };
+
+    /// setup parameters
+    int maxLevels{12};
+    Ti coarsestSize{256};
+    T strengthThreshold{(T)0.08};
+    T prolongationDamping{(T)4 / (T)3};
+    int chebyshevDegree{3};
+    T chebyshevRatio{(T)10};
+    int powerIterations{10};
+    amg_smoother_e smoother{amg_smoother_e::chebyshev};
+
+    std::vector<Level> levels{};
+    /// dense lu factors of the coarsest operator (row-major), with row pivots
+    std::vector<T> coarseLu{};
+    std::vector<Ti> coarsePivots{};
+
+    Ti numLevels() const noexcept { return (Ti)levels.size(); }
+    Ti numDofs() const noexcept { return levels.size() ? levels[0].A.rows() : 0; }
+    /// @brief operator complexity (sum of nnz over all levels / nnz of the finest level)
+    double operatorComplexity() const {
+      if (levels.empty()) return 0;
+      double total = 0;
+      for (const auto &l : levels) total += l.A.nnz();
+      return total / levels[0].A.nnz();
+    }
+
+    template <typename Policy> void build(Policy &&policy, const spmat_type &A);
+
+    /// @brief x = M^{-1} b, one v-cycle with zero initial guess
+    template <typename Policy, typename BRange, typename XRange>
+    void apply(Policy &&policy, BRange &&b, XRange &&x);
+
+    /// @brief dofview-based preconditioner interface (see ConjugateGradient)
+    template <typename Policy, typename In, typename Out>
+    void precondition(Policy &&policy, In &&in, Out &&out) {
+      constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+      auto &fine = levels[0];
+      policy(range(numDofs()), [in, b = view<space>(fine.b)] ZS_LAMBDA(Ti i) mutable {
+        b[i] = in.get(i, scalar_c);
+      });
+      vcycle(policy, 0);
+      policy(range(numDofs()), [out, x = view<space>(fine.x)] ZS_LAMBDA(Ti i) mutable {
+        out.set(i, x[i]);
+      });
+    }
+
+  protected:
+    template <typename Policy> void smooth(Policy &&policy, Level &level, bool pre);
+    template <typename Policy> void vcycle(Policy &&policy, Ti l);
+    template <typename Policy> T estimateSpectralRadius(Policy &&policy, Level &level);
+    void factorCoarsest(const spmat_type &A);
+    void solveCoarsest(Level &level);
+  };
+
+  template <typename T, typename Ti, typename Tn, typename AllocatorT>
+  template <typename Policy>
+  T SmoothedAggregationAmg<T, Ti, Tn, AllocatorT>::estimateSpectralRadius(Policy &&policy,
+                                                                        Level &level) {
+    constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+    const Ti n = level.A.rows();
+    auto allocator = get_temporary_memory_source(policy);
+    vector_type v{level.x.get_allocator(), (size_t)n}, w{level.x.get_allocator(), (size_t)n};
+    Vector<T> res{allocator, 1};
+    policy(range(n), [v = view<space>(v)] ZS_LAMBDA(Ti i) mutable {
+      v[i] = (T)(detail::coloring_vertex_weight((u32)i) >> 8) / (T)(1 << 24) + (T)0.5;
+    });
+    T lambda = 0;
+    for (int iter = 0; iter != powerIterations; ++iter) {
+      spmv(policy, level.A, v, w);
+      policy(range(n), [w = view<space>(w), invDiag = view<space>(level.invDiag)] ZS_LAMBDA(
+                           Ti i) mutable { w[i] *= invDiag[i]; });
+      /// rayleigh quotient in the D-inner product is avoided, the norm ratio suffices here
+      policy(range(n), [v = view<space>(v), w = view<space>(w)] ZS_LAMBDA(Ti i) mutable {
+        v[i] = w[i] * w[i];
+      });
+      reduce(policy, std::begin(v), std::end(v), std::begin(res), (T)0, plus<T>{});
+      T norm = std::sqrt(res.getVal());
+      if (norm == 0) break;
+      lambda = norm;
+      policy(range(n), [v = view<space>(v), w = view<space>(w), norm] ZS_LAMBDA(Ti i) mutable {
+        v[i] = w[i] / norm;
+      });
+    }
+    return lambda;
+  }
+
+  template <typename T, typename Ti, typename Tn, typename AllocatorT>
+  void SmoothedAggregationAmg<T, Ti, Tn, AllocatorT>::factorCoarsest(const spmat_type &A) {
+    const Ti n = A.rows();
+    coarseLu.assign((size_t)n * n, (T)0);
+    coarsePivots.resize(n);
+    for (Ti i = 0; i != n; ++i)
+      for (auto k = A._ptrs[i]; k != A._ptrs[i + 1]; ++k)
+        coarseLu[(size_t)i * n + A._inds[k]] += A._vals[k];
+    T maxDiag = 0;
+    for (Ti i = 0; i != n; ++i) maxDiag = std::max(maxDiag, std::abs(coarseLu[(size_t)i * n + i]));
+    const T eps = maxDiag * std::numeric_limits<T>::epsilon() * n;
+    for (Ti k = 0; k != n; ++k) {
+      Ti p = k;
+      for (Ti i = k + 1; i < n; ++i)
+        if (std::abs(coarseLu[(size_t)i * n + k]) > std::abs(coarseLu[(size_t)p * n + k])) p = i;
+      coarsePivots[k] = p;
+      if (p != k)
+        for (Ti j = 0; j != n; ++j)
+          std::swap(coarseLu[(size_t)k * n + j], coarseLu[(size_t)p * n + j]);
+      T pivot = coarseLu[(size_t)k * n + k];
+      /// @note singular (e.g. pure neumann) operators: the null direction is dropped
+      if (std::abs(pivot) <= eps) {
+        coarseLu[(size_t)k * n + k] = 0;
+        continue;
+      }
+      for (Ti i = k + 1; i < n; ++i) {
+        T f = coarseLu[(size_t)i * n + k] /= pivot;
+        if (f != 0)
+          for (Ti j = k + 1; j < n; ++j)
+            coarseLu[(size_t)i * n + j] -= f * coarseLu[(size_t)k * n + j];
+      }
+    }
+  }
+
+  template <typename T, typename Ti, typename Tn, typename AllocatorT>
+  void SmoothedAggregationAmg<T, Ti, Tn, AllocatorT>::solveCoarsest(Level &level) {
+    const Ti n = level.A.rows();
+    for (Ti i = 0; i != n; ++i) level.x[i] = level.b[i];
+    for (Ti k = 0; k != n; ++k)
+      if (coarsePivots[k] != k) std::swap(level.x[k], level.x[coarsePivots[k]]);
+    for (Ti i = 0; i != n; ++i)
+      for (Ti j = 0; j != i; ++j) level.x[i] -= coarseLu[(size_t)i * n + j] * level.x[j];
+    for (Ti i = n - 1; i >= 0; --i) {
+      for (Ti j = i + 1; j < n; ++j) level.x[i] -= coarseLu[(size_t)i * n + j] * level.x[j];
+      auto pivot = coarseLu[(size_t)i * n + i];
+      level.x[i] = pivot != 0 ? level.x[i] / pivot : (T)0;
+    }
+  }
+
+  template <typename T, typename Ti, typename Tn, typename AllocatorT>
+  template <typename Policy>
+  void SmoothedAggregationAmg<T, Ti, Tn, AllocatorT>::build(Policy &&policy, const spmat_type &A) {
+    constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+    static_assert(space == execspace_e::host || space == execspace_e::openmp,
+                  "amg setup is only available for host execution policies.");
+    if (A.rows() != A.cols()) throw std::runtime_error("amg requires a square spmat");
+    if (!valid_memspace_for_execution(policy, A.get_allocator()))
+      throw std::runtime_error("current memory location not compatible with the execution policy");
+
+    auto allocator = get_temporary_memory_source(policy);
+    const auto &valloc = A._vals.get_allocator();
+    levels.clear();
+    levels.emplace_back();
+    levels[0].A = A;
+
+    for (int l = 0;; ++l) {
+      auto *level = &levels[l];
+      const Ti n = level->A.rows();
+      level->invDiag = vector_type{valloc, (size_t)n};
+      level->x = vector_type{valloc, (size_t)n};
+      level->b = vector_type{valloc, (size_t)n};
+      level->r = vector_type{valloc, (size_t)n};
+      level->d = vector_type{valloc, (size_t)n};
+      policy(range(n), [A = view<space>(level->A), invDiag = view<space>(level->invDiag)] ZS_LAMBDA(
+                           Ti i) mutable {
+        T diag = 0;
+        for (auto k = A._ptrs[i]; k != A._ptrs[i + 1]; ++k)
+          if (A._inds[k] == i) diag += A._vals[k];
+        invDiag[i] = diag != 0 ? (T)1 / diag : (T)0;
+      });
+
+      if (n <= coarsestSize || l + 1 >= maxLevels) {
+        factorCoarsest(level->A);
+        break;
+      }
+      level->lambdaMax = estimateSpectralRadius(policy, *level);
+      if (smoother == amg_smoother_e::multicolor_gauss_seidel) level->gs.build(policy, level->A);
+
+      /// @brief strength of connection graph S (symmetric, |a_ij| as values)
+      /// @note the diagonal is kept as an explicit zero so that S^2 covers both 1 and 2 hops
+      auto isStrong = [theta = strengthThreshold](T aij, T invDi, T invDj) {
+        return aij * aij * invDi * invDj >= theta * theta;
+      };
+      spmat_type S{allocator, n, n};
+      {
+        Vector<size_type> cnts{allocator, (size_t)n + 1};
+        policy(range(n), [&](Ti i) {
+          size_type cnt = 0;
+          for (auto k = level->A._ptrs[i]; k != level->A._ptrs[i + 1]; ++k) {
+            auto j = level->A._inds[k];
+            if (j == i || isStrong(level->A._vals[k], level->invDiag[i], level->invDiag[j])) ++cnt;
+          }
+          cnts[i] = cnt;
+        });
+        cnts.setVal(0, n);
+        S._ptrs.resize((size_t)n + 1);
+        exclusive_scan(policy, std::begin(cnts), std::end(cnts), std::begin(S._ptrs));
+        auto nnz = S._ptrs.getVal(n);
+        S._inds.resize(nnz);
+        S._vals.resize(nnz);
+        policy(range(n), [&](Ti i) {
+          auto dst = S._ptrs[i];
+          for (auto k = level->A._ptrs[i]; k != level->A._ptrs[i + 1]; ++k) {
+            auto j = level->A._inds[k];
+            if (j == i || isStrong(level->A._vals[k], level->invDiag[i], level->invDiag[j])) {
+              S._inds[dst] = j;
+              S._vals[dst++] = j != i ? std::abs(level->A._vals[k]) : (T)0;
+            }
+          }
+        });
+      }
+
+      /// @brief aggregate roots: maximal independent set of S^2 (roots are 3 hops apart)
+      /// @note independent sets from fast_independent_sets are merged greedily color by color
+      Vector<int> isRoot{allocator, (size_t)n};
+      {
+        auto S2 = spgemm(policy, S, S);
+        Vector<u32> weights{allocator, (size_t)n};
+        Vector<Ti> colors{allocator, (size_t)n};
+        policy(enumerate(weights),
+               [] ZS_LAMBDA(Ti i, u32 & w) { w = detail::coloring_vertex_weight((u32)i); });
+        auto numColors = fast_independent_sets(policy, S2, weights, colors);
+        isRoot.reset(0);
+        for (Ti color = 1; color <= numColors; ++color)
+          policy(range(n), [&, color](Ti i) {
+            if (colors[i] != color) return;
+            for (auto k = S2._ptrs[i]; k != S2._ptrs[i + 1]; ++k)
+              if (isRoot[S2._inds[k]]) return;
+            isRoot[i] = 1;
+          });
+      }
+
+      Vector<Ti> rootIds{allocator, (size_t)n + 1}, aggs{allocator, (size_t)n};
+      {
+        Vector<Ti> marks{allocator, (size_t)n + 1};
+        policy(range(n), [&](Ti i) { marks[i] = isRoot[i] ? 1 : 0; });
+        marks.setVal(0, n);
+        exclusive_scan(policy, std::begin(marks), std::end(marks), std::begin(rootIds));
+      }
+      const Ti nc = rootIds.getVal(n);
+      if (nc == 0 || nc == n) {
+        factorCoarsest(level->A);
+        break;
+      }
+      /// @brief aggregates: roots with their strong neighbors, then the remaining vertices
+      /// join the strongest neighboring aggregate
+      auto strongestNeighborAgg = [&](Ti i, auto &&isCandidate) {
+        Ti agg = -1;
+        T strongest = -1;
+        for (auto k = S._ptrs[i]; k != S._ptrs[i + 1]; ++k) {
+          auto j = S._inds[k];
+          if (j != i && isCandidate(j) && S._vals[k] > strongest) {
+            strongest = S._vals[k];
+            agg = j;
+          }
+        }
+        return agg;
+      };
+      policy(range(n), [&](Ti i) {
+        if (isRoot[i]) {
+          aggs[i] = rootIds[i];
+          return;
+        }
+        auto j = strongestNeighborAgg(i, [&](Ti j) { return isRoot[j] != 0; });
+        aggs[i] = j != -1 ? rootIds[j] : -1;
+      });
+      Vector<Ti> aggSizes{allocator, (size_t)nc};
+      aggSizes.reset(0);
+      policy(range(n), [&](Ti i) {
+        Ti agg = aggs[i];
+        if (agg == -1) {
+          /// roots are maximal in S^2, some strong neighbor is already aggregated
+          auto j = strongestNeighborAgg(i, [&](Ti j) { return aggs[j] != -1; });
+          agg = j != -1 ? aggs[j] : -1;
+        }
+        /// @note a vertex left without aggregate gets an empty prolongation row
+        if (agg != -1) atomic_add(wrapv<space>{}, &aggSizes[agg], (Ti)1);
+        rootIds[i] = agg;
+      });
+      policy(range(n), [&](Ti i) { aggs[i] = rootIds[i]; });
+
+      /// @brief smoothed prolongation P = (I - w D^{-1} A) P_tentative
+      spmat_type P{valloc, n, nc};
+      {
+        const T omega = prolongationDamping / level->lambdaMax;
+        spmat_type Pt{valloc, n, nc};
+        Pt._ptrs.resize((size_t)n + 1);
+        Pt._inds.resize(n);
+        Pt._vals.resize(n);
+        policy(range(n + 1), [&](Ti i) { Pt._ptrs[i] = i; });
+        policy(range(n), [&](Ti i) {
+          const Ti agg = aggs[i];
+          /// unaggregated vertices keep an explicit zero so that every row has one entry
+          Pt._inds[i] = agg != -1 ? agg : 0;
+          Pt._vals[i] = agg != -1 ? (T)1 / std::sqrt((T)aggSizes[agg]) : (T)0;
+        });
+        spmat_type DinvA = level->A;
+        policy(range(n), [&](Ti i) {
+          for (auto k = DinvA._ptrs[i]; k != DinvA._ptrs[i + 1]; ++k) {
+            DinvA._vals[k] *= -omega * level->invDiag[i];
+            if (DinvA._inds[k] == i) DinvA._vals[k] += (T)1;
+          }
+        });
+        P = spgemm(policy, DinvA, Pt);
+      }
+      level->P = zs::move(P);
+      level->R.transposeFrom(policy, level->P);
+
+      /// @brief galerkin coarse operator A_c = R A P
+      auto AP = spgemm(policy, level->A, level->P);
+      spmat_type Ac = spgemm(policy, level->R, AP);
+      levels.emplace_back();
+      levels.back().A = zs::move(Ac);
+    }
+  }
+
+  template <typename T, typename Ti, typename Tn, typename AllocatorT>
+  template <typename Policy>
+  void SmoothedAggregationAmg<T, Ti, Tn, AllocatorT>::smooth(Policy &&policy, Level &level,
+                                                             bool pre) {
+    constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+    /// @note forward sweeps before and backward sweeps after the coarse correction keep the
+    /// v-cycle symmetric
+    if (smoother == amg_smoother_e::multicolor_gauss_seidel) {
+      level.gs.sweep(policy, level.b, level.x, pre);
+      return;
+    }
+    const Ti n = level.A.rows();
+    /// @note chebyshev iteration on D^{-1} A targeting [lambda / ratio, 1.1 lambda]
+    const T upper = (T)1.1 * level.lambdaMax;
+    const T lower = upper / chebyshevRatio;
+    const T theta = (upper + lower) / 2, delta = (upper - lower) / 2;
+    const T sigma = theta / delta;
+    T rho = 1 / sigma;
+
+    auto residual = [&]() {
+      spmv(policy, level.A, level.x, level.r);
+      policy(range(n), [r = view<space>(level.r), b = view<space>(level.b),
+                        invDiag = view<space>(level.invDiag)] ZS_LAMBDA(Ti i) mutable {
+        r[i] = (b[i] - r[i]) * invDiag[i];
+      });
+    };
+    residual();
+    policy(range(n), [d = view<space>(level.d), r = view<space>(level.r), theta] ZS_LAMBDA(
+                         Ti i) mutable { d[i] = r[i] / theta; });
+    for (int k = 0; k != chebyshevDegree; ++k) {
+      policy(range(n), [x = view<space>(level.x), d = view<space>(level.d)] ZS_LAMBDA(
+                           Ti i) mutable { x[i] += d[i]; });
+      if (k + 1 == chebyshevDegree) break;
+      residual();
+      T rhoNew = 1 / (2 * sigma - rho);
+      T c0 = rhoNew * rho, c1 = 2 * rhoNew / delta;
+      policy(range(n), [d = view<space>(level.d), r = view<space>(level.r), c0, c1] ZS_LAMBDA(
+                           Ti i) mutable { d[i] = c0 * d[i] + c1 * r[i]; });
+      rho = rhoNew;
+    }
+  }
+
+  template <typename T, typename Ti, typename Tn, typename AllocatorT>
+  template <typename Policy>
+  void SmoothedAggregationAmg<T, Ti, Tn, AllocatorT>::vcycle(Policy &&policy, Ti l) {
+    constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+    auto &level = levels[l];
+    if (l + 1 == numLevels()) {
+      solveCoarsest(level);
+      return;
+    }
+    auto &coarse = levels[l + 1];
+    const Ti n = level.A.rows();
+    level.x.reset(0);
+    smooth(policy, level, true);
+    /// restrict the residual
+    spmv(policy, level.A, level.x, level.r);
+    policy(range(n), [r = view<space>(level.r), b = view<space>(level.b)] ZS_LAMBDA(
+                         Ti i) mutable { r[i] = b[i] - r[i]; });
+    spmv(policy, level.R, level.r, coarse.b);
+    vcycle(policy, l + 1);
+    /// prolongate the correction
+    spmv(policy, level.P, coarse.x, level.r);
+    policy(range(n), [x = view<space>(level.x), r = view<space>(level.r)] ZS_LAMBDA(
+                         Ti i) mutable { x[i] += r[i]; });
+    smooth(policy, level, false);
+  }
+
+  template <typename T, typename Ti, typename Tn, typename AllocatorT>
+  template <typename Policy, typename BRange, typename XRange>
+  void SmoothedAggregationAmg<T, Ti, Tn, AllocatorT>::apply(Policy &&policy, BRange &&b,
+                                                          XRange &&x) {
+    constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+    if (range_size(b) != numDofs() || range_size(x) != numDofs())
+      throw std::runtime_error("amg apply size mismatch");
+    auto &fine = levels[0];
+    policy(range(numDofs()), [src = std::begin(b), dst = view<space>(fine.b)] ZS_LAMBDA(
+                                 Ti i) mutable { dst[i] = src[i]; });
+    vcycle(policy, 0);
+    policy(range(numDofs()), [src = view<space>(fine.x), dst = std::begin(x)] ZS_LAMBDA(
+                                 Ti i) mutable { dst[i] = src[i]; });
+  }
+
+  /// @brief spmat system operator for ConjugateGradient and friends (dofview protocol)
+  template <typename SpMatT, typename PreconditionerT> struct PreconditionedSparseSystem {
+    using value_type = typename SpMatT::value_type;
+    using index_type = typename SpMatT::index_type;
+
+    PreconditionedSparseSystem(const SpMatT &A, PreconditionerT &precond)
+        : A{A},
+          precond{precond},
+          in{A._vals.get_allocator(), (size_t)A.rows()},
+          out{A._vals.get_allocator(), (size_t)A.rows()} {}
+
+    template <class ExecutionPolicy, typename In, typename Out>
+    void multiply(ExecutionPolicy &&policy, In &&x, Out &&y) {
+      constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+      policy(range(A.rows()), [x, in = view<space>(in)] ZS_LAMBDA(index_type i) mutable {
+        in[i] = x.get(i, scalar_c);
+      });
+      spmv(policy, A, in, out);
+      policy(range(A.rows()), [y, out = view<space>(out)] ZS_LAMBDA(index_type i) mutable {
+        y.set(i, out[i]);
+      });
+    }
+    template <class ExecutionPolicy, typename InOut>
+    void project(ExecutionPolicy &&, InOut &&) {}
+    template <class ExecutionPolicy, typename In, typename Out>
+    void precondition(ExecutionPolicy &&policy, In &&x, Out &&y) {
+      precond.precondition(FWD(policy), FWD(x), FWD(y));
+    }
+
+    const SpMatT &A;
+    PreconditionerT &precond;
+    Vector<value_type, typename SpMatT::allocator_type> in, out;
+  };
+
+}  // namespace zs
@@ -21,6 +21,8 @@ namespace zs {
     size_type numDofs;
     T tol;
     T relTol;
+    /// print the residual and intermediate vector norms of every iteration
+    bool verbose{false};
 
     ConjugateGradient(const allocator_type& allocator, size_type ndofs)
         : x_{allocator, ndofs},
@@ -84,8 +86,9 @@ namespace zs {
 
       int iter = 0;
       auto condition = [&iter]() { return iter >= 1; };
-      auto shouldPrint = [](bool v = true) { return v; };
+      auto shouldPrint = [this](bool v = true) { return verbose && v; };
       auto checkVector = [&policy, this](auto&& v) {
+        if (!verbose) return;
         auto res = dotProduct(policy, v, v);
         std::cout << "\tchecking result dotprod: " << res << '\n';
       };
@@ -116,7 +119,7 @@ namespace zs {
       }
 
       zTrk = dotProduct(policy, r, q);  // zTrk = std::abs(dotProduct(r, q));
-      std::cout << "pre loop, zTrk " << zTrk << " (r.dot(q))\n";
+      if (shouldPrint()) std::cout << "pre loop, zTrk " << zTrk << " (r.dot(q))\n";
       residualPreconditionedNorm = std::sqrt(zTrk);
       T localTol = std::min(relTol * residualPreconditionedNorm, tol);
       for (; iter != maxIters; ++iter) {
@@ -168,7 +171,6 @@ namespace zs {
         }
 
         residualPreconditionedNorm = std::sqrt(zTrk);
-        if (iter >= 1) getchar();
       }
       policy(range(numDofs), DofAssign{x, xinout});
       return iter;
@@ -0,0 +1,169 @@
+#pragma once
+#include <vector>
+
+#include "zensim/container/Vector.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/graph/Coloring.hpp"
+
+namespace zs {
+
+  /// @brief multicolor gauss-seidel / sor operator
+  /// @note rows are colored (fast_independent_sets upon the symmetric sparsity pattern) and
+  /// regrouped by color once, each color is then relaxed in parallel
+  /// @note forward/backward sweeps and their symmetric composition (ssor), the latter being
+  /// usable as a cg preconditioner
+  template <typename T = double, typename Ti = int, typename Tn = int,
+            typename AllocatorT = ZSPmrAllocator<>>
+  struct MulticolorGaussSeidel {
+    static_assert(is_floating_point_v<T>, "gauss-seidel value_type should be floating point.");
+    using value_type = T;
+    using index_type = Ti;
+    using allocator_type = AllocatorT;
+    using spmat_type = SparseMatrix<T, true, Ti, Tn, AllocatorT>;
+    using size_type = typename spmat_type::size_type;
+
+    /// relaxation factor, 1 for gauss-seidel
+    T omega{1};
+
+    /// rows regrouped by color: row k of 'rows' is the original row 'rowIds[k]'
+    spmat_type rows{};
+    Vector<Ti, AllocatorT> rowIds{};
+    Vector<T, AllocatorT> invDiag{};
+    /// host-side [colorOffsets[c], colorOffsets[c + 1]) row range of color c
+    std::vector<size_type> colorOffsets{};
+
+    Ti numColors() const noexcept { return colorOffsets.size() ? colorOffsets.size() - 1 : 0; }
+    Ti numDofs() const noexcept { return rows.rows(); }
+
+    template <typename Policy> void build(Policy &&policy, const spmat_type &A);
+
+    /// @brief one sor sweep upon x (in place), forward or backward in color order
+    template <typename Policy, typename BRange, typename XRange>
+    void sweep(Policy &&policy, BRange &&b, XRange &&x, bool forward = true) const;
+    /// @brief forward sweep followed by a backward one
+    template <typename Policy, typename BRange, typename XRange>
+    void symmetricSweep(Policy &&policy, BRange &&b, XRange &&x) const {
+      sweep(policy, b, x, true);
+      sweep(policy, b, x, false);
+    }
+    /// @brief x = M_ssor^{-1} b, i.e. one symmetric sweep with zero initial guess
+    template <typename Policy, typename BRange, typename XRange>
+    void apply(Policy &&policy, BRange &&b, XRange &&x) const {
+      policy(x, [] ZS_LAMBDA(auto &v) { v = 0; });
+      symmetricSweep(policy, b, x);
+    }
+
+    /// @brief dofview-based preconditioner interface (see ConjugateGradient)
+    template <typename Policy, typename In, typename Out>
+    void precondition(Policy &&policy, In &&in, Out &&out) {
+      constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+      policy(range(numDofs()), [in, b = view<space>(bs)] ZS_LAMBDA(Ti i) mutable {
+        b[i] = in.get(i, scalar_c);
+      });
+      apply(policy, bs, xs);
+      policy(range(numDofs()), [out, x = view<space>(xs)] ZS_LAMBDA(Ti i) mutable {
+        out.set(i, x[i]);
+      });
+    }
+
+  protected:
+    Vector<T, AllocatorT> bs{}, xs{};
+  };
+
+  template <typename T, typename Ti, typename Tn, typename AllocatorT>
+  template <typename Policy>
+  void MulticolorGaussSeidel<T, Ti, Tn, AllocatorT>::build(Policy &&policy, const spmat_type &A) {
+    constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+    if (A.rows() != A.cols()) throw std::runtime_error("gauss-seidel requires a square spmat");
+    if (!valid_memspace_for_execution(policy, A.get_allocator()))
+      throw std::runtime_error("current memory location not compatible with the execution policy");
+
+    const Ti n = A.rows();
+    const auto &alloc = A._vals.get_allocator();
+    auto allocator = get_temporary_memory_source(policy);
+
+    /// coloring
+    Vector<u32> weights{allocator, (size_t)n};
+    Vector<Ti> colors{allocator, (size_t)n};
+    policy(enumerate(weights),
+           [] ZS_LAMBDA(Ti i, u32 & w) { w = detail::coloring_vertex_weight((u32)i); });
+    const Ti nc = fast_independent_sets(policy, A, weights, colors);
+
+    /// group rows by color
+    Vector<Ti> indices{allocator, (size_t)n}, sortedColors{allocator, (size_t)n};
+    rowIds = Vector<Ti, AllocatorT>{alloc, (size_t)n};
+    policy(enumerate(indices), [] ZS_LAMBDA(Ti i, Ti & id) { id = i; });
+    radix_sort_pair(policy, std::begin(colors), std::begin(indices), std::begin(sortedColors),
+                    std::begin(rowIds), n, 0, std::max((int)bit_count(nc + 1), 1));
+    Vector<size_type> offsets{allocator, (size_t)nc + 1};
+    offsets.setVal(n, nc);
+    policy(range(n), [sortedColors = view<space>(sortedColors),
+                      offsets = view<space>(offsets)] ZS_LAMBDA(Ti k) mutable {
+      /// colors are numbered from 1
+      auto c = sortedColors[k];
+      if (k == 0 || sortedColors[k - 1] != c)
+        for (auto cc = k == 0 ? 1 : sortedColors[k - 1] + 1; cc <= c; ++cc) offsets[cc - 1] = k;
+    });
+    colorOffsets.resize((size_t)nc + 1);
+    offsets.retrieveVals(colorOffsets.data());
+
+    /// gather rows in color order
+    rows = spmat_type{alloc, n, n};
+    rows._ptrs = Vector<size_type, AllocatorT>{alloc, (size_t)n + 1};
+    Vector<size_type> cnts{allocator, (size_t)n + 1};
+    policy(range(n), [A = view<space>(A), rowIds = view<space>(rowIds),
+                      cnts = view<space>(cnts)] ZS_LAMBDA(Ti k) mutable {
+      auto row = rowIds[k];
+      cnts[k] = A._ptrs[row + 1] - A._ptrs[row];
+    });
+    cnts.setVal(0, n);
+    exclusive_scan(policy, std::begin(cnts), std::end(cnts), std::begin(rows._ptrs));
+    rows._inds = Vector<Ti, AllocatorT>{alloc, (size_t)A.nnz()};
+    rows._vals = Vector<T, AllocatorT>{alloc, (size_t)A.nnz()};
+    invDiag = Vector<T, AllocatorT>{alloc, (size_t)n};
+    policy(range(n), [A = view<space>(A), rows = view<space>(rows), rowIds = view<space>(rowIds),
+                      invDiag = view<space>(invDiag)] ZS_LAMBDA(Ti k) mutable {
+      auto row = rowIds[k];
+      auto dst = rows._ptrs[k];
+      T diag = 0;
+      for (auto i = A._ptrs[row]; i != A._ptrs[row + 1]; ++i, ++dst) {
+        auto col = A._inds[i];
+        rows._inds[dst] = col;
+        rows._vals[dst] = A._vals[i];
+        if (col == row) diag += A._vals[i];
+      }
+      invDiag[k] = diag != 0 ? (T)1 / diag : (T)0;
+    });
+
+    bs = Vector<T, AllocatorT>{alloc, (size_t)n};
+    xs = Vector<T, AllocatorT>{alloc, (size_t)n};
+  }
+
+  template <typename T, typename Ti, typename Tn, typename AllocatorT>
+  template <typename Policy, typename BRange, typename XRange>
+  void MulticolorGaussSeidel<T, Ti, Tn, AllocatorT>::sweep(Policy &&policy, BRange &&b,
+                                                           XRange &&x, bool forward) const {
+    constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+    if (range_size(b) != numDofs() || range_size(x) != numDofs())
+      throw std::runtime_error("gauss-seidel sweep size mismatch");
+    const Ti nc = numColors();
+    for (Ti c = 0; c != nc; ++c) {
+      auto color = forward ? c : nc - 1 - c;
+      auto st = colorOffsets[color], ed = colorOffsets[color + 1];
+      policy(range(ed - st), [rows = view<space>(rows), rowIds = view<space>(rowIds),
+                              invDiag = view<space>(invDiag), b = std::begin(b),
+                              x = std::begin(x), omega = omega, st] ZS_LAMBDA(size_type k) mutable {
+        k += st;
+        auto row = rowIds[k];
+        T sum = b[row];
+        for (auto i = rows._ptrs[k]; i != rows._ptrs[k + 1]; ++i) {
+          auto col = rows._inds[i];
+          if (col != row) sum -= rows._vals[i] * x[col];
+        }
+        /// rows of the same color are not coupled, x[row] is only written here
+        x[row] = ((T)1 - omega) * x[row] + omega * sum * invDiag[k];
+      });
+    }
+  }
+
+}  // namespace zs
@@ -0,0 +1,335 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+#include "SVD.hpp"
+#include "zensim/container/TileVector.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/math/FloatLanes.hpp"
+
+namespace zs {
+  namespace math {
+
+    namespace detail {
+      /// @brief one jacobi conjugation of the symmetric 3x3 normal matrix, see svd_3d
+      /// @note (p, q) is the rotated pair, r the remaining diagonal entry. the quaternion parts
+      /// (qa, qb, qc) are passed permuted alongside the entries.
+      template <typename P>
+      void jacobi_conjugation_(P &p, P &pq, P &q, P &pr, P &qr, P &r, P &qa, P &qb, P &qc,
+                               P &qs) noexcept {
+        using mask_type = typename P::mask_type;
+        const P zero = P::broadcast(0.f), one = P::broadcast(1.f);
+        P sh = pq * P::broadcast(0.5f);
+        P tmp5 = p - q;
+
+        mask_type m = sh * sh >= P::broadcast(1.e-20f);
+        sh = P::select(m, sh, zero);
+        P ch = P::select(m, tmp5, one);
+
+        P t1 = sh * sh;
+        P t2 = ch * ch;
+        P t4 = P::rsqrt(t1 + t2);
+        sh = t4 * sh;
+        ch = t4 * ch;
+        m = t2 <= P::broadcast(5.8284273147583007813f) * t1;
+        sh = P::select(m, P::broadcast(0.3826834323650897717f), sh);
+        ch = P::select(m, P::broadcast(0.9238795325112867561f), ch);
+
+        t1 = sh * sh;
+        t2 = ch * ch;
+        const P c = t2 - t1;
+        const P s = (ch * sh) + (ch * sh);
+
+        P t3 = t1 + t2;
+        r = r * t3 * t3;
+        pr = pr * t3;
+        qr = qr * t3;
+
+        t1 = s * pr;
+        t2 = s * qr;
+        pr = c * pr + t2;
+        qr = c * qr - t1;
+
+        t2 = s * s;
+        t1 = q * t2;
+        t3 = p * t2;
+        t4 = c * c;
+        p = p * t4 + t1;
+        q = q * t4 + t3;
+        t4 = t4 - t2;
+        t2 = pq + pq;
+        pq = pq * t4;
+        t4 = c * s;
+        t2 = t2 * t4;
+        tmp5 = tmp5 * t4;
+        p = p + t2;
+        pq = pq - tmp5;
+        q = q - t2;
+
+        /// cumulative rotation, in quaternion form
+        t1 = sh * qa;
+        t2 = sh * qb;
+        t3 = sh * qc;
+        sh = sh * qs;
+        qs = ch * qs;
+        qa = ch * qa;
+        qb = ch * qb;
+        qc = ch * qc;
+        qc = qc + sh;
+        qs = qs - t3;
+        qa = qa + t2;
+        qb = qb - t1;
+      }
+
+      /// @brief givens rotation zeroing a(J, I) against the pivot a(I, I), accumulated into U
+      template <int I, int J, typename P> void qr_givens_(P (&a)[3][3], P (&u)[3][3]) noexcept {
+        const P small = P::broadcast(1.e-12f);
+        const P zero = P::broadcast(0.f);
+        const P &piv = a[I][I], &sub = a[J][I];
+        P sh = P::select(sub * sub >= small, sub, zero);
+        P ch = P::max(P::max(zero - piv, piv), small);
+        const auto positive = piv >= zero;
+
+        const P t2 = ch * ch + sh * sh;
+        ch = ch + t2 * P::rsqrt(t2);
+        const P t1 = P::select(positive, ch, sh);
+        sh = P::select(positive, sh, ch);
+        ch = t1;
+        const P w = P::rsqrt(ch * ch + sh * sh);
+        ch = ch * w;
+        sh = sh * w;
+        const P c = ch * ch - sh * sh;
+        const P s = (sh * ch) + (sh * ch);
+
+        for (int j = 0; j != 3; ++j) {
+          const P x = a[I][j], y = a[J][j];
+          a[I][j] = c * x + s * y;
+          a[J][j] = c * y - s * x;
+        }
+        for (int i = 0; i != 3; ++i) {
+          const P x = u[i][I], y = u[i][J];
+          u[i][I] = c * x + s * y;
+          u[i][J] = c * y - s * x;
+        }
+      }
+
+      /// @brief swap columns I, J of A and V if |a_I| < |a_J|, then negate column K of both
+      template <int I, int J, int K, typename P>
+      void sort_columns_(P (&a)[3][3], P (&v)[3][3], P (&rho)[3]) noexcept {
+        const auto m = rho[I] < rho[J];
+        for (int r = 0; r != 3; ++r) {
+          const P ai = a[r][I], vi = v[r][I];
+          a[r][I] = P::select(m, a[r][J], ai);
+          a[r][J] = P::select(m, ai, a[r][J]);
+          v[r][I] = P::select(m, v[r][J], vi);
+          v[r][J] = P::select(m, vi, v[r][J]);
+        }
+        const P ri = rho[I];
+        rho[I] = P::select(m, rho[J], ri);
+        rho[J] = P::select(m, ri, rho[J]);
+        for (int r = 0; r != 3; ++r) {
+          a[r][K] = P::select(m, -a[r][K], a[r][K]);
+          v[r][K] = P::select(m, -v[r][K], v[r][K]);
+        }
+      }
+    }  // namespace detail
+
+    /// @brief lane-parallel counterpart of svd_3d, A = U diag(S) V^T for P::width matrices
+    /// @note follows the same jacobi sweeps, column sorting and givens qr as svd_3d, so the
+    /// results agree with math::svd up to rounding (U, V are rotations, S(2) may be negative)
+    template <typename P>
+    void svd_3d_lanes(const P (&A)[3][3], P (&U)[3][3], P (&S)[3], P (&V)[3][3]) noexcept {
+      P a[3][3];
+      for (int i = 0; i != 3; ++i)
+        for (int j = 0; j != 3; ++j) a[i][j] = A[i][j];
+
+      /// normal equations
+      P s11 = a[0][0] * a[0][0] + a[1][0] * a[1][0] + a[2][0] * a[2][0];
+      P s21 = a[0][1] * a[0][0] + a[1][1] * a[1][0] + a[2][1] * a[2][0];
+      P s31 = a[0][2] * a[0][0] + a[1][2] * a[1][0] + a[2][2] * a[2][0];
+      P s22 = a[0][1] * a[0][1] + a[1][1] * a[1][1] + a[2][1] * a[2][1];
+      P s32 = a[0][2] * a[0][1] + a[1][2] * a[1][1] + a[2][2] * a[2][1];
+      P s33 = a[0][2] * a[0][2] + a[1][2] * a[1][2] + a[2][2] * a[2][2];
+
+      /// symmetric eigenproblem by jacobi iteration
+      P qs = P::broadcast(1.f), qx = P::broadcast(0.f), qy = qx, qz = qx;
+      for (int sweep = 0; sweep != 4; ++sweep) {
+        detail::jacobi_conjugation_(s11, s21, s22, s31, s32, s33, qx, qy, qz, qs);
+        detail::jacobi_conjugation_(s22, s32, s33, s21, s31, s11, qy, qz, qx, qs);
+        detail::jacobi_conjugation_(s33, s31, s11, s32, s21, s22, qz, qx, qy, qs);
+      }
+
+      /// normalized quaternion to V
+      {
+        const P w = P::rsqrt(qs * qs + qx * qx + qy * qy + qz * qz);
+        qs = qs * w;
+        qx = qx * w;
+        qy = qy * w;
+        qz = qz * w;
+      }
+      P v[3][3];
+      {
+        const P xx = qx * qx, yy = qy * qy, zz = qz * qz, ss = qs * qs;
+        v[0][0] = ss + xx - yy - zz;
+        v[1][1] = ss - xx + yy - zz;
+        v[2][2] = ss - xx - yy + zz;
+        const P x2 = qx + qx, y2 = qy + qy, z2 = qz + qz;
+        const P sx = qs * x2, sy = qs * y2, sz = qs * z2;
+        const P xy = qy * x2, yz = qz * y2, xz = qx * z2;
+        v[0][1] = xy - sz;
+        v[1][2] = yz - sx;
+        v[2][0] = xz - sy;
+        v[1][0] = xy + sz;
+        v[2][1] = yz + sx;
+        v[0][2] = xz + sy;
+      }
+
+      /// A <- A V
+      for (int i = 0; i != 3; ++i) {
+        const P r0 = a[i][0], r1 = a[i][1], r2 = a[i][2];
+        for (int j = 0; j != 3; ++j) a[i][j] = r0 * v[0][j] + r1 * v[1][j] + r2 * v[2][j];
+      }
+
+      /// sort the columns by decreasing norm, keeping V a rotation
+      P rho[3];
+      for (int j = 0; j != 3; ++j) rho[j] = a[0][j] * a[0][j] + a[1][j] * a[1][j] + a[2][j] * a[2][j];
+      detail::sort_columns_<0, 1, 1>(a, v, rho);
+      detail::sort_columns_<0, 2, 0>(a, v, rho);
+      detail::sort_columns_<1, 2, 2>(a, v, rho);
+
+      /// QR factorization of A V (= U S) by givens rotations
+      const P zero = P::broadcast(0.f), one = P::broadcast(1.f);
+      for (int i = 0; i != 3; ++i)
+        for (int j = 0; j != 3; ++j) U[i][j] = i == j ? one : zero;
+      detail::qr_givens_<0, 1>(a, U);
+      detail::qr_givens_<0, 2>(a, U);
+      detail::qr_givens_<1, 2>(a, U);
+
+      for (int i = 0; i != 3; ++i) {
+        S[i] = a[i][i];
+        for (int j = 0; j != 3; ++j) V[i][j] = v[i][j];
+      }
+    }
+
+    /// @brief lane-parallel polar decomposition A = R P (R rotation, P symmetric)
+    /// @note built upon svd_3d_lanes, R = U V^T and P = V diag(S) V^T
+    template <typename P>
+    void polar_3d_lanes(const P (&A)[3][3], P (&R)[3][3], P (&Sym)[3][3]) noexcept {
+      P U[3][3], S[3], V[3][3];
+      svd_3d_lanes(A, U, S, V);
+      for (int i = 0; i != 3; ++i)
+        for (int j = 0; j != 3; ++j) {
+          R[i][j] = U[i][0] * V[j][0] + U[i][1] * V[j][1] + U[i][2] * V[j][2];
+          Sym[i][j] = V[i][0] * S[0] * V[j][0] + V[i][1] * S[1] * V[j][1]
+                      + V[i][2] * S[2] * V[j][2];
+        }
+    }
+
+    namespace detail {
+      /// @brief [count] lanes of [Extent] channels (channel stride [stride]), padded with [pad]
+      template <typename P, int Extent>
+      void load_lanes_(P *dst, const float *src, size_t stride, size_t count,
+                       const float (&pad)[Extent]) noexcept {
+        constexpr int W = P::width;
+        if (count == (size_t)W) {
+          for (int c = 0; c != Extent; ++c) dst[c] = P::load(src + c * stride);
+          return;
+        }
+        float buf[W];
+        for (int c = 0; c != Extent; ++c) {
+          for (int l = 0; l != W; ++l) buf[l] = (size_t)l < count ? src[c * stride + l] : pad[c];
+          dst[c] = P::load(buf);
+        }
+      }
+      template <typename P>
+      void store_lanes_(const P *src, int extent, float *dst, size_t stride,
+                        size_t count) noexcept {
+        constexpr int W = P::width;
+        if (count == (size_t)W) {
+          for (int c = 0; c != extent; ++c) src[c].store(dst + c * stride);
+          return;
+        }
+        float buf[W];
+        for (int c = 0; c != extent; ++c) {
+          src[c].store(buf);
+          for (size_t l = 0; l != count; ++l) dst[c * stride + l] = buf[l];
+        }
+      }
+
+      /// @brief visits the tilevector in batches of P::width consecutive elements
+      /// @note the batch width divides lane_width, so each batch lies within a single tile and
+      /// every channel of it is one contiguous (unit-stride) load
+      template <typename Policy, size_t Length, typename Allocator, typename F>
+      void for_each_lane_batch_(Policy &&pol, TileVector<float, Length, Allocator> &tv, F &&f) {
+        constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+        static_assert(space == execspace_e::host || space == execspace_e::openmp,
+                      "lane-batched decompositions are only available for host execution policies.");
+        if (!valid_memspace_for_execution(pol, tv.get_allocator()))
+          throw std::runtime_error("current memory location not compatible with the execution policy");
+        constexpr size_t W = batch_float_lanes<Length>();
+        const size_t n = tv.size();
+        const size_t numChannels = tv.numChannels();
+        float *data = tv.data();
+        pol(range((n + W - 1) / W), [&](size_t b) {
+          const size_t first = b * W;
+          f(data + first / Length * numChannels * Length + first % Length,
+            n - first < W ? n - first : W);
+        });
+      }
+
+      template <typename TileVectorT>
+      int require_property_(const TileVectorT &tv, const SmallString &tag, int extent) {
+        const auto handle = tv.getPropertyHandle(tag);
+        if (handle.extent != extent)
+          throw std::runtime_error(std::string("tilevector property [") + tag.asChars()
+                                   + "] should have " + std::to_string(extent) + " channels");
+        return handle.offset;
+      }
+    }  // namespace detail
+
+    /// @brief F = U diag(S) V^T for every element of [tv], evaluated in simd batches
+    /// @note [fTag], [uTag], [vTag] are 9-channel (row-major 3x3) properties, [sTag] is 3-channel
+    template <typename Policy, size_t Length, typename Allocator>
+    void svd_3d_tiles(Policy &&pol, TileVector<float, Length, Allocator> &tv,
+                      const SmallString &fTag, const SmallString &uTag, const SmallString &sTag,
+                      const SmallString &vTag) {
+      using P = detail::float_lanes<detail::batch_float_lanes<Length>()>;
+      const int fOffset = detail::require_property_(tv, fTag, 9);
+      const int uOffset = detail::require_property_(tv, uTag, 9);
+      const int sOffset = detail::require_property_(tv, sTag, 3);
+      const int vOffset = detail::require_property_(tv, vTag, 9);
+      detail::for_each_lane_batch_(pol, tv, [&](float *base, size_t count) {
+        constexpr float identity[9] = {1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f};
+        P F[3][3], U[3][3], S[3], V[3][3];
+        detail::load_lanes_<P, 9>(&F[0][0], base + fOffset * Length, Length, count, identity);
+        svd_3d_lanes(F, U, S, V);
+        detail::store_lanes_(&U[0][0], 9, base + uOffset * Length, Length, count);
+        detail::store_lanes_(S, 3, base + sOffset * Length, Length, count);
+        detail::store_lanes_(&V[0][0], 9, base + vOffset * Length, Length, count);
+      });
+    }
+
+    /// @brief F = R P for every element of [tv], evaluated in simd batches
+    /// @note [rTag] receives the rotation, [pTag] (if not empty) the symmetric factor
+    template <typename Policy, size_t Length, typename Allocator>
+    void polar_3d_tiles(Policy &&pol, TileVector<float, Length, Allocator> &tv,
+                        const SmallString &fTag, const SmallString &rTag,
+                        const SmallString &pTag = "") {
+      using P = detail::float_lanes<detail::batch_float_lanes<Length>()>;
+      const int fOffset = detail::require_property_(tv, fTag, 9);
+      const int rOffset = detail::require_property_(tv, rTag, 9);
+      const bool withSym = pTag.size() != 0;
+      const int pOffset = withSym ? detail::require_property_(tv, pTag, 9) : 0;
+      detail::for_each_lane_batch_(pol, tv, [&](float *base, size_t count) {
+        constexpr float identity[9] = {1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f};
+        P F[3][3], R[3][3], Sym[3][3];
+        detail::load_lanes_<P, 9>(&F[0][0], base + fOffset * Length, Length, count, identity);
+        polar_3d_lanes(F, R, Sym);
+        detail::store_lanes_(&R[0][0], 9, base + rOffset * Length, Length, count);
+        if (withSym) detail::store_lanes_(&Sym[0][0], 9, base + pOffset * Length, Length, count);
+      });
+    }
+
+  }  // namespace math
+}  // namespace zs
@@ -361,14 +361,14 @@ namespace zs {
     /// @brief in-place
     template <typename Policy, bool ORowMajor, bool PostOrder = true> void transposeFrom(
         Policy &&policy,
-        const SparseMatrix<value_type, ORowMajor, index_type, size_type, allocator_type> &o,
+        const SparseMatrix<value_type, ORowMajor, index_type, Tn, allocator_type> &o,
         wrapv<PostOrder> = {});
     template <typename Policy> void transpose(Policy &&policy) {
       transposeFrom(FWD(policy), *this);
     }
     template <typename Policy, bool ORowMajor> void transposeTo(
         Policy &&policy,
-        SparseMatrix<value_type, ORowMajor, index_type, size_type, allocator_type> &o) const {
+        SparseMatrix<value_type, ORowMajor, index_type, Tn, allocator_type> &o) const {
       o.transposeFrom(FWD(policy), *this);
     }
 
@@ -593,7 +593,7 @@ namespace zs {
   template <typename Policy, bool ORowMajor, bool PostOrder>
   void SparseMatrix<T, RowMajor, Ti, Tn, AllocatorT>::transposeFrom(
       Policy &&policy,
-      const SparseMatrix<value_type, ORowMajor, index_type, size_type, allocator_type> &o,
+      const SparseMatrix<value_type, ORowMajor, index_type, Tn, allocator_type> &o,
       wrapv<PostOrder>) {
     constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
     if (!valid_memspace_for_execution(policy, o.get_allocator()))
@@ -628,6 +628,8 @@ namespace zs {
       auto nnz = o.nnz();
       auto nOuter = o.outerSize();
       auto nInner = o.innerSize();
+      auto oNRows = o.rows();
+      auto oNCols = o.cols();
       auto allocator = get_temporary_memory_source(policy);
       Vector<size_type> localOffsets{allocator, (size_t)nnz};
       Vector<size_type> cnts{allocator, (size_t)(nInner + 1)};
@@ -651,6 +653,8 @@ namespace zs {
                             view<space>(o._vals), view<space>(_ptrs), view<space>(_inds),
                             view<space>(_vals), valActivated),
              _transpose_from_reorder_vals{});
+      _nrows = oNCols;
+      _ncols = oNRows;
     }
     if constexpr (PostOrder) localOrdering(policy);
   }
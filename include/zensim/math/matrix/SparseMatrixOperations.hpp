@@ -1,6 +1,10 @@
 #pragma once
+#include <algorithm>
+#include <vector>
+
 #include "SparseMatrix.hpp"
 #include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/math/Hash.hpp"
 
 namespace zs {
 
@@ -345,4 +349,230 @@ namespace zs {
            _spmv_mask_col_major{});
   }
 
-}  // namespace zs
\ No newline at end of file
+  ///@note spgemm (row major), two phases: symbolic (sparsity pattern) and numeric
+  /// every row accumulates its products in an open-addressing table of its own, sized by the
+  /// row's number of products (symbolic) or of nonzeros of C (numeric). the tables of a batch of
+  /// rows share one scratch buffer, reused batch after batch, thus scratch memory stays bounded
+  /// instead of growing with the total number of products.
+  template <typename Ti, typename SizeT> struct _spgemm_row_table {
+    static constexpr Ti empty = (Ti)-1;
+
+    constexpr void clear() {
+      for (SizeT s = 0; s != cap; ++s) keys[s] = empty;
+    }
+    /// @return slot of [col] (inserted if absent), or cap when the table is full
+    constexpr SizeT insert(Ti col, bool &inserted) {
+      inserted = false;
+      if (cap == 0) return cap;
+      SizeT s = (SizeT)zs::hash((u32)col) % cap;
+      for (SizeT n = 0; n != cap; ++n, s = s + 1 == cap ? 0 : s + 1) {
+        if (keys[s] == col) return s;
+        if (keys[s] == empty) {
+          keys[s] = col;
+          inserted = true;
+          return s;
+        }
+      }
+      return cap;
+    }
+    /// @return slot of [col], or cap when absent
+    constexpr SizeT find(Ti col) const {
+      if (cap == 0) return cap;
+      SizeT s = (SizeT)zs::hash((u32)col) % cap;
+      for (SizeT n = 0; n != cap; ++n, s = s + 1 == cap ? 0 : s + 1) {
+        if (keys[s] == col) return s;
+        if (keys[s] == empty) return cap;
+      }
+      return cap;
+    }
+
+    Ti *keys;
+    SizeT cap;
+  };
+
+  inline constexpr size_t s_spgemm_scratch_slots = (size_t)1 << 22;
+  /// @brief splits the rows into consecutive batches whose tables (two slots per entry counted by
+  /// the prefix sums [offsets]) fit in [budget] slots, a larger row forms a batch of its own
+  /// @return batch boundaries, [scratchSlots] is set to the slots of the largest batch
+  template <typename SizeT>
+  std::vector<size_t> _spgemm_row_batches(const SizeT *offsets, size_t nrows, size_t &scratchSlots,
+                                          size_t budget = s_spgemm_scratch_slots) {
+    std::vector<size_t> bounds{0};
+    scratchSlots = 0;
+    for (size_t r = 0; r != nrows;) {
+      const size_t r0 = r++;
+      while (r != nrows && 2 * (size_t)(offsets[r + 1] - offsets[r0]) <= budget) ++r;
+      bounds.push_back(r);
+      scratchSlots = std::max(scratchSlots, 2 * (size_t)(offsets[r] - offsets[r0]));
+    }
+    return bounds;
+  }
+
+  struct _spgemm_count_products {
+    template <typename Index, typename ParamT>
+    constexpr void operator()(Index row, ParamT &&params) const {
+      auto &[A, B, cnts] = params;
+      using size_type = RM_CVREF_T(cnts[row]);
+      size_type n = 0;
+      for (auto k = A._ptrs[row]; k != A._ptrs[row + 1]; ++k) {
+        auto j = A._inds[k];
+        n += B._ptrs[j + 1] - B._ptrs[j];
+      }
+      cnts[row] = n;
+    }
+  };
+  /// @note counts the distinct columns of a row, or gathers them (unsorted) when [Gather]
+  template <bool Gather> struct _spgemm_symbolic_row {
+    template <typename Index, typename ParamT>
+    constexpr void operator()(Index i, ParamT &&params) const {
+      auto &[A, B, keys, offsets, rowBase, slotBase, cnts, ptrs, inds] = params;
+      using Ti = typename RM_CVREF_T(A)::index_type;
+      using SizeT = RM_CVREF_T(slotBase);
+      const auto row = rowBase + (Ti)i;
+      _spgemm_row_table<Ti, SizeT> tab{&keys[2 * offsets[row] - slotBase],
+                                       2 * (offsets[row + 1] - offsets[row])};
+      tab.clear();
+      SizeT n = 0;
+      bool inserted = false;
+      for (auto k = A._ptrs[row]; k != A._ptrs[row + 1]; ++k) {
+        auto j = A._inds[k];
+        for (auto l = B._ptrs[j]; l != B._ptrs[j + 1]; ++l) {
+          tab.insert(B._inds[l], inserted);
+          if (inserted) {
+            if constexpr (Gather) inds[ptrs[row] + n] = B._inds[l];
+            ++n;
+          }
+        }
+      }
+      if constexpr (!Gather) cnts[row] = n;
+    }
+  };
+  /// @note accumulates the products of a row in its table, then scatters them into C's row
+  struct _spgemm_numeric_row {
+    template <typename Index, typename ParamT>
+    constexpr void operator()(Index i, ParamT &&params) const {
+      auto &[A, B, C, keys, vals, rowBase, slotBase] = params;
+      using Ti = typename RM_CVREF_T(A)::index_type;
+      using SizeT = RM_CVREF_T(slotBase);
+      using T = typename RM_CVREF_T(C)::value_type;
+      const auto row = rowBase + (Ti)i;
+      const auto base = 2 * (SizeT)C._ptrs[row] - slotBase;
+      _spgemm_row_table<Ti, SizeT> tab{&keys[base],
+                                       2 * (SizeT)(C._ptrs[row + 1] - C._ptrs[row])};
+      tab.clear();
+      bool inserted = false;
+      for (auto k = A._ptrs[row]; k != A._ptrs[row + 1]; ++k) {
+        auto j = A._inds[k];
+        auto a = A._vals[k];
+        for (auto l = B._ptrs[j]; l != B._ptrs[j + 1]; ++l) {
+          const auto s = tab.insert(B._inds[l], inserted);
+          /// @note the table only overflows when the patterns of A, B changed since the symbolic
+          /// phase, such products have no place in C anyway
+          if (s == tab.cap) continue;
+          if (inserted) vals[base + s] = (T)0;
+          vals[base + s] += a * B._vals[l];
+        }
+      }
+      for (auto k = C._ptrs[row]; k != C._ptrs[row + 1]; ++k) {
+        const auto s = tab.find(C._inds[k]);
+        C._vals[k] = s != tab.cap ? vals[base + s] : (T)0;
+      }
+    }
+  };
+
+  /// @brief symbolic spgemm, sets up the (sorted) sparsity pattern of C = A * B
+  /// @note C._vals is allocated but not computed, see spgemm_numeric
+  template <typename Policy, typename T, typename Ti, typename Tn, typename AllocatorT>
+  inline void spgemm_symbolic(Policy &&policy, const SparseMatrix<T, true, Ti, Tn, AllocatorT> &A,
+                              const SparseMatrix<T, true, Ti, Tn, AllocatorT> &B,
+                              SparseMatrix<T, true, Ti, Tn, AllocatorT> &C) {
+    using spmat_type = SparseMatrix<T, true, Ti, Tn, AllocatorT>;
+    using size_type = typename spmat_type::size_type;
+    constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+
+    if (A.cols() != B.rows()) throw std::runtime_error("spgemm size mismatch");
+    if (!valid_memspace_for_execution(policy, A.get_allocator())
+        || !valid_memspace_for_execution(policy, B.get_allocator()))
+      throw std::runtime_error("current memory location not compatible with the execution policy");
+    if (&C == &A || &C == &B) throw std::runtime_error("spgemm output aliases an input");
+
+    const Ti nrows = A.rows();
+    auto allocator = get_temporary_memory_source(policy);
+
+    /// @brief number of scalar products of every row, upper bound of its number of entries
+    Vector<size_type> cnts{allocator, (size_t)nrows + 1};
+    policy(range(nrows), zs::make_tuple(view<space>(A), view<space>(B), view<space>(cnts)),
+           _spgemm_count_products{});
+    cnts.setVal(0, nrows);
+    Vector<size_type> offsets{allocator, (size_t)nrows + 1};
+    exclusive_scan(policy, std::begin(cnts), std::end(cnts), std::begin(offsets));
+
+    auto hostOffsets = offsets.clone({memsrc_e::host, -1});
+    size_t scratchSlots = 0;
+    const auto bounds = _spgemm_row_batches(hostOffsets.data(), (size_t)nrows, scratchSlots);
+    Vector<Ti> keys{allocator, std::max(scratchSlots, (size_t)1)};
+
+    /// @brief pattern, distinct columns counted first, then gathered
+    C = spmat_type{A.get_allocator(), A.rows(), B.cols()};
+    C._ptrs.resize((size_t)nrows + 1);
+    const auto run = [&](auto gather) {
+      for (size_t b = 0; b + 1 < bounds.size(); ++b)
+        policy(range(bounds[b + 1] - bounds[b]),
+               zs::make_tuple(view<space>(A), view<space>(B), view<space>(keys),
+                              view<space>(offsets), (Ti)bounds[b],
+                              (size_type)(2 * hostOffsets[bounds[b]]), view<space>(cnts),
+                              view<space>(C._ptrs), view<space>(C._inds)),
+               _spgemm_symbolic_row<RM_CVREF_T(gather)::value>{});
+    };
+    run(false_c);
+    cnts.setVal(0, nrows);
+    exclusive_scan(policy, std::begin(cnts), std::end(cnts), std::begin(C._ptrs));
+    auto nnz = C._ptrs.getVal(nrows);
+    C._inds.resize(nnz);
+    run(true_c);
+    C._vals = Vector<T, AllocatorT>{};
+    C.localOrdering(policy, false_c);
+    C._vals = Vector<T, AllocatorT>{A._vals.get_allocator(), (size_t)nnz};
+  }
+
+  /// @brief numeric spgemm, C = A * B upon the pattern from spgemm_symbolic
+  /// @note the pattern is reusable as long as the patterns of A and B remain unchanged
+  template <typename Policy, typename T, typename Ti, typename Tn, typename AllocatorT>
+  inline void spgemm_numeric(Policy &&policy, const SparseMatrix<T, true, Ti, Tn, AllocatorT> &A,
+                             const SparseMatrix<T, true, Ti, Tn, AllocatorT> &B,
+                             SparseMatrix<T, true, Ti, Tn, AllocatorT> &C) {
+    using size_type = typename SparseMatrix<T, true, Ti, Tn, AllocatorT>::size_type;
+    constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+    if (A.cols() != B.rows() || C.rows() != A.rows() || C.cols() != B.cols())
+      throw std::runtime_error("spgemm size mismatch");
+    if (C._vals.size() != C._inds.size())
+      throw std::runtime_error("spgemm output pattern not set up (see spgemm_symbolic)");
+    if (!valid_memspace_for_execution(policy, A.get_allocator())
+        || !valid_memspace_for_execution(policy, B.get_allocator()))
+      throw std::runtime_error("current memory location not compatible with the execution policy");
+
+    const Ti nrows = A.rows();
+    auto allocator = get_temporary_memory_source(policy);
+    auto hostPtrs = C._ptrs.clone({memsrc_e::host, -1});
+    size_t scratchSlots = 0;
+    const auto bounds = _spgemm_row_batches(hostPtrs.data(), (size_t)nrows, scratchSlots);
+    Vector<Ti> keys{allocator, std::max(scratchSlots, (size_t)1)};
+    Vector<T> vals{allocator, std::max(scratchSlots, (size_t)1)};
+    for (size_t b = 0; b + 1 < bounds.size(); ++b)
+      policy(range(bounds[b + 1] - bounds[b]),
+             zs::make_tuple(view<space>(A), view<space>(B), view<space>(C), view<space>(keys),
+                            view<space>(vals), (Ti)bounds[b],
+                            (size_type)(2 * (size_type)hostPtrs[bounds[b]])),
+             _spgemm_numeric_row{});
+  }
+
+  template <typename Policy, typename T, typename Ti, typename Tn, typename AllocatorT>
+  inline auto spgemm(Policy &&policy, const SparseMatrix<T, true, Ti, Tn, AllocatorT> &A,
+                     const SparseMatrix<T, true, Ti, Tn, AllocatorT> &B) {
+    SparseMatrix<T, true, Ti, Tn, AllocatorT> C{A.get_allocator(), A.rows(), B.cols()};
+    spgemm_symbolic(policy, A, B, C);
+    spgemm_numeric(policy, A, B, C);
+    return C;
+  }
+
+}  // namespace zs
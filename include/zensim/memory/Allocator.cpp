@@ -1,8 +1,10 @@
 #include "Allocator.h"
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <sstream>
+#include <unordered_map>
 
 #include "zensim/Logger.hpp"
 
@@ -332,6 +334,406 @@ namespace zs {
   void stack_virtual_memory_resource<host_mem_tag>::do_deallocate(void *ptr, size_t bytes,
                                                                   size_t alignment) {}
 
+  /// scratch_arena
+  scratch_arena::scratch_arena(size_t reservation, mr_t *upstream) : _upstream{upstream} {
+    _vmr = zs::make_unique<stack_virtual_memory_resource<host_mem_tag>>(
+        (ProcID)-1, reservation ? reservation : default_reservation);
+  }
+  scratch_arena::~scratch_arena() = default;
+
+  bool scratch_arena::owns_(const void *p) const noexcept {
+    auto base = static_cast<const char *>(_vmr->address(0));
+    return p >= base && p < base + _vmr->_reservedSpace;
+  }
+
+  void *scratch_arena::allocate(size_t bytes, size_t alignment) {
+    if (bytes == 0) return nullptr;
+    bytes = round_up(bytes, block_granularity);
+    std::lock_guard<std::mutex> lk{_mutex};
+    _stats.numAllocations++;
+    const size_t offset = round_up(_offset, alignment);
+    void *ret = nullptr;
+    if (offset + bytes <= _vmr->_reservedSpace
+        && (_vmr->check_residency(0, offset + bytes) || _vmr->commit(0, offset + bytes))) {
+      ret = _vmr->address(offset);
+      _offset = offset + bytes;
+    } else {
+      ret = _upstream->allocate(bytes, alignment);
+      _upstreamBytes += bytes;
+      _stats.numFallbacks++;
+    }
+    _live++;
+    _demand = std::max(_demand, _offset + _upstreamBytes);
+    _stats.highWater = std::max(_stats.highWater, _offset + _upstreamBytes);
+    return ret;
+  }
+
+  void scratch_arena::deallocate(void *p, size_t bytes, size_t alignment) {
+    if (p == nullptr) return;
+    bytes = round_up(bytes, block_granularity);
+    std::lock_guard<std::mutex> lk{_mutex};
+    if (owns_(p)) {
+      const size_t offset = static_cast<size_t>(static_cast<char *>(p)
+                                                - static_cast<char *>(_vmr->address(0)));
+      if (offset + bytes == _offset) {
+        _offset = offset;
+        /// released blocks that become the top are popped as well
+        for (bool popped = true; popped;) {
+          popped = false;
+          for (auto it = _holes.begin(); it != _holes.end(); ++it)
+            if (it->second == _offset) {
+              _offset = it->first;
+              _holes.erase(it);
+              popped = true;
+              break;
+            }
+        }
+      } else
+        _holes.emplace_back(offset, offset + bytes);
+    } else {
+      _upstream->deallocate(p, bytes, alignment);
+      _upstreamBytes -= bytes;
+    }
+    if (--_live == 0) rewind_();
+  }
+
+  void scratch_arena::rewind_() {
+    _offset = 0;
+    _holes.clear();
+    if (_demand > _vmr->_reservedSpace) {
+      /// the committed pages are dropped along with the old reservation
+      _vmr = zs::make_unique<stack_virtual_memory_resource<host_mem_tag>>(
+          (ProcID)-1, std::max(_demand, _vmr->_reservedSpace * 2));
+      _stats.numGrows++;
+    }
+    _demand = 0;
+  }
+
+  bool scratch_arena::trim(size_t keepBytes) {
+    std::lock_guard<std::mutex> lk{_mutex};
+    if (_live != 0) return false;
+    const size_t committed = _vmr->_allocatedSpace;
+    if (keepBytes >= committed) return true;
+    return _vmr->evict(keepBytes, committed - keepBytes);
+  }
+
+  scratch_arena_stats scratch_arena::stats() const {
+    std::lock_guard<std::mutex> lk{_mutex};
+    auto ret = _stats;
+    ret.used = _offset;
+    ret.committed = _vmr->_allocatedSpace;
+    ret.reserved = _vmr->_reservedSpace;
+    return ret;
+  }
+
+  void scratch_arena::reset_high_water() {
+    std::lock_guard<std::mutex> lk{_mutex};
+    _stats.highWater = _offset + _upstreamBytes;
+  }
+
+  /// memory_pools
+  namespace {
+    constexpr u32 k_num_fine_classes = 16;  // 16, 32, ..., 256
+    constexpr u32 k_num_size_classes = k_num_fine_classes + 7 * 4;  // quarter steps up to 32K
+    constexpr u32 k_max_batch = 64;
+
+    constexpr size_t size_class_bytes(u32 cls) noexcept {
+      if (cls < k_num_fine_classes) return (size_t)(cls + 1) * 16;
+      cls -= k_num_fine_classes;
+      const size_t base = (size_t)256 << (cls / 4);
+      return base + (base / 4) * (cls % 4 + 1);
+    }
+    static_assert(size_class_bytes(k_num_size_classes - 1) == memory_pools::max_small_bytes,
+                  "size classes should cover the small allocations");
+
+    /// blocks moved between a thread cache and the central list at a time
+    constexpr u32 batch_size(u32 cls) noexcept {
+      const size_t n = ((size_t)16 << 10) / size_class_bytes(cls);
+      return n < 2 ? 2 : (n > k_max_batch ? k_max_batch : (u32)n);
+    }
+
+    struct PoolRegistry {
+      std::mutex mutex;
+      std::unordered_map<u64, memory_pools::Impl *> pools;
+      u64 nextId{1};
+    };
+    PoolRegistry &pool_registry() {
+      static PoolRegistry *s_registry = new PoolRegistry();
+      return *s_registry;
+    }
+
+    /// set once the calling thread's cache slots are destroyed (late in its exit), trivially
+    /// destructible thus still readable by later thread_local destructors
+    thread_local bool t_slotsGone = false;
+  }  // namespace
+
+  struct memory_pools::Impl {
+    struct alignas(64) Central {
+      std::mutex mutex;
+      void *head{nullptr};
+    };
+    struct ThreadCache {
+      void *heads[k_num_size_classes]{};
+      u32 counts[k_num_size_classes]{};
+      bool active{true};
+      std::atomic<u64> numAllocations{0}, numDeallocations{0}, numCacheHits{0},
+          numCentralRefills{0}, numBypasses{0}, allocatedBytes{0}, deallocatedBytes{0};
+    };
+    /// per-thread cache lookup, flushes the caches of live pools upon thread exit
+    struct ThreadSlots {
+      std::vector<std::pair<u64, ThreadCache *>> entries;
+      u64 lastId{0};
+      ThreadCache *last{nullptr};
+      ~ThreadSlots() {
+        /// the caches below may be handed to other threads from now on
+        t_slotsGone = true;
+        lastId = 0;
+        last = nullptr;
+        auto &reg = pool_registry();
+        std::lock_guard<std::mutex> lk{reg.mutex};
+        for (auto &[id, cache] : entries)
+          if (auto it = reg.pools.find(id); it != reg.pools.end()) {
+            it->second->flush(*cache);
+            std::lock_guard<std::mutex> clk{it->second->cacheMutex};
+            cache->active = false;
+          }
+      }
+    };
+
+    /// counters are only written by their owning thread
+    static void bump(std::atomic<u64> &counter, u64 v = 1) noexcept {
+      counter.store(counter.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+    }
+    static void push(void *&head, void *block) noexcept {
+      *static_cast<void **>(block) = head;
+      head = block;
+    }
+    static void *pop(void *&head) noexcept {
+      void *ret = head;
+      head = *static_cast<void **>(ret);
+      return ret;
+    }
+
+    /// @return nullptr once the calling thread's slots are gone, see allocate_uncached
+    ThreadCache *thread_cache() {
+      if (t_slotsGone) return nullptr;
+      thread_local ThreadSlots t_slots;
+      if (t_slots.lastId == id) return t_slots.last;
+      for (auto &[slotId, cache] : t_slots.entries)
+        if (slotId == id) {
+          t_slots.lastId = id;
+          t_slots.last = cache;
+          return cache;
+        }
+      ThreadCache *cache = nullptr;
+      {
+        std::lock_guard<std::mutex> lk{cacheMutex};
+        for (auto &c : caches)
+          if (!c->active) {
+            cache = c.get();
+            cache->active = true;
+            break;
+          }
+        if (!cache) {
+          caches.push_back(std::make_unique<ThreadCache>());
+          cache = caches.back().get();
+        }
+      }
+      t_slots.entries.emplace_back(id, cache);
+      t_slots.lastId = id;
+      t_slots.last = cache;
+      return cache;
+    }
+
+    /// carves a chunk into the (empty) central list, its mutex held
+    void carve(Central &central, u32 cls) {
+      const size_t blockSize = size_class_bytes(cls);
+      auto chunk = static_cast<char *>(upstream->allocate(chunk_bytes, max_block_alignment));
+      {
+        std::lock_guard<std::mutex> clk{chunkMutex};
+        chunks.push_back(chunk);
+      }
+      for (size_t offset = chunk_bytes / blockSize * blockSize; offset != 0;) {
+        offset -= blockSize;
+        push(central.head, chunk + offset);
+      }
+    }
+    /// moves up to a batch of blocks from the central list (carving a chunk if needed)
+    void refill(ThreadCache &cache, u32 cls) {
+      auto &central = centrals[cls];
+      std::lock_guard<std::mutex> lk{central.mutex};
+      if (central.head == nullptr) carve(central, cls);
+      for (u32 n = batch_size(cls); n != 0 && central.head; --n) {
+        push(cache.heads[cls], pop(central.head));
+        cache.counts[cls]++;
+      }
+    }
+    void release(ThreadCache &cache, u32 cls, u32 n) {
+      if (n == 0 || cache.heads[cls] == nullptr) return;
+      /// detach a chain of n blocks
+      void *first = cache.heads[cls], *last = first;
+      u32 k = 1;
+      for (; k < n && *static_cast<void **>(last); ++k) last = *static_cast<void **>(last);
+      cache.heads[cls] = *static_cast<void **>(last);
+      cache.counts[cls] -= k;
+      auto &central = centrals[cls];
+      std::lock_guard<std::mutex> lk{central.mutex};
+      *static_cast<void **>(last) = central.head;
+      central.head = first;
+    }
+    void flush(ThreadCache &cache) {
+      for (u32 cls = 0; cls != k_num_size_classes; ++cls) release(cache, cls, cache.counts[cls]);
+    }
+
+    /// a thread past its slots (e.g. within another thread_local destructor) works upon the
+    /// central lists directly, counted in 'uncached' by any number of such threads
+    static void bump_shared(std::atomic<u64> &counter, u64 v = 1) noexcept {
+      counter.fetch_add(v, std::memory_order_relaxed);
+    }
+    void *allocate_uncached(size_t bytes, size_t alignment, u32 cls) {
+      bump_shared(uncached.numAllocations);
+      if (cls == k_num_size_classes) {
+        bump_shared(uncached.numBypasses);
+        bump_shared(uncached.allocatedBytes, bytes);
+        return upstream->allocate(bytes, alignment);
+      }
+      bump_shared(uncached.allocatedBytes, size_class_bytes(cls));
+      auto &central = centrals[cls];
+      std::lock_guard<std::mutex> lk{central.mutex};
+      if (central.head == nullptr) carve(central, cls);
+      return pop(central.head);
+    }
+    void deallocate_uncached(void *p, size_t bytes, size_t alignment, u32 cls) {
+      bump_shared(uncached.numDeallocations);
+      if (cls == k_num_size_classes) {
+        bump_shared(uncached.deallocatedBytes, bytes);
+        return upstream->deallocate(p, bytes, alignment);
+      }
+      bump_shared(uncached.deallocatedBytes, size_class_bytes(cls));
+      auto &central = centrals[cls];
+      std::lock_guard<std::mutex> lk{central.mutex};
+      push(central.head, p);
+    }
+
+    mr_t *upstream;
+    u64 id;
+    Central centrals[k_num_size_classes];
+    std::mutex chunkMutex;
+    std::vector<char *> chunks;
+    std::mutex cacheMutex;
+    std::vector<std::unique_ptr<ThreadCache>> caches;
+    ThreadCache uncached;
+  };
+
+  memory_pools &memory_pools::instance() {
+    /// never destroyed, blocks may be released during static destruction
+    static memory_pools *s_instance = new memory_pools();
+    return *s_instance;
+  }
+
+  memory_pools::memory_pools(mr_t *source) : _impl{new Impl{}} {
+    _impl->upstream = source;
+    auto &reg = pool_registry();
+    std::lock_guard<std::mutex> lk{reg.mutex};
+    _impl->id = reg.nextId++;
+    reg.pools[_impl->id] = _impl;
+  }
+
+  memory_pools::~memory_pools() {
+    {
+      auto &reg = pool_registry();
+      std::lock_guard<std::mutex> lk{reg.mutex};
+      reg.pools.erase(_impl->id);
+    }
+    for (auto chunk : _impl->chunks)
+      _impl->upstream->deallocate(chunk, chunk_bytes, max_block_alignment);
+    delete _impl;
+  }
+
+  u32 memory_pools::num_size_classes() noexcept { return k_num_size_classes; }
+  size_t memory_pools::class_size(u32 cls) noexcept { return size_class_bytes(cls); }
+
+  u32 memory_pools::size_class(size_t bytes, size_t alignment) noexcept {
+    if (alignment > max_block_alignment || bytes > max_small_bytes) return k_num_size_classes;
+    if (bytes == 0) bytes = 1;
+    if (alignment > 16) bytes = round_up(bytes, alignment);
+    u32 cls;
+    if (bytes <= 256)
+      cls = (u32)((bytes + 15) / 16) - 1;
+    else {
+      const u32 k = (u32)bit_length(bytes - 1) - 1;  // floor(log2(bytes - 1))
+      const size_t base = (size_t)1 << k, step = base / 4;
+      cls = k_num_fine_classes + (k - 8) * 4 + (u32)((bytes - base + step - 1) / step) - 1;
+    }
+    while (cls < k_num_size_classes && size_class_bytes(cls) % alignment != 0) ++cls;
+    return cls;
+  }
+
+  void *memory_pools::do_allocate(size_t bytes, size_t alignment) {
+    const u32 cls = size_class(bytes, alignment);
+    auto *cachePtr = _impl->thread_cache();
+    if (cachePtr == nullptr) return _impl->allocate_uncached(bytes, alignment, cls);
+    auto &cache = *cachePtr;
+    Impl::bump(cache.numAllocations);
+    if (cls == k_num_size_classes) {
+      Impl::bump(cache.numBypasses);
+      Impl::bump(cache.allocatedBytes, bytes);
+      return _impl->upstream->allocate(bytes, alignment);
+    }
+    Impl::bump(cache.allocatedBytes, size_class_bytes(cls));
+    if (cache.heads[cls])
+      Impl::bump(cache.numCacheHits);
+    else {
+      Impl::bump(cache.numCentralRefills);
+      _impl->refill(cache, cls);
+    }
+    cache.counts[cls]--;
+    return Impl::pop(cache.heads[cls]);
+  }
+
+  void memory_pools::do_deallocate(void *p, size_t bytes, size_t alignment) {
+    if (p == nullptr) return;
+    const u32 cls = size_class(bytes, alignment);
+    auto *cachePtr = _impl->thread_cache();
+    if (cachePtr == nullptr) return _impl->deallocate_uncached(p, bytes, alignment, cls);
+    auto &cache = *cachePtr;
+    Impl::bump(cache.numDeallocations);
+    if (cls == k_num_size_classes) {
+      Impl::bump(cache.deallocatedBytes, bytes);
+      return _impl->upstream->deallocate(p, bytes, alignment);
+    }
+    Impl::bump(cache.deallocatedBytes, size_class_bytes(cls));
+    Impl::push(cache.heads[cls], p);
+    if (++cache.counts[cls] > 2 * batch_size(cls)) _impl->release(cache, cls, batch_size(cls));
+  }
+
+  memory_pool_stats memory_pools::stats() const {
+    memory_pool_stats ret{};
+    u64 allocated = 0, deallocated = 0;
+    {
+      const auto accumulate = [&](const Impl::ThreadCache &cache) {
+        ret.numAllocations += cache.numAllocations.load(std::memory_order_relaxed);
+        ret.numDeallocations += cache.numDeallocations.load(std::memory_order_relaxed);
+        ret.numCacheHits += cache.numCacheHits.load(std::memory_order_relaxed);
+        ret.numCentralRefills += cache.numCentralRefills.load(std::memory_order_relaxed);
+        ret.numBypasses += cache.numBypasses.load(std::memory_order_relaxed);
+        allocated += cache.allocatedBytes.load(std::memory_order_relaxed);
+        deallocated += cache.deallocatedBytes.load(std::memory_order_relaxed);
+      };
+      std::lock_guard<std::mutex> lk{_impl->cacheMutex};
+      for (const auto &cache : _impl->caches) accumulate(*cache);
+      accumulate(_impl->uncached);
+    }
+    ret.bytesInUse = (size_t)(allocated - deallocated);
+    std::lock_guard<std::mutex> lk{_impl->chunkMutex};
+    ret.bytesReserved = _impl->chunks.size() * chunk_bytes;
+    return ret;
+  }
+
+  void memory_pools::flush_thread_cache() {
+    if (auto *cache = _impl->thread_cache()) _impl->flush(*cache);
+  }
+
   /// handle_resource
   handle_resource::handle_resource(mr_t *upstream) noexcept : _upstream{upstream} {}
   handle_resource::handle_resource(size_t initSize, mr_t *upstream) noexcept
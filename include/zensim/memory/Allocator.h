@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <type_traits>
 #include <vector>
@@ -341,98 +342,198 @@ namespace zs {
     char *_handle{nullptr}, *_head{nullptr};
   };
 
-  /// https://en.cppreference.com/w/cpp/named_req/Allocator#Allocator_completeness_requirements
-  // An allocator type X for type T additionally satisfies the allocator
-  // completeness requirements if both of the following are true regardless of
-  // whether T is a complete type: X is a complete type Except for value_type, all
-  // the member types of std::allocator_traits<X> are complete types.
+  struct scratch_arena_stats {
+    size_t used{0};       ///< bytes currently handed out by the arena (incl. alignment padding)
+    size_t highWater{0};  ///< peak demand (arena and upstream) since the last 'reset_high_water'
+    size_t committed{0};  ///< resident bytes kept for reuse
+    size_t reserved{0};   ///< reserved address space
+    size_t numAllocations{0};
+    size_t numFallbacks{0};  ///< requests beyond the reservation, served by the upstream
+    size_t numGrows{0};
+  };
 
-#if 0
-  /// for automatic dynamic memory management
-  struct memory_pools : mr_t {
-    /// https://stackoverflow.com/questions/46509152/why-in-x86-64-the-virtual-address-are-4-bits-shorter-than-physical-48-bits-vs
-
-    using poolid = unsigned char;
-    static constexpr poolid nPools = 4;
-    /// 9-bit per page-level: 512, 4K, 2M, 1G
-    static constexpr size_t block_bits[nPools] = {9, 12, 21, 30};
-    static constexpr size_t block_sizes(poolid pid) noexcept {
-      return static_cast<size_t>(1) << block_bits[pid];
-    }
-    static constexpr poolid pool_index(size_t bytes) noexcept {
-      const poolid nbits = bit_count(bytes);
-      for (poolid i = 0; i < nPools; ++i)
-        if (block_bits[i] > nbits) return i;
-      return nPools - 1;
-    }
+  /// @brief growable bump arena for short-lived scratch memory (host only)
+  /// @note built on stack_virtual_memory_resource: pages are committed up to the high-water mark
+  /// and kept, so recurring scratch requests neither fault nor unmap. deallocating the top block
+  /// pops it (along with released blocks right beneath), and the arena rewinds once every block
+  /// is released.
+  /// @note requests beyond the reservation are served by the upstream, the reservation then
+  /// grows upon the next rewind
+  /// @note thread-safe, yet meant to be used by one thread at a time (e.g. per-thread arenas)
+  struct ZPC_CORE_API scratch_arena {
+    static constexpr size_t default_reservation = (size_t)1 << 30;
+    /// block sizes are padded to this, so that blocks tile without gaps
+    static constexpr size_t block_granularity = 64;
+
+    explicit scratch_arena(size_t reservation = default_reservation,
+                           mr_t *upstream = &raw_memory_resource<host_mem_tag>::instance());
+    ~scratch_arena();
+    scratch_arena(const scratch_arena &) = delete;
+    scratch_arena &operator=(const scratch_arena &) = delete;
+
+    void *allocate(size_t bytes, size_t alignment);
+    void deallocate(void *p, size_t bytes, size_t alignment);
+    /// @brief decommits the pages beyond 'keepBytes', only when no block is alive
+    bool trim(size_t keepBytes = 0);
+    scratch_arena_stats stats() const;
+    void reset_high_water();
 
-    memory_pools(mr_t *source) {
-      for (char i = 0; i < nPools; ++i) {
-        pmr::pool_options opt{/*.max_blocks_per_chunk = */ 0,
-                              /*.largest_required_pool_block = */ block_sizes(i)};
-        /// thread-safe version
-        _pools[i] = zs::make_unique<synchronized_pool_resource>(opt, source);
-      }
-    }
+  private:
+    bool owns_(const void *p) const noexcept;
+    void rewind_();
+
+    mutable std::mutex _mutex{};
+    UniquePtr<stack_virtual_memory_resource<host_mem_tag>> _vmr{};
+    mr_t *_upstream;
+    size_t _offset{0}, _live{0}, _upstreamBytes{0}, _demand{0};
+    /// released blocks (offset, end) below the top
+    std::vector<std::pair<size_t, size_t>> _holes{};
+    scratch_arena_stats _stats{};
+  };
+
+  /// @brief mr_t handle of a shared scratch_arena, cheap to clone along with ZSPmrAllocator
+  struct scratch_memory_resource : mr_t {
+    explicit scratch_memory_resource(std::shared_ptr<scratch_arena> arena) noexcept
+        : _arena{zs::move(arena)} {}
+    const std::shared_ptr<scratch_arena> &arena() const noexcept { return _arena; }
 
   protected:
     void *do_allocate(size_t bytes, size_t alignment) override {
-      const poolid pid = pool_index(bytes);
-      return _pools[pid]->allocate(bytes, alignment);
+      return _arena->allocate(bytes, alignment);
     }
-
     void do_deallocate(void *p, size_t bytes, size_t alignment) override {
-      const poolid pid = pool_index(bytes);
-      _pools[pid]->deallocate(p, bytes, alignment);
+      _arena->deallocate(p, bytes, alignment);
     }
     bool do_is_equal(const mr_t &other) const noexcept override {
-      return this == dynamic_cast<memory_pools *>(const_cast<mr_t *>(&other));
+      if (this == &other) return true;
+      auto o = dynamic_cast<const scratch_memory_resource *>(&other);
+      return o && o->_arena == _arena;
     }
 
   private:
-    std::array<UniquePtr<mr_t>, nPools> _pools;
+    std::shared_ptr<scratch_arena> _arena;
+  };
+
+  /// https://en.cppreference.com/w/cpp/named_req/Allocator#Allocator_completeness_requirements
+  // An allocator type X for type T additionally satisfies the allocator
+  // completeness requirements if both of the following are true regardless of
+  // whether T is a complete type: X is a complete type Except for value_type, all
+  // the member types of std::allocator_traits<X> are complete types.
+
+  struct memory_pool_stats {
+    u64 numAllocations{0};
+    u64 numDeallocations{0};
+    u64 numCacheHits{0};      ///< served by the thread cache
+    u64 numCentralRefills{0};  ///< batch refills from the central free lists
+    u64 numBypasses{0};        ///< huge (or over-aligned) requests forwarded to the upstream
+    size_t bytesInUse{0};      ///< size-class bytes currently handed out (bypasses included)
+    size_t bytesReserved{0};   ///< chunk bytes acquired from the upstream
+  };
+
+  /// @brief thread-caching size-class pool for small allocations
+  /// @note size classes step by 16 bytes up to 256 and by quarters of a power of two up to
+  /// 'max_small_bytes', larger (or more than page-aligned) requests bypass to the upstream
+  /// @note each thread keeps bounded free lists per class, refilled from (and spilled to) central
+  /// per-class free lists in batches. blocks are carved from 64KB chunks, which are returned to
+  /// the upstream only upon destruction.
+  /// @note blocks may be released by any thread
+  struct ZPC_CORE_API memory_pools : mr_t {
+    static constexpr size_t max_small_bytes = (size_t)32 << 10;
+    static constexpr size_t chunk_bytes = (size_t)64 << 10;
+    static constexpr size_t max_block_alignment = 4096;
+
+    /// @brief process-wide pool over the raw host resource, as selected by
+    /// get_memory_source(memsrc_e::host, -1, "POOLED")
+    static memory_pools &instance();
+
+    explicit memory_pools(mr_t *source = &raw_memory_resource<host_mem_tag>::instance());
+    ~memory_pools() override;
+    memory_pools(const memory_pools &) = delete;
+    memory_pools &operator=(const memory_pools &) = delete;
+
+    static u32 num_size_classes() noexcept;
+    static size_t class_size(u32 cls) noexcept;
+    /// @brief the smallest class fitting 'bytes' at 'alignment', num_size_classes() if bypassed
+    static u32 size_class(size_t bytes, size_t alignment) noexcept;
+
+    memory_pool_stats stats() const;
+    /// @brief returns the calling thread's cached blocks to the central free lists
+    void flush_thread_cache();
+
+    struct Impl;
+
+  protected:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const mr_t &other) const noexcept override { return this == &other; }
+
+  private:
+    Impl *_impl;
   };
 
+  /// @brief single-threaded pools of power-of-two blocks (1 << Ns bytes, ascending)
+  /// @note requests larger than the largest block (or more aligned than it) bypass to the
+  /// upstream, blocks are carved from chunks of at least 'chunk_bytes'
   template <size_t... Ns> struct static_memory_pools : mr_t {
-    using poolid = char;
+    static_assert(((Ns >= 3) && ...), "blocks should at least hold a pointer");
+    using poolid = int;
     static constexpr poolid nPools = sizeof...(Ns);
     static constexpr size_t block_bits[nPools] = {Ns...};
+    static constexpr size_t chunk_bytes = (size_t)64 << 10;
     static constexpr size_t block_sizes(poolid pid) noexcept {
       return static_cast<size_t>(1) << block_bits[pid];
     }
-    static constexpr poolid pool_index(size_t bytes) noexcept {
-      const poolid nbits = bit_count(bytes);
+    static constexpr poolid pool_index(size_t bytes, size_t alignment) noexcept {
+      if (alignment > bytes) bytes = alignment;
       for (poolid i = 0; i < nPools; ++i)
-        if (block_bits[i] > nbits) return i;
-      return nPools - 1;
+        if (block_sizes(i) >= bytes) return i;
+      return nPools;
     }
 
-    static_memory_pools(mr_t *source) {
-      for (char i = 0; i < nPools; ++i) {
-        pmr::pool_options opt{/*.max_blocks_per_chunk = */ 0,
-                              /*.largest_required_pool_block = */ block_sizes(i)};
-        _pools[i] = zs::make_unique<unsynchronized_pool_resource>(opt, source);
-      }
+    explicit static_memory_pools(mr_t *source = &raw_memory_resource<host_mem_tag>::instance())
+        : _upstream{source} {}
+    ~static_memory_pools() override {
+      for (auto &chunk : _chunks) _upstream->deallocate(chunk.first, chunk.second, chunk.second);
     }
+    static_memory_pools(const static_memory_pools &) = delete;
+    static_memory_pools &operator=(const static_memory_pools &) = delete;
 
   protected:
     void *do_allocate(size_t bytes, size_t alignment) override {
-      const poolid pid = pool_index(bytes);
-      return _pools[pid]->allocate(bytes, alignment);
+      const poolid pid = pool_index(bytes, alignment);
+      if (pid == nPools) return _upstream->allocate(bytes, alignment);
+      if (_freeLists[pid] == nullptr) refill_(pid);
+      void *ret = _freeLists[pid];
+      _freeLists[pid] = *static_cast<void **>(ret);
+      return ret;
     }
 
     void do_deallocate(void *p, size_t bytes, size_t alignment) override {
-      const poolid pid = pool_index(bytes);
-      _pools[pid]->deallocate(p, bytes, alignment);
-    }
-    bool do_is_equal(const mr_t &other) const noexcept override {
-      return this == dynamic_cast<static_memory_pools *>(const_cast<mr_t *>(&other));
+      const poolid pid = pool_index(bytes, alignment);
+      if (pid == nPools) return _upstream->deallocate(p, bytes, alignment);
+      *static_cast<void **>(p) = _freeLists[pid];
+      _freeLists[pid] = p;
     }
+    bool do_is_equal(const mr_t &other) const noexcept override { return this == &other; }
 
   private:
-    std::array<UniquePtr<mr_t>, nPools> _pools;
+    void refill_(poolid pid) {
+      const size_t blockSize = block_sizes(pid);
+      const size_t bytes = blockSize > chunk_bytes ? blockSize : chunk_bytes;
+      /// chunks are aligned to their size, hence every block to its size
+      auto chunk = static_cast<char *>(_upstream->allocate(bytes, bytes));
+      _chunks.emplace_back(chunk, bytes);
+      for (size_t offset = bytes; offset != 0;) {
+        offset -= blockSize;
+        *reinterpret_cast<void **>(chunk + offset) = _freeLists[pid];
+        _freeLists[pid] = chunk + offset;
+      }
+    }
+
+    mr_t *_upstream;
+    void *_freeLists[nPools]{};
+    std::vector<std::pair<void *, size_t>> _chunks{};
   };
-#endif
 
   struct ZPC_CORE_API general_allocator {
     general_allocator() noexcept : _mr{&raw_memory_resource<host_mem_tag>::instance()} {};
@@ -0,0 +1,272 @@
+#include "MappedFile.hpp"
+
+#include <utility>
+
+#if defined(ZS_PLATFORM_WINDOWS)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace zs {
+
+  namespace {
+    size_t page_size() noexcept {
+#if defined(ZS_PLATFORM_WINDOWS)
+      SYSTEM_INFO info{};
+      GetSystemInfo(&info);
+      return (size_t)info.dwPageSize;
+#else
+      return (size_t)sysconf(_SC_PAGESIZE);
+#endif
+    }
+    /// [offset, offset + bytes) widened to whole pages and clamped to the mapping
+    bool page_range(size_t offset, size_t bytes, size_t mappedSize, size_t &st, size_t &ed) {
+      const size_t page = page_size();
+      if (offset >= mappedSize) return false;
+      st = offset / page * page;
+      ed = bytes == 0 || bytes > mappedSize - offset ? mappedSize : offset + bytes;
+      ed = (ed + page - 1) / page * page;
+      if (ed > mappedSize) ed = mappedSize;
+      return st < ed;
+    }
+  }  // namespace
+
+#if defined(ZS_PLATFORM_WINDOWS)
+
+  MappedFile::MappedFile(const std::string &path, MappedFileAccess access, size_t mapSize)
+      : _path{path}, _access{access} {
+    const bool writable = access == MappedFileAccess::read_write;
+    HANDLE file = CreateFileA(path.c_str(), writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                              FILE_SHARE_READ, nullptr, writable ? OPEN_ALWAYS : OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return;
+    _fileHandle = file;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size)) {
+      close_mapping();
+      return;
+    }
+    _fileSize = (size_t)size.QuadPart;
+    /// a read-only view cannot extend past the end of the file
+    if (mapSize == 0 || (!writable && mapSize > _fileSize)) mapSize = _fileSize;
+    if (mapSize == 0) return;
+    /// CreateFileMapping grows the file for writable mappings
+    if (writable && mapSize > _fileSize) _fileSize = mapSize;
+
+    const DWORD protect = access == MappedFileAccess::read_only   ? PAGE_READONLY
+                          : access == MappedFileAccess::read_write ? PAGE_READWRITE
+                                                                   : PAGE_WRITECOPY;
+    const unsigned long long extent = mapSize;
+    _mappingHandle = CreateFileMappingA(file, nullptr, protect, (DWORD)(extent >> 32),
+                                        (DWORD)(extent & 0xffffffffull), nullptr);
+    if (_mappingHandle == nullptr) {
+      close_mapping();
+      return;
+    }
+    const DWORD viewAccess = access == MappedFileAccess::read_only   ? FILE_MAP_READ
+                             : access == MappedFileAccess::read_write ? FILE_MAP_WRITE
+                                                                      : FILE_MAP_COPY;
+    _addr = MapViewOfFile((HANDLE)_mappingHandle, viewAccess, 0, 0, mapSize);
+    if (_addr == nullptr) {
+      close_mapping();
+      return;
+    }
+    const size_t page = page_size();
+    _mappedSize = (mapSize + page - 1) / page * page;
+  }
+
+  void MappedFile::close_mapping() noexcept {
+    if (_addr) UnmapViewOfFile(_addr);
+    if (_mappingHandle) CloseHandle((HANDLE)_mappingHandle);
+    if (_fileHandle) CloseHandle((HANDLE)_fileHandle);
+    _addr = nullptr;
+    _mappingHandle = nullptr;
+    _fileHandle = nullptr;
+    _fileSize = _mappedSize = 0;
+  }
+
+  bool MappedFile::flush(size_t offset, size_t bytes) {
+    size_t st, ed;
+    if (!_addr || !page_range(offset, bytes, _mappedSize, st, ed)) return false;
+    if (!FlushViewOfFile((char *)_addr + st, ed - st)) return false;
+    return _access != MappedFileAccess::read_write || FlushFileBuffers((HANDLE)_fileHandle) != 0;
+  }
+
+  bool MappedFile::do_commit(size_t offset, size_t bytes) {
+    size_t st, ed;
+    if (!_addr || !page_range(offset, bytes, _mappedSize, st, ed)) return false;
+#  if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+    WIN32_MEMORY_RANGE_ENTRY range{(char *)_addr + st, ed - st};
+    return PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0) != 0;
+#  else
+    return true;
+#  endif
+  }
+
+  bool MappedFile::do_evict(size_t offset, size_t bytes) {
+    size_t st, ed;
+    if (!_addr || !page_range(offset, bytes, _mappedSize, st, ed)) return false;
+    /// unlocking pages that are not locked trims them from the working set
+    VirtualUnlock((char *)_addr + st, ed - st);
+    return true;
+  }
+
+  bool MappedFile::do_protect(size_t offset, size_t bytes, PageAccess access) {
+    size_t st, ed;
+    if (!_addr || !page_range(offset, bytes, _mappedSize, st, ed)) return false;
+    DWORD prot = PAGE_NOACCESS;
+    switch (access) {
+      case PageAccess::none:            prot = PAGE_NOACCESS; break;
+      case PageAccess::read:            prot = PAGE_READONLY; break;
+      case PageAccess::read_write:      prot = PAGE_READWRITE; break;
+      case PageAccess::read_exec:       prot = PAGE_EXECUTE_READ; break;
+      case PageAccess::read_write_exec: prot = PAGE_EXECUTE_READWRITE; break;
+    }
+    DWORD oldProt = 0;
+    return VirtualProtect((char *)_addr + st, ed - st, prot, &oldProt) != 0;
+  }
+
+  MappedFile::MappedFile(MappedFile &&o) noexcept
+      : _path{std::move(o._path)},
+        _access{o._access},
+        _addr{std::exchange(o._addr, nullptr)},
+        _fileSize{std::exchange(o._fileSize, (size_t)0)},
+        _mappedSize{std::exchange(o._mappedSize, (size_t)0)},
+        _fileHandle{std::exchange(o._fileHandle, nullptr)},
+        _mappingHandle{std::exchange(o._mappingHandle, nullptr)} {}
+
+  MappedFile &MappedFile::operator=(MappedFile &&o) noexcept {
+    if (this == &o) return *this;
+    close_mapping();
+    _path = std::move(o._path);
+    _access = o._access;
+    _addr = std::exchange(o._addr, nullptr);
+    _fileSize = std::exchange(o._fileSize, (size_t)0);
+    _mappedSize = std::exchange(o._mappedSize, (size_t)0);
+    _fileHandle = std::exchange(o._fileHandle, nullptr);
+    _mappingHandle = std::exchange(o._mappingHandle, nullptr);
+    return *this;
+  }
+
+#else
+
+  MappedFile::MappedFile(const std::string &path, MappedFileAccess access, size_t mapSize)
+      : _path{path}, _access{access} {
+    const bool writable = access == MappedFileAccess::read_write;
+    _fd = ::open(path.c_str(), writable ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+    if (_fd < 0) return;
+
+    struct stat st {};
+    if (::fstat(_fd, &st) != 0) {
+      close_mapping();
+      return;
+    }
+    _fileSize = (size_t)st.st_size;
+    /// pages beyond the end of the file raise SIGBUS, only writable mappings may grow it
+    if (mapSize == 0 || (!writable && mapSize > _fileSize)) mapSize = _fileSize;
+    if (mapSize == 0) return;
+    if (writable && mapSize > _fileSize) {
+      if (::ftruncate(_fd, (off_t)mapSize) != 0) {
+        close_mapping();
+        return;
+      }
+      _fileSize = mapSize;
+    }
+
+    const int prot = access == MappedFileAccess::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+    const int flags = access == MappedFileAccess::copy_on_write ? MAP_PRIVATE : MAP_SHARED;
+    void *addr = ::mmap(nullptr, mapSize, prot, flags, _fd, 0);
+    if (addr == MAP_FAILED) {
+      close_mapping();
+      return;
+    }
+    _addr = addr;
+    const size_t page = page_size();
+    _mappedSize = (mapSize + page - 1) / page * page;
+  }
+
+  void MappedFile::close_mapping() noexcept {
+    if (_addr) ::munmap(_addr, _mappedSize);
+    if (_fd >= 0) ::close(_fd);
+    _addr = nullptr;
+    _fd = -1;
+    _fileSize = _mappedSize = 0;
+  }
+
+  bool MappedFile::flush(size_t offset, size_t bytes) {
+    size_t st, ed;
+    if (!_addr || !page_range(offset, bytes, _mappedSize, st, ed)) return false;
+    return ::msync((char *)_addr + st, ed - st, MS_SYNC) == 0;
+  }
+
+  bool MappedFile::do_commit(size_t offset, size_t bytes) {
+    size_t st, ed;
+    if (!_addr || !page_range(offset, bytes, _mappedSize, st, ed)) return false;
+    return ::madvise((char *)_addr + st, ed - st, MADV_WILLNEED) == 0;
+  }
+
+  bool MappedFile::do_evict(size_t offset, size_t bytes) {
+    size_t st, ed;
+    if (!_addr || !page_range(offset, bytes, _mappedSize, st, ed)) return false;
+    /// shared file pages are re-read from the file on the next access, private copies are lost
+    return ::madvise((char *)_addr + st, ed - st, MADV_DONTNEED) == 0;
+  }
+
+  bool MappedFile::do_protect(size_t offset, size_t bytes, PageAccess access) {
+    size_t st, ed;
+    if (!_addr || !page_range(offset, bytes, _mappedSize, st, ed)) return false;
+    int prot = PROT_NONE;
+    switch (access) {
+      case PageAccess::none:            prot = PROT_NONE; break;
+      case PageAccess::read:            prot = PROT_READ; break;
+      case PageAccess::read_write:      prot = PROT_READ | PROT_WRITE; break;
+      case PageAccess::read_exec:       prot = PROT_READ | PROT_EXEC; break;
+      case PageAccess::read_write_exec: prot = PROT_READ | PROT_WRITE | PROT_EXEC; break;
+    }
+    return ::mprotect((char *)_addr + st, ed - st, prot) == 0;
+  }
+
+  MappedFile::MappedFile(MappedFile &&o) noexcept
+      : _path{std::move(o._path)},
+        _access{o._access},
+        _addr{std::exchange(o._addr, nullptr)},
+        _fileSize{std::exchange(o._fileSize, (size_t)0)},
+        _mappedSize{std::exchange(o._mappedSize, (size_t)0)},
+        _fd{std::exchange(o._fd, -1)} {}
+
+  MappedFile &MappedFile::operator=(MappedFile &&o) noexcept {
+    if (this == &o) return *this;
+    close_mapping();
+    _path = std::move(o._path);
+    _access = o._access;
+    _addr = std::exchange(o._addr, nullptr);
+    _fileSize = std::exchange(o._fileSize, (size_t)0);
+    _mappedSize = std::exchange(o._mappedSize, (size_t)0);
+    _fd = std::exchange(o._fd, -1);
+    return *this;
+  }
+
+#endif
+
+  MappedFile::~MappedFile() { close_mapping(); }
+
+  bool MappedFile::do_check_residency(size_t offset, size_t bytes) const {
+    return _addr != nullptr && offset <= _mappedSize && bytes <= _mappedSize - offset;
+  }
+
+  void *MappedFile::do_address(size_t offset) const {
+    return _addr && offset < _mappedSize ? (char *)_addr + offset : nullptr;
+  }
+
+}  // namespace zs
@@ -27,6 +27,10 @@ namespace zs {
     register_advisor_resource(
         memsrc_e::host,
         [](ProcID devid, std::string_view advice) -> UniquePtr<mr_t> {
+          /// size-class pools with thread caches, for many small allocations
+          if (advice == "POOLED")
+            return zs::make_unique<default_memory_resource<host_mem_tag>>(
+                devid, &memory_pools::instance());
           return zs::make_unique<advisor_memory_resource<host_mem_tag>>(devid, advice);
         });
 
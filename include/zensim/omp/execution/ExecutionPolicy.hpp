@@ -11,19 +11,25 @@
 #  error "ZS_ENABLE_OPENMP defined but the compiler is not defining the _OPENMP macro as expected"
 #endif
 
+#include <atomic>
 #include <sstream>
 
 #include "zensim/ZpcFunction.hpp"
 #include "zensim/execution/ExecutionPolicy.hpp"
 #include "zensim/execution/ManagedThread.hpp"
 #include "zensim/math/bit/Bits.h"
+#include "zensim/memory/Allocator.h"
 #include "zensim/omp/Omp.h"
 #include "zensim/types/Iterator.h"
 
 namespace zs {
 
   struct OmpExecutionPolicy;
+  /// @note served by a per-thread scratch_arena (of the calling thread), reused across launches
   ZPC_API extern ZSPmrAllocator<> get_temporary_memory_source(const OmpExecutionPolicy &pol);
+  ZPC_API extern scratch_arena_stats get_temporary_memory_stats(const OmpExecutionPolicy &pol);
+  /// @brief decommits the idle scratch pages (of the calling thread) beyond 'keepBytes'
+  ZPC_API extern bool trim_temporary_memory(const OmpExecutionPolicy &pol, size_t keepBytes = 0);
 
   /// use pragma syntax instead of attribute syntax
   struct OmpExecutionPolicy : ExecutionPolicyInterface<OmpExecutionPolicy> {
@@ -36,8 +42,8 @@ namespace zs {
       using namespace index_literals;
       constexpr auto dim = Collapse<Ts, Is>::dim;
       using Ti = make_signed_t<RM_CVREF_T(dims.get(0_th))>;
-      CppTimer timer;
-      if (shouldProfile()) timer.tick();
+      KernelTimer timer;
+      if (shouldProfile()) timer.tick(preparePerfCounters());
       if constexpr (dim == 1) {
 #pragma omp parallel for if (_dop < dims.get(0_th)) num_threads(_dop)
         for (Ti i = 0; i < dims.get(0_th); ++i) zs::invoke(f, i);
@@ -56,15 +62,13 @@ namespace zs {
         oss << "execution of " << dim << "-layers of loops not supported!";
         throw std::runtime_error(oss.str());
       }
-      if (shouldProfile())
-        timer.tock(std::string("[Omp Exec | File ") + loc.file_name() + ", Ln "
-                   + std::to_string(loc.line()) + ", Col " + std::to_string(loc.column()) + "]");
+      if (shouldProfile()) timer.tock(loc, "Omp Exec");
     }
     template <typename Range, typename F>
     void operator()(Range &&range, F &&f,
                     const source_location &loc = source_location::current()) const {
-      CppTimer timer;
-      if (shouldProfile()) timer.tick();
+      KernelTimer timer;
+      if (shouldProfile()) timer.tick(preparePerfCounters());
       constexpr auto hasBegin = is_valid(
           [](auto t) -> decltype((void)std::begin(declval<typename decltype(t)::type>())) {});
       constexpr auto hasEnd = is_valid(
@@ -130,16 +134,14 @@ namespace zs {
           }
         }
       }
-      if (shouldProfile())
-        timer.tock(std::string("[Omp Exec | File ") + loc.file_name() + ", Ln "
-                   + std::to_string(loc.line()) + ", Col " + std::to_string(loc.column()) + "]");
+      if (shouldProfile()) timer.tock(loc, "Omp Exec");
     }
     template <typename Range, typename ParamTuple, typename F,
               enable_if_t<is_tuple_v<remove_cvref_t<ParamTuple>>> = 0>
     void operator()(Range &&range, ParamTuple &&params, F &&f,
                     const source_location &loc = source_location::current()) const {
-      CppTimer timer;
-      if (shouldProfile()) timer.tick();
+      KernelTimer timer;
+      if (shouldProfile()) timer.tick(preparePerfCounters());
       constexpr auto hasBegin = is_valid(
           [](auto t) -> decltype((void)std::begin(declval<typename decltype(t)::type>())) {});
       constexpr auto hasEnd = is_valid(
@@ -207,9 +209,7 @@ namespace zs {
           }
         }
       }
-      if (shouldProfile())
-        timer.tock(std::string("[Omp Exec | File ") + loc.file_name() + ", Ln "
-                   + std::to_string(loc.line()) + ", Col " + std::to_string(loc.column()) + "]");
+      if (shouldProfile()) timer.tock(loc, "Omp Exec");
     }
 
     template <zs::size_t I, size_t... Is, typename... Iters, typename... Policies,
@@ -275,8 +275,8 @@ namespace zs {
           "diff type not compatible");
       static_assert(std::is_convertible_v<typename std::iterator_traits<IterT>::value_type, ValueT>,
                     "value type not compatible");
-      CppTimer timer;
-      if (shouldProfile()) timer.tick();
+      KernelTimer timer;
+      if (shouldProfile()) timer.tick(preparePerfCounters());
       const auto dist = last - first;
       auto allocator = get_temporary_memory_source(*this);
       Vector<ValueT> localRes{allocator, (size_t)0};
@@ -322,9 +322,7 @@ namespace zs {
             *(d_first + offset) = binary_op(*(d_first + offset), tmp);
         }
       }
-      if (shouldProfile())
-        timer.tock(std::string("[Omp InclScan | File ") + loc.file_name() + ", Ln "
-                   + std::to_string(loc.line()) + ", Col " + std::to_string(loc.column()) + "]");
+      if (shouldProfile()) timer.tock(loc, "Omp InclScan");
     }
     template <class InputIt, class OutputIt,
               class BinaryOperation = plus<remove_cvref_t<decltype(*declval<InputIt>())>>>
@@ -351,8 +349,8 @@ namespace zs {
           "diff type not compatible");
       static_assert(std::is_convertible_v<typename std::iterator_traits<IterT>::value_type, ValueT>,
                     "value type not compatible");
-      CppTimer timer;
-      if (shouldProfile()) timer.tick();
+      KernelTimer timer;
+      if (shouldProfile()) timer.tick(preparePerfCounters());
       const auto dist = last - first;
       auto allocator = get_temporary_memory_source(*this);
       Vector<ValueT> localRes{allocator, (size_t)0};
@@ -398,9 +396,7 @@ namespace zs {
             *(d_first + offset) = binary_op(*(d_first + offset), tmp);
         }
       }
-      if (shouldProfile())
-        timer.tock(std::string("[Omp ExclScan | File ") + loc.file_name() + ", Ln "
-                   + std::to_string(loc.line()) + ", Col " + std::to_string(loc.column()) + "]");
+      if (shouldProfile()) timer.tock(loc, "Omp ExclScan");
     }
     template <class InputIt, class OutputIt,
               class BinaryOperation
@@ -432,8 +428,8 @@ namespace zs {
           "diff type not compatible");
       static_assert(std::is_convertible_v<typename std::iterator_traits<IterT>::value_type, ValueT>,
                     "value type not compatible");
-      CppTimer timer;
-      if (shouldProfile()) timer.tick();
+      KernelTimer timer;
+      if (shouldProfile()) timer.tick(preparePerfCounters());
       const auto dist = last - first;
       auto allocator = get_temporary_memory_source(*this);
       Vector<ValueT> localRes{allocator, (size_t)0};
@@ -469,9 +465,7 @@ namespace zs {
 
         if (tid == 0) *d_first = tmp;
       }
-      if (shouldProfile())
-        timer.tock(std::string("[Omp Reduce | File ") + loc.file_name() + ", Ln "
-                   + std::to_string(loc.line()) + ", Col " + std::to_string(loc.column()) + "]");
+      if (shouldProfile()) timer.tock(loc, "Omp Reduce");
     }
     template <class InputIt, class OutputIt,
               class BinaryOp
@@ -519,8 +513,8 @@ namespace zs {
       using KeyT = typename std::iterator_traits<KeyIterT>::value_type;
       using ValueT = typename std::iterator_traits<ValueIterT>::value_type;
 
-      CppTimer timer;
-      if (shouldProfile()) timer.tick();
+      KernelTimer timer;
+      if (shouldProfile()) timer.tick(preparePerfCounters());
 
       auto allocator = get_temporary_memory_source(*this);
       Vector<KeyT> okeys_{allocator, (size_t)dist};
@@ -696,9 +690,7 @@ namespace zs {
         }
       }
 
-      if (shouldProfile())
-        timer.tock(std::string("[Omp merge_sort_pair | File ") + loc.file_name() + ", Ln "
-                   + std::to_string(loc.line()) + ", Col " + std::to_string(loc.column()) + "]");
+      if (shouldProfile()) timer.tock(loc, "Omp merge_sort_pair");
     }
     template <typename KeyIter, typename ValueIter,
               typename CompareOpT
@@ -725,8 +717,8 @@ namespace zs {
       using DiffT = typename std::iterator_traits<IterT>::difference_type;
       using KeyT = typename std::iterator_traits<IterT>::value_type;
 
-      CppTimer timer;
-      if (shouldProfile()) timer.tick();
+      KernelTimer timer;
+      if (shouldProfile()) timer.tick(preparePerfCounters());
       const auto dist = last - first;
 
       auto allocator = get_temporary_memory_source(*this);
@@ -868,9 +860,7 @@ namespace zs {
           for (DiffT k = l; k < r; ++k) first[k] = ofirst[k];
       }
 
-      if (shouldProfile())
-        timer.tock(std::string("[Omp merge_sort | File ") + loc.file_name() + ", Ln "
-                   + std::to_string(loc.line()) + ", Col " + std::to_string(loc.column()) + "]");
+      if (shouldProfile()) timer.tock(loc, "Omp merge_sort");
     }
 
     template <class KeyIter,
@@ -947,8 +937,8 @@ namespace zs {
                                 || sizeof(InputValueT) == sizeof(double))),
                     "value type not supported by radix sort");
 
-      CppTimer timer;
-      if (shouldProfile()) timer.tick();
+      KernelTimer timer;
+      if (shouldProfile()) timer.tick(preparePerfCounters());
       const auto dist = last - first;
       DiffT nths{}, nwork{};
       // const int binBits = bit_length(_dop);
@@ -1058,9 +1048,7 @@ namespace zs {
 
 #pragma omp parallel for if (_dop < dist) num_threads(_dop)
       for (DiffT i = 0; i < dist; ++i) *(d_first + i) = curVals[i];
-      if (shouldProfile())
-        timer.tock(std::string("[Omp Exec | File ") + loc.file_name() + ", Ln "
-                   + std::to_string(loc.line()) + ", Col " + std::to_string(loc.column()) + "]");
+      if (shouldProfile()) timer.tock(loc, "Omp Exec");
     }
     template <class InputIt, class OutputIt> void radix_sort(
         InputIt &&first, InputIt &&last, OutputIt &&d_first, int sbit = 0,
@@ -1085,8 +1073,8 @@ namespace zs {
                             && (sizeof(KeyT) == sizeof(float) || sizeof(KeyT) == sizeof(double))),
                     "key type not supported by radix sort");
 
-      CppTimer timer;
-      if (shouldProfile()) timer.tick();
+      KernelTimer timer;
+      if (shouldProfile()) timer.tick(preparePerfCounters());
       const auto dist = count;
       DiffT nths{}, nwork{};
       // const int binBits = bit_length(_dop);
@@ -1204,9 +1192,7 @@ namespace zs {
         *(keysOut + i) = curKeys[i];
         *(valsOut + i) = curVals[i];
       }
-      if (shouldProfile())
-        timer.tock(std::string("[Omp Exec | File ") + loc.file_name() + ", Ln "
-                   + std::to_string(loc.line()) + ", Col " + std::to_string(loc.column()) + "]");
+      if (shouldProfile()) timer.tock(loc, "Omp Exec");
     }
     template <class KeyIter, class ValueIter,
               typename Tn
@@ -1228,11 +1214,30 @@ namespace zs {
       _dop = numThreads;
       return *this;
     }
+    int getThreads() const noexcept { return _dop; }
+    /// @brief also sample hardware counters (see PerfCounters) of profiled launches
+    OmpExecutionPolicy &perfCounters(bool enable) noexcept {
+      _perfCounters = enable;
+      return *this;
+    }
 
   protected:
     friend struct ExecutionPolicyInterface<OmpExecutionPolicy>;
 
+    /// @note attaches the pool threads once (per process) for the largest dop requested
+    bool preparePerfCounters() const {
+      if (!_perfCounters || !PerfCounters::supported()) return false;
+      static std::atomic<int> s_attachedDop{0};
+      int attached = s_attachedDop.load(std::memory_order_acquire);
+      if (attached < _dop && s_attachedDop.compare_exchange_strong(attached, _dop)) {
+#pragma omp parallel num_threads(_dop)
+        PerfCounters::attachCurrentThread();
+      }
+      return true;
+    }
+
     int _dop{1};
+    bool _perfCounters{false};
   };
 
   constexpr bool is_backend_available(OmpExecutionPolicy) noexcept { return true; }
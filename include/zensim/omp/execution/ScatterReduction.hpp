@@ -0,0 +1,175 @@
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "zensim/omp/execution/ExecutionPolicy.hpp"
+
+namespace zs {
+
+  /// @brief privatized scatter-add, a drop-in for host atomic_add upon contended targets
+  /// @note every thread accumulates into its own buffer, 'merge' then adds all buffers into the
+  /// target in parallel (no two merging threads touch the same target entry)
+  /// @note dense variant: per-thread buffers are split into pages allocated upon first touch,
+  /// thus memory stays proportional to the touched portion of the target
+  /// @note buffers are kept (zeroed) after merging so that subsequent passes reuse them
+  template <typename T, size_t PageBits = 10> struct ScatterReducer {
+    static_assert(is_arithmetic_v<T>, "scatter reduction only supports arithmetic types.");
+    using value_type = T;
+    using size_type = size_t;
+    static constexpr size_type page_size = (size_type)1 << PageBits;
+
+    ScatterReducer() = default;
+    ScatterReducer(const OmpExecutionPolicy &pol, T *target, size_type n)
+        : _target{target}, _size{n}, _numPages{(n + page_size - 1) / page_size} {
+      _buffers.resize(pol.getThreads());
+      for (auto &buffer : _buffers) buffer.pages.resize(_numPages);
+    }
+
+    constexpr T *target() const noexcept { return _target; }
+    constexpr size_type size() const noexcept { return _size; }
+    size_type numThreads() const noexcept { return _buffers.size(); }
+
+    /// @note only valid within the parallel region of the policy used for construction
+    void add(size_type i, T val) {
+      auto &buffer = _buffers[omp_get_thread_num()];
+      auto &page = buffer.pages[i >> PageBits];
+      if (!page) page.reset(new T[page_size]());
+      page[i & (page_size - 1)] += val;
+    }
+    void add(T *dst, T val) { add(static_cast<size_type>(dst - _target), val); }
+
+    /// @brief target += sum of all thread-private buffers, which are reset afterwards
+    void merge(const OmpExecutionPolicy &pol) {
+      const auto nth = _buffers.size();
+      pol(range(_numPages), [this, nth](size_type pg) {
+        T *dst = _target + pg * page_size;
+        const auto n = pg + 1 == _numPages ? _size - pg * page_size : page_size;
+        for (size_t t = 0; t != nth; ++t)
+          if (auto &page = _buffers[t].pages[pg]; page)
+            for (size_type k = 0; k != n; ++k) {
+              dst[k] += page[k];
+              page[k] = 0;
+            }
+      });
+    }
+    /// @brief release all pages
+    void clear() {
+      for (auto &buffer : _buffers)
+        for (auto &page : buffer.pages) page.reset();
+    }
+
+  protected:
+    /// padded to avoid false sharing among neighboring threads' page tables
+    struct alignas(128) Buffer {
+      std::vector<std::unique_ptr<T[]>> pages;
+    };
+    T *_target{nullptr};
+    size_type _size{0}, _numPages{0};
+    std::vector<Buffer> _buffers{};
+  };
+
+  /// @brief privatized scatter-add for sparsely touched (or huge) targets
+  /// @note per-thread open-addressing tables, partitioned by index so that 'merge' processes
+  /// each partition (across all threads) on a single thread
+  template <typename T> struct HashedScatterReducer {
+    static_assert(is_arithmetic_v<T>, "scatter reduction only supports arithmetic types.");
+    using value_type = T;
+    using size_type = size_t;
+    static constexpr size_type empty_key = detail::deduce_numeric_max<size_type>();
+
+    HashedScatterReducer() = default;
+    HashedScatterReducer(const OmpExecutionPolicy &pol, T *target, size_type n,
+                         size_type expectedEntriesPerThread = 1024)
+        : _target{target}, _size{n} {
+      const size_type nth = pol.getThreads();
+      _numPartitions = nth;
+      size_type cap = 16;
+      while (cap * _numPartitions < expectedEntriesPerThread * 2) cap <<= 1;
+      _tables.resize(nth * _numPartitions);
+      for (auto &table : _tables) table.reset(cap);
+    }
+
+    constexpr T *target() const noexcept { return _target; }
+    constexpr size_type size() const noexcept { return _size; }
+
+    /// @note only valid within the parallel region of the policy used for construction
+    void add(size_type i, T val) {
+      const size_type tid = omp_get_thread_num();
+      _tables[tid * _numPartitions + i % _numPartitions].add(i, val);
+    }
+    void add(T *dst, T val) { add(static_cast<size_type>(dst - _target), val); }
+
+    /// @brief target += sum of all thread-private tables, which are emptied afterwards
+    void merge(const OmpExecutionPolicy &pol) {
+      const auto nth = _tables.size() / _numPartitions;
+      pol(range(_numPartitions), [this, nth](size_type p) {
+        for (size_type t = 0; t != nth; ++t) {
+          auto &table = _tables[t * _numPartitions + p];
+          if (table.count == 0) continue;
+          for (size_type k = 0; k != table.keys.size(); ++k)
+            if (table.keys[k] != empty_key) {
+              _target[table.keys[k]] += table.vals[k];
+              table.keys[k] = empty_key;
+            }
+          table.count = 0;
+        }
+      });
+    }
+
+  protected:
+    struct alignas(128) Table {
+      void reset(size_type cap) {
+        keys.assign(cap, empty_key);
+        vals.assign(cap, (T)0);
+        count = 0;
+      }
+      void add(size_type key, T val) {
+        if ((count + 1) * 2 > keys.size()) grow();
+        const size_type mask = keys.size() - 1;
+        for (size_type slot = hash(key) & mask;; slot = (slot + 1) & mask) {
+          if (keys[slot] == key) {
+            vals[slot] += val;
+            return;
+          }
+          if (keys[slot] == empty_key) {
+            keys[slot] = key;
+            vals[slot] = val;
+            ++count;
+            return;
+          }
+        }
+      }
+      void grow() {
+        auto oldKeys = std::move(keys);
+        auto oldVals = std::move(vals);
+        reset(oldKeys.size() * 2);
+        for (size_type k = 0; k != oldKeys.size(); ++k)
+          if (oldKeys[k] != empty_key) add(oldKeys[k], oldVals[k]);
+      }
+      static constexpr size_type hash(size_type key) noexcept {
+        key ^= key >> 33;
+        key *= (size_type)0xff51afd7ed558ccdull;
+        key ^= key >> 33;
+        return key;
+      }
+      std::vector<size_type> keys;
+      std::vector<T> vals;
+      size_type count{0};
+    };
+    T *_target{nullptr};
+    size_type _size{0}, _numPartitions{1};
+    std::vector<Table> _tables{};
+  };
+
+  /// @brief drop-in replacements for atomic_add(exec_omp, dst, val) within policy lambdas
+  /// @note unlike atomic_add, the previous value is not available
+  template <typename T, size_t PageBits>
+  inline void atomic_add(ScatterReducer<T, PageBits> &reducer, T *dest, const T val) {
+    reducer.add(dest, val);
+  }
+  template <typename T>
+  inline void atomic_add(HashedScatterReducer<T> &reducer, T *dest, const T val) {
+    reducer.add(dest, val);
+  }
+
+}  // namespace zs
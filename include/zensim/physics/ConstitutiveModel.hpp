@@ -120,6 +120,16 @@ namespace zs {
                             is_floating_point_v<typename VecT::value_type>> = 0>
     constexpr auto first_piola(const VecInterface<VecT>& F) const noexcept {
       auto [U, S, V] = math::svd(F);
+      return first_piola_from_svd(U, S, V);
+    }
+    // first piola, upon a precomputed F = U diag(S) V^T
+    template <typename VecT, typename VecS,
+              enable_if_all<VecT::dim == 2, VecS::dim == 1, VecT::template range_t<0>::value <= 3,
+                            VecT::template range_t<0>::value == VecT::template range_t<1>::value,
+                            VecT::template range_t<0>::value == VecS::template range_t<0>::value,
+                            is_floating_point_v<typename VecT::value_type>> = 0>
+    constexpr auto first_piola_from_svd(const VecInterface<VecT>& U, const VecInterface<VecS>& S,
+                                        const VecInterface<VecT>& V) const noexcept {
       auto dE_dsigma = static_cast<const Model*>(this)->dpsi_dsigma(S);
       return diag_mul(U, dE_dsigma) * V.transpose();
     }
@@ -129,12 +139,24 @@ namespace zs {
                             VecT::template range_t<0>::value == VecT::template range_t<1>::value,
                             is_floating_point_v<typename VecT::value_type>> = 0>
     constexpr auto first_piola_derivative(const VecInterface<VecT>& F,
-                                          wrapv<project_SPD> = {}) const noexcept {
+                                          wrapv<project_SPD> flag = {}) const noexcept {
+      auto [U, S, V] = math::svd(F);
+      return first_piola_derivative_from_svd(U, S, V, flag);
+    }
+    // first piola derivative, upon a precomputed F = U diag(S) V^T
+    template <typename VecT, typename VecS, bool project_SPD = false,
+              enable_if_all<VecT::dim == 2, VecS::dim == 1, VecT::template range_t<0>::value <= 3,
+                            VecT::template range_t<0>::value == VecT::template range_t<1>::value,
+                            VecT::template range_t<0>::value == VecS::template range_t<0>::value,
+                            is_floating_point_v<typename VecT::value_type>> = 0>
+    constexpr auto first_piola_derivative_from_svd(const VecInterface<VecT>& U,
+                                                   const VecInterface<VecS>& S,
+                                                   const VecInterface<VecT>& V,
+                                                   wrapv<project_SPD> = {}) const noexcept {
       using T = typename VecT::value_type;
       using Ti = typename VecT::index_type;
       constexpr int dim = VecT::template range_t<0>::value;
 
-      auto [U, S, V] = math::svd(F);
       auto dE_dsigma = static_cast<const Model*>(this)->dpsi_dsigma(S);
       // A
       auto d2E_dsigma2 = static_cast<const Model*>(this)->d2psi_dsigma2(S);
@@ -264,7 +286,6 @@ namespace zs {
                             is_floating_point_v<typename VecT::value_type>> = 0>
     constexpr auto I_wrt_F(const VecInterface<VecT>& F, wrapv<project_SPD> = {}) const noexcept {
       constexpr auto dim = dim_t<VecT>::value;
-      using ScalarT = typename VecT::value_type;
       using index_type = typename VecT::index_type;
       using GradientT = gradient_t<VecT>;
       using HessianT = hessian_t<VecT>;
@@ -272,7 +293,6 @@ namespace zs {
 
       static_assert(!project_SPD, "no SPD projection impl for invariant-based iso elastic model");
 
-      using MatT = vec<ScalarT, dim, dim>;
       RetT ret{};
       ///  I1 (length)
       if constexpr (I == 0) {
@@ -287,35 +307,7 @@ namespace zs {
           zs::get<1>(ret) = vectorize(R);
         } else if constexpr (deriv_order == 2) {
           auto [U, S, V] = math::qr_svd(F);
-          zs::get<0>(ret) = S.sum();
-          auto R = U * V.transpose();
-          // ref: Dynamic Deformables: Implementations and Production Practices
-          // Sec 7.3.2, P96
-          zs::get<1>(ret) = vectorize(R);
-          // auto Ssym = diag_mul(V, S) * V.transpose();
-          auto& dRdF = zs::get<2>(ret);
-          dRdF = HessianT::zeros();
-          constexpr auto sqrt2Inv = (ScalarT)1 / g_sqrt2;
-          if constexpr (dim == 2) {
-            // ref: Dynamic Deformables: Implementations and Production Practices
-            // Sec 5.4.4 (5.42), P65
-            constexpr MatT T0{0, -1, 1, 0};
-            const auto vecQ0 = vectorize(sqrt2Inv * U * T0 * V.transpose());
-            dRdF
-                += (ScalarT)2 / math::max((S(0) + S(1)), (ScalarT)1e-6) * dyadic_prod(vecQ0, vecQ0);
-          } else if constexpr (dim == 3) {
-            // ref: Dynamic Deformables: Implementations and Production Practices
-            // Sec 5.4.4 (5.47), P67
-            // Sec 7.2 P89
-            constexpr MatT Ti[3] = {{0, -1, 0, 1, 0, 0, 0, 0, 0},
-                                    {0, 0, 0, 0, 0, 1, 0, -1, 0},
-                                    {0, 0, 1, 0, 0, 0, -1, 0, 0}};
-            for (int d = 0; d != 3; ++d) {
-              const auto vecQi = vectorize(sqrt2Inv * U * Ti[d] * V.transpose());
-              dRdF += ((ScalarT)2 / math::max((S(d) + S(d + 1 == 3 ? 0 : d + 1)), (ScalarT)1e-6)
-                       * dyadic_prod(vecQi, vecQi));
-            }
-          }
+          ret = I_wrt_F_from_svd<0, 2>(F, U, S, V);
         }
       }
       ///  I2 (area)
@@ -388,6 +380,60 @@ namespace zs {
       return ret;
     }
 
+    // isotropic invariants upon a precomputed F = U diag(S) V^T
+    // only I_1 relies on the decomposition, the others are evaluated from F directly
+    template <int I, int deriv_order = 0, typename VecT, typename VecTU, typename VecS,
+              enable_if_all<VecT::dim == 2, VecTU::dim == 2, VecS::dim == 1,
+                            VecT::template range_t<0>::value == VecT::template range_t<1>::value,
+                            VecT::template range_t<0>::value <= 3,
+                            is_floating_point_v<typename VecT::value_type>> = 0>
+    constexpr auto I_wrt_F_from_svd(const VecInterface<VecT>& F, const VecInterface<VecTU>& U,
+                                    const VecInterface<VecS>& S,
+                                    const VecInterface<VecTU>& V) const noexcept {
+      if constexpr (I == 0) {
+        constexpr auto dim = dim_t<VecT>::value;
+        using ScalarT = typename VecT::value_type;
+        using HessianT = hessian_t<VecT>;
+        using MatT = vec<ScalarT, dim, dim>;
+        pack_t<VecT, deriv_order> ret{};
+        zs::get<0>(ret) = S.sum();
+        if constexpr (deriv_order > 0) {
+          auto R = U * V.transpose();
+          // ref: Dynamic Deformables: Implementations and Production Practices
+          // Sec 7.3.2, P96
+          zs::get<1>(ret) = vectorize(R);
+        }
+        if constexpr (deriv_order > 1) {
+          // auto Ssym = diag_mul(V, S) * V.transpose();
+          auto& dRdF = zs::get<2>(ret);
+          dRdF = HessianT::zeros();
+          constexpr auto sqrt2Inv = (ScalarT)1 / g_sqrt2;
+          if constexpr (dim == 2) {
+            // ref: Dynamic Deformables: Implementations and Production Practices
+            // Sec 5.4.4 (5.42), P65
+            constexpr MatT T0{0, -1, 1, 0};
+            const auto vecQ0 = vectorize(sqrt2Inv * U * T0 * V.transpose());
+            dRdF
+                += (ScalarT)2 / math::max((S(0) + S(1)), (ScalarT)1e-6) * dyadic_prod(vecQ0, vecQ0);
+          } else if constexpr (dim == 3) {
+            // ref: Dynamic Deformables: Implementations and Production Practices
+            // Sec 5.4.4 (5.47), P67
+            // Sec 7.2 P89
+            constexpr MatT Ti[3] = {{0, -1, 0, 1, 0, 0, 0, 0, 0},
+                                    {0, 0, 0, 0, 0, 1, 0, -1, 0},
+                                    {0, 0, 1, 0, 0, 0, -1, 0, 0}};
+            for (int d = 0; d != 3; ++d) {
+              const auto vecQi = vectorize(sqrt2Inv * U * Ti[d] * V.transpose());
+              dRdF += ((ScalarT)2 / math::max((S(d) + S(d + 1 == 3 ? 0 : d + 1)), (ScalarT)1e-6)
+                       * dyadic_prod(vecQi, vecQi));
+            }
+          }
+        }
+        return ret;
+      } else
+        return I_wrt_F<I, deriv_order>(F);
+    }
+
     // anisotropic invariants
     // I_4 = aT S a (mainly use its sign info)
     // I_5 = aT FT F a
@@ -490,6 +536,13 @@ namespace zs {
       return static_cast<const Model*>(this)->template first_piola_derivative<VecT, false>(
           F, wrapv<false>{});
     }
+    // models whose projection relies on a decomposition override this to reuse a precomputed one
+    template <typename VecT, typename VecTU, typename VecS>
+    constexpr decltype(auto) do_first_piola_derivative_spd_from_svd(
+        const VecInterface<VecT>& F, const VecInterface<VecTU>&, const VecInterface<VecS>&,
+        const VecInterface<VecTU>&) const noexcept {
+      return static_cast<const Model*>(this)->template do_first_piola_derivative_spd<VecT>(F);
+    }
 
     /// isotropic
     // psi
@@ -520,6 +573,28 @@ namespace zs {
       zs::tie(Is(0), gi[0]) = I_wrt_F<0, 1>(F);
       zs::tie(Is[1], gi[1]) = I_wrt_F<1, 1>(F);
       zs::tie(Is[2], gi[2]) = I_wrt_F<2, 1>(F);
+      return first_piola_from_invariants<VecT>(Is, gi);
+    }
+    // first piola, upon a precomputed F = U diag(S) V^T
+    template <typename VecT, typename VecTU, typename VecS,
+              enable_if_all<VecT::dim == 2, VecT::template range_t<0>::value <= 3,
+                            VecT::template range_t<0>::value == VecT::template range_t<1>::value,
+                            is_floating_point_v<typename VecT::value_type>> = 0>
+    constexpr auto first_piola_from_svd(const VecInterface<VecT>& F, const VecInterface<VecTU>& U,
+                                        const VecInterface<VecS>& S,
+                                        const VecInterface<VecTU>& V) const noexcept {
+      typename VecT::template variant_vec<typename VecT::value_type,
+                                          integer_sequence<typename VecT::index_type, 3>>
+          Is{};
+      gradient_t<VecT> gi[3]{};
+      zs::tie(Is(0), gi[0]) = I_wrt_F_from_svd<0, 1>(F, U, S, V);
+      zs::tie(Is[1], gi[1]) = I_wrt_F<1, 1>(F);
+      zs::tie(Is[2], gi[2]) = I_wrt_F<2, 1>(F);
+      return first_piola_from_invariants<VecT>(Is, gi);
+    }
+    template <typename VecT, typename VecI>
+    constexpr auto first_piola_from_invariants(const VecInterface<VecI>& Is,
+                                               const gradient_t<VecT> (&gi)[3]) const noexcept {
       auto res = gradient_t<VecT>::zeros();
       res += dpsi_dI<0>(Is) * gi[0];
       res += dpsi_dI<1>(Is) * gi[1];
@@ -553,13 +628,44 @@ namespace zs {
         zs::tie(Is[0], gi[0], Hi[0]) = I_wrt_F<0, 2>(F, flag);
         zs::tie(Is[1], gi[1], Hi[1]) = I_wrt_F<1, 2>(F, flag);
         zs::tie(Is[2], gi[2], Hi[2]) = I_wrt_F<2, 2>(F, flag);
-        auto dPdF = hessian_t<VecT>::zeros();
-        dPdF += d2psi_dI2<0>(Is) * dyadic_prod(gi[0], gi[0]) + dpsi_dI<0>(Is) * Hi[0];
-        dPdF += d2psi_dI2<1>(Is) * dyadic_prod(gi[1], gi[1]) + dpsi_dI<1>(Is) * Hi[1];
-        dPdF += d2psi_dI2<2>(Is) * dyadic_prod(gi[2], gi[2]) + dpsi_dI<2>(Is) * Hi[2];
-        return dPdF;
+        return first_piola_derivative_from_invariants<VecT>(Is, gi, Hi);
       }
     }
+    // first piola derivative, upon a precomputed F = U diag(S) V^T
+    // @note the spd projection is model specific (do_first_piola_derivative_spd_from_svd)
+    template <typename VecT, typename VecTU, typename VecS, bool project_SPD = false,
+              enable_if_all<VecT::dim == 2, VecT::template range_t<0>::value <= 3,
+                            VecT::template range_t<0>::value == VecT::template range_t<1>::value,
+                            is_floating_point_v<typename VecT::value_type>> = 0>
+    constexpr auto first_piola_derivative_from_svd(const VecInterface<VecT>& F,
+                                                   const VecInterface<VecTU>& U,
+                                                   const VecInterface<VecS>& S,
+                                                   const VecInterface<VecTU>& V,
+                                                   wrapv<project_SPD> flag = {}) const noexcept {
+      if constexpr (project_SPD) {
+        return static_cast<const Model*>(this)->do_first_piola_derivative_spd_from_svd(F, U, S, V);
+      } else {
+        typename VecT::template variant_vec<typename VecT::value_type,
+                                            integer_sequence<typename VecT::index_type, 3>>
+            Is{};
+        gradient_t<VecT> gi[3]{};
+        hessian_t<VecT> Hi[3]{};
+        zs::tie(Is[0], gi[0], Hi[0]) = I_wrt_F_from_svd<0, 2>(F, U, S, V);
+        zs::tie(Is[1], gi[1], Hi[1]) = I_wrt_F<1, 2>(F, flag);
+        zs::tie(Is[2], gi[2], Hi[2]) = I_wrt_F<2, 2>(F, flag);
+        return first_piola_derivative_from_invariants<VecT>(Is, gi, Hi);
+      }
+    }
+    template <typename VecT, typename VecI>
+    constexpr auto first_piola_derivative_from_invariants(
+        const VecInterface<VecI>& Is, const gradient_t<VecT> (&gi)[3],
+        const hessian_t<VecT> (&Hi)[3]) const noexcept {
+      auto dPdF = hessian_t<VecT>::zeros();
+      dPdF += d2psi_dI2<0>(Is) * dyadic_prod(gi[0], gi[0]) + dpsi_dI<0>(Is) * Hi[0];
+      dPdF += d2psi_dI2<1>(Is) * dyadic_prod(gi[1], gi[1]) + dpsi_dI<1>(Is) * Hi[1];
+      dPdF += d2psi_dI2<2>(Is) * dyadic_prod(gi[2], gi[2]) + dpsi_dI<2>(Is) * Hi[2];
+      return dPdF;
+    }
 
     /// anisotropic
     // psi
@@ -0,0 +1,124 @@
+#pragma once
+#include <cstring>
+
+#include "ConstitutiveModel.hpp"
+#include "zensim/math/matrix/SVDBatch.hpp"
+
+namespace zs {
+
+  namespace detail {
+    template <typename Model> constexpr bool is_isotropic_constitutive_model_v
+        = is_base_of_v<IsotropicConstitutiveModelInterface<Model>, Model>;
+    template <typename Model> constexpr bool is_invariant_constitutive_model_v
+        = is_base_of_v<InvariantConstitutiveModelInterface<Model>, Model>;
+
+    /// @brief tilevector channel offset of an optional output, -1 if not requested
+    template <typename TileVectorT>
+    int optional_property_(const TileVectorT &tv, const SmallString &tag, int extent) {
+      if (tag.size() == 0) return -1;
+      return math::detail::require_property_(tv, tag, extent);
+    }
+  }  // namespace detail
+
+  /// @brief evaluates an isotropic (or invariant-based) elastic model over every element of [tv],
+  /// batching only the singular value decompositions
+  /// @note the deformation gradients [fTag] (row-major 3x3) are decomposed W at a time in simd
+  /// registers (see math::svd_3d_tiles). The model formulas are scalar: energy, stress and its
+  /// derivative are evaluated lane by lane upon the precomputed decompositions (psi_sigma,
+  /// first_piola_from_svd, first_piola_derivative_from_svd), none of them decomposes again.
+  /// @note outputs are optional (pass an empty tag to skip): [psiTag] energy density (1 channel),
+  /// [pTag] first piola stress (row-major 3x3), [hTag] dP/dF (row-major 9x9, F vectorized in
+  /// column-major order), spd-projected if [project_SPD] is set.
+  template <typename Policy, size_t Length, typename Allocator, typename Model,
+            bool project_SPD = false>
+  void evaluate_constitutive_model_svd_batched(Policy &&pol,
+                                               TileVector<float, Length, Allocator> &tv,
+                                               const Model &model, const SmallString &fTag,
+                                               const SmallString &pTag,
+                                               const SmallString &psiTag = "",
+                                               const SmallString &hTag = "",
+                                               wrapv<project_SPD> projectSPD = {}) {
+    static_assert(detail::is_isotropic_constitutive_model_v<Model>
+                      || detail::is_invariant_constitutive_model_v<Model>,
+                  "batch evaluation expects an isotropic or invariant-based constitutive model");
+    static_assert(is_same_v<typename Model::value_type, float>,
+                  "batch evaluation works upon single precision models");
+    using P = math::detail::float_lanes<math::detail::batch_float_lanes<Length>()>;
+    using mat3 = vec<float, 3, 3>;
+    using vec3 = vec<float, 3>;
+    constexpr int W = P::width;
+
+    const int fOffset = math::detail::require_property_(tv, fTag, 9);
+    const int pOffset = detail::optional_property_(tv, pTag, 9);
+    const int psiOffset = detail::optional_property_(tv, psiTag, 1);
+    const int hOffset = detail::optional_property_(tv, hTag, 81);
+
+    math::detail::for_each_lane_batch_(pol, tv, [&](float *base, size_t count) {
+      constexpr float identity[9] = {1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f};
+      P Fl[3][3], Ul[3][3], Sl[3], Vl[3][3];
+      math::detail::load_lanes_<P, 9>(&Fl[0][0], base + fOffset * Length, Length, count,
+                                      identity);
+      math::svd_3d_lanes(Fl, Ul, Sl, Vl);
+
+      /// transpose the decompositions to per-lane matrices
+      float f[9][W], u[9][W], s[3][W], v[9][W];
+      for (int c = 0; c != 9; ++c) {
+        (&Fl[0][0])[c].store(f[c]);
+        (&Ul[0][0])[c].store(u[c]);
+        (&Vl[0][0])[c].store(v[c]);
+      }
+      for (int c = 0; c != 3; ++c) Sl[c].store(s[c]);
+
+      float stress[9][W], energy[W], hessian[81][W];
+      for (int l = 0; l != (int)count; ++l) {
+        mat3 F{}, U{}, V{};
+        vec3 S{};
+        for (int c = 0; c != 9; ++c) {
+          F.val(c) = f[c][l];
+          U.val(c) = u[c][l];
+          V.val(c) = v[c][l];
+        }
+        for (int c = 0; c != 3; ++c) S.val(c) = s[c][l];
+
+        if constexpr (detail::is_isotropic_constitutive_model_v<Model>) {
+          if (psiOffset >= 0) energy[l] = model.psi_sigma(S);
+          if (pOffset >= 0) {
+            const auto Pl = model.first_piola_from_svd(U, S, V);
+            for (int c = 0; c != 9; ++c) stress[c][l] = Pl.val(c);
+          }
+          if (hOffset >= 0) {
+            const auto Hl = model.first_piola_derivative_from_svd(U, S, V, projectSPD);
+            for (int c = 0; c != 81; ++c) hessian[c][l] = Hl.val(c);
+          }
+        } else {
+          if (psiOffset >= 0) {
+            vec3 Is{};
+            Is[0] = zs::get<0>(model.template I_wrt_F_from_svd<0, 0>(F, U, S, V));
+            Is[1] = zs::get<0>(model.template I_wrt_F<1, 0>(F));
+            Is[2] = zs::get<0>(model.template I_wrt_F<2, 0>(F));
+            energy[l] = model.psi_I(Is);
+          }
+          if (pOffset >= 0) {
+            const auto Pl = model.first_piola_from_svd(F, U, S, V);
+            for (int c = 0; c != 9; ++c) stress[c][l] = Pl.val(c);
+          }
+          if (hOffset >= 0) {
+            const auto Hl = model.first_piola_derivative_from_svd(F, U, S, V, projectSPD);
+            for (int c = 0; c != 81; ++c) hessian[c][l] = Hl.val(c);
+          }
+        }
+      }
+
+      /// unit-stride channel rows back into the tile
+      const auto bytes = sizeof(float) * count;
+      if (psiOffset >= 0) std::memcpy(base + psiOffset * Length, energy, bytes);
+      if (pOffset >= 0)
+        for (int c = 0; c != 9; ++c)
+          std::memcpy(base + (pOffset + c) * Length, stress[c], bytes);
+      if (hOffset >= 0)
+        for (int c = 0; c != 81; ++c)
+          std::memcpy(base + (hOffset + c) * Length, hessian[c], bytes);
+    });
+  }
+
+}  // namespace zs
@@ -203,6 +203,18 @@ namespace zs {
                             is_floating_point_v<typename VecT::value_type>>
               = 0>
     constexpr auto do_first_piola_derivative_spd(const VecInterface<VecT>& F) const noexcept {
+      auto [U, S, V] = math::qr_svd(F);
+      return do_first_piola_derivative_spd_from_svd(F, U, S, V);
+    }
+    // upon a precomputed F = U diag(S) V^T
+    template <typename VecT, typename VecTU, typename VecS,
+              enable_if_all<VecT::dim == 2, VecT::template range_t<0>::value == 3,
+                            VecT::template range_t<0>::value == VecT::template range_t<1>::value,
+                            is_floating_point_v<typename VecT::value_type>>
+              = 0>
+    constexpr auto do_first_piola_derivative_spd_from_svd(
+        const VecInterface<VecT>& F, const VecInterface<VecTU>& U, const VecInterface<VecS>& S,
+        const VecInterface<VecTU>& V) const noexcept {
       // sum_i ((d2Psi / dI_i2) g_i g_i^T + ((dPsi / dI_i) H_i))
       // printf("do_first_piola_derivative_spd get called\n");
 
@@ -210,11 +222,9 @@ namespace zs {
                                           integer_sequence<typename VecT::index_type, 3>>
           Is{};
 
-      auto [U, S, V] = math::qr_svd(F);
-
-      Is[0] = zs::get<0>(base_t::I_wrt_F<0, 0>(F));
-      Is[1] = zs::get<0>(base_t::I_wrt_F<1, 0>(F));
-      Is[2] = zs::get<0>(base_t::I_wrt_F<2, 0>(F));
+      Is[0] = zs::get<0>(base_t::template I_wrt_F_from_svd<0, 0>(F, U, S, V));
+      Is[1] = zs::get<0>(base_t::template I_wrt_F<1, 0>(F));
+      Is[2] = zs::get<0>(base_t::template I_wrt_F<2, 0>(F));
 
       auto A = eval_stretching_matrix(Is, S);
       auto [A_eigvals, A_eigvecs] = zs::eigen_decomposition(A.template cast<double>());
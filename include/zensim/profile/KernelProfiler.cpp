@@ -0,0 +1,350 @@
+#include "KernelProfiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+#include "zensim/zpc_tpls/fmt/color.h"
+#include "zensim/zpc_tpls/fmt/core.h"
+
+namespace zs {
+
+  namespace {
+
+    struct EventChunk {
+      static constexpr size_t capacity = 4096;
+      ProfileEvent events[capacity];
+      std::atomic<size_t> count{0};
+      std::atomic<EventChunk *> next{nullptr};
+    };
+
+    /// single writer (the owning thread), any number of readers
+    struct ThreadEventBuffer {
+      explicit ThreadEventBuffer(u32 tid) : thread{tid} { head = tail = new EventChunk; }
+      ~ThreadEventBuffer() { release(head); }
+
+      static void release(EventChunk *chunk) {
+        while (chunk) {
+          auto next = chunk->next.load(std::memory_order_relaxed);
+          delete chunk;
+          chunk = next;
+        }
+      }
+      /// only invoked by the owning thread, upon observing a newer generation
+      void reset(u64 gen) {
+        auto rest = head->next.exchange(nullptr, std::memory_order_acq_rel);
+        head->count.store(0, std::memory_order_release);
+        tail = head;
+        release(rest);
+        generation.store(gen, std::memory_order_release);
+      }
+      void push(const ProfileEvent &e) {
+        auto n = tail->count.load(std::memory_order_relaxed);
+        if (n == EventChunk::capacity) {
+          auto chunk = new EventChunk;
+          tail->next.store(chunk, std::memory_order_release);
+          tail = chunk;
+          n = 0;
+        }
+        tail->events[n] = e;
+        tail->count.store(n + 1, std::memory_order_release);
+      }
+      template <typename F> void forEach(F &&f) const {
+        for (auto chunk = head; chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+          const auto n = chunk->count.load(std::memory_order_acquire);
+          for (size_t i = 0; i != n; ++i) f(chunk->events[i]);
+        }
+      }
+
+      EventChunk *head, *tail;
+      std::atomic<u64> generation{0};
+      u32 thread;
+    };
+
+    struct SourceKey {
+      const char *file;
+      const char *category;
+      int line, column;
+      bool operator==(const SourceKey &o) const noexcept {
+        return file == o.file && category == o.category && line == o.line && column == o.column;
+      }
+    };
+    struct SourceKeyHash {
+      size_t operator()(const SourceKey &k) const noexcept {
+        size_t h = std::hash<const void *>{}(k.file);
+        h ^= std::hash<const void *>{}(k.category) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+        h ^= std::hash<long long>{}(((long long)k.line << 32) | (unsigned)k.column)
+             + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+        return h;
+      }
+    };
+
+    /// per-thread direct-mapped cache of interned launch sites
+    struct SiteCache {
+      static constexpr size_t size = 64;
+      SourceKey keys[size]{};
+      u32 ids[size]{};
+    };
+
+    std::string escape_json(std::string_view str) {
+      std::string ret;
+      ret.reserve(str.size());
+      for (char c : str) {
+        if (c == '"' || c == '\\')
+          ret.push_back('\\'), ret.push_back(c);
+        else if ((unsigned char)c < 0x20)
+          ret.push_back(' ');
+        else
+          ret.push_back(c);
+      }
+      return ret;
+    }
+
+  }  // namespace
+
+  struct KernelProfiler::Impl {
+    std::atomic<bool> enabled{false};
+    std::atomic<u64> generation{0};
+
+    mutable std::mutex siteMutex;
+    std::deque<ProfileSite> sites;
+    std::unordered_map<SourceKey, u32, SourceKeyHash> sourceSites;
+    std::map<std::pair<std::string, std::string>, u32> labelSites;
+
+    mutable std::mutex bufferMutex;
+    std::vector<std::unique_ptr<ThreadEventBuffer>> buffers;
+
+    /// per-site counter sums, only touched by launches sampling hardware counters
+    mutable std::mutex counterMutex;
+    std::unordered_map<u32, std::pair<u64, PerfCounterValues>> counters;
+
+    ThreadEventBuffer &localBuffer() {
+      thread_local ThreadEventBuffer *buffer = nullptr;
+      if (!buffer) {
+        std::lock_guard<std::mutex> lk{bufferMutex};
+        buffers.push_back(std::make_unique<ThreadEventBuffer>((u32)buffers.size()));
+        buffer = buffers.back().get();
+        buffer->generation.store(generation.load(std::memory_order_acquire));
+      }
+      if (auto gen = generation.load(std::memory_order_acquire);
+          buffer->generation.load(std::memory_order_relaxed) != gen)
+        buffer->reset(gen);
+      return *buffer;
+    }
+    template <typename F> void forEachEvent(F &&f) const {
+      std::lock_guard<std::mutex> lk{bufferMutex};
+      const auto gen = generation.load(std::memory_order_acquire);
+      for (auto &buffer : buffers)
+        if (buffer->generation.load(std::memory_order_acquire) == gen) buffer->forEach(f);
+    }
+  };
+
+  KernelProfiler::KernelProfiler() : _impl{new Impl} {}
+  KernelProfiler::~KernelProfiler() { delete _impl; }
+
+  KernelProfiler &KernelProfiler::instance() {
+    static KernelProfiler s_profiler;
+    return s_profiler;
+  }
+  u64 KernelProfiler::now() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  void KernelProfiler::enable(bool on) noexcept {
+    _impl->enabled.store(on, std::memory_order_relaxed);
+  }
+  bool KernelProfiler::enabled() const noexcept {
+    return _impl->enabled.load(std::memory_order_relaxed);
+  }
+
+  u32 KernelProfiler::intern(const source_location &loc, const char *category) {
+    thread_local SiteCache cache{};
+    const SourceKey key{loc.file_name(), category, loc.line(), loc.column()};
+    const auto idx = SourceKeyHash{}(key) % SiteCache::size;
+    if (cache.keys[idx] == key && key.file) return cache.ids[idx];
+
+    std::lock_guard<std::mutex> lk{_impl->siteMutex};
+    auto [it, inserted] = _impl->sourceSites.try_emplace(key, (u32)_impl->sites.size());
+    if (inserted) {
+      ProfileSite site{};
+      site.name = std::string(loc.file_name()) + ":" + std::to_string(loc.line());
+      site.category = category;
+      site.file = loc.file_name();
+      site.line = loc.line();
+      _impl->sites.push_back(zs::move(site));
+    }
+    cache.keys[idx] = key;
+    cache.ids[idx] = it->second;
+    return it->second;
+  }
+  u32 KernelProfiler::intern(std::string_view label, const char *category) {
+    std::lock_guard<std::mutex> lk{_impl->siteMutex};
+    auto [it, inserted] = _impl->labelSites.try_emplace(
+        std::make_pair(std::string(label), std::string(category)), (u32)_impl->sites.size());
+    if (inserted) {
+      ProfileSite site{};
+      site.name = std::string(label);
+      site.category = category;
+      _impl->sites.push_back(zs::move(site));
+    }
+    return it->second;
+  }
+  ProfileSite KernelProfiler::site(u32 id) const {
+    std::lock_guard<std::mutex> lk{_impl->siteMutex};
+    return id < _impl->sites.size() ? _impl->sites[id] : ProfileSite{};
+  }
+  u32 KernelProfiler::numSites() const {
+    std::lock_guard<std::mutex> lk{_impl->siteMutex};
+    return (u32)_impl->sites.size();
+  }
+
+  void KernelProfiler::record(u32 site, u64 begin, u64 end) {
+    if (site == invalid_site) return;
+    auto &buffer = _impl->localBuffer();
+    buffer.push(ProfileEvent{begin, end, site, buffer.thread});
+  }
+
+  void KernelProfiler::record(u32 site, u64 begin, u64 end, const PerfCounterValues &counters) {
+    if (site == invalid_site) return;
+    record(site, begin, end);
+    if (counters.mask == 0) return;
+    std::lock_guard<std::mutex> lk{_impl->counterMutex};
+    auto &entry = _impl->counters[site];
+    entry.first++;
+    entry.second += counters;
+  }
+
+  std::vector<ProfileEvent> KernelProfiler::events() const {
+    std::vector<ProfileEvent> ret;
+    _impl->forEachEvent([&ret](const ProfileEvent &e) { ret.push_back(e); });
+    std::sort(ret.begin(), ret.end(),
+              [](const ProfileEvent &a, const ProfileEvent &b) { return a.begin < b.begin; });
+    return ret;
+  }
+
+  std::vector<ProfileRecord> KernelProfiler::aggregate() const {
+    std::unordered_map<u32, std::vector<u64>> durations;
+    _impl->forEachEvent([&durations](const ProfileEvent &e) {
+      durations[e.site].push_back(e.end > e.begin ? e.end - e.begin : 0);
+    });
+    std::vector<ProfileRecord> ret;
+    ret.reserve(durations.size());
+    for (auto &[id, ds] : durations) {
+      std::sort(ds.begin(), ds.end());
+      const auto rank = [&ds](double q) {
+        /// nearest-rank percentile
+        size_t k = (size_t)(q * ds.size() + 0.999999);
+        return ds[std::min(std::max(k, (size_t)1), ds.size()) - 1] * 1e-6;
+      };
+      ProfileRecord r{};
+      auto s = site(id);
+      r.site = id;
+      r.name = zs::move(s.name);
+      r.category = s.category;
+      r.count = ds.size();
+      for (auto d : ds) r.total += d * 1e-6;
+      r.min = ds.front() * 1e-6;
+      r.max = ds.back() * 1e-6;
+      r.p50 = rank(0.5);
+      r.p99 = rank(0.99);
+      {
+        std::lock_guard<std::mutex> lk{_impl->counterMutex};
+        if (auto it = _impl->counters.find(id); it != _impl->counters.end()) {
+          r.countedLaunches = it->second.first;
+          r.counters = it->second.second;
+        }
+      }
+      ret.push_back(zs::move(r));
+    }
+    std::sort(ret.begin(), ret.end(),
+              [](const ProfileRecord &a, const ProfileRecord &b) { return a.total > b.total; });
+    return ret;
+  }
+
+  void KernelProfiler::report() const {
+    const auto records = aggregate();
+    fmt::print(fg(fmt::color::cyan), "{:>10} {:>12} {:>10} {:>10} {:>10} {:>10}  {}\n", "count",
+               "total(ms)", "min", "p50", "p99", "max", "site");
+    for (const auto &r : records) {
+      fmt::print("{:>10} {:>12.3f} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.3f}  [{}] {}\n", r.count,
+                 r.total, r.min, r.p50, r.p99, r.max, r.category, r.name);
+      if (r.countedLaunches && r.counters.mask) {
+        const auto &c = r.counters;
+        fmt::print("{:>10} ipc {:.2f}, llc miss {:.1f}%, {:.1f} MB llc-miss traffic, {} branch "
+                   "misses\n",
+                   "", c.ipc(),
+                   c.valid(perf_llc_references) && c[perf_llc_references]
+                       ? 100. * c[perf_llc_misses] / c[perf_llc_references]
+                       : 0.,
+                   c.llcMissBytes() / (1024. * 1024.), c[perf_branch_misses]);
+      }
+    }
+  }
+
+  std::string KernelProfiler::chromeTrace() const {
+    const auto es = events();
+    const u64 origin = es.empty() ? 0 : es.front().begin;
+    std::vector<ProfileSite> sites;
+    {
+      std::lock_guard<std::mutex> lk{_impl->siteMutex};
+      sites.assign(_impl->sites.begin(), _impl->sites.end());
+    }
+    std::ostringstream oss;
+    oss.precision(3);
+    oss << std::fixed << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto &e : es) {
+      const auto &s = sites[e.site];
+      oss << (first ? "" : ",") << "\n{\"name\":\"" << escape_json(s.name) << "\",\"cat\":\""
+          << escape_json(s.category) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << e.thread
+          << ",\"ts\":" << (e.begin - origin) * 1e-3
+          << ",\"dur\":" << (e.end > e.begin ? e.end - e.begin : 0) * 1e-3 << "}";
+      first = false;
+    }
+    oss << "\n]}\n";
+    return oss.str();
+  }
+  bool KernelProfiler::writeChromeTrace(const std::string &path) const {
+    const auto trace = chromeTrace();
+    FILE *fp = std::fopen(path.c_str(), "wb");
+    if (!fp) return false;
+    const bool ok = std::fwrite(trace.data(), 1, trace.size(), fp) == trace.size();
+    return std::fclose(fp) == 0 && ok;
+  }
+
+  void KernelProfiler::clear() {
+    std::lock_guard<std::mutex> lk{_impl->bufferMutex};
+    /// buffers are reset lazily by their owning threads
+    _impl->generation.fetch_add(1, std::memory_order_acq_rel);
+    std::lock_guard<std::mutex> clk{_impl->counterMutex};
+    _impl->counters.clear();
+  }
+
+  void KernelTimer::tick(bool withCounters) noexcept {
+    _counters = withCounters ? PerfCounters::read() : PerfCounterValues{};
+    _begin = KernelProfiler::now();
+  }
+
+  void KernelTimer::tock(const source_location &loc, const char *category) {
+    const auto end = KernelProfiler::now();
+    auto &profiler = KernelProfiler::instance();
+    if (_counters.mask) {
+      auto counters = PerfCounters::read();
+      counters.mask &= _counters.mask;
+      for (u32 c = 0; c != num_perf_counters; ++c)
+        counters.values[c] = counters.values[c] - _counters.values[c];
+      profiler.record(profiler.intern(loc, category), _begin, end, counters);
+    } else
+      profiler.record(profiler.intern(loc, category), _begin, end);
+  }
+
+}  // namespace zs
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "zensim/profile/PerfCounters.hpp"
+#include "zensim/types/SourceLocation.hpp"
+
+namespace zs {
+
+  /// @brief interned origin of profiled events (a launch site or a named task/pass)
+  struct ProfileSite {
+    std::string name{};  ///< "file:line" for launch sites, the label otherwise
+    const char *category{""};
+    const char *file{nullptr};
+    u32 line{0};
+  };
+
+  /// @note timestamps in nanoseconds of KernelProfiler::now()
+  struct ProfileEvent {
+    u64 begin{0}, end{0};
+    u32 site{0};
+    u32 thread{0};
+  };
+
+  /// @brief per-site aggregation, durations in milliseconds
+  struct ProfileRecord {
+    u32 site{0};
+    std::string name{};
+    const char *category{""};
+    u64 count{0};
+    double total{0}, min{0}, max{0}, p50{0}, p99{0};
+    /// hardware counters summed over the 'countedLaunches' events recorded with counters
+    u64 countedLaunches{0};
+    PerfCounterValues counters{};
+  };
+
+  /// @brief low-overhead profiling sink shared by execution policies, AsyncScheduler and
+  /// ExecutionGraph
+  /// @note events are appended to per-thread chunked buffers (no locks upon recording), sites are
+  /// interned once and cached per thread
+  /// @note aggregation and export may run concurrently with recording, yet 'clear' should only be
+  /// issued when no events are being recorded
+  struct ZPC_CORE_API KernelProfiler {
+    static constexpr u32 invalid_site = ~(u32)0;
+
+    static KernelProfiler &instance();
+    static u64 now() noexcept;
+
+    /// @brief switch for sources without a per-policy profile flag (scheduler tasks, graph passes)
+    void enable(bool on) noexcept;
+    bool enabled() const noexcept;
+
+    u32 intern(const source_location &loc, const char *category);
+    u32 intern(std::string_view label, const char *category);
+    ProfileSite site(u32 id) const;
+    u32 numSites() const;
+
+    void record(u32 site, u64 begin, u64 end);
+    void record(u32 site, u64 begin, u64 end, const PerfCounterValues &counters);
+
+    std::vector<ProfileEvent> events() const;
+    std::vector<ProfileRecord> aggregate() const;
+    /// @brief prints the aggregated records, sorted by total time
+    void report() const;
+    /// @brief chrome trace event format (loadable by chrome://tracing and perfetto)
+    std::string chromeTrace() const;
+    bool writeChromeTrace(const std::string &path) const;
+    void clear();
+
+    KernelProfiler(const KernelProfiler &) = delete;
+    KernelProfiler &operator=(const KernelProfiler &) = delete;
+
+  private:
+    KernelProfiler();
+    ~KernelProfiler();
+
+    struct Impl;
+    Impl *_impl;
+  };
+
+  /// @brief records the lifetime of the scope as an event of the given site
+  struct ProfileScope {
+    explicit ProfileScope(u32 site) noexcept
+        : _site{site}, _begin{site != KernelProfiler::invalid_site ? KernelProfiler::now() : 0} {}
+    ~ProfileScope() {
+      if (_site != KernelProfiler::invalid_site)
+        KernelProfiler::instance().record(_site, _begin, KernelProfiler::now());
+    }
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+  private:
+    u32 _site;
+    u64 _begin;
+  };
+
+  /// @brief timer used by execution policies when profiling is requested
+  /// @note optionally samples hardware counters (of all attached threads) around the launch
+  struct ZPC_CORE_API KernelTimer {
+    void tick(bool withCounters = false) noexcept;
+    void tock(const source_location &loc, const char *category);
+
+  private:
+    u64 _begin{0};
+    PerfCounterValues _counters{};
+  };
+
+}  // namespace zs
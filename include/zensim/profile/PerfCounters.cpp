@@ -0,0 +1,186 @@
+#include "PerfCounters.hpp"
+
+#include <mutex>
+#include <vector>
+
+#if defined(__linux__)
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+
+#  include <cstring>
+#endif
+
+namespace zs {
+
+  namespace {
+
+    /// one event group per thread, led by the cycles counter, members that failed to open are -1
+    struct ThreadCounters {
+      int fds[num_perf_counters];
+    };
+
+    struct CounterRegistry {
+      std::mutex mutex;
+      std::vector<const ThreadCounters *> threads;
+      /// final readings of detached (exited) threads, keeps the sums monotonic
+      PerfCounterValues retired{};
+    };
+    CounterRegistry &registry() {
+      static CounterRegistry s_registry;
+      return s_registry;
+    }
+
+#if defined(__linux__)
+    int open_counter(perf_counter_e c, int groupFd) noexcept {
+      static constexpr u64 configs[num_perf_counters]
+          = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_REFERENCES,
+             PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = configs[c];
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      /// members are scheduled together with the leader, the times expose multiplexing
+      attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+                         | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      /// this thread, any cpu
+      return (int)syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC);
+    }
+
+    void open_group(ThreadCounters &counters) noexcept {
+      for (u32 c = 0; c != num_perf_counters; ++c) counters.fds[c] = -1;
+      const int leader = open_counter(perf_cycles, -1);
+      if (leader < 0) return;
+      counters.fds[perf_cycles] = leader;
+      for (u32 c = perf_cycles + 1; c != num_perf_counters; ++c)
+        counters.fds[c] = open_counter((perf_counter_e)c, leader);
+    }
+
+    void close_group(ThreadCounters &counters) noexcept {
+      /// members first, the leader last
+      for (u32 c = num_perf_counters; c-- != 0;)
+        if (counters.fds[c] >= 0) close(counters.fds[c]);
+      for (u32 c = 0; c != num_perf_counters; ++c) counters.fds[c] = -1;
+    }
+
+    /// accumulates one group reading, scaled by enabled / running time when the group was
+    /// multiplexed with other events
+    void read_group(const ThreadCounters &counters, PerfCounterValues &sum) noexcept {
+      const int leader = counters.fds[perf_cycles];
+      if (leader < 0) return;
+      /// { nr, time_enabled, time_running, value[nr] }, values in the order the group was opened
+      u64 buf[3 + num_perf_counters];
+      const auto got = ::read(leader, buf, sizeof(buf));
+      if (got < (ssize_t)(3 * sizeof(u64))) return;
+      const u64 nr = buf[0], enabled = buf[1], running = buf[2];
+      /// never scheduled, there is nothing to extrapolate from
+      if (running == 0) return;
+      const double scale = running < enabled ? (double)enabled / (double)running : 1.;
+      u64 slot = 0;
+      for (u32 c = 0; c != num_perf_counters; ++c) {
+        if (counters.fds[c] < 0) continue;
+        if (slot == nr || got < (ssize_t)((4 + slot) * sizeof(u64))) break;
+        sum.values[c] += (u64)((double)buf[3 + slot++] * scale);
+        sum.mask |= 1u << c;
+      }
+    }
+
+    /// detaches the thread upon its exit: the final readings are retired, the fds closed
+    struct ThreadAttachment {
+      ThreadCounters counters;
+      bool attached{false};
+
+      ~ThreadAttachment() {
+        if (!attached) return;
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lk{reg.mutex};
+        read_group(counters, reg.retired);
+        for (auto it = reg.threads.begin(); it != reg.threads.end(); ++it)
+          if (*it == &counters) {
+            reg.threads.erase(it);
+            break;
+          }
+        close_group(counters);
+      }
+    };
+#endif
+
+  }  // namespace
+
+  bool PerfCounters::supported() noexcept {
+#if defined(__linux__)
+    static const bool s_supported = [] {
+      int fd = open_counter(perf_cycles, -1);
+      if (fd < 0) return false;
+      close(fd);
+      return true;
+    }();
+    return s_supported;
+#else
+    return false;
+#endif
+  }
+
+  void PerfCounters::attachCurrentThread() noexcept {
+#if defined(__linux__)
+    thread_local ThreadAttachment attachment;
+    if (attachment.attached || !supported()) return;
+    attachment.attached = true;
+    open_group(attachment.counters);
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lk{reg.mutex};
+    reg.threads.push_back(&attachment.counters);
+#endif
+  }
+
+  u32 PerfCounters::numAttachedThreads() noexcept {
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lk{reg.mutex};
+    return (u32)reg.threads.size();
+  }
+
+  PerfCounterValues PerfCounters::read() noexcept {
+    PerfCounterValues ret{};
+#if defined(__linux__)
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lk{reg.mutex};
+    ret = reg.retired;
+    for (const auto *counters : reg.threads) read_group(*counters, ret);
+#endif
+    return ret;
+  }
+
+  const char *PerfCounters::name(perf_counter_e c) noexcept {
+    switch (c) {
+      case perf_cycles:
+        return "cycles";
+      case perf_instructions:
+        return "instructions";
+      case perf_llc_references:
+        return "llc_references";
+      case perf_llc_misses:
+        return "llc_misses";
+      case perf_branch_misses:
+        return "branch_misses";
+      default:
+        return "unknown";
+    }
+  }
+
+  PerfCounterScope::PerfCounterScope() noexcept {
+    PerfCounters::attachCurrentThread();
+    _begin = PerfCounters::read();
+  }
+  PerfCounterValues PerfCounterScope::stop() const noexcept {
+    auto ret = PerfCounters::read();
+    ret.mask &= _begin.mask;
+    for (u32 c = 0; c != num_perf_counters; ++c)
+      ret.values[c] = (ret.mask & (1u << c)) ? ret.values[c] - _begin.values[c] : 0;
+    return ret;
+  }
+
+}  // namespace zs
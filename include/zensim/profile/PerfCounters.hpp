@@ -0,0 +1,65 @@
+#pragma once
+
+#include "zensim/TypeAlias.hpp"
+
+namespace zs {
+
+  enum perf_counter_e : u32 {
+    perf_cycles = 0,
+    perf_instructions,
+    perf_llc_references,
+    perf_llc_misses,
+    perf_branch_misses,
+    num_perf_counters
+  };
+
+  /// @brief hardware counter readings (or deltas), 'mask' marks the valid entries
+  struct PerfCounterValues {
+    u64 values[num_perf_counters]{};
+    u32 mask{0};
+
+    constexpr bool valid(perf_counter_e c) const noexcept { return mask & (1u << c); }
+    constexpr u64 operator[](perf_counter_e c) const noexcept { return values[c]; }
+    PerfCounterValues &operator+=(const PerfCounterValues &o) noexcept {
+      for (u32 c = 0; c != num_perf_counters; ++c) values[c] += o.values[c];
+      mask |= o.mask;
+      return *this;
+    }
+    /// @note llc misses are the memory traffic proxy (one cache line each)
+    constexpr double ipc() const noexcept {
+      return valid(perf_cycles) && valid(perf_instructions) && values[perf_cycles]
+                 ? (double)values[perf_instructions] / values[perf_cycles]
+                 : 0.;
+    }
+    constexpr u64 llcMissBytes(u64 cacheLineBytes = 64) const noexcept {
+      return valid(perf_llc_misses) ? values[perf_llc_misses] * cacheLineBytes : 0;
+    }
+  };
+
+  /// @brief per-thread hardware counters (perf_event_open on linux, user space only)
+  /// @note counters of a thread are opened as one event group upon 'attachCurrentThread' and
+  /// closed when the thread exits, 'read' sums them over all attached threads (e.g. an openmp
+  /// pool) plus the final readings of exited ones
+  /// @note readings are scaled by enabled / running time when the kernel multiplexed the group
+  /// @note when counters are unavailable (other platforms, perf_event_paranoid, containers), the
+  /// readings simply carry an empty mask
+  struct ZPC_CORE_API PerfCounters {
+    static bool supported() noexcept;
+    static void attachCurrentThread() noexcept;
+    static u32 numAttachedThreads() noexcept;
+    static PerfCounterValues read() noexcept;
+    static const char *name(perf_counter_e c) noexcept;
+  };
+
+  /// @brief counter deltas of all attached threads (the calling one attached) within a scope
+  struct ZPC_CORE_API PerfCounterScope {
+    PerfCounterScope() noexcept;
+    /// @brief deltas since construction
+    PerfCounterValues stop() const noexcept;
+    bool available() const noexcept { return _begin.mask != 0; }
+
+  private:
+    PerfCounterValues _begin;
+  };
+
+}  // namespace zs
@@ -246,37 +246,95 @@ namespace reflect {
     const MethodAccessor* methods;
     int                   methodCount;
 
-    // --- Lookup (linear search; O(N) — fast for typical field counts) ----
+    /// Name indices built by freezeIndex() (see AccessorRegistry::freeze).
+    mutable const detail::FrozenHashIndex* fieldIndex{nullptr};
+    mutable const detail::FrozenHashIndex* methodIndex{nullptr};
+
+    /// Build the field / method name indices (once, before concurrent use).
+    void freezeIndex() const {
+      if (!fieldIndex && fields && fieldCount > 0) {
+        auto* index = new detail::FrozenHashIndex(fieldCount);
+        for (int i = 0; i < fieldCount; ++i)
+          index->insert(detail::fnv1a_64(fields[i].name), i);
+        fieldIndex = index;
+      }
+      if (!methodIndex && methods && methodCount > 0) {
+        auto* index = new detail::FrozenHashIndex(methodCount);
+        for (int i = 0; i < methodCount; ++i)
+          index->insert(detail::fnv1a_64(methods[i].name), i);
+        methodIndex = index;
+      }
+    }
+
+    /// Drop the indices built by freezeIndex() (lookups go back to linear scans).
+    void releaseIndex() const {
+      delete fieldIndex;
+      delete methodIndex;
+      fieldIndex  = nullptr;
+      methodIndex = nullptr;
+    }
+
+    // --- Lookup (hashed once frozen, linear search otherwise) -----------
+
+    const FieldAccessor* findField(const NameHandle& name) const {
+      if (fieldIndex) {
+        int i = fieldIndex->find(name.hash, [&](int slot) {
+          return detail::str_eq(fields[slot].name, name.name);
+        });
+        return i >= 0 ? &fields[i] : nullptr;
+      }
+      for (int i = 0; i < fieldCount; ++i)
+        if (detail::str_eq(fields[i].name, name.name)) return &fields[i];
+      return nullptr;
+    }
 
     const FieldAccessor* findField(const char* name) const {
+      if (fieldIndex) return name ? findField(NameHandle{name}) : nullptr;
       for (int i = 0; i < fieldCount; ++i)
         if (detail::str_eq(fields[i].name, name)) return &fields[i];
       return nullptr;
     }
 
+    const MethodAccessor* findMethod(const NameHandle& name) const {
+      if (methodIndex) {
+        int i = methodIndex->find(name.hash, [&](int slot) {
+          return detail::str_eq(methods[slot].name, name.name);
+        });
+        return i >= 0 ? &methods[i] : nullptr;
+      }
+      for (int i = 0; i < methodCount; ++i)
+        if (detail::str_eq(methods[i].name, name.name)) return &methods[i];
+      return nullptr;
+    }
+
     const MethodAccessor* findMethod(const char* name) const {
+      if (methodIndex) return name ? findMethod(NameHandle{name}) : nullptr;
       for (int i = 0; i < methodCount; ++i)
         if (detail::str_eq(methods[i].name, name)) return &methods[i];
       return nullptr;
     }
 
     // --- Convenience wrappers --------------------------------------------
+    // `Name` is either a C string or a pre-hashed NameHandle.
 
-    bool getField(const void* obj, const char* name, Any* out) const {
+    template <typename Name>
+    bool getField(const void* obj, const Name& name, Any* out) const {
       const FieldAccessor* fa = findField(name);
       if (!fa || !fa->get) return false;
       fa->get(obj, out);
       return true;
     }
 
-    bool setField(void* obj, const char* name, const Any* val) const {
+    template <typename Name>
+    bool setField(void* obj, const Name& name, const Any* val) const {
       const FieldAccessor* fa = findField(name);
       if (!fa || !fa->set) return false;
       fa->set(obj, val);
       return true;
     }
 
-    bool invoke(void* obj, const char* name,
+    template <typename Name>
+    bool invoke(void* obj, const Name& name,
                 const Any* args, int nargs, Any* ret) const {
       const MethodAccessor* ma = findMethod(name);
       if (!ma || !ma->invoke) return false;
@@ -284,8 +342,10 @@ namespace reflect {
       return true;
     }
 
-    bool hasField(const char* name)  const { return findField(name)  != nullptr; }
-    bool hasMethod(const char* name) const { return findMethod(name) != nullptr; }
+    template <typename Name>
+    bool hasField(const Name& name)  const { return findField(name)  != nullptr; }
+    template <typename Name>
+    bool hasMethod(const Name& name) const { return findMethod(name) != nullptr; }
   };
 
   // -----------------------------------------------------------------------
@@ -298,23 +358,71 @@ namespace reflect {
     AccessorEntry*  next;
   };
 
+  /// @note freeze() builds hash indices over the registered accessors (and
+  /// the field / method names of each), see TypeRegistry::freeze.  While
+  /// frozen, registration is rejected until an explicit thaw().
   class AccessorRegistry {
   public:
     /// Register an entry (called during static initialisation).
-    static void add(AccessorEntry* entry) {
+    /// @return false if frozen (see thaw), the entry is then not linked.
+    static bool add(AccessorEntry* entry) {
+      if (frozen()) return false;
       entry->next = head_;
       head_       = entry;
+      return true;
+    }
+
+    /// Build the lookup indices (once registration is complete, no-op if
+    /// frozen).
+    static void freeze() {
+      if (frozen()) return;
+      int n = 0;
+      for (auto* e = head_; e; e = e->next) ++n;
+      auto** entries = new const AccessorEntry*[n > 0 ? n : 1];
+      auto*  byHash  = new detail::FrozenHashIndex(n);
+      auto*  byName  = new detail::FrozenHashIndex(n);
+      n = 0;
+      for (auto* e = head_; e; e = e->next, ++n) {
+        entries[n] = e;
+        byHash->insert(e->typeHash, n);
+        if (e->accessor) {
+          e->accessor->freezeIndex();
+          if (e->accessor->info)
+            byName->insert(detail::fnv1a_64(e->accessor->info->name), n);
+        }
+      }
+      frozenEntries_ = entries;
+      frozenByHash_  = byHash;
+      frozenByName_  = byName;
     }
 
+    static bool frozen() { return frozenEntries_ != nullptr; }
+
     /// Look up by type hash.
     static const Accessor* find(zs::u64 typeHash) {
+      if (frozen()) {
+        int i = frozenByHash_->find(typeHash, [](int) { return true; });
+        return i >= 0 ? frozenEntries_[i]->accessor : nullptr;
+      }
       for (auto* e = head_; e; e = e->next)
         if (e->typeHash == typeHash) return e->accessor;
       return nullptr;
     }
 
-    /// Look up by type name (linear scan through linked list).
+    /// Look up by pre-hashed type name.
+    static const Accessor* findByName(const NameHandle& name) {
+      if (frozen()) {
+        int i = frozenByName_->find(name.hash, [&](int slot) {
+          return detail::str_eq(frozenEntries_[slot]->accessor->info->name, name.name);
+        });
+        return i >= 0 ? frozenEntries_[i]->accessor : nullptr;
+      }
+      return findByName(name.name);
+    }
+
+    /// Look up by type name (linear scan through linked list until frozen).
     static const Accessor* findByName(const char* name) {
+      if (frozen()) return name ? findByName(NameHandle{name}) : nullptr;
       for (auto* e = head_; e; e = e->next)
         if (e->accessor && e->accessor->info
             && detail::str_eq(e->accessor->info->name, name))
@@ -322,8 +430,26 @@ namespace reflect {
       return nullptr;
     }
 
+    /// Drop the lookup indices, re-enabling registration.  Not thread-safe:
+    /// no lookup may be in flight.
+    static void thaw() {
+      /// the per-accessor indices belong to the frozen state as well
+      if (frozenEntries_)
+        for (auto* e = head_; e; e = e->next)
+          if (e->accessor) e->accessor->releaseIndex();
+      delete[] frozenEntries_;
+      delete frozenByHash_;
+      delete frozenByName_;
+      frozenEntries_ = nullptr;
+      frozenByHash_  = nullptr;
+      frozenByName_  = nullptr;
+    }
+
   private:
     static inline AccessorEntry* head_ = nullptr;  // C++17 inline variable
+    static inline const AccessorEntry** frozenEntries_ = nullptr;
+    static inline const detail::FrozenHashIndex* frozenByHash_ = nullptr;
+    static inline const detail::FrozenHashIndex* frozenByName_ = nullptr;
   };
 
   /// RAII helper used by generated code to register an Accessor.
@@ -354,29 +480,36 @@ namespace reflect {
 
     // --- Field access by name ---
 
-    Any getField(const char* name) const {
+    // (`Name` is either a C string or a pre-hashed NameHandle)
+
+    template <typename Name>
+    Any getField(const Name& name) const {
       Any out;
       accessor().getField(static_cast<const void*>(this), name, &out);
       return out;
     }
 
-    bool setField(const char* name, const Any& val) {
+    template <typename Name>
+    bool setField(const Name& name, const Any& val) {
       return accessor().setField(static_cast<void*>(this), name, &val);
     }
 
-    bool hasField(const char* name) const {
+    template <typename Name>
+    bool hasField(const Name& name) const {
       return accessor().hasField(name);
     }
 
     // --- Method invocation by name ---
 
-    Any invoke(const char* name, const Any* args = nullptr, int nargs = 0) {
+    template <typename Name>
+    Any invoke(const Name& name, const Any* args = nullptr, int nargs = 0) {
       Any ret;
       accessor().invoke(static_cast<void*>(this), name, args, nargs, &ret);
       return ret;
     }
 
-    bool hasMethod(const char* name) const {
+    template <typename Name>
+    bool hasMethod(const Name& name) const {
       return accessor().hasMethod(name);
     }
 
@@ -425,8 +558,8 @@ namespace reflect {
   // -----------------------------------------------------------------------
 
   /// Get a field from any reflected object.
-  template <typename T>
-  Any getField(const T& obj, const char* name) {
+  template <typename T, typename Name>
+  Any getField(const T& obj, const Name& name) {
     Any out;
     if constexpr (has_accessor_v<T>)
       AccessorOf<zs::decay_t<T>>::get().getField(&obj, name, &out);
@@ -434,16 +567,16 @@ namespace reflect {
   }
 
   /// Set a field on any reflected object.
-  template <typename T>
-  bool setField(T& obj, const char* name, const Any& value) {
+  template <typename T, typename Name>
+  bool setField(T& obj, const Name& name, const Any& value) {
     if constexpr (has_accessor_v<T>)
       return AccessorOf<zs::decay_t<T>>::get().setField(&obj, name, &value);
     return false;
   }
 
   /// Invoke a method on any reflected object.
-  template <typename T>
-  Any invoke(T& obj, const char* name,
+  template <typename T, typename Name>
+  Any invoke(T& obj, const Name& name,
              const Any* args = nullptr, int nargs = 0) {
     Any ret;
     if constexpr (has_accessor_v<T>)
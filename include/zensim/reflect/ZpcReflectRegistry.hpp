@@ -5,7 +5,8 @@
 // can be looked up by name or hash at runtime.
 //
 // This header is std-free — it uses an intrusive linked list for storage,
-// consistent with the patterns in ZpcMeta.hpp / ZpcImplPattern.hpp.
+// consistent with the patterns in ZpcMeta.hpp / ZpcImplPattern.hpp, plus a
+// frozen hash index for O(1) lookups once registration is complete.
 
 #pragma once
 
@@ -31,34 +32,88 @@ namespace reflect {
   /// Concurrent registration from multiple TUs is safe on platforms that
   /// serialize static-init per-TU (all major compilers).  Runtime lookup
   /// after initialisation is inherently thread-safe (read-only traversal).
+  /// @note freeze() builds hash indices over the registered types (and the
+  /// field / method names of each type) so that lookups become O(1).  Call
+  /// it once after static registration, before concurrent lookups begin.
+  /// While frozen, registering or unregistering is rejected (returns false):
+  /// the indices stay reachable by concurrent lookups and are never freed
+  /// under them.  thaw() drops them explicitly, once no lookup is in flight.
   class TypeRegistry {
   public:
     /// Register a type.  Called from static initialisers.
-    static void registerType(const TypeInfo* info) {
-      if (!info) return;
+    /// @return false if frozen (see thaw) or already registered.
+    static bool registerType(const TypeInfo* info) {
+      if (!info || frozen()) return false;
       // prevent double registration
-      if (findByHash(info->typeHash)) return;
+      if (findByHash(info->typeHash)) return false;
       auto* entry = ::new TypeRegistryEntry{info, head_};
       head_ = entry;
+      return true;
     }
 
     /// Unregister by hash (e.g. for hot-reload).
+    /// @return false if frozen (see thaw) or not registered.
     /// @note Leaks the unlinked node intentionally — it originated from
     /// ::operator new during static init and there is no safe dealloc order.
-    static void unregisterType(zs::u64 hash) {
+    static bool unregisterType(zs::u64 hash) {
+      if (frozen()) return false;
       TypeRegistryEntry** pp = &head_;
       while (*pp) {
         if ((*pp)->info && (*pp)->info->typeHash == hash) {
           *pp = (*pp)->next;
-          return;
+          return true;
         }
         pp = &(*pp)->next;
       }
+      return false;
+    }
+
+    /// Build the lookup indices over all registered types (no-op if frozen).
+    static void freeze() {
+      if (frozen()) return;
+      int n = 0;
+      for (auto* e = head_; e; e = e->next)
+        if (e->info) ++n;
+      auto** infos = new const TypeInfo*[n > 0 ? n : 1];
+      auto*  byHash = new detail::FrozenHashIndex(n);
+      auto*  byName = new detail::FrozenHashIndex(n);
+      // list order is kept (newest first), matching the unfrozen lookups
+      n = 0;
+      for (auto* e = head_; e; e = e->next) {
+        if (!e->info) continue;
+        e->info->freezeIndex();
+        infos[n] = e->info;
+        byHash->insert(e->info->typeHash, n);
+        byName->insert(detail::fnv1a_64(e->info->name), n);
+        ++n;
+      }
+      frozenInfos_  = infos;
+      frozenByHash_ = byHash;
+      frozenByName_ = byName;
+    }
+
+    static bool frozen() { return frozenInfos_ != nullptr; }
+
+    /// Look up by pre-hashed qualified name.
+    static const TypeInfo* findByName(const NameHandle& name) {
+      if (!name.name) return nullptr;
+      if (frozen()) {
+        int i = frozenByName_->find(name.hash, [&](int slot) {
+          return detail::str_eq(frozenInfos_[slot]->name, name.name);
+        });
+        return i >= 0 ? frozenInfos_[i] : nullptr;
+      }
+      for (auto* e = head_; e; e = e->next) {
+        if (e->info && detail::str_eq(e->info->name, name.name))
+          return e->info;
+      }
+      return nullptr;
     }
 
     /// Look up by qualified name.
     static const TypeInfo* findByName(const char* name) {
       if (!name) return nullptr;
+      if (frozen()) return findByName(NameHandle{name});
       for (auto* e = head_; e; e = e->next) {
         if (e->info && detail::str_eq(e->info->name, name))
           return e->info;
@@ -68,6 +123,10 @@ namespace reflect {
 
     /// Look up by hash.
     static const TypeInfo* findByHash(zs::u64 hash) {
+      if (frozen()) {
+        int i = frozenByHash_->find(hash, [](int) { return true; });
+        return i >= 0 ? frozenInfos_[i] : nullptr;
+      }
       for (auto* e = head_; e; e = e->next)
         if (e->info && e->info->typeHash == hash) return e->info;
       return nullptr;
@@ -87,8 +146,26 @@ namespace reflect {
       return n;
     }
 
+    /// Drop the lookup indices (back to list traversal), re-enabling
+    /// registration.  Not thread-safe: no lookup may be in flight.
+    static void thaw() {
+      /// the per-type indices belong to the frozen state as well
+      if (frozenInfos_)
+        for (auto* e = head_; e; e = e->next)
+          if (e->info) e->info->releaseIndex();
+      delete[] frozenInfos_;
+      delete frozenByHash_;
+      delete frozenByName_;
+      frozenInfos_  = nullptr;
+      frozenByHash_ = nullptr;
+      frozenByName_ = nullptr;
+    }
+
   private:
     static inline TypeRegistryEntry* head_ = nullptr;  // C++17 inline variable
+    static inline const TypeInfo** frozenInfos_ = nullptr;
+    static inline const detail::FrozenHashIndex* frozenByHash_ = nullptr;
+    static inline const detail::FrozenHashIndex* frozenByName_ = nullptr;
   };
 
   // -----------------------------------------------------------------------
@@ -15,6 +15,92 @@
 namespace zs {
 namespace reflect {
 
+  // -----------------------------------------------------------------------
+  // FNV-1a hash (matches the reflect tool) and frozen lookup index
+  // -----------------------------------------------------------------------
+
+  namespace detail {
+    /// Null-safe C string comparison (avoids <cstring> dependency).
+    inline bool str_eq(const char* a, const char* b) noexcept {
+      if (a == b) return true;
+      if (!a || !b) return false;
+      while (*a && *a == *b) { ++a; ++b; }
+      return *a == *b;
+    }
+
+    /// FNV-1a hash over a null-terminated C string.
+    inline constexpr zs::u64 fnv1a_64(const char* s) noexcept {
+      zs::u64 h = 0xcbf29ce484222325ULL;
+      if (s) {
+        for (; *s; ++s) {
+          h ^= static_cast<unsigned char>(*s);
+          h *= 0x100000001b3ULL;
+        }
+      }
+      return h;
+    }
+
+    /// Frozen open-addressing (linear probing) index from 64-bit name/type
+    /// hashes to slots [0, n).  Built once, read-only afterwards; colliding
+    /// hashes are disambiguated by the caller-provided predicate.
+    class FrozenHashIndex {
+    public:
+      explicit FrozenHashIndex(int n) {
+        zs::u64 cap = 4;
+        while (cap < (zs::u64)n * 2) cap <<= 1;
+        keys_  = new zs::u64[cap];
+        slots_ = new int[cap];
+        for (zs::u64 i = 0; i < cap; ++i) slots_[i] = -1;
+        mask_ = cap - 1;
+      }
+      ~FrozenHashIndex() {
+        delete[] keys_;
+        delete[] slots_;
+      }
+      FrozenHashIndex(const FrozenHashIndex&)            = delete;
+      FrozenHashIndex& operator=(const FrozenHashIndex&) = delete;
+
+      void insert(zs::u64 key, int slot) noexcept {
+        for (zs::u64 i = key & mask_;; i = (i + 1) & mask_)
+          if (slots_[i] < 0) {
+            keys_[i]  = key;
+            slots_[i] = slot;
+            return;
+          }
+      }
+
+      /// Returns the first inserted slot whose key matches and for which
+      /// `match(slot)` holds, or -1.
+      template <typename Pred>
+      int find(zs::u64 key, Pred&& match) const {
+        for (zs::u64 i = key & mask_; slots_[i] >= 0; i = (i + 1) & mask_)
+          if (keys_[i] == key && match(slots_[i])) return slots_[i];
+        return -1;
+      }
+
+    private:
+      zs::u64* keys_{nullptr};
+      int*     slots_{nullptr};
+      zs::u64  mask_{0};
+    };
+  }  // namespace detail
+
+  // -----------------------------------------------------------------------
+  // NameHandle — pre-hashed name for hot lookups
+  // -----------------------------------------------------------------------
+
+  /// Pairs a name (string literal or static storage) with its FNV-1a hash so
+  /// repeated lookups skip rehashing, e.g.
+  ///   static constexpr NameHandle kPos{"pos"};  info->findField(kPos);
+  struct NameHandle {
+    const char* name{nullptr};
+    zs::u64     hash{0};
+
+    constexpr NameHandle() noexcept = default;
+    explicit constexpr NameHandle(const char* n) noexcept
+        : name{n}, hash{detail::fnv1a_64(n)} {}
+  };
+
   // -----------------------------------------------------------------------
   // Type identifiers
   // -----------------------------------------------------------------------
@@ -138,8 +224,9 @@ namespace reflect {
   // TypeInfo — the main descriptor for a reflected type
   // -----------------------------------------------------------------------
 
-  /// @note All pointer members refer to static-storage arrays emitted by
-  /// the code generator; no dynamic memory is involved.
+  /// @note The descriptor pointers refer to static-storage arrays emitted by
+  /// the code generator.  Only the name indices (fieldIndex / methodIndex)
+  /// are heap-allocated, by freezeIndex(), and owned until releaseIndex().
   struct TypeInfo {
     const char*          name{nullptr};          ///< Qualified C++ name.
     const char*          displayName{nullptr};   ///< Short, editor-friendly name.
@@ -163,27 +250,80 @@ namespace reflect {
     const MetaEntry*     metadata{nullptr};
     int                  metadataCount{0};
 
+    /// Lookup indices over field / method names, built by freezeIndex()
+    /// (see TypeRegistry::freeze); lookups fall back to a linear scan
+    /// until then.
+    mutable const detail::FrozenHashIndex* fieldIndex{nullptr};
+    mutable const detail::FrozenHashIndex* methodIndex{nullptr};
+
+    /// Build the field / method name indices.  Not thread-safe; intended to
+    /// run once after static registration, before concurrent lookups.
+    void freezeIndex() const {
+      if (!fieldIndex && fields && fieldCount > 0) {
+        auto* index = new detail::FrozenHashIndex(fieldCount);
+        for (int i = 0; i < fieldCount; ++i)
+          index->insert(detail::fnv1a_64(fields[i].name), i);
+        fieldIndex = index;
+      }
+      if (!methodIndex && methods && methodCount > 0) {
+        auto* index = new detail::FrozenHashIndex(methodCount);
+        for (int i = 0; i < methodCount; ++i)
+          index->insert(detail::fnv1a_64(methods[i].name), i);
+        methodIndex = index;
+      }
+    }
+
+    /// Drop the indices built by freezeIndex() (lookups go back to linear scans).
+    void releaseIndex() const {
+      delete fieldIndex;
+      delete methodIndex;
+      fieldIndex  = nullptr;
+      methodIndex = nullptr;
+    }
+
+    /// Find a field by pre-hashed name.  Returns nullptr if not found.
+    const FieldInfo* findField(const NameHandle& n) const {
+      if (!n.name || !fields) return nullptr;
+      if (fieldIndex) {
+        int i = fieldIndex->find(n.hash, [&](int slot) {
+          return detail::str_eq(fields[slot].name, n.name);
+        });
+        return i >= 0 ? &fields[i] : nullptr;
+      }
+      for (int i = 0; i < fieldCount; ++i)
+        if (detail::str_eq(fields[i].name, n.name)) return &fields[i];
+      return nullptr;
+    }
+
     /// Find a field by name.  Returns nullptr if not found.
     const FieldInfo* findField(const char* n) const {
       if (!n || !fields) return nullptr;
-      for (int i = 0; i < fieldCount; ++i) {
-        const char* a = fields[i].name;
-        const char* b = n;
-        while (*a && *a == *b) { ++a; ++b; }
-        if (*a == *b) return &fields[i];
+      if (fieldIndex) return findField(NameHandle{n});
+      for (int i = 0; i < fieldCount; ++i)
+        if (detail::str_eq(fields[i].name, n)) return &fields[i];
+      return nullptr;
+    }
+
+    /// Find a method by pre-hashed name (first overload).
+    const MethodInfo* findMethod(const NameHandle& n) const {
+      if (!n.name || !methods) return nullptr;
+      if (methodIndex) {
+        int i = methodIndex->find(n.hash, [&](int slot) {
+          return detail::str_eq(methods[slot].name, n.name);
+        });
+        return i >= 0 ? &methods[i] : nullptr;
       }
+      for (int i = 0; i < methodCount; ++i)
+        if (detail::str_eq(methods[i].name, n.name)) return &methods[i];
       return nullptr;
     }
 
     /// Find a method by name.  Returns nullptr if not found (first overload).
     const MethodInfo* findMethod(const char* n) const {
       if (!n || !methods) return nullptr;
-      for (int i = 0; i < methodCount; ++i) {
-        const char* a = methods[i].name;
-        const char* b = n;
-        while (*a && *a == *b) { ++a; ++b; }
-        if (*a == *b) return &methods[i];
-      }
+      if (methodIndex) return findMethod(NameHandle{n});
+      for (int i = 0; i < methodCount; ++i)
+        if (detail::str_eq(methods[i].name, n)) return &methods[i];
       return nullptr;
     }
   };
@@ -212,31 +352,5 @@ namespace reflect {
     }
   }
 
-  // -----------------------------------------------------------------------
-  // FNV-1a hash (matches the reflect tool)
-  // -----------------------------------------------------------------------
-
-  namespace detail {
-    /// Null-safe C string comparison (avoids <cstring> dependency).
-    inline bool str_eq(const char* a, const char* b) noexcept {
-      if (a == b) return true;
-      if (!a || !b) return false;
-      while (*a && *a == *b) { ++a; ++b; }
-      return *a == *b;
-    }
-
-    /// FNV-1a hash over a null-terminated C string.
-    inline constexpr zs::u64 fnv1a_64(const char* s) noexcept {
-      zs::u64 h = 0xcbf29ce484222325ULL;
-      if (s) {
-        for (; *s; ++s) {
-          h ^= static_cast<unsigned char>(*s);
-          h *= 0x100000001b3ULL;
-        }
-      }
-      return h;
-    }
-  }  // namespace detail
-
 }  // namespace reflect
 }  // namespace zs
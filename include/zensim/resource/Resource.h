@@ -180,6 +180,8 @@ namespace zs {
     return MemoryBackendRegistry::instance().is_available(mre);
   }
 
+  /// @note for host memory, advice "POOLED" selects the process-wide thread-caching size-class
+  /// pools (memory_pools::instance()), suited for many small allocations
   ZPC_API ZSPmrAllocator<> get_memory_source(memsrc_e mre, ProcID devid,
                                              std::string_view advice = std::string_view{});
 
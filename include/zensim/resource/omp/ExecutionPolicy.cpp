@@ -2,8 +2,27 @@
 
 namespace zs {
 
+  static const std::shared_ptr<scratch_arena> &omp_scratch_arena() {
+    thread_local std::shared_ptr<scratch_arena> s_arena = std::make_shared<scratch_arena>();
+    return s_arena;
+  }
+
   ZPC_API ZSPmrAllocator<> get_temporary_memory_source(const OmpExecutionPolicy &pol) {
-    return get_memory_source(memsrc_e::host, (ProcID)-1);
+    ZSPmrAllocator<> ret{};
+    auto arena = omp_scratch_arena();
+    auto cloner = [arena]() -> UniquePtr<mr_t> {
+      return zs::make_unique<scratch_memory_resource>(arena);
+    };
+    ret.init(cloner(), MemoryLocation{memsrc_e::host, (ProcID)-1}, zs::move(cloner));
+    return ret;
+  }
+
+  ZPC_API scratch_arena_stats get_temporary_memory_stats(const OmpExecutionPolicy &pol) {
+    return omp_scratch_arena()->stats();
+  }
+
+  ZPC_API bool trim_temporary_memory(const OmpExecutionPolicy &pol, size_t keepBytes) {
+    return omp_scratch_arena()->trim(keepBytes);
   }
 
-}  // namespace zs
\ No newline at end of file
+}  // namespace zs
@@ -16,23 +16,25 @@ namespace zs {
       template <typename _Tp> using size_t = typename _Tp::size_type;
       template <typename _Tp> using index_t = typename _Tp::index_t;
       template <typename _Tp> using counter_t = typename _Tp::channel_counter_type;
-      template <typename _Tp> using dim_t = typename integral_constant<int, _Tp::dim>;
-      template <typename _Tp> using extent_t = typename integral_constant<int, _Tp::extent>;
+      template <typename _Tp> using dim_t = integral_constant<int, _Tp::dim>;
+      template <typename _Tp> using extent_t = integral_constant<int, _Tp::extent>;
     };
 
     using structure_view_t = decltype(proxy<space>(declval<Structure>()));
     using structure_type = remove_cvref_t<Structure>;
-    using value_type = detected_or_t<detected_or_t<float, dof_detail::T_t, structure_type>,
-                                     dof_detail::value_t, structure_type>;
-    using size_type = detected_or_t<detected_or_t<zs::size_t, dof_detail::index_t, structure_type>,
-                                    dof_detail::size_t, structure_type>;
+    using value_type
+        = detected_or_t<detected_or_t<float, dof_detail::template T_t, structure_type>,
+                        dof_detail::template value_t, structure_type>;
+    using size_type
+        = detected_or_t<detected_or_t<zs::size_t, dof_detail::template index_t, structure_type>,
+                        dof_detail::template size_t, structure_type>;
     using channel_counter_type
-        = detected_or_t<unsigned char, dof_detail::counter_t, structure_type>;
+        = detected_or_t<unsigned char, dof_detail::template counter_t, structure_type>;
     static constexpr attrib_e entry_e
         = is_arithmetic_v<value_type> ? attrib_e::scalar : attrib_e::vector;
     static constexpr int deduced_dim = detected_or_t<
-        detected_or_t<integral_constant<int, 1>, dof_detail::extent_t, value_type>,
-        dof_detail::dim_t, structure_type>::value;
+        detected_or_t<integral_constant<int, 1>, dof_detail::template extent_t, value_type>,
+        dof_detail::template dim_t, structure_type>::value;
 
     /// access by entry index
     template <typename svt, enable_if_t<is_same_v<svt, structure_view_t>> = 0>
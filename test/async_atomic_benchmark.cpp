@@ -90,6 +90,44 @@ namespace {
       }
     });
   }
+  /// one thread allocates, another frees (submission thread vs. executor workers)
+  template <typename Alloc, typename Free>
+  double bench_producer_consumer(size_t iterations, Alloc &&alloc, Free &&free) {
+    constexpr size_t ring_size = 1024;
+    std::vector<std::atomic<BenchNode *>> ring(ring_size);
+    for (auto &slot : ring) slot.store(nullptr);
+    return bench_ms([&] {
+      std::thread consumer{[&] {
+        for (size_t i = 0; i < iterations; ++i) {
+          auto &slot = ring[i % ring_size];
+          BenchNode *node = nullptr;
+          while (!(node = slot.exchange(nullptr, std::memory_order_acquire)))
+            std::this_thread::yield();
+          free(node);
+        }
+      }};
+      for (size_t i = 0; i < iterations; ++i) {
+        auto *node = alloc(i);
+        auto &slot = ring[i % ring_size];
+        while (slot.load(std::memory_order_relaxed)) std::this_thread::yield();
+        slot.store(node, std::memory_order_release);
+      }
+      consumer.join();
+    });
+  }
+
+  double bench_std_new_delete_cross_thread(size_t iterations) {
+    return bench_producer_consumer(
+        iterations, [](size_t i) { return new BenchNode{static_cast<u64>(i), nullptr}; },
+        [](BenchNode *node) { delete node; });
+  }
+
+  double bench_async_pool_cross_thread(size_t iterations) {
+    detail::AsyncObjectPool<BenchNode, 1024> pool;
+    return bench_producer_consumer(
+        iterations, [&](size_t i) { return pool.acquire(static_cast<u64>(i), nullptr); },
+        [&](BenchNode *node) { pool.release(node); });
+  }
 }  // namespace
 
 int main() {
@@ -107,6 +145,8 @@ int main() {
     const double zs_contended = bench_zs_fetch_add_contended(thread_count, contended_iterations);
     const double std_heap = bench_std_new_delete(pool_iterations);
     const double zs_pool = bench_async_pool(pool_iterations);
+    const double std_heap_cross = bench_std_new_delete_cross_thread(pool_iterations);
+    const double zs_pool_cross = bench_async_pool_cross_thread(pool_iterations);
 
     std::printf("async benchmark\n");
     std::printf("std::atomic fetch_add single-thread : %.3f ms\n", std_single);
@@ -119,6 +159,9 @@ int main() {
     std::printf("new/delete BenchNode                : %.3f ms\n", std_heap);
     std::printf("async pool BenchNode                : %.3f ms (ratio %.3f)\n", zs_pool,
                 zs_pool / std_heap);
+    std::printf("new/delete BenchNode cross-thread   : %.3f ms\n", std_heap_cross);
+    std::printf("async pool BenchNode cross-thread   : %.3f ms (ratio %.3f)\n", zs_pool_cross,
+                zs_pool_cross / std_heap_cross);
     std::fflush(stdout);
     return 0;
   } catch (const std::exception &ex) {
@@ -0,0 +1,153 @@
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "zensim/execution/AsyncRuntime.hpp"
+#include "zensim/zpc_tpls/fmt/core.h"
+
+namespace {
+
+  void require(bool cond, const char *msg) {
+    if (!cond) throw std::runtime_error(std::string("async batch check failed: ") + msg);
+  }
+
+  zs::AsyncSubmission make_job(const char *executor, zs::AsyncStep step) {
+    zs::AsyncSubmission submission{};
+    submission.executor = executor;
+    submission.step = zs::move(step);
+    return submission;
+  }
+
+  /// one job per partition, one finalizer depending on all of them
+  void check_fan_out_fan_in(zs::AsyncRuntime &runtime, const char *executor) {
+    using namespace zs;
+    constexpr u32 numPartitions = 64;
+    std::vector<std::atomic<int>> partials(numPartitions);
+    for (auto &p : partials) p.store(0);
+    std::atomic<int> total{-1};
+
+    std::vector<AsyncSubmission> batch;
+    std::vector<AsyncBatchDependency> deps;
+    for (u32 p = 0; p != numPartitions; ++p) {
+      batch.push_back(make_job(executor, [&partials, p](AsyncExecutionContext &) {
+        partials[p].store(static_cast<int>(p) + 1);
+        return AsyncPollStatus::completed;
+      }));
+      deps.push_back(AsyncBatchDependency{p, numPartitions});
+    }
+    batch.push_back(make_job(executor, [&](AsyncExecutionContext &) {
+      int sum = 0;
+      for (auto &p : partials) {
+        if (p.load() == 0) return AsyncPollStatus::failed;
+        sum += p.load();
+      }
+      total.store(sum);
+      return AsyncPollStatus::completed;
+    }));
+
+    auto handles = runtime.submit_batch(batch, deps);
+    require(handles.size() == numPartitions + 1, "one handle per submission");
+    handles.back().event().wait();
+    require(handles.back().status() == AsyncTaskStatus::completed, "finalizer completed");
+    require(total.load() == (int)(numPartitions * (numPartitions + 1) / 2),
+            "finalizer ran after every partition");
+    for (u32 i = 1; i != handles.size(); ++i)
+      require(handles[i].id() == handles[i - 1].id() + 1, "contiguous submission ids");
+  }
+
+  void check_chain_and_failure(zs::AsyncRuntime &runtime) {
+    using namespace zs;
+    std::vector<int> order;
+    std::vector<AsyncSubmission> batch;
+    for (int i = 0; i != 4; ++i)
+      batch.push_back(make_job("thread_pool", [&order, i](AsyncExecutionContext &) {
+        order.push_back(i);
+        return i == 1 ? AsyncPollStatus::failed : AsyncPollStatus::completed;
+      }));
+    /// 3 -> 0 -> 1 -> 2 (listed out of order)
+    auto handles = runtime.submit_batch(
+        batch, {AsyncBatchDependency{0, 1}, AsyncBatchDependency{3, 0}, AsyncBatchDependency{1, 2}});
+    handles[2].event().wait();
+    require(handles[3].status() == AsyncTaskStatus::completed, "root completed");
+    require(handles[0].status() == AsyncTaskStatus::completed, "middle completed");
+    require(handles[1].status() == AsyncTaskStatus::failed, "failing step");
+    require(handles[2].status() == AsyncTaskStatus::failed, "failure propagated");
+    require(order.size() == 3 && order[0] == 3 && order[1] == 0 && order[2] == 1,
+            "dependency order, the dependent of a failure never runs");
+  }
+
+  void check_external_prerequisites(zs::AsyncRuntime &runtime) {
+    using namespace zs;
+    auto gate = AsyncEvent::create();
+    std::atomic<int> ran{0};
+    std::vector<AsyncSubmission> batch;
+    batch.push_back(make_job("thread_pool", [&](AsyncExecutionContext &) {
+      ran.fetch_add(1);
+      return AsyncPollStatus::completed;
+    }));
+    batch.back().prerequisites.push_back(gate);
+    batch.push_back(make_job("inline", [&](AsyncExecutionContext &) {
+      ran.fetch_add(1);
+      return AsyncPollStatus::completed;
+    }));
+    auto handles = runtime.submit_batch(batch, {AsyncBatchDependency{0, 1}});
+    require(!handles[0].event().wait_for(20), "held back by the external event");
+    require(ran.load() == 0, "nothing ran before the gate");
+    gate.complete();
+    handles[1].event().wait();
+    require(ran.load() == 2, "released by the gate");
+  }
+
+  void check_validation(zs::AsyncRuntime &runtime) {
+    using namespace zs;
+    std::atomic<int> ran{0};
+    auto makeBatch = [&] {
+      std::vector<AsyncSubmission> batch;
+      for (int i = 0; i != 3; ++i)
+        batch.push_back(make_job("thread_pool", [&](AsyncExecutionContext &) {
+          ran.fetch_add(1);
+          return AsyncPollStatus::completed;
+        }));
+      return batch;
+    };
+    auto expectThrow = [&](std::vector<AsyncSubmission> batch,
+                           std::vector<AsyncBatchDependency> deps, const char *msg) {
+      bool threw = false;
+      try {
+        runtime.submit_batch(batch, deps);
+      } catch (...) {
+        threw = true;
+      }
+      require(threw, msg);
+    };
+    expectThrow(makeBatch(), {AsyncBatchDependency{0, 1}, AsyncBatchDependency{1, 0}},
+                "cycle rejected");
+    expectThrow(makeBatch(), {AsyncBatchDependency{0, 3}}, "index out of range rejected");
+    expectThrow(makeBatch(), {AsyncBatchDependency{2, 2}}, "self dependency rejected");
+    {
+      auto batch = makeBatch();
+      batch[1].executor = "missing";
+      expectThrow(zs::move(batch), {}, "unknown executor rejected");
+    }
+    require(ran.load() == 0, "invalid batches dispatch nothing");
+    require(runtime.submit_batch(nullptr, 0).empty(), "empty batch");
+  }
+
+}  // namespace
+
+int main() {
+  try {
+    zs::AsyncRuntime runtime{3};
+    check_fan_out_fan_in(runtime, "thread_pool");
+    check_fan_out_fan_in(runtime, "inline");
+    check_chain_and_failure(runtime);
+    check_external_prerequisites(runtime);
+    check_validation(runtime);
+    fmt::print("async batch submission checks passed\n");
+    return 0;
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return 1;
+  }
+}
@@ -0,0 +1,255 @@
+#include <atomic>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "zensim/execution/AsyncMemoryPool.hpp"
+#include "zensim/execution/AsyncRuntime.hpp"
+#include "zensim/zpc_tpls/fmt/core.h"
+
+namespace {
+
+  void require(bool cond, const char *msg) {
+    if (!cond) throw std::runtime_error(std::string("async memory pool check failed: ") + msg);
+  }
+
+  struct Tracked {
+    static std::atomic<int> live;
+    explicit Tracked(zs::u64 v) : value{v} { ++live; }
+    ~Tracked() { --live; }
+    zs::u64 value;
+    zs::u64 pad[3];
+  };
+  std::atomic<int> Tracked::live{0};
+
+  void check_single_thread_recycling() {
+    using Pool = zs::detail::AsyncObjectPool<Tracked, 64>;
+    Pool pool;
+    require(Pool::slots_per_slab >= 64, "slab holds the requested blocks");
+
+    std::vector<Tracked *> objs;
+    std::set<Tracked *> addresses;
+    for (zs::u64 i = 0; i != 200; ++i) {
+      objs.push_back(pool.acquire(i));
+      addresses.insert(objs.back());
+    }
+    require(addresses.size() == objs.size(), "distinct slots");
+    require(Tracked::live.load() == 200, "constructed in place");
+    for (zs::u64 i = 0; i != 200; ++i) require(objs[i]->value == i, "payload intact");
+    const auto slabs = pool.numSlabs();
+
+    for (auto *obj : objs) pool.release(obj);
+    require(Tracked::live.load() == 0, "destroyed upon release");
+    for (int round = 0; round != 10; ++round) {
+      objs.clear();
+      for (zs::u64 i = 0; i != 200; ++i) {
+        objs.push_back(pool.acquire(i));
+        require(addresses.count(objs.back()) == 1, "recycled slot");
+      }
+      for (auto *obj : objs) pool.release(obj);
+    }
+    require(pool.numSlabs() == slabs, "no growth in steady state");
+    require(pool.numHeaps() == 1, "one heap per thread");
+  }
+
+  /// producer acquires, consumers release (remote frees flow back to the producer heap)
+  void check_cross_thread_release() {
+    using Pool = zs::detail::AsyncObjectPool<Tracked, 128>;
+    Pool pool;
+    constexpr int numConsumers = 3;
+    constexpr zs::u64 numObjects = 60000;
+    std::vector<std::atomic<Tracked *>> mailbox(256);
+    for (auto &m : mailbox) m.store(nullptr);
+    std::atomic<bool> done{false};
+    std::atomic<zs::u64> consumed{0}, checksum{0};
+
+    std::vector<std::thread> consumers;
+    for (int c = 0; c != numConsumers; ++c)
+      consumers.emplace_back([&, c] {
+        while (!done.load() || consumed.load() < numObjects) {
+          bool any = false;
+          for (size_t i = c; i < mailbox.size(); i += numConsumers) {
+            if (auto *obj = mailbox[i].exchange(nullptr)) {
+              checksum.fetch_add(obj->value);
+              pool.release(obj);
+              consumed.fetch_add(1);
+              any = true;
+            }
+          }
+          if (!any) std::this_thread::yield();
+        }
+      });
+
+    zs::u64 expected = 0;
+    for (zs::u64 i = 0; i != numObjects; ++i) {
+      auto *obj = pool.acquire(i);
+      expected += i;
+      for (size_t k = i % mailbox.size();; k = (k + 1) % mailbox.size()) {
+        Tracked *empty = nullptr;
+        if (mailbox[k].compare_exchange_strong(empty, obj)) break;
+      }
+    }
+    done.store(true);
+    for (auto &t : consumers) t.join();
+
+    require(consumed.load() == numObjects, "all objects consumed");
+    require(checksum.load() == expected, "payloads intact across threads");
+    require(Tracked::live.load() == 0, "all destroyed");
+    /// at most 256 objects in flight plus the consumers' remote batches
+    require(pool.numSlabs() * Pool::slots_per_slab < numObjects / 4,
+            "remote frees are recycled by the producer");
+    /// consumers never acquire, so they own no heap
+    require(pool.numHeaps() == 1, "release does not create heaps");
+  }
+
+  void check_heap_adoption() {
+    using Pool = zs::detail::AsyncObjectPool<Tracked, 32>;
+    Pool pool;
+    for (int round = 0; round != 8; ++round) {
+      std::thread t{[&] {
+        std::vector<Tracked *> objs;
+        for (zs::u64 i = 0; i != 100; ++i) objs.push_back(pool.acquire(i));
+        for (auto *obj : objs) pool.release(obj);
+      }};
+      t.join();
+    }
+    require(pool.numHeaps() == 1, "heaps of exited threads are adopted");
+    require(Tracked::live.load() == 0, "all destroyed");
+  }
+
+  /// a thread_local that outlives the pool's per-thread heaps and uses the pool on destruction
+  using LatePool = zs::detail::AsyncObjectPool<Tracked, 32>;
+  struct LateUser {
+    LatePool *pool{nullptr};
+    std::atomic<int> *finished{nullptr};
+    ~LateUser() {
+      if (!pool) return;
+      std::vector<Tracked *> objs;
+      for (zs::u64 i = 0; i != 40; ++i) objs.push_back(pool->acquire(i));
+      for (zs::u64 i = 0; i != 40; ++i)
+        if (objs[i]->value == i) pool->release(objs[i]);
+      finished->fetch_add(1);
+    }
+  };
+
+  void check_late_thread_local_use() {
+    LatePool pool;
+    std::atomic<int> finished{0};
+    for (int round = 0; round != 4; ++round) {
+      std::thread t{[&] {
+        /// constructed before the heaps, hence destroyed after them
+        thread_local LateUser user{};
+        user.pool = &pool;
+        user.finished = &finished;
+        pool.release(pool.acquire(zs::u64{0}));
+      }};
+      t.join();
+    }
+    require(finished.load() == 4, "late users finished");
+    require(Tracked::live.load() == 0, "late releases destroyed");
+    require(pool.numHeaps() == 1, "late users do not keep heaps");
+    pool.release(pool.acquire(zs::u64{1}));
+    require(pool.numHeaps() == 1, "the main thread adopts the abandoned heap");
+  }
+
+  struct SharedCounted {
+    static std::atomic<int> live;
+    explicit SharedCounted(int v) : value{v} { ++live; }
+    ~SharedCounted() { --live; }
+    int value;
+  };
+  std::atomic<int> SharedCounted::live{0};
+
+  void check_allocate_shared() {
+    using namespace zs;
+    {
+      auto a = zs::allocate_shared<SharedCounted>(detail::AsyncBlockAllocator{}, 7);
+      require(a && a->value == 7 && SharedCounted::live.load() == 1, "constructed");
+      auto b = a;
+      require(a.use_count() == 2, "shared ownership");
+      a.reset();
+      require(SharedCounted::live.load() == 1 && b->value == 7, "kept alive by the copy");
+      WeakPtr<SharedCounted> w = b;
+      b.reset();
+      require(SharedCounted::live.load() == 0, "destroyed with the last strong reference");
+      require(w.expired(), "weak observes expiry");
+    }
+    /// released on other threads than the allocating one
+    std::vector<Shared<SharedCounted>> objs;
+    for (int i = 0; i != 1000; ++i)
+      objs.push_back(zs::allocate_shared<SharedCounted>(detail::AsyncBlockAllocator{}, i));
+    std::thread t{[objs = zs::move(objs)]() mutable { objs.clear(); }};
+    t.join();
+    require(SharedCounted::live.load() == 0, "cross-thread release");
+
+    /// oversized requests fall back to the arena
+    struct Big {
+      byte data[4096];
+    };
+    auto big = zs::allocate_shared<Big>(detail::AsyncBlockAllocator{});
+    require(static_cast<bool>(big), "arena fallback");
+  }
+
+  void check_runtime_submissions() {
+    using namespace zs;
+    AsyncRuntime runtime{2};
+    std::atomic<int> executed{0};
+    auto submitAll = [&](int n) {
+      std::vector<AsyncSubmissionHandle> handles;
+      handles.reserve(n);
+      for (int i = 0; i != n; ++i) {
+        AsyncSubmission submission{};
+        submission.executor = "thread_pool";
+        submission.step = [&](AsyncExecutionContext &) {
+          executed.fetch_add(1);
+          return AsyncPollStatus::completed;
+        };
+        handles.push_back(runtime.submit(zs::move(submission)));
+      }
+      for (auto &handle : handles) handle.event().wait();
+      for (auto &handle : handles)
+        require(handle.status() == AsyncTaskStatus::completed, "submission completed");
+    };
+    submitAll(2000);
+    const auto arenaAllocs = detail::AsyncMemoryArena::instance().numAllocations();
+    submitAll(2000);
+    require(executed.load() == 4000, "all steps executed");
+    require(detail::AsyncMemoryArena::instance().numAllocations() == arenaAllocs,
+            "steady-state submission reuses pooled states");
+
+    /// dependency counters are pooled as well
+    auto first = runtime.submit(AsyncSubmission{"inline", {}, {}, [&](AsyncExecutionContext &) {
+                                                  executed.fetch_add(1);
+                                                  return AsyncPollStatus::completed;
+                                                }});
+    AsyncSubmission dependent{};
+    dependent.executor = "inline";
+    dependent.prerequisites.push_back(first.event());
+    dependent.step = [&](AsyncExecutionContext &) {
+      executed.fetch_add(1);
+      return AsyncPollStatus::completed;
+    };
+    auto second = runtime.submit(zs::move(dependent));
+    second.event().wait();
+    require(executed.load() == 4002, "dependent submission");
+  }
+
+}  // namespace
+
+int main() {
+  try {
+    check_single_thread_recycling();
+    check_cross_thread_release();
+    check_heap_adoption();
+    check_late_thread_local_use();
+    check_allocate_shared();
+    check_runtime_submissions();
+    fmt::print("async memory pool checks passed\n");
+    return 0;
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return 1;
+  }
+}
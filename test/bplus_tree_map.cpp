@@ -0,0 +1,204 @@
+#include <functional>
+#include <iterator>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "zensim/container/BPlusTreeMap.hpp"
+#include "zensim/zpc_tpls/fmt/core.h"
+
+namespace {
+
+  void require(bool cond, const std::string &msg) {
+    if (!cond) throw std::runtime_error("b+tree map check failed: " + msg);
+  }
+
+  template <typename Map, typename RefMap>
+  void check_same(const Map &m, const RefMap &ref, const std::string &tag) {
+    require(m.size() == ref.size(), "size, " + tag);
+    auto it = m.cbegin();
+    for (const auto &[k, v] : ref) {
+      require(it != m.cend() && it->first == k && it->second == v, "forward iteration, " + tag);
+      ++it;
+    }
+    require(it == m.cend(), "forward iteration end, " + tag);
+    auto rit = m.crbegin();
+    for (auto r = ref.rbegin(); r != ref.rend(); ++r, ++rit)
+      require(rit != m.crend() && rit->first == r->first, "reverse iteration, " + tag);
+    require(rit == m.crend(), "reverse iteration end, " + tag);
+    /// walking back from end() visits the entries in reverse
+    if (!ref.empty()) {
+      auto back = m.cend();
+      --back;
+      require(back->first == ref.rbegin()->first, "decrement from end, " + tag);
+    }
+  }
+
+  /// random inserts, lookups and erases mirrored on std::map
+  template <typename Key, typename Compare, int CacheLines = 4, typename Gen>
+  void check_random_ops(Gen &&genKey, int numOps, unsigned seed, const std::string &tag) {
+    using namespace zs;
+    std::mt19937 rng{seed};
+    BPlusTreeMap<Key, int, Compare, CacheLines> m;
+    std::map<Key, int, Compare> ref;
+    for (int op = 0; op != numOps; ++op) {
+      const Key key = genKey(rng);
+      const int value = (int)(rng() % 1000);
+      switch (rng() % 6) {
+        case 0:
+        case 1:
+          m.insert(key, value);
+          ref[key] = value;
+          break;
+        case 2:
+          m[key] += value;
+          ref[key] += value;
+          break;
+        case 3:
+          require(m.erase(key) == ref.erase(key), "erase by key, " + tag);
+          break;
+        case 4: {
+          auto it = m.lower_bound(key);
+          auto rit = ref.lower_bound(key);
+          require((it == m.end()) == (rit == ref.end()), "lower_bound end, " + tag);
+          if (rit != ref.end()) {
+            require(it->first == rit->first, "lower_bound key, " + tag);
+            /// erasing through the iterator yields its successor
+            auto next = m.erase(it);
+            rit = ref.erase(rit);
+            require((next == m.end()) == (rit == ref.end()), "erase successor end, " + tag);
+            if (rit != ref.end()) require(next->first == rit->first, "erase successor, " + tag);
+          }
+          break;
+        }
+        default: {
+          auto it = m.upper_bound(key);
+          auto rit = ref.upper_bound(key);
+          require((it == m.end()) == (rit == ref.end()), "upper_bound end, " + tag);
+          if (rit != ref.end()) require(it->first == rit->first, "upper_bound key, " + tag);
+          require(m.count(key) == ref.count(key), "count, " + tag);
+        }
+      }
+      if (op % (numOps / 8) == 0) check_same(m, ref, tag);
+    }
+    check_same(m, ref, tag);
+
+    /// range erase, then drain everything
+    if (ref.size() > 10) {
+      auto first = m.begin(), last = m.begin();
+      auto rfirst = ref.begin(), rlast = ref.begin();
+      std::advance(first, 3), std::advance(rfirst, 3);
+      std::advance(last, ref.size() / 2), std::advance(rlast, ref.size() / 2);
+      auto it = m.erase(first, last);
+      auto rit = ref.erase(rfirst, rlast);
+      require(it->first == rit->first, "range erase result, " + tag);
+      check_same(m, ref, tag);
+    }
+    m.removeAll([](const Key &, int v) { return v % 3 == 0; });
+    for (auto it = ref.begin(); it != ref.end();) it = it->second % 3 == 0 ? ref.erase(it) : ++it;
+    check_same(m, ref, tag + ", removeAll");
+    while (!ref.empty()) {
+      require(m.erase(ref.begin()->first) == 1, "drain, " + tag);
+      ref.erase(ref.begin());
+    }
+    check_same(m, ref, tag + ", drained");
+    require(m.begin() == m.end() && m.rbegin() == m.rend(), "empty map iterators, " + tag);
+  }
+
+  void check_bulk_load_and_scans() {
+    using namespace zs;
+    for (int n : {0, 1, 7, 64, 65, 1000, 100000}) {
+      std::vector<std::pair<long long, double>> sorted;
+      for (int i = 0; i != n; ++i) sorted.emplace_back(3ll * i, 0.5 * i);
+      BPlusTreeMap<long long, double> m;
+      m.insert(-1, 1.);  // replaced by the loaded entries
+      m.bulkLoad(sorted.begin(), sorted.end());
+      std::map<long long, double> ref(sorted.begin(), sorted.end());
+      const auto tag = fmt::format("bulk load {}", n);
+      check_same(m, ref, tag);
+
+      /// [lo, hi) scans over the leaf chain
+      for (auto [lo, hi] : {std::pair<long long, long long>{-5, 10}, {4, 4}, {2, 3ll * n / 2},
+                            {3ll * n - 7, 3ll * n + 100}, {0, 3ll * n}}) {
+        std::vector<long long> got, expected;
+        m.forEachInRange(lo, hi, [&](long long k, double) { got.push_back(k); });
+        for (auto it = ref.lower_bound(lo); it != ref.end() && it->first < hi; ++it)
+          expected.push_back(it->first);
+        require(got == expected, fmt::format("range scan [{}, {}), {}", lo, hi, tag));
+      }
+      m.forEachInRangeMut(0, 30, [](long long, double &v) { v = -1.; });
+      for (long long k = 0; k < 30 && k < 3ll * n; k += 3) {
+        require(m.get(k) == -1., "mutable range scan, " + tag);
+        ref[k] = -1.;
+      }
+
+      /// the bulk-loaded tree keeps accepting updates
+      for (int i = 0; i < n; i += 2) m.erase(3ll * i), ref.erase(3ll * i);
+      for (int i = 0; i < n; i += 5) m.insert(3ll * i + 1, 2.), ref[3ll * i + 1] = 2.;
+      m.forEachInRangeMut(0, 30, [](long long, double &v) { v = (double)(long long)v; });
+      for (auto &[k, v] : ref)
+        if (k < 30) v = (double)(long long)v;
+      check_same(m, ref, tag + ", updated");
+    }
+
+    bool threw = false;
+    try {
+      std::vector<std::pair<int, int>> unsorted{{1, 0}, {3, 0}, {2, 0}};
+      BPlusTreeMap<int, int> m;
+      m.bulkLoad(unsorted.begin(), unsorted.end());
+    } catch (const std::runtime_error &) {
+      threw = true;
+    }
+    require(threw, "unsorted bulk load is rejected");
+  }
+
+  void check_missing_mapping() {
+    zs::BPlusTreeMap<std::string, float> m;
+    bool threw = false;
+    try {
+      m.get("absent");
+    } catch (const zs::BPlusTreeMap<std::string, float>::NoSuchMappingException &) {
+      threw = true;
+    }
+    require(threw, "get on an empty map throws");
+    m["present"] = 1.f;
+    require(m.at("present") == 1.f && m.count("absent") == 0, "lookup after insert");
+    threw = false;
+    try {
+      m.at("absent");
+    } catch (const zs::BPlusTreeMap<std::string, float>::NoSuchMappingException &) {
+      threw = true;
+    }
+    require(threw, "at on a missing key throws");
+    require(m.find("absent") == m.end() && m.find("present")->second == 1.f, "find");
+  }
+
+}  // namespace
+
+int main() {
+  try {
+    check_random_ops<int, std::less<int>>(
+        [](std::mt19937 &rng) { return (int)(rng() % 5000); }, 200000, 1, "int keys");
+    /// minimal nodes (4 keys), deep trees stress splits, borrows and merges of inner nodes
+    check_random_ops<long long, std::less<long long>, 0>(
+        [](std::mt19937 &rng) { return (long long)(rng() % 20000); }, 200000, 5, "small nodes");
+    check_random_ops<float, std::less<float>>(
+        [](std::mt19937 &rng) { return (float)(rng() % 3000) * 0.25f; }, 100000, 2,
+        "float keys");
+    check_random_ops<int, std::greater<int>>(
+        [](std::mt19937 &rng) { return (int)(rng() % 2000); }, 100000, 3, "descending order");
+    check_random_ops<std::string, std::less<std::string>>(
+        [](std::mt19937 &rng) { return std::to_string(rng() % 4000); }, 100000, 4,
+        "string keys");
+    check_bulk_load_and_scans();
+    check_missing_mapping();
+    fmt::print("b+tree map checks passed\n");
+    return 0;
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return 1;
+  }
+}
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "zensim/container/BPlusTreeMap.hpp"
+#include "zensim/container/RBTreeMap.hpp"
+
+namespace {
+
+  using clock_t = std::chrono::steady_clock;
+
+  template <typename F> double time_ms(F &&f) {
+    const auto start = clock_t::now();
+    f();
+    return std::chrono::duration<double, std::milli>(clock_t::now() - start).count();
+  }
+
+}  // namespace
+
+int main() {
+  using namespace zs;
+  const int n = 1000000;
+  std::mt19937 rng{1};
+  std::vector<int> keys(n), queries(n);
+  for (int i = 0; i != n; ++i) keys[i] = (int)(rng() % (4u * n));
+  for (int i = 0; i != n; ++i) queries[i] = (int)(rng() % (4u * n));
+
+  RBTreeMap<int, int> rb;
+  BPlusTreeMap<int, int> bp;
+  std::printf("%d entries, %d keys per b+tree node\n", n, BPlusTreeMap<int, int>::capacity);
+  std::printf("%-22s %12s %12s %9s\n", "operation", "rbtree(ms)", "b+tree(ms)", "speedup");
+  const auto report = [](const char *name, double a, double b) {
+    std::printf("%-22s %12.2f %12.2f %8.2fx\n", name, a, b, a / b);
+  };
+
+  report("random insert", time_ms([&] {
+           for (int k : keys) rb.insert(k, k);
+         }),
+         time_ms([&] {
+           for (int k : keys) bp.insert(k, k);
+         }));
+
+  size_t hitsA = 0, hitsB = 0;
+  report("random lookup", time_ms([&] {
+           for (int q : queries) hitsA += rb.count(q);
+         }),
+         time_ms([&] {
+           for (int q : queries) hitsB += bp.count(q);
+         }));
+
+  long long sumA = 0, sumB = 0;
+  report("ordered traversal", time_ms([&] {
+           for (auto it = rb.begin(); it != rb.end(); ++it) sumA += it->second;
+         }),
+         time_ms([&] {
+           for (auto it = bp.begin(); it != bp.end(); ++it) sumB += it->second;
+         }));
+
+  /// short range scans starting at random keys
+  const int numScans = 100000, span = 400;
+  report("range scan", time_ms([&] {
+           for (int s = 0; s != numScans; ++s)
+             for (auto it = rb.lower_bound(queries[s]);
+                  it != rb.end() && it->first < queries[s] + span; ++it)
+               sumA += it->second;
+         }),
+         time_ms([&] {
+           for (int s = 0; s != numScans; ++s)
+             bp.forEachInRange(queries[s], queries[s] + span,
+                               [&sumB](int, int v) { sumB += v; });
+         }));
+
+  std::printf("%-22s %12s %12.2f\n", "random erase", "-", time_ms([&] {
+                for (int q : queries) bp.erase(q);
+              }));
+
+  std::vector<std::pair<int, int>> sorted;
+  for (int i = 0; i != n; ++i) sorted.emplace_back(4 * i, i);
+  BPlusTreeMap<int, int> loaded;
+  std::printf("%-22s %12s %12.2f\n", "bulk load (sorted)", "-",
+              time_ms([&] { loaded.bulkLoad(sorted.begin(), sorted.end()); }));
+
+  if (hitsA != hitsB || sumA != sumB) {
+    std::printf("result mismatch between the maps\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/container/CellList.hpp"
+#include "zensim/zpc_tpls/fmt/core.h"
+
+namespace {
+
+  void require(bool cond, const std::string &msg) {
+    if (!cond) throw std::runtime_error("cell list check failed: " + msg);
+  }
+
+  template <int dim> using point_t = zs::vec<float, dim>;
+
+  template <int dim> float dist2(const point_t<dim> &a, const point_t<dim> &b) {
+    return (a - b).l2NormSqr();
+  }
+
+  /// brute-force reference: neighbors within radius, and the K nearest of those
+  template <int dim, int K, typename Policy>
+  void check_queries(Policy &pol, const zs::CellList<dim> &cl,
+                     const std::vector<point_t<dim>> &pts, const std::vector<point_t<dim>> &queries,
+                     float radius, const std::string &tag) {
+    using namespace zs;
+    constexpr auto space = RM_REF_T(pol)::exec_tag::value;
+    const auto nq = queries.size();
+    std::vector<std::vector<int>> found(nq);
+    std::vector<int> knnIds(nq * K), knnCnts(nq);
+    std::vector<float> knnD2s(nq * K);
+    std::vector<char> distanceOk(nq, 1);
+    pol(range(nq), [&, clv = proxy<space>(cl)](size_t q) {
+      clv.iter_neighbors(queries[q], radius, [&](int j, float d2) {
+        if (std::abs(d2 - dist2(pts[j], queries[q])) > 1e-5f) distanceOk[q] = 0;
+        found[q].push_back(j);
+      });
+      int ids[K];
+      float d2s[K];
+      knnCnts[q] = clv.knn(queries[q], radius, ids, d2s);
+      for (int k = 0; k != knnCnts[q]; ++k) {
+        knnIds[q * K + k] = ids[k];
+        knnD2s[q * K + k] = d2s[k];
+      }
+    });
+
+    require(std::all_of(distanceOk.begin(), distanceOk.end(), [](char v) { return v; }),
+            "reported distances, " + tag);
+    const float r2 = radius * radius;
+    for (size_t q = 0; q != nq; ++q) {
+      std::vector<std::pair<float, int>> ref;
+      for (int j = 0; j != (int)pts.size(); ++j)
+        if (auto d2 = dist2(pts[j], queries[q]); d2 <= r2) ref.emplace_back(d2, j);
+      std::vector<int> refIds;
+      for (auto &[d2, j] : ref) refIds.push_back(j);
+      std::sort(found[q].begin(), found[q].end());
+      require(found[q] == refIds, fmt::format("radius query {}, {}", q, tag));
+
+      std::sort(ref.begin(), ref.end());
+      const int expected = std::min((int)ref.size(), K);
+      require(knnCnts[q] == expected, fmt::format("knn count of query {}, {}", q, tag));
+      for (int k = 0; k != expected; ++k) {
+        require(knnD2s[q * K + k] == ref[k].first, fmt::format("knn order of query {}, {}", q, tag));
+        require(dist2(pts[knnIds[q * K + k]], queries[q]) == ref[k].first,
+                fmt::format("knn index of query {}, {}", q, tag));
+      }
+    }
+  }
+
+  template <int dim> zs::Vector<point_t<dim>> to_vector(const std::vector<point_t<dim>> &pts) {
+    zs::Vector<point_t<dim>> ret{pts.size()};
+    std::copy(pts.begin(), pts.end(), ret.begin());
+    return ret;
+  }
+
+  /// points sharing a cell are contiguous, cells follow morton order
+  template <int dim> void check_layout(const zs::CellList<dim> &cl, size_t n,
+                                       const std::string &tag) {
+    require(cl.size() == n, "size, " + tag);
+    std::vector<int> seen(n, 0);
+    for (size_t no = 0; no != n; ++no) {
+      if (no) require(cl._keys[no - 1] <= cl._keys[no], "sorted keys, " + tag);
+      ++seen[cl._indices[no]];
+    }
+    require(std::all_of(seen.begin(), seen.end(), [](int v) { return v == 1; }),
+            "permutation, " + tag);
+  }
+
+  void check_dense_3d() {
+    using namespace zs;
+    auto pol = preferred_host_policy();
+    std::mt19937 rng{3};
+    std::uniform_real_distribution<float> dist{0.f, 1.f};
+    std::vector<point_t<3>> pts(20000), queries(300);
+    for (auto &p : pts) p = point_t<3>{dist(rng), dist(rng), dist(rng)};
+    for (auto &q : queries) q = point_t<3>{dist(rng), dist(rng), dist(rng)} * 1.2f - 0.1f;
+
+    CellList<3> cl{};
+    auto points = to_vector(pts);
+    cl.build(pol, 0.05f, points);
+    require(cl.isDense(), "uniform points use the counting-sort layout");
+    check_layout(cl, pts.size(), "dense");
+    check_queries<3, 8>(pol, cl, pts, queries, 0.05f, "dense");
+    check_queries<3, 4>(pol, cl, pts, queries, 10.f, "dense, unbounded knn");
+
+    /// a few points change cells, the rest jitter within theirs
+    std::uniform_real_distribution<float> jitter{-5e-4f, 5e-4f};
+    for (int round = 0; round != 3; ++round) {
+      for (auto &p : pts) p += point_t<3>{jitter(rng), jitter(rng), jitter(rng)};
+      for (int i = 0; i != 100; ++i)
+        pts[(i * 7919 + round) % pts.size()] = point_t<3>{dist(rng), dist(rng), dist(rng)};
+      points = to_vector(pts);
+      require(cl.update(pol, points), "few movers are merged incrementally");
+      check_layout(cl, pts.size(), "dense update");
+      check_queries<3, 8>(pol, cl, pts, queries, 0.05f, "dense update");
+    }
+
+    /// leaving the grid forces a rebuild
+    pts[0] = point_t<3>{5.f, 5.f, 5.f};
+    points = to_vector(pts);
+    require(!cl.update(pol, points), "points leaving the grid trigger a rebuild");
+    check_queries<3, 8>(pol, cl, pts, queries, 0.05f, "rebuilt");
+  }
+
+  void check_sparse_3d() {
+    using namespace zs;
+    auto pol = preferred_host_policy();
+    std::mt19937 rng{11};
+    std::uniform_real_distribution<float> dist{0.f, 1.f};
+    /// two far apart clusters, the bounding grid is mostly empty
+    std::vector<point_t<3>> pts(6000), queries;
+    for (size_t i = 0; i != pts.size(); ++i)
+      pts[i] = point_t<3>{dist(rng), dist(rng), dist(rng)} + (i % 2 ? 500.f : 0.f);
+    for (int i = 0; i != 200; ++i)
+      queries.push_back(point_t<3>{dist(rng), dist(rng), dist(rng)}
+                        + (i % 2 ? 500.f : i % 4 ? 0.f : 250.f));
+
+    CellList<3> cl{};
+    auto points = to_vector(pts);
+    cl.build(pol, 0.04f, points);
+    require(!cl.isDense(), "sparse occupancy uses the sorted layout");
+    check_layout(cl, pts.size(), "sparse");
+    check_queries<3, 6>(pol, cl, pts, queries, 0.06f, "sparse");
+
+    /// movers stay inside their cluster
+    for (int i = 0; i != 50; ++i)
+      pts[i * 13] = point_t<3>{dist(rng), dist(rng), dist(rng)} + (i % 2 ? 500.f : 0.f);
+    points = to_vector(pts);
+    require(cl.update(pol, points), "sparse incremental update");
+    check_layout(cl, pts.size(), "sparse update");
+    check_queries<3, 6>(pol, cl, pts, queries, 0.06f, "sparse update");
+  }
+
+  void check_2d() {
+    using namespace zs;
+    auto pol = preferred_host_policy();
+    std::mt19937 rng{7};
+    std::uniform_real_distribution<float> dist{-2.f, 3.f};
+    std::vector<point_t<2>> pts(5000), queries(200);
+    for (auto &p : pts) p = point_t<2>{dist(rng), dist(rng)};
+    for (auto &q : queries) q = point_t<2>{dist(rng), dist(rng)};
+    CellList<2> cl{};
+    cl.build(pol, 0.1f, to_vector(pts));
+    check_layout(cl, pts.size(), "2d");
+    check_queries<2, 5>(pol, cl, pts, queries, 0.15f, "2d");
+
+    CellList<2> empty{};
+    cl.build(pol, 0.1f, to_vector(std::vector<point_t<2>>{}));
+    check_queries<2, 5>(pol, cl, {}, queries, 0.15f, "empty");
+
+    bool thrown = false;
+    try {
+      empty.build(pol, 0.f, to_vector(pts));
+    } catch (const std::runtime_error &) {
+      thrown = true;
+    }
+    require(thrown, "zero cell size rejected");
+  }
+
+}  // namespace
+
+int main() {
+  try {
+    check_dense_3d();
+    check_sparse_3d();
+    check_2d();
+    fmt::print("cell list checks passed\n");
+    return 0;
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return 1;
+  }
+}
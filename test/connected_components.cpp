@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/graph/ConnectedComponents.hpp"
+#include "zensim/math/matrix/SparseMatrix.hpp"
+#include "zensim/zpc_tpls/fmt/core.h"
+
+namespace {
+
+  void require(bool cond, const std::string &msg) {
+    if (!cond) throw std::runtime_error("connected components check failed: " + msg);
+  }
+
+  struct graph_t {
+    int n;
+    std::vector<int> is, js;
+    std::vector<float> vs;
+
+    void connect(int u, int v, float val = 0.f) {
+      is.push_back(u), js.push_back(v), vs.push_back(val);
+      is.push_back(v), js.push_back(u), vs.push_back(val);
+    }
+  };
+
+  /// a giant randomly wired cluster, many small ones and isolated vertices, shuffled ids.
+  /// edges valued 1 are "cut" edges, each only bridging two otherwise separate clusters
+  graph_t make_graph(int n, unsigned seed) {
+    std::mt19937 rng{seed};
+    std::vector<int> ids(n);
+    std::iota(ids.begin(), ids.end(), 0);
+    std::shuffle(ids.begin(), ids.end(), rng);
+    graph_t g{n};
+    const int giant = n * 3 / 5;
+    std::uniform_int_distribution<int> inGiant{0, std::max(giant - 1, 0)};
+    for (int v = 1; v < giant; ++v) {
+      g.connect(ids[v], ids[std::uniform_int_distribution<int>{0, v - 1}(rng)]);
+      g.connect(ids[v], ids[inGiant(rng)]);
+    }
+    /// clusters of 2 to 9 vertices, consecutive (pre-shuffle) ones bridged by cut edges
+    int v = giant, prevCluster = -1;
+    while (v < n - n / 20) {
+      const int size = std::min(2 + (int)(rng() % 8), n - v);
+      for (int k = 1; k != size; ++k) g.connect(ids[v + k], ids[v + (int)(rng() % k)]);
+      if (prevCluster >= 0 && rng() % 2) g.connect(ids[v], ids[prevCluster], 1.f);
+      prevCluster = v;
+      v += size;
+    }
+    /// the remaining vertices stay isolated (a few with self loops)
+    for (; v < n; ++v)
+      if (v % 2) g.is.push_back(ids[v]), g.js.push_back(ids[v]), g.vs.push_back(0.f);
+    return g;
+  }
+
+  /// sequential reference, smallest vertex index per component
+  std::vector<int> reference_roots(const graph_t &g, bool skipCuts) {
+    std::vector<int> fa(g.n);
+    std::iota(fa.begin(), fa.end(), 0);
+    auto find = [&](int v) {
+      while (fa[v] != v) v = fa[v] = fa[fa[v]];
+      return v;
+    };
+    for (size_t e = 0; e != g.is.size(); ++e) {
+      if (skipCuts && g.vs[e] != 0.f) continue;
+      int a = find(g.is[e]), b = find(g.js[e]);
+      if (a != b) fa[std::max(a, b)] = std::min(a, b);
+    }
+    for (int v = 0; v != g.n; ++v) fa[v] = find(v);
+    return fa;
+  }
+
+  template <typename Range> std::vector<int> to_std(const Range &r) {
+    return std::vector<int>(std::begin(r), std::end(r));
+  }
+
+  void check_graph(int n, unsigned seed) {
+    using namespace zs;
+    auto pol = preferred_host_policy();
+    const auto g = make_graph(n, seed);
+    SparseMatrix<float, true, int, int> spmat{n, n};
+    spmat.build(pol, n, n, g.is, g.js, g.vs);
+    spmat.localOrdering(pol);
+
+    for (bool skipCuts : {false, true}) {
+      const auto ref = reference_roots(g, skipCuts);
+      const auto tag = fmt::format("{} vertices{}", n, skipCuts ? ", cut edges skipped" : "");
+      for (int numRounds : {0, 1, 2, 5}) {
+        Vector<int> fas{(size_t)n};
+        if (skipCuts)
+          union_find(pol, spmat, fas, [](float v) { return v != 0.f; }, numRounds);
+        else
+          union_find(pol, spmat, fas, numRounds);
+        require(to_std(fas) == ref, fmt::format("component roots, {} rounds, {}", numRounds, tag));
+      }
+      /// any integral round count picks the rounds overload rather than the predicate one
+      if (!skipCuts) {
+        Vector<int> fas{(size_t)n};
+        union_find(pol, spmat, fas, (size_t)3);
+        require(to_std(fas) == ref, fmt::format("component roots, size_t rounds, {}", tag));
+      }
+
+      /// the single-pass variant yields an equivalent (uncompressed) forest
+      Vector<int> ecl{(size_t)n}, labels{(size_t)n};
+      if (skipCuts)
+        union_find_ecl(pol, spmat, ecl, [](float v) { return v != 0.f; });
+      else
+        union_find_ecl(pol, spmat, ecl);
+      const int numComps = relabel_components(pol, ecl, labels);
+      const auto ls = to_std(labels);
+
+      /// contiguous ids, numbered by the smallest vertex of each component
+      std::vector<int> expected(n), firstOf;
+      for (int v = 0; v != n; ++v) {
+        if (ref[v] == v) firstOf.push_back(v);
+        expected[v] = (int)(std::lower_bound(firstOf.begin(), firstOf.end(), ref[v])
+                            - firstOf.begin());
+      }
+      require(numComps == (int)firstOf.size(), "number of components, " + tag);
+      require(ls == expected, "contiguous component ids, " + tag);
+    }
+  }
+
+}  // namespace
+
+int main() {
+  try {
+    check_graph(1, 1);
+    check_graph(997, 3);
+    check_graph(60000, 7);
+    fmt::print("connected components checks passed\n");
+    return 0;
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return 1;
+  }
+}
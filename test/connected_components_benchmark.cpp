@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/graph/ConnectedComponents.hpp"
+#include "zensim/math/matrix/SparseMatrix.hpp"
+
+namespace {
+
+  using clock_t = std::chrono::steady_clock;
+
+  template <typename F> double time_ms(F &&f) {
+    f();  // warm up
+    const int reps = 3;
+    const auto start = clock_t::now();
+    for (int r = 0; r != reps; ++r) f();
+    return std::chrono::duration<double, std::milli>(clock_t::now() - start).count() / reps;
+  }
+
+  struct graph_t {
+    int n;
+    std::vector<int> is, js;
+    void connect(int u, int v) {
+      is.push_back(u), js.push_back(v);
+      is.push_back(v), js.push_back(u);
+    }
+  };
+
+  /// a giant 3d grid component (randomly numbered) plus many tiny clusters
+  graph_t grid_graph(int side, int numSmall) {
+    const int numGrid = side * side * side;
+    graph_t g{numGrid + numSmall};
+    std::vector<int> ids(g.n);
+    std::iota(ids.begin(), ids.end(), 0);
+    std::shuffle(ids.begin(), ids.end(), std::mt19937{0});
+    for (int x = 0; x != side; ++x)
+      for (int y = 0; y != side; ++y)
+        for (int z = 0; z != side; ++z) {
+          const int v = (x * side + y) * side + z;
+          if (x + 1 < side) g.connect(ids[v], ids[v + side * side]);
+          if (y + 1 < side) g.connect(ids[v], ids[v + side]);
+          if (z + 1 < side) g.connect(ids[v], ids[v + 1]);
+        }
+    for (int v = numGrid; v + 1 < g.n; v += 3) g.connect(ids[v], ids[v + 1]);
+    return g;
+  }
+
+  /// skewed degrees: every vertex attaches to a few hubs, hubs form one giant component
+  graph_t hub_graph(int n, int numHubs) {
+    graph_t g{n};
+    std::mt19937 rng{1};
+    std::uniform_int_distribution<int> hub{0, numHubs - 1};
+    for (int h = 1; h != numHubs; ++h) g.connect(h, h - 1);
+    for (int v = numHubs; v != n; ++v)
+      if (v % 10) {
+        g.connect(v, hub(rng));
+        g.connect(v, hub(rng));
+      }
+    return g;
+  }
+
+  void run(const char *name, const graph_t &g) {
+    using namespace zs;
+    auto pol = preferred_host_policy();
+    SparseMatrix<float, true, int, int> spmat{g.n, g.n};
+    spmat.build(pol, g.n, g.n, g.is, g.js, std::vector<float>(g.is.size(), 1.f));
+    spmat.localOrdering(pol);
+    Vector<int> fas{(size_t)g.n}, labels{(size_t)g.n};
+    const double ecl = time_ms([&] { union_find_ecl(pol, spmat, fas); });
+    const double afforest = time_ms([&] { union_find(pol, spmat, fas); });
+    int numComps = 0;
+    const double relabel = time_ms([&] { numComps = relabel_components(pol, fas, labels); });
+    std::printf("%-10s %10d %12zu %10d %10.2f %10.2f %10.2f\n", name, g.n, g.is.size(), numComps,
+                ecl, afforest, relabel);
+  }
+
+}  // namespace
+
+int main() {
+  std::printf("%-10s %10s %12s %10s %10s %10s %10s\n", "graph", "vertices", "entries",
+              "components", "ecl(ms)", "afforest", "relabel");
+  run("grid", grid_graph(100, 1000000));
+  run("hubs", hub_graph(2000000, 64));
+  return 0;
+}
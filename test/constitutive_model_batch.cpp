@@ -0,0 +1,113 @@
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/container/TileVector.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/physics/ConstitutiveModelBatch.hpp"
+#include "zensim/physics/constitutive_models/FixedCorotated.h"
+#include "zensim/physics/constitutive_models/NeoHookean.hpp"
+#include "zensim/physics/constitutive_models/StvkWithHencky.hpp"
+#include "zensim/zpc_tpls/fmt/core.h"
+
+namespace {
+
+  using mat3 = zs::vec<float, 3, 3>;
+
+  void require(bool cond, const std::string &msg) {
+    if (!cond) throw std::runtime_error("constitutive model batch check failed: " + msg);
+  }
+
+  /// mildly deformed, non-inverted deformation gradients
+  std::vector<mat3> make_inputs(size_t n) {
+    std::mt19937 rng{5};
+    std::uniform_real_distribution<float> dist{-0.3f, 0.3f};
+    std::vector<mat3> ret;
+    while (ret.size() != n) {
+      mat3 F = mat3::identity();
+      for (int r = 0; r != 3; ++r)
+        for (int c = 0; c != 3; ++c) F(r, c) += dist(rng);
+      if (zs::determinant(F) > 0.2f) ret.push_back(F);
+    }
+    return ret;
+  }
+
+  bool close(float a, float b, float scale) { return std::abs(a - b) <= 2e-3f * scale; }
+
+  template <size_t Length, typename Model, bool project_SPD = false>
+  void check_model(const Model &model, const char *name, size_t n,
+                   zs::wrapv<project_SPD> projectSPD = {}) {
+    using namespace zs;
+    auto pol = preferred_host_policy();
+    const auto inputs = make_inputs(n);
+    TileVector<float, Length> tv{{{"F", 9}, {"P", 9}, {"psi", 1}, {"H", 81}}, n};
+    auto tvv = view<execspace_e::host>({}, tv);
+    for (size_t i = 0; i != n; ++i) tvv.tuple(dim_c<3, 3>, "F", i) = inputs[i];
+
+    evaluate_constitutive_model_svd_batched(pol, tv, model, "F", "P", "psi", "H", projectSPD);
+
+    const float scale = model.mu + model.lam;
+    for (size_t i = 0; i != n; ++i) {
+      const auto &F = inputs[i];
+      const auto tag = fmt::format("{}, lane width {}, element {}", name, Length, i);
+      require(close(tvv("psi", i), model.psi(F), scale), "energy density, " + tag);
+      const auto Pref = model.first_piola(F);
+      const mat3 P = tvv.pack(dim_c<3, 3>, "P", i);
+      for (int c = 0; c != 9; ++c) require(close(P.val(c), Pref.val(c), scale), "stress, " + tag);
+      const auto Href = model.first_piola_derivative(F, projectSPD);
+      for (int c = 0; c != 81; ++c)
+        require(close(tvv("H", c, i), Href.val(c), scale), "stress derivative, " + tag);
+    }
+  }
+
+  /// outputs are optional, untouched channels keep their contents
+  void check_optional_outputs() {
+    using namespace zs;
+    auto pol = preferred_host_policy();
+    constexpr size_t n = 77;
+    const auto inputs = make_inputs(n);
+    TileVector<float, 8> tv{{{"F", 9}, {"P", 9}, {"psi", 1}}, n};
+    auto tvv = view<execspace_e::host>({}, tv);
+    for (size_t i = 0; i != n; ++i) {
+      tvv.tuple(dim_c<3, 3>, "F", i) = inputs[i];
+      tvv("psi", i) = -1.f;
+    }
+    FixedCorotated<float> model{1e4f, 0.3f};
+    evaluate_constitutive_model_svd_batched(pol, tv, model, "F", "P");
+    for (size_t i = 0; i != n; ++i) {
+      require(tvv("psi", i) == -1.f, "skipped energy density");
+      const auto Pref = model.first_piola(inputs[i]);
+      require(close(tvv("P", 4, i), Pref(1, 1), model.mu + model.lam), "stress only");
+    }
+    bool thrown = false;
+    try {
+      evaluate_constitutive_model_svd_batched(pol, tv, model, "F", "P", "", "psi");
+    } catch (const std::runtime_error &) {
+      thrown = true;
+    }
+    require(thrown, "mismatching hessian extent rejected");
+  }
+
+}  // namespace
+
+int main() {
+  try {
+    using namespace zs;
+    check_model<32>(FixedCorotated<float>{1e4f, 0.3f}, "fixed corotated", 1003);
+    check_model<32>(FixedCorotated<float>{1e4f, 0.3f}, "fixed corotated (spd)", 301, true_c);
+    check_model<8>(NeoHookean<float>{5e3f, 0.4f}, "neohookean", 517);
+    check_model<8>(StvkWithHencky<float>{1e4f, 0.25f}, "stvk hencky", 259);
+    check_model<16>(NeoHookeanInvariant<float>{5e3f, 0.4f}, "neohookean (invariants)", 333);
+    check_model<16>(StableNeohookeanInvarient<float>{5e3f, 0.4f},
+                    "stable neohookean (invariants, spd)", 129, true_c);
+    check_optional_outputs();
+    fmt::print("constitutive model batch checks passed\n");
+    return 0;
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return 1;
+  }
+}
@@ -0,0 +1,137 @@
+#include <array>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "zensim/ZpcCoroutine.hpp"
+#include "zensim/ZpcTaskGraph.hpp"
+#include "zensim/execution/AsyncMemoryPool.hpp"
+#include "zensim/execution/AsyncScheduler.hpp"
+#include "zensim/zpc_tpls/fmt/core.h"
+
+namespace {
+
+  void require(bool cond, const char *msg) {
+    if (!cond) throw std::runtime_error(std::string("coroutine frame pool check failed: ") + msg);
+  }
+
+  zs::Future<int> add_one(int v) { co_return v + 1; }
+
+  zs::Future<int> chain(int v) {
+    int a = co_await add_one(v);
+    int b = co_await add_one(a);
+    co_return b;
+  }
+
+  size_t arena_allocations() {
+    return zs::detail::AsyncMemoryArena::instance().numAllocations();
+  }
+
+  void check_frames_are_pooled() {
+    constexpr int n = 1000;
+    std::vector<zs::Future<int>> live;
+    live.reserve(n);
+    const auto before = arena_allocations();
+    for (int i = 0; i != n; ++i) live.push_back(chain(i));
+    const auto grown = arena_allocations() - before;
+    require(grown > 0 && grown < n / 4, "frames are carved from slabs");
+    for (int i = 0; i != n; ++i) {
+      live[i].resume();
+      require(live[i].isDone() && live[i].get() == i + 2, "coroutine result");
+    }
+    live.clear();
+
+    /// steady state, frames (including the nested ones) are recycled
+    const auto steady = arena_allocations();
+    for (int round = 0; round != 5; ++round) {
+      for (int i = 0; i != n; ++i) live.push_back(chain(i));
+      for (auto &f : live) f.resume();
+      live.clear();
+    }
+    require(arena_allocations() == steady, "no slab growth in steady state");
+  }
+
+  void check_cross_thread_frames() {
+    constexpr int n = 2000;
+    for (int round = 0; round != 3; ++round) {
+      std::vector<zs::Future<int>> frames;
+      for (int i = 0; i != n; ++i) frames.push_back(add_one(i));
+      const auto before = arena_allocations();
+      std::thread consumer{[&] {
+        int sum = 0;
+        for (auto &f : frames) {
+          f.resume();
+          sum += f.get();
+        }
+        frames.clear();  // frames go back to the allocating thread's heaps
+        require(sum == n * (n + 1) / 2, "results computed on the consumer");
+      }};
+      consumer.join();
+      if (round > 0) require(arena_allocations() == before, "remote frees are recycled");
+    }
+  }
+
+  void check_callable_nodes() {
+    using namespace zs;
+    AsyncScheduler scheduler{2};
+    std::atomic<int> order{0};
+    int results[4] = {0, 0, 0, 0};
+    /// larger than both the function buffer and the inline node storage
+    std::array<int, 32> big{};
+    for (int i = 0; i != 32; ++i) big[i] = i;
+
+    TaskGraph graph;
+    auto *root = graph.addNode([&] { results[0] = order.fetch_add(1) + 1; }, "root");
+    auto *left = graph.addNode([&, big] { results[1] = order.fetch_add(1) + 1 + big[0]; }, "left");
+    auto *right = graph.addNode(function<void()>{[&] { results[2] = order.fetch_add(1) + 1; }},
+                                "right");
+    auto *join = graph.addNode([&] {
+      results[3] = order.fetch_add(1) + 1;
+      throw std::runtime_error("join failure");
+    }, "join");
+    require(root->has_callable() && left->has_callable() && right->has_callable()
+                && !root->_task.getHandle(),
+            "callables skip the coroutine frame");
+    graph.addEdge(root, left);
+    graph.addEdge(root, right);
+    graph.addEdge(left, join);
+    graph.addEdge(right, join);
+
+    graph.submit(scheduler);
+    graph.wait(scheduler);
+    require(graph.allDone(), "all nodes done");
+    require(results[0] == 1 && results[3] == 4, "root first, join last");
+    require(results[1] > 1 && results[2] > 1 && results[1] < 4 && results[2] < 4, "diamond");
+    require(join->exception() != nullptr && root->exception() == nullptr,
+            "exceptions are kept on the node");
+
+    /// coroutine and callable nodes mix
+    TaskGraph mixed;
+    int seen = 0;
+    auto *coro = mixed.addNode([](int *out) -> Future<void> {
+      *out = 1;
+      co_return;
+    }(&seen), "coro");
+    auto *tail = mixed.addNode([&] { seen *= 10; }, "tail");
+    mixed.addEdge(coro, tail);
+    mixed.submit(scheduler);
+    mixed.wait(scheduler);
+    require(seen == 10, "coroutine node before callable node");
+  }
+
+}  // namespace
+
+int main() {
+  try {
+    check_frames_are_pooled();
+    check_cross_thread_frames();
+    check_callable_nodes();
+    fmt::print("coroutine frame pool checks passed\n");
+    return 0;
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return 1;
+  }
+}
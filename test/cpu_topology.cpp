@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+#include "zensim/execution/AsyncRuntime.hpp"
+#include "zensim/execution/AsyncScheduler.hpp"
+#include "zensim/execution/CpuTopology.hpp"
+#include "zensim/execution/ManagedThread.hpp"
+#include "zensim/zpc_tpls/fmt/core.h"
+
+namespace {
+
+  void require(bool cond, const char *msg) {
+    if (!cond) throw std::runtime_error(std::string("cpu topology check failed: ") + msg);
+  }
+
+  void check_topology(const zs::CpuTopology &topo) {
+    using namespace zs;
+    require(topo.numCpus() > 0, "usable cpus");
+    require(topo.numCores() > 0 && topo.numCores() <= topo.numCpus(), "core count");
+    require(topo.numL3Domains() > 0 && topo.numNumaNodes() > 0, "domain counts");
+    for (u32 i = 1; i < topo.numCpus(); ++i)
+      require(topo.cpus[i - 1].cpu < topo.cpus[i].cpu, "sorted by os index");
+    for (const auto &info : topo.cpus) {
+      require(topo.find(info.cpu) == &info, "lookup");
+      require(info.core < topo.numCores() && info.l3Domain < topo.numL3Domains(), "dense ids");
+    }
+
+    for (auto policy : {affinity_compact, affinity_scatter}) {
+      const u32 n = topo.numCpus();
+      auto cpus = topo.placement(policy, n);
+      require(cpus.size() == n, "placement size");
+      require(std::set<u32>(cpus.begin(), cpus.end()).size() == n, "no oversubscription");
+      auto wrapped = topo.placement(policy, 2 * n + 1);
+      require(wrapped[n] == cpus[0] && wrapped[2 * n] == cpus[0], "wrap around");
+      if (policy == affinity_scatter) {
+        /// physical cores come before their smt siblings
+        for (u32 i = 0; i != std::min(n, topo.numCores()); ++i)
+          require(topo.find(cpus[i])->smtIndex == 0, "scatter prefers physical cores");
+      } else {
+        for (u32 i = 1; i < n; ++i)
+          require(topo.find(cpus[i - 1])->l3Domain <= topo.find(cpus[i])->l3Domain
+                      || topo.find(cpus[i - 1])->numaNode < topo.find(cpus[i])->numaNode,
+                  "compact keeps domains contiguous");
+      }
+    }
+    require(topo.placement(affinity_none, 4).empty(), "no placement without affinity");
+    require(topo.placement(affinity_compact, 4, (i32)topo.numNumaNodes()).empty(),
+            "unknown numa node");
+  }
+
+}  // namespace
+
+int main() {
+  using namespace zs;
+  const auto &topo = CpuTopology::instance();
+  fmt::print("{} cpus, {} cores, {} packages, {} numa nodes, {} L3 domains\n", topo.numCpus(),
+             topo.numCores(), topo.numPackages(), topo.numNumaNodes(), topo.numL3Domains());
+  check_topology(topo);
+  check_topology(CpuTopology::flat(8));
+  {
+    /// scatter over a synthetic two-socket layout alternates the L3 domains
+    auto topo2 = CpuTopology::flat(8);
+    for (auto &info : topo2.cpus) info.l3Domain = info.package = info.cpu % 2;
+    auto cpus = topo2.placement(affinity_scatter, 4);
+    require(cpus[0] % 2 != cpus[1] % 2 && cpus[2] % 2 != cpus[3] % 2, "scatter alternates");
+    cpus = topo2.placement(affinity_compact, 4);
+    require(cpus[0] % 2 == cpus[3] % 2, "compact fills a domain first");
+  }
+
+  /// pinning a managed thread, before and after start
+  const i32 target = (i32)topo.cpus.back().cpu;
+  {
+    ManagedThread thread;
+    require(thread.set_affinity(target), "deferred affinity");
+    std::atomic<i32> observed{-2};
+    thread.start([&observed](ManagedThread &) { observed = ManagedThread::current_cpu(); });
+    thread.join();
+#if defined(__linux__)
+    require(observed.load() == target, "thread runs on its pinned cpu");
+#endif
+    require(thread.affinity() == target, "affinity recorded");
+  }
+
+  /// pinned scheduler workers still run every task, stealing near victims first
+  {
+    AsyncScheduler scheduler{4, affinity_compact};
+    for (size_t i = 0; i != scheduler.numWorkers(); ++i)
+      require(topo.find((u32)scheduler.worker_cpu(i)) != nullptr, "workers pinned");
+    std::atomic<int> count{0};
+    for (int i = 0; i != 256; ++i) scheduler.enqueue([&count] { count.fetch_add(1); }, i % 4);
+    scheduler.wait();
+    require(count.load() == 256, "pinned scheduler runs all tasks");
+  }
+  {
+    AsyncScheduler scheduler{3};
+    require(scheduler.worker_cpu(0) == -1, "unpinned by default");
+    std::atomic<int> count{0};
+    for (int i = 0; i != 64; ++i) scheduler.enqueue([&count] { count.fetch_add(1); });
+    scheduler.wait();
+    require(count.load() == 64, "unpinned scheduler runs all tasks");
+  }
+  {
+    AsyncThreadPoolExecutor executor{"pinned_pool", 2, affinity_scatter, 0};
+    executor.shutdown();
+  }
+  return 0;
+}
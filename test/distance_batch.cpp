@@ -0,0 +1,350 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/geometry/DistanceBatch.hpp"
+#include "zensim/zpc_tpls/fmt/core.h"
+
+namespace {
+
+  using vec3 = zs::vec<float, 3>;
+  using grad_t = zs::vec<float, 12>;
+  using hess_t = zs::vec<float, 12, 12>;
+
+  void require(bool cond, const std::string &msg) {
+    if (!cond) throw std::runtime_error("distance batch check failed: " + msg);
+  }
+
+  template <typename T> zs::Vector<T> to_vector(const std::vector<T> &vs) {
+    zs::Vector<T> ret{vs.size()};
+    std::copy(vs.begin(), vs.end(), ret.begin());
+    return ret;
+  }
+  template <typename T> std::vector<T> to_std(const zs::Vector<T> &vs, size_t n) {
+    return std::vector<T>(vs.begin(), vs.begin() + n);
+  }
+
+  /// scalar reference, the derivatives of the classified sub-primitive scattered to the stencil
+  struct reference_t {
+    int type;
+    float dist2;
+    grad_t grad;
+    hess_t hess;
+  };
+
+  template <typename G, typename H>
+  void scatter(reference_t &ref, const G &g, const H &h, std::initializer_list<int> slots) {
+    const int *s = slots.begin();
+    const int n = (int)slots.size() * 3;
+    ref.grad = grad_t::zeros();
+    ref.hess = hess_t::zeros();
+    for (int i = 0; i != n; ++i) {
+      ref.grad.val(s[i / 3] * 3 + i % 3) = g.val(i);
+      for (int j = 0; j != n; ++j) ref.hess(s[i / 3] * 3 + i % 3, s[j / 3] * 3 + j % 3) = h(i, j);
+    }
+  }
+
+  reference_t reference_pt(const vec3 &p, const vec3 &t0, const vec3 &t1, const vec3 &t2) {
+    using namespace zs;
+    reference_t ref{pt_distance_type(p, t0, t1, t2), dist2_pt_unclassified(p, t0, t1, t2), {}, {}};
+    const vec3 ts[3] = {t0, t1, t2};
+    switch (ref.type) {
+      case 0:
+      case 1:
+      case 2:
+        scatter(ref, dist_grad_pp(p, ts[ref.type]), dist_hess_pp(p, ts[ref.type]),
+                {0, ref.type + 1});
+        break;
+      case 3:
+      case 4:
+      case 5: {
+        const int k = ref.type - 3;
+        const auto &e0 = ts[k], &e1 = ts[(k + 1) % 3];
+        scatter(ref, dist_grad_pe(p, e0, e1), dist_hess_pe(p, e0, e1),
+                {0, k + 1, (k + 1) % 3 + 1});
+        break;
+      }
+      default:
+        scatter(ref, dist_grad_pt(p, t0, t1, t2), dist_hess_pt(p, t0, t1, t2), {0, 1, 2, 3});
+    }
+    return ref;
+  }
+
+  reference_t reference_ee(const vec3 &a0, const vec3 &a1, const vec3 &b0, const vec3 &b1) {
+    using namespace zs;
+    reference_t ref{
+        ee_distance_type(a0, a1, b0, b1), dist2_ee_unclassified(a0, a1, b0, b1), {}, {}};
+    const vec3 vs[4] = {a0, a1, b0, b1};
+    const auto pp = [&](int i, int j) {
+      scatter(ref, dist_grad_pp(vs[i], vs[j]), dist_hess_pp(vs[i], vs[j]), {i, j});
+    };
+    const auto pe = [&](int i, int j, int k) {
+      scatter(ref, dist_grad_pe(vs[i], vs[j], vs[k]), dist_hess_pe(vs[i], vs[j], vs[k]),
+              {i, j, k});
+    };
+    switch (ref.type) {
+      case 0: pp(0, 2); break;
+      case 1: pp(0, 3); break;
+      case 2: pe(0, 2, 3); break;
+      case 3: pp(1, 2); break;
+      case 4: pp(1, 3); break;
+      case 5: pe(1, 2, 3); break;
+      case 6: pe(2, 0, 1); break;
+      case 7: pe(3, 0, 1); break;
+      default:
+        scatter(ref, dist_grad_ee(a0, a1, b0, b1), dist_hess_ee(a0, a1, b0, b1), {0, 1, 2, 3});
+    }
+    return ref;
+  }
+
+  template <typename VecT> float max_abs(const VecT &v) {
+    float m = 0.f;
+    for (int i = 0; i != VecT::extent; ++i) m = std::max(m, std::abs(v.val(i)));
+    return m;
+  }
+  template <typename VecT> bool close(const VecT &a, const VecT &b, float rel) {
+    const float tol = rel * std::max(1.f, max_abs(b));
+    for (int i = 0; i != VecT::extent; ++i)
+      if (std::abs(a.val(i) - b.val(i)) > tol) return false;
+    return true;
+  }
+
+  /// scalar additive ccd, the reference of the lane-batched kernels
+  template <int NumSrc, typename Dist2F>
+  float reference_accd(vec3 (&x)[4], vec3 (&dx)[4], Dist2F &&dist2Of, float eta,
+                       float thickness) {
+    const vec3 mov = (dx[0] + dx[1] + dx[2] + dx[3]) * 0.25f;
+    float m[2] = {0.f, 0.f};
+    for (int v = 0; v != 4; ++v) {
+      dx[v] -= mov;
+      m[v < NumSrc ? 0 : 1] = std::max(m[v < NumSrc ? 0 : 1], dx[v].l2NormSqr());
+    }
+    const float maxDispMag = std::sqrt(m[0]) + std::sqrt(m[1]);
+    if (maxDispMag == 0.f) return 1.f;
+    const float thick2 = thickness * thickness;
+    float dist2 = dist2Of(x), dist = std::sqrt(dist2);
+    if (dist2 <= thick2) return 0.f;
+    const float gap = eta * (dist2 - thick2) / (dist + thickness);
+    float toc = 0.f;
+    for (int iter = 0; iter != 1000; ++iter) {
+      const float lb = (1 - eta) * (dist2 - thick2) / ((dist + thickness) * maxDispMag);
+      for (int v = 0; v != 4; ++v) x[v] += lb * dx[v];
+      dist2 = dist2Of(x);
+      dist = std::sqrt(dist2);
+      if (toc > 0.f && (dist2 - thick2) / (dist + thickness) < gap) return toc;
+      toc += lb;
+      if (toc > 1.f) return 1.f;
+    }
+    return toc;
+  }
+
+  struct scene_t {
+    std::vector<vec3> xs, dxs;
+    std::vector<zs::vec<int, 3>> tris;
+    std::vector<zs::vec<int, 2>> edges;
+    std::vector<int> idsA, idsB;
+  };
+
+  /// random points, triangles and edges in the unit cube, moving towards each other
+  scene_t make_scene(size_t numVerts, size_t numPairs, bool edgeEdge, unsigned seed) {
+    std::mt19937 rng{seed};
+    std::uniform_real_distribution<float> dist{0.f, 1.f}, disp{-0.3f, 0.3f};
+    scene_t scene;
+    for (size_t i = 0; i != numVerts; ++i) {
+      scene.xs.push_back(vec3{dist(rng), dist(rng), dist(rng)});
+      scene.dxs.push_back(vec3{disp(rng), disp(rng), disp(rng)});
+    }
+    std::uniform_int_distribution<int> vid{0, (int)numVerts - 1};
+    for (size_t i = 0; i != numVerts; ++i) {
+      scene.tris.push_back(zs::vec<int, 3>{vid(rng), vid(rng), vid(rng)});
+      scene.edges.push_back(zs::vec<int, 2>{vid(rng), vid(rng)});
+    }
+    std::uniform_int_distribution<int> pid{0, (int)numVerts - 1};
+    for (size_t i = 0; i != numPairs; ++i) {
+      int a = pid(rng), b = pid(rng);
+      if (edgeEdge) {
+        const auto &ea = scene.edges[a], &eb = scene.edges[b];
+        if (ea[0] == ea[1] || eb[0] == eb[1] || ea[0] == eb[0] || ea[0] == eb[1]
+            || ea[1] == eb[0] || ea[1] == eb[1]) {
+          --i;
+          continue;
+        }
+      } else {
+        const auto &t = scene.tris[b];
+        if (t[0] == t[1] || t[1] == t[2] || t[2] == t[0] || a == t[0] || a == t[1] || a == t[2]) {
+          --i;
+          continue;
+        }
+      }
+      scene.idsA.push_back(a);
+      scene.idsB.push_back(b);
+    }
+    return scene;
+  }
+
+  void check_pt() {
+    using namespace zs;
+    auto pol = preferred_host_policy();
+    const size_t numPairs = 3001;
+    const auto scene = make_scene(400, numPairs, false, 5);
+    const auto xs = to_vector(scene.xs);
+    const auto tris = to_vector(scene.tris);
+    const auto pointIds = to_vector(scene.idsA), triIds = to_vector(scene.idsB);
+    Vector<int> types{1};
+    Vector<float> dist2s{1};
+    Vector<grad_t> grads{1};
+    Vector<hess_t> hessians{1};
+    pt_distance_batch(pol, xs, tris, pointIds, triIds, numPairs, types, dist2s, &grads,
+                      &hessians);
+    const auto ts = to_std(types, numPairs);
+    const auto ds = to_std(dist2s, numPairs);
+    const auto gs = to_std(grads, numPairs);
+    const auto hs = to_std(hessians, numPairs);
+
+    size_t mismatches = 0;
+    int seenTypes = 0;
+    for (size_t i = 0; i != numPairs; ++i) {
+      const auto &tri = scene.tris[scene.idsB[i]];
+      const auto &p = scene.xs[scene.idsA[i]];
+      const auto ref = reference_pt(p, scene.xs[tri[0]], scene.xs[tri[1]], scene.xs[tri[2]]);
+      const auto tag = fmt::format("point-triangle pair {}", i);
+      require(std::abs(ds[i] - ref.dist2) <= 1e-4f * std::max(1e-2f, ref.dist2),
+              "squared distance, " + tag);
+      /// classification may only differ on (numerically) shared boundaries
+      if (ts[i] != ref.type) {
+        ++mismatches;
+        continue;
+      }
+      seenTypes |= 1 << ts[i];
+      require(close(gs[i], ref.grad, 1e-3f), "gradient, " + tag);
+      require(close(hs[i], ref.hess, 1e-2f), "hessian, " + tag);
+    }
+    require(mismatches * 1000 <= numPairs, fmt::format("{} type mismatches", mismatches));
+    require(seenTypes == 0x7f, "every point-triangle type is exercised");
+
+    /// distances only, fewer pairs than ids
+    Vector<int> types2{1};
+    Vector<float> dist2s2{1};
+    pt_distance_batch(pol, xs, tris, pointIds, triIds, 17, types2, dist2s2);
+    for (size_t i = 0; i != 17; ++i) require(dist2s2.getVal(i) == ds[i], "distance only pass");
+
+    bool thrown = false;
+    try {
+      pt_distance_batch(pol, xs, tris, pointIds, triIds, numPairs + 1, types2, dist2s2);
+    } catch (const std::runtime_error &) {
+      thrown = true;
+    }
+    require(thrown, "missing candidate ids rejected");
+  }
+
+  void check_ee() {
+    using namespace zs;
+    auto pol = preferred_host_policy();
+    const size_t numPairs = 4003;
+    const auto scene = make_scene(300, numPairs, true, 9);
+    const auto xs = to_vector(scene.xs);
+    const auto edges = to_vector(scene.edges);
+    const auto eaIds = to_vector(scene.idsA), ebIds = to_vector(scene.idsB);
+    Vector<int> types{1};
+    Vector<float> dist2s{1};
+    Vector<grad_t> grads{1};
+    Vector<hess_t> hessians{1};
+    ee_distance_batch(pol, xs, edges, eaIds, ebIds, numPairs, types, dist2s, &grads, &hessians);
+    const auto ts = to_std(types, numPairs);
+    const auto ds = to_std(dist2s, numPairs);
+    const auto gs = to_std(grads, numPairs);
+    const auto hs = to_std(hessians, numPairs);
+
+    size_t mismatches = 0;
+    int seenTypes = 0;
+    for (size_t i = 0; i != numPairs; ++i) {
+      const auto &ea = scene.edges[scene.idsA[i]], &eb = scene.edges[scene.idsB[i]];
+      const auto ref
+          = reference_ee(scene.xs[ea[0]], scene.xs[ea[1]], scene.xs[eb[0]], scene.xs[eb[1]]);
+      const auto tag = fmt::format("edge-edge pair {}", i);
+      require(std::abs(ds[i] - ref.dist2) <= 1e-4f * std::max(1e-2f, ref.dist2),
+              "squared distance, " + tag);
+      if (ts[i] != ref.type) {
+        ++mismatches;
+        continue;
+      }
+      seenTypes |= 1 << ts[i];
+      require(close(gs[i], ref.grad, 1e-3f), "gradient, " + tag);
+      require(close(hs[i], ref.hess, 1e-2f), "hessian, " + tag);
+    }
+    require(mismatches * 1000 <= numPairs, fmt::format("{} type mismatches", mismatches));
+    require(seenTypes == 0x1ff, "every edge-edge type is exercised");
+  }
+
+  void check_accd() {
+    using namespace zs;
+    auto pol = preferred_host_policy();
+    const size_t numPairs = 2000;
+    const float eta = 0.1f, thickness = 1e-3f;
+    for (bool edgeEdge : {false, true}) {
+      const auto scene = make_scene(300, numPairs, edgeEdge, edgeEdge ? 13 : 17);
+      const auto xs = to_vector(scene.xs), dxs = to_vector(scene.dxs);
+      const auto idsA = to_vector(scene.idsA), idsB = to_vector(scene.idsB);
+      Vector<float> tois{1};
+      if (edgeEdge)
+        ee_accd_batch(pol, xs, dxs, to_vector(scene.edges), idsA, idsB, numPairs, tois, eta,
+                      thickness);
+      else
+        pt_accd_batch(pol, xs, dxs, to_vector(scene.tris), idsA, idsB, numPairs, tois, eta,
+                      thickness);
+
+      size_t numHits = 0;
+      for (size_t i = 0; i != numPairs; ++i) {
+        int vs[4];
+        if (edgeEdge) {
+          const auto &ea = scene.edges[scene.idsA[i]], &eb = scene.edges[scene.idsB[i]];
+          vs[0] = ea[0], vs[1] = ea[1], vs[2] = eb[0], vs[3] = eb[1];
+        } else {
+          const auto &t = scene.tris[scene.idsB[i]];
+          vs[0] = scene.idsA[i], vs[1] = t[0], vs[2] = t[1], vs[3] = t[2];
+        }
+        vec3 x[4], dx[4];
+        for (int v = 0; v != 4; ++v) x[v] = scene.xs[vs[v]], dx[v] = scene.dxs[vs[v]];
+        const auto dist2Of = [edgeEdge](const vec3(&y)[4]) {
+          return edgeEdge ? dist2_ee_unclassified(y[0], y[1], y[2], y[3])
+                          : dist2_pt_unclassified(y[0], y[1], y[2], y[3]);
+        };
+        vec3 x0[4];
+        for (int v = 0; v != 4; ++v) x0[v] = x[v];
+        const float ref = edgeEdge ? reference_accd<2>(x, dx, dist2Of, eta, thickness)
+                                   : reference_accd<1>(x, dx, dist2Of, eta, thickness);
+        const float toi = tois.getVal(i);
+        const auto tag = fmt::format("{} pair {}", edgeEdge ? "edge-edge" : "point-triangle", i);
+        require(std::abs(toi - ref) <= 1e-2f * std::max(ref, 1e-2f), "time of impact, " + tag);
+        /// no contact closer than the thickness before the reported time
+        if (dist2Of(x0) > thickness * thickness)
+          for (int step = 1; step <= 8; ++step) {
+            const float t = toi * step / 8;
+            vec3 y[4];
+            for (int v = 0; v != 4; ++v) y[v] = x0[v] + t * scene.dxs[vs[v]];
+            require(dist2Of(y) > thickness * thickness * 0.99f, "conservative step, " + tag);
+          }
+        if (toi < 1.f) ++numHits;
+      }
+      require(numHits > numPairs / 50, "some pairs collide");
+    }
+  }
+
+}  // namespace
+
+int main() {
+  try {
+    check_pt();
+    check_ee();
+    check_accd();
+    fmt::print("distance batch checks passed\n");
+    return 0;
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return 1;
+  }
+}
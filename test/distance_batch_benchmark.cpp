@@ -0,0 +1,147 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/geometry/DistanceBatch.hpp"
+
+namespace {
+
+  using clock_t = std::chrono::steady_clock;
+  using vec3 = zs::vec<float, 3>;
+  using grad_t = zs::vec<float, 12>;
+  using hess_t = zs::vec<float, 12, 12>;
+
+  template <typename F> double time_ms(F &&f) {
+    f();  // warm up
+    const int reps = 5;
+    const auto start = clock_t::now();
+    for (int r = 0; r != reps; ++r) f();
+    return std::chrono::duration<double, std::milli>(clock_t::now() - start).count() / reps;
+  }
+
+  template <typename T> zs::Vector<T> to_vector(const std::vector<T> &vs) {
+    zs::Vector<T> ret{vs.size()};
+    std::copy(vs.begin(), vs.end(), ret.begin());
+    return ret;
+  }
+
+  template <typename G> void scatter(grad_t &grad, const G &g, const int (&slots)[4], int n) {
+    grad = grad_t::zeros();
+    for (int i = 0; i != n * 3; ++i) grad.val(slots[i / 3] * 3 + i % 3) = g.val(i);
+  }
+  template <typename H> void scatter(hess_t &hess, const H &h, const int (&slots)[4], int n) {
+    hess = hess_t::zeros();
+    for (int i = 0; i != n * 3; ++i)
+      for (int j = 0; j != n * 3; ++j)
+        hess(slots[i / 3] * 3 + i % 3, slots[j / 3] * 3 + j % 3) = h(i, j);
+  }
+
+  /// the per-pair path: classify, then evaluate the sub-primitive with the scalar functions
+  void scalar_pt(const vec3 *xs, const int (&vs)[4], int &type, float &dist2, grad_t *grad,
+                 hess_t *hess) {
+    using namespace zs;
+    const auto &p = xs[vs[0]], &t0 = xs[vs[1]], &t1 = xs[vs[2]], &t2 = xs[vs[3]];
+    type = pt_distance_type(p, t0, t1, t2);
+    dist2 = dist2_pt_unclassified(p, t0, t1, t2);
+    if (!grad) return;
+    const vec3 ts[3] = {t0, t1, t2};
+    if (type < 3) {
+      const int slots[4] = {0, type + 1};
+      scatter(*grad, dist_grad_pp(p, ts[type]), slots, 2);
+      if (hess) scatter(*hess, dist_hess_pp(p, ts[type]), slots, 2);
+    } else if (type < 6) {
+      const int k = type - 3;
+      const int slots[4] = {0, k + 1, (k + 1) % 3 + 1};
+      scatter(*grad, dist_grad_pe(p, ts[k], ts[(k + 1) % 3]), slots, 3);
+      if (hess) scatter(*hess, dist_hess_pe(p, ts[k], ts[(k + 1) % 3]), slots, 3);
+    } else {
+      const int slots[4] = {0, 1, 2, 3};
+      scatter(*grad, dist_grad_pt(p, t0, t1, t2), slots, 4);
+      if (hess) scatter(*hess, dist_hess_pt(p, t0, t1, t2), slots, 4);
+    }
+  }
+
+}  // namespace
+
+int main() {
+  using namespace zs;
+  auto pol = preferred_host_policy();
+  const size_t numVerts = 20000, numPairs = 200000;
+  std::mt19937 rng{1};
+  std::uniform_real_distribution<float> dist{0.f, 1.f}, disp{-0.05f, 0.05f};
+  std::uniform_int_distribution<int> vid{0, (int)numVerts - 1};
+  std::vector<vec3> xs(numVerts), dxs(numVerts);
+  for (auto &x : xs) x = vec3{dist(rng), dist(rng), dist(rng)};
+  for (auto &dx : dxs) dx = vec3{disp(rng), disp(rng), disp(rng)};
+  std::vector<vec<int, 3>> tris(numVerts);
+  std::vector<vec<int, 2>> edges(numVerts);
+  for (int i = 0; i != (int)numVerts; ++i) {
+    tris[i] = vec<int, 3>{i, (i + 1) % (int)numVerts, (i + 7) % (int)numVerts};
+    edges[i] = vec<int, 2>{i, (i + 3) % (int)numVerts};
+  }
+  std::vector<int> idsA(numPairs), idsB(numPairs);
+  for (size_t i = 0; i != numPairs; ++i) {
+    idsA[i] = vid(rng);
+    do {
+      idsB[i] = vid(rng);
+    } while (idsB[i] == idsA[i] || idsB[i] == (idsA[i] + 3) % (int)numVerts);
+  }
+
+  auto xsv = to_vector(xs), dxsv = to_vector(dxs);
+  auto trisv = to_vector(tris);
+  auto edgesv = to_vector(edges);
+  auto idsAv = to_vector(idsA), idsBv = to_vector(idsB);
+  Vector<int> types{numPairs};
+  Vector<float> dist2s{numPairs}, tois{numPairs};
+  Vector<grad_t> grads{numPairs};
+  Vector<hess_t> hessians{numPairs};
+
+  std::vector<int> sTypes(numPairs);
+  std::vector<float> sDist2s(numPairs);
+  std::vector<grad_t> sGrads(numPairs);
+  std::vector<hess_t> sHessians(numPairs);
+  const auto scalarPt = [&](bool withGrad, bool withHess) {
+    pol(range(numPairs), [&](size_t i) {
+      const auto &t = tris[idsB[i]];
+      const int vs[4] = {idsA[i], t[0], t[1], t[2]};
+      scalar_pt(xs.data(), vs, sTypes[i], sDist2s[i], withGrad ? &sGrads[i] : nullptr,
+                withHess ? &sHessians[i] : nullptr);
+    });
+  };
+  const auto scalarEe = [&]() {
+    pol(range(numPairs), [&](size_t i) {
+      const auto &ea = edges[idsA[i]], &eb = edges[idsB[i]];
+      const auto &a0 = xs[ea[0]], &a1 = xs[ea[1]], &b0 = xs[eb[0]], &b1 = xs[eb[1]];
+      sTypes[i] = ee_distance_type(a0, a1, b0, b1);
+      sDist2s[i] = dist2_ee_unclassified(a0, a1, b0, b1);
+    });
+  };
+
+  std::printf("%zu pairs, %d float lanes\n", numPairs, math::detail::native_float_lanes);
+  std::printf("%-28s %12s %12s %9s\n", "kernel", "scalar(ms)", "batched(ms)", "speedup");
+  const auto report = [](const char *name, double scalar, double batched) {
+    std::printf("%-28s %12.2f %12.2f %8.2fx\n", name, scalar, batched, scalar / batched);
+  };
+  report("pt dist2 + type", time_ms([&] { scalarPt(false, false); }), time_ms([&] {
+           pt_distance_batch(pol, xsv, trisv, idsAv, idsBv, numPairs, types, dist2s);
+         }));
+  report("pt dist2 + gradient", time_ms([&] { scalarPt(true, false); }), time_ms([&] {
+           pt_distance_batch(pol, xsv, trisv, idsAv, idsBv, numPairs, types, dist2s, &grads);
+         }));
+  report("pt dist2 + gradient + hessian", time_ms([&] { scalarPt(true, true); }), time_ms([&] {
+           pt_distance_batch(pol, xsv, trisv, idsAv, idsBv, numPairs, types, dist2s, &grads,
+                             &hessians);
+         }));
+  report("ee dist2 + type", time_ms(scalarEe), time_ms([&] {
+           ee_distance_batch(pol, xsv, edgesv, idsAv, idsBv, numPairs, types, dist2s);
+         }));
+  std::printf("%-28s %12s %12.2f\n", "pt accd", "-", time_ms([&] {
+                pt_accd_batch(pol, xsv, dxsv, trisv, idsAv, idsBv, numPairs, tois);
+              }));
+  std::printf("%-28s %12s %12.2f\n", "ee accd", "-", time_ms([&] {
+                ee_accd_batch(pol, xsv, dxsv, edgesv, idsAv, idsBv, numPairs, tois);
+              }));
+  return 0;
+}
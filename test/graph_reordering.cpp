@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/container/TileVector.hpp"
+#include "zensim/graph/Reordering.hpp"
+
+namespace {
+
+  template <typename SpMat> int bandwidth(const SpMat &spmat) {
+    int bw = 0;
+    for (int i = 0; i != (int)spmat.outerSize(); ++i)
+      for (auto k = spmat._ptrs[i]; k != spmat._ptrs[i + 1]; ++k)
+        bw = std::max(bw, std::abs(i - (int)spmat._inds[k]));
+    return bw;
+  }
+
+  template <typename PermT> bool is_permutation(const PermT &perm, int n) {
+    std::vector<int> cnts(n, 0);
+    for (int i = 0; i != n; ++i) {
+      int v = perm[i];
+      if (v < 0 || v >= n || cnts[v]++) return false;
+    }
+    return true;
+  }
+
+}  // namespace
+
+int main() {
+  using namespace zs;
+  auto pol = preferred_host_policy();
+
+  /// randomly numbered 2d grid (two disconnected patches)
+  constexpr int nx = 40, ny = 30, n = nx * ny * 2;
+  std::vector<int> shuffle(n);
+  for (int i = 0; i != n; ++i) shuffle[i] = i;
+  std::shuffle(shuffle.begin(), shuffle.end(), std::mt19937{0});
+  std::vector<int> is, js;
+  std::vector<float> vs;
+  for (int p = 0; p != 2; ++p)
+    for (int x = 0; x != nx; ++x)
+      for (int y = 0; y != ny; ++y) {
+        int v = p * nx * ny + x * ny + y;
+        auto connect = [&](int u) {
+          is.push_back(shuffle[v]);
+          js.push_back(shuffle[u]);
+          vs.push_back((float)(v * n + u));
+        };
+        connect(v);
+        if (x > 0) connect(v - ny);
+        if (x + 1 < nx) connect(v + ny);
+        if (y > 0) connect(v - 1);
+        if (y + 1 < ny) connect(v + 1);
+      }
+  SparseMatrix<float, true, int, int> spmat{n, n};
+  spmat.build(pol, n, n, is, js, vs);
+  spmat.localOrdering(pol);
+  const int bw = bandwidth(spmat);
+
+  /// rcm
+  Vector<int> perm{(size_t)n};
+  reverse_cuthill_mckee(pol, spmat, perm);
+  if (!is_permutation(perm, n)) throw std::runtime_error("rcm does not produce a permutation");
+  auto rcmMat = symmetric_permute(pol, spmat, perm);
+  if (rcmMat.nnz() != spmat.nnz()) throw std::runtime_error("symmetric_permute lost entries");
+  if (bandwidth(rcmMat) > std::min(nx, ny) + 1 || bandwidth(rcmMat) >= bw)
+    throw std::runtime_error("rcm fails to reduce the bandwidth");
+  {
+    auto ov = view<execspace_e::host>(spmat);
+    for (int i = 0; i != n; ++i)
+      for (auto k = rcmMat._ptrs[i]; k != rcmMat._ptrs[i + 1]; ++k)
+        if (rcmMat._vals[k] != ov(perm[i], perm[rcmMat._inds[k]]))
+          throw std::runtime_error("symmetric_permute value mismatch");
+  }
+
+  /// nested dissection
+  Vector<int> ndPerm{(size_t)n};
+  nested_dissection(pol, spmat, ndPerm, 16);
+  if (!is_permutation(ndPerm, n))
+    throw std::runtime_error("nested dissection does not produce a permutation");
+
+  /// dof arrays
+  TileVector<float, 32> dofs{{{"x", 3}, {"m", 1}}, (size_t)n};
+  {
+    auto dv = view<execspace_e::host>(dofs);
+    for (int i = 0; i != n; ++i) dv(0, i) = dv(3, i) = (float)i;
+  }
+  dofs.reorder(pol, perm);
+  {
+    auto dv = view<execspace_e::host>(dofs);
+    for (int i = 0; i != n; ++i)
+      if (dv(0, i) != (float)perm[i] || dv(3, i) != (float)perm[i])
+        throw std::runtime_error("tilevector reorder mismatch");
+  }
+  return 0;
+}
@@ -0,0 +1,94 @@
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/execution/AsyncScheduler.hpp"
+#include "zensim/execution/ExecutionGraph.hpp"
+#include "zensim/profile/KernelProfiler.hpp"
+
+namespace {
+
+  void require(bool cond, const char *msg) {
+    if (!cond) throw std::runtime_error(std::string("kernel profiler check failed: ") + msg);
+  }
+  const zs::ProfileRecord *find_record(const std::vector<zs::ProfileRecord> &records,
+                                       const std::string &category, const std::string &name) {
+    for (const auto &r : records)
+      if (category == r.category && r.name.find(name) != std::string::npos) return &r;
+    return nullptr;
+  }
+
+}  // namespace
+
+int main() {
+  using namespace zs;
+  auto &profiler = KernelProfiler::instance();
+  auto pol = preferred_host_policy().profile(true);
+  std::vector<double> vals(1 << 16, 1.);
+
+  /// policy launches, two sites
+  for (int iter = 0; iter != 10; ++iter) {
+    pol(range(vals.size()), [&vals](size_t i) { vals[i] *= 1.0001; });
+    if (iter % 2 == 0) pol(range(vals.size()), [&vals](size_t i) { vals[i] += 1; });
+  }
+  {
+    auto records = profiler.aggregate();
+    require(records.size() == 2, "one record per launch site");
+    u64 counts[2] = {records[0].count, records[1].count};
+    require((counts[0] == 10 && counts[1] == 5) || (counts[0] == 5 && counts[1] == 10),
+            "launch counts");
+    for (const auto &r : records)
+      require(r.min <= r.p50 && r.p50 <= r.p99 && r.p99 <= r.max && r.total >= r.max,
+              "ordered statistics");
+  }
+  /// profiling switched off upon the policy
+  pol.profile(false);
+  pol(range(vals.size()), [&vals](size_t i) { vals[i] -= 1; });
+  require(profiler.events().size() == 15, "no events without profiling");
+
+  /// scheduler tasks and graph passes
+  profiler.enable(true);
+  {
+    AsyncScheduler scheduler{2};
+    for (int i = 0; i != 8; ++i) scheduler.enqueue([] {});
+    scheduler.wait();
+  }
+  ExecutionGraph graph;
+  auto buf = graph.importResource({"buf", 1 << 10});
+  graph.addPass("produce", {{buf, AccessMode::write, AccessDomain::host_sequential}},
+                [](AsyncExecutionContext &) {});
+  graph.addPass("consume", {{buf, AccessMode::read, AccessDomain::host_sequential}},
+                [](AsyncExecutionContext &) {});
+  auto compiled = graph.compile();
+  for (int i = 0; i != 3; ++i) graph.executeInline(compiled);
+  profiler.enable(false);
+
+  auto records = profiler.aggregate();
+  auto tasks = find_record(records, "AsyncScheduler", "task");
+  require(tasks && tasks->count == 8, "scheduler tasks");
+  auto produce = find_record(records, "ExecutionGraph", "produce");
+  auto consume = find_record(records, "ExecutionGraph", "consume");
+  require(produce && produce->count == 3 && consume && consume->count == 3, "graph passes");
+
+  /// chrome trace export
+  auto trace = profiler.chromeTrace();
+  require(trace.rfind("{\"displayTimeUnit\"", 0) == 0, "trace header");
+  require(trace.find("\"name\":\"produce\",\"cat\":\"ExecutionGraph\",\"ph\":\"X\"")
+              != std::string::npos,
+          "trace pass event");
+  size_t numEvents = 0;
+  for (auto p = trace.find("\"ph\":\"X\""); p != std::string::npos;
+       p = trace.find("\"ph\":\"X\"", p + 1))
+    ++numEvents;
+  require(numEvents == profiler.events().size() && numEvents == 15 + 8 + 6, "trace event count");
+  profiler.report();
+
+  profiler.clear();
+  require(profiler.events().empty() && profiler.aggregate().empty(), "clear");
+  pol.profile(true);
+  pol(range(vals.size()), [&vals](size_t i) { vals[i] += 1; });
+  require(profiler.events().size() == 1, "recording after clear");
+  return 0;
+}
@@ -0,0 +1,133 @@
+#include <cmath>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/math/linear/AlgebraicMultigrid.hpp"
+#include "zensim/math/linear/ConjugateGradient.hpp"
+
+namespace {
+
+  double norm(const std::vector<double> &v) {
+    double s = 0;
+    for (auto e : v) s += e * e;
+    return std::sqrt(s);
+  }
+
+}  // namespace
+
+int main() {
+  using namespace zs;
+  auto pol = preferred_host_policy();
+
+  /// 2d poisson (dirichlet)
+  constexpr int nx = 96, ny = 80, n = nx * ny;
+  std::vector<int> is, js;
+  std::vector<double> vs;
+  for (int x = 0; x != nx; ++x)
+    for (int y = 0; y != ny; ++y) {
+      int v = x * ny + y;
+      auto connect = [&](int u, double val) {
+        is.push_back(v);
+        js.push_back(u);
+        vs.push_back(val);
+      };
+      connect(v, 4);
+      if (x > 0) connect(v - ny, -1);
+      if (x + 1 < nx) connect(v + ny, -1);
+      if (y > 0) connect(v - 1, -1);
+      if (y + 1 < ny) connect(v + 1, -1);
+    }
+  SparseMatrix<double, true, int, int> A{n, n};
+  A.build(pol, n, n, is, js, vs);
+  A.localOrdering(pol);
+
+  SmoothedAggregationAmg<double, int, int> amg{};
+  amg.build(pol, A);
+  if (amg.numLevels() < 2) throw std::runtime_error("amg hierarchy is not built");
+  if (amg.operatorComplexity() > 2.0) throw std::runtime_error("amg operator complexity too high");
+
+  /// amg as a stationary iteration
+  std::vector<double> b(n, 1.0), x(n, 0.0), r(n), z(n);
+  auto residual = [&]() {
+    spmv(pol, A, x, r);
+    for (int i = 0; i != n; ++i) r[i] = b[i] - r[i];
+    return norm(r);
+  };
+  double r0 = residual(), rk = r0;
+  for (int k = 0; k != 10; ++k) {
+    amg.apply(pol, r, z);
+    for (int i = 0; i != n; ++i) x[i] += z[i];
+    rk = residual();
+  }
+  if (rk > r0 * 1e-2) throw std::runtime_error("amg v-cycle fails to converge");
+
+  /// preconditioned cg
+  auto pcg = [&](auto &&precond) {
+    std::fill(x.begin(), x.end(), 0.0);
+    std::vector<double> p(n), q(n);
+    residual();
+    precond.apply(pol, r, z);
+    p = z;
+    double rz = 0;
+    for (int i = 0; i != n; ++i) rz += r[i] * z[i];
+    int iter = 0;
+    for (; iter != 1000 && norm(r) > r0 * 1e-8; ++iter) {
+      spmv(pol, A, p, q);
+      double pq = 0;
+      for (int i = 0; i != n; ++i) pq += p[i] * q[i];
+      double alpha = rz / pq;
+      for (int i = 0; i != n; ++i) {
+        x[i] += alpha * p[i];
+        r[i] -= alpha * q[i];
+      }
+      precond.apply(pol, r, z);
+      double rzNew = 0;
+      for (int i = 0; i != n; ++i) rzNew += r[i] * z[i];
+      for (int i = 0; i != n; ++i) p[i] = z[i] + rzNew / rz * p[i];
+      rz = rzNew;
+    }
+    if (residual() > r0 * 1e-6) throw std::runtime_error("pcg fails to converge");
+    return iter;
+  };
+  if (pcg(amg) > 20) throw std::runtime_error("amg preconditioned cg converges too slowly");
+
+  /// multicolor symmetric gauss-seidel
+  MulticolorGaussSeidel<double, int, int> sgs{};
+  sgs.build(pol, A);
+  if (sgs.numColors() < 2) throw std::runtime_error("multicolor gauss-seidel coloring failed");
+  for (int c = 0; c != sgs.numColors(); ++c)
+    for (auto k = sgs.colorOffsets[c]; k != sgs.colorOffsets[c + 1]; ++k) {
+      int row = sgs.rowIds[k];
+      for (auto i = A._ptrs[row]; i != A._ptrs[row + 1]; ++i) {
+        int col = A._inds[i];
+        if (col == row) continue;
+        for (auto l = sgs.colorOffsets[c]; l != sgs.colorOffsets[c + 1]; ++l)
+          if (sgs.rowIds[l] == col) throw std::runtime_error("coupled rows share a color");
+      }
+    }
+  auto sgsIters = pcg(sgs);
+  if (sgsIters > 200) throw std::runtime_error("ssor preconditioned cg converges too slowly");
+
+  amg.smoother = amg_smoother_e::multicolor_gauss_seidel;
+  amg.build(pol, A);
+  if (pcg(amg) > 25)
+    throw std::runtime_error("amg (gauss-seidel) preconditioned cg converges too slowly");
+
+  /// the library cg driven through the preconditioned system adapter
+  {
+    constexpr auto space = RM_REF_T(pol)::exec_tag::value;
+    Vector<double> xs{(size_t)n}, bs{(size_t)n};
+    xs.reset(0);
+    for (int i = 0; i != n; ++i) bs.setVal(1.0, i);
+    PreconditionedSparseSystem system{A, amg};
+    ConjugateGradient<double, 1, int> cg{};
+    cg.tol = 1e-10;
+    auto iters = cg.solve(pol, system, dof_view<space, 1>(xs), dof_view<space, 1>(bs));
+    for (int i = 0; i != n; ++i) x[i] = xs.getVal(i);
+    std::fill(b.begin(), b.end(), 1.0);
+    if (residual() > r0 * 1e-6)
+      throw std::runtime_error("ConjugateGradient with amg fails to converge");
+    if (iters > 25) throw std::runtime_error("ConjugateGradient with amg converges too slowly");
+  }
+  return 0;
+}
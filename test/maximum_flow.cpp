@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/graph/MaximumFlow.hpp"
+#include "zensim/math/matrix/SparseMatrix.hpp"
+#include "zensim/zpc_tpls/fmt/core.h"
+
+namespace {
+
+  void require(bool cond, const std::string &msg) {
+    if (!cond) throw std::runtime_error("maximum flow check failed: " + msg);
+  }
+
+  /// directed capacities, the reverse of every edge is present (possibly with zero capacity)
+  template <typename T> struct network_t {
+    int n, source, sink;
+    std::map<std::pair<int, int>, T> caps;
+
+    void connect(int u, int v, T c) {
+      if (u == v) return;
+      caps[{u, v}] += c;
+      caps[{v, u}] += 0;
+    }
+  };
+
+  /// image-segmentation like grid: 4-neighborhood edges, terminal links to a few pixels
+  template <typename T> network_t<T> make_grid(int w, int h, unsigned seed) {
+    std::mt19937 rng{seed};
+    std::uniform_int_distribution<int> cap{1, 20};
+    network_t<T> g{w * h + 2, w * h, w * h + 1, {}};
+    for (int y = 0; y != h; ++y)
+      for (int x = 0; x != w; ++x) {
+        const int v = y * w + x;
+        if (x + 1 < w) g.connect(v, v + 1, (T)cap(rng)), g.connect(v + 1, v, (T)cap(rng));
+        if (y + 1 < h) g.connect(v, v + w, (T)cap(rng)), g.connect(v + w, v, (T)cap(rng));
+        const auto r = rng() % 8;
+        if (r == 0) g.connect(g.source, v, (T)(cap(rng) * 4));
+        if (r == 1) g.connect(v, g.sink, (T)(cap(rng) * 4));
+      }
+    return g;
+  }
+
+  /// sparse random digraph, with vertices unreachable from the source or not reaching the sink
+  template <typename T> network_t<T> make_random(int n, int m, unsigned seed) {
+    std::mt19937 rng{seed};
+    std::uniform_int_distribution<int> vid{0, n - 1}, cap{0, 100};
+    network_t<T> g{n, 0, n - 1, {}};
+    for (int e = 0; e != m; ++e) g.connect(vid(rng), vid(rng), (T)cap(rng));
+    return g;
+  }
+
+  /// sequential reference (edmonds-karp)
+  template <typename T> double reference_flow(const network_t<T> &g) {
+    std::vector<std::vector<int>> adj(g.n);
+    std::map<std::pair<int, int>, double> res;
+    for (const auto &[e, c] : g.caps) adj[e.first].push_back(e.second), res[e] = c;
+    double flow = 0;
+    while (true) {
+      std::vector<int> parents(g.n, -1);
+      parents[g.source] = g.source;
+      std::queue<int> q;
+      q.push(g.source);
+      while (!q.empty() && parents[g.sink] < 0) {
+        const int u = q.front();
+        q.pop();
+        for (int v : adj[u])
+          if (parents[v] < 0 && res[{u, v}] > 0) parents[v] = u, q.push(v);
+      }
+      if (parents[g.sink] < 0) break;
+      double bottleneck = 1e30;
+      for (int v = g.sink; v != g.source; v = parents[v])
+        bottleneck = std::min(bottleneck, res[{parents[v], v}]);
+      for (int v = g.sink; v != g.source; v = parents[v])
+        res[{parents[v], v}] -= bottleneck, res[{v, parents[v]}] += bottleneck;
+      flow += bottleneck;
+    }
+    return flow;
+  }
+
+  template <typename T> void check_network(const network_t<T> &g, const std::string &tag) {
+    using namespace zs;
+    auto pol = preferred_host_policy();
+    std::vector<int> is, js;
+    std::vector<T> vs;
+    for (const auto &[e, c] : g.caps)
+      is.push_back(e.first), js.push_back(e.second), vs.push_back(c);
+    SparseMatrix<T, true, int, int> spmat{g.n, g.n};
+    spmat.build(pol, g.n, g.n, is, js, vs);
+    spmat.localOrdering(pol);
+    auto original = spmat._vals.clone({memsrc_e::host, -1});
+
+    T flow{};
+    Vector<int> cut{(size_t)g.n};
+    maximum_flow(pol, g.source, g.sink, spmat, flow, cut);
+
+    const double ref = reference_flow(g);
+    const double tol = std::is_floating_point_v<T> ? 1e-4 * std::max(ref, 1.) : 0;
+    require(std::abs((double)flow - ref) <= tol,
+            fmt::format("flow value {} vs reference {}, {}", (double)flow, ref, tag));
+
+    /// residuals form a feasible flow of the computed value
+    auto ptrs = spmat._ptrs.clone({memsrc_e::host, -1});
+    auto inds = spmat._inds.clone({memsrc_e::host, -1});
+    auto residuals = spmat._vals.clone({memsrc_e::host, -1});
+    for (int v = 0; v != g.n; ++v) {
+      double net = 0;
+      for (auto j = ptrs[v]; j != ptrs[v + 1]; ++j) {
+        require(residuals[j] >= -tol, "non-negative residual capacities, " + tag);
+        net += (double)original[j] - (double)residuals[j];
+      }
+      /// each edge and its reverse carry opposite flows, the net outflow is the total flow
+      const double expected = v == g.source ? ref : v == g.sink ? -ref : 0;
+      require(std::abs(net - expected) <= tol * 2,
+              fmt::format("flow conservation at {} ({} vs {}), {}", v, net, expected, tag));
+    }
+
+    /// the source side of the cut, its outgoing capacity equals the flow
+    require(cut.getVal(g.source) == 1 && cut.getVal(g.sink) == 0,
+            "cut separates terminals, " + tag);
+    double cutCapacity = 0;
+    for (int v = 0; v != g.n; ++v) {
+      if (!cut.getVal(v)) continue;
+      for (auto j = ptrs[v]; j != ptrs[v + 1]; ++j)
+        if (!cut.getVal(inds[j])) {
+          cutCapacity += original[j];
+          require(residuals[j] <= tol, "cut edges are saturated, " + tag);
+        }
+    }
+    require(std::abs(cutCapacity - ref) <= tol * 2,
+            fmt::format("cut capacity {} vs flow {}, {}", cutCapacity, ref, tag));
+  }
+
+}  // namespace
+
+int main() {
+  try {
+    check_network(make_random<int>(2, 1, 1), "trivial");
+    check_network(make_random<int>(200, 800, 2), "random digraph");
+    check_network(make_random<float>(2000, 12000, 3), "random digraph (float)");
+    check_network(make_grid<int>(64, 48, 4), "grid");
+    check_network(make_grid<double>(150, 100, 5), "grid (double)");
+
+    bool threw = false;
+    try {
+      using namespace zs;
+      auto pol = preferred_host_policy();
+      std::vector<int> is{0}, js{1};
+      std::vector<float> vs{1.f};
+      SparseMatrix<float, true, int, int> spmat{2, 2};
+      spmat.build(pol, 2, 2, is, js, vs);
+      float flow = 0;
+      maximum_flow(pol, 0, 1, spmat, flow);
+    } catch (const std::runtime_error &) {
+      threw = true;
+    }
+    require(threw, "asymmetric sparsity pattern is rejected");
+
+    fmt::print("maximum flow checks passed\n");
+    return 0;
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return 1;
+  }
+}
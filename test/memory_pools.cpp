@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "zensim/memory/Allocator.h"
+#include "zensim/resource/Resource.h"
+
+namespace {
+
+  void require(bool cond, const char *msg) {
+    if (!cond) throw std::runtime_error(std::string("memory pool check failed: ") + msg);
+  }
+
+}  // namespace
+
+int main() {
+  using namespace zs;
+
+  /// size classes
+  for (u32 cls = 1; cls != memory_pools::num_size_classes(); ++cls)
+    require(memory_pools::class_size(cls - 1) < memory_pools::class_size(cls), "ascending");
+  for (size_t bytes : {(size_t)1, (size_t)16, (size_t)17, (size_t)300, (size_t)5000,
+                       memory_pools::max_small_bytes})
+    for (size_t alignment : {(size_t)8, (size_t)64, (size_t)4096}) {
+      const auto cls = memory_pools::size_class(bytes, alignment);
+      require(cls < memory_pools::num_size_classes(), "small request pooled");
+      const auto size = memory_pools::class_size(cls);
+      require(size >= bytes && size % alignment == 0, "class fits the request");
+    }
+  require(memory_pools::size_class(memory_pools::max_small_bytes + 1, 8)
+              == memory_pools::num_size_classes(),
+          "huge request bypassed");
+
+  /// allocation, reuse and statistics
+  {
+    memory_pools pools{};
+    std::vector<std::pair<void *, size_t>> blocks;
+    std::mt19937 gen{3};
+    for (int i = 0; i != 4096; ++i) {
+      const size_t bytes = 1 + gen() % 2048;
+      auto p = static_cast<char *>(pools.allocate(bytes, 16));
+      require(p && (uintptr_t)p % 16 == 0, "aligned block");
+      std::memset(p, i & 0xff, bytes);
+      blocks.emplace_back(p, bytes);
+    }
+    std::sort(blocks.begin(), blocks.end());
+    for (size_t i = 1; i < blocks.size(); ++i)
+      require((char *)blocks[i - 1].first + blocks[i - 1].second <= blocks[i].first,
+              "disjoint blocks");
+    auto big = pools.allocate((size_t)1 << 20, 64);
+    auto stats = pools.stats();
+    require(stats.numAllocations == 4097 && stats.numBypasses == 1, "allocation counts");
+    require(stats.bytesInUse >= ((size_t)1 << 20) && stats.bytesReserved > 0, "byte counts");
+    pools.deallocate(big, (size_t)1 << 20, 64);
+    for (auto &[p, bytes] : blocks) pools.deallocate(p, bytes, 16);
+    stats = pools.stats();
+    require(stats.numDeallocations == 4097 && stats.bytesInUse == 0, "all released");
+
+    /// recycled without new chunks
+    const auto reserved = stats.bytesReserved;
+    for (int i = 0; i != 4; ++i) {
+      auto p = pools.allocate(100, 8);
+      pools.deallocate(p, 100, 8);
+    }
+    require(pools.stats().bytesReserved == reserved, "blocks recycled");
+    require(pools.stats().numCacheHits > 0, "thread cache hits");
+
+    /// cross-thread release
+    std::vector<void *> foreign(1000);
+    std::thread producer{[&] {
+      for (auto &p : foreign) p = pools.allocate(48, 16);
+    }};
+    producer.join();
+    for (auto p : foreign) pools.deallocate(p, 48, 16);
+    require(pools.stats().bytesInUse == 0, "released by another thread");
+
+    /// allocations from thread_local destructors that run after the thread's cache is gone
+    struct LateUser {
+      memory_pools *pools;
+      ~LateUser() {
+        auto p = pools->allocate(48, 16);
+        std::memset(p, 1, 48);
+        pools->deallocate(p, 48, 16);
+      }
+    };
+    const auto allocations = pools.stats().numAllocations;
+    std::thread exiting{[&] {
+      /// constructed before the thread's cache, thus destroyed after it
+      thread_local LateUser late{&pools};
+      pools.deallocate(pools.allocate(48, 16), 48, 16);
+    }};
+    exiting.join();
+    stats = pools.stats();
+    require(stats.numAllocations == allocations + 2 && stats.bytesInUse == 0,
+            "allocation after the thread cache is gone");
+  }
+
+  /// selectable through get_memory_source
+  {
+    auto allocator = get_memory_source(memsrc_e::host, (ProcID)-1, "POOLED");
+    const auto before = memory_pools::instance().stats().numAllocations;
+    auto p = allocator.allocate(200, 8);
+    auto copy = allocator;  // clones share the process-wide pools
+    copy.deallocate(p, 200, 8);
+    require(memory_pools::instance().stats().numAllocations == before + 1, "pooled source");
+  }
+
+  /// single-threaded power-of-two pools
+  {
+    static_memory_pools<4, 6, 8, 12> pools{};
+    auto a = pools.allocate(10, 8), b = pools.allocate(200, 256), c = pools.allocate(5000, 8);
+    require((uintptr_t)b % 256 == 0, "block aligned to its size");
+    pools.deallocate(a, 10, 8);
+    require(pools.allocate(16, 16) == a, "free list reuse");
+    pools.deallocate(a, 16, 16);
+    pools.deallocate(b, 200, 256);
+    pools.deallocate(c, 5000, 8);
+  }
+  return 0;
+}
@@ -0,0 +1,60 @@
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "zensim/memory/Allocator.h"
+
+namespace {
+
+  using clock_t = std::chrono::steady_clock;
+
+  /// many short-lived small blocks, interleaved as container metadata typically is
+  double bench(zs::mr_t &resource, size_t rounds, size_t live) {
+    std::vector<std::pair<void *, size_t>> blocks(live);
+    const auto start = clock_t::now();
+    for (size_t r = 0; r != rounds; ++r) {
+      for (size_t i = 0; i != live; ++i) {
+        const size_t bytes = 16 + ((i * 2654435761u + r) % 16) * 24;
+        blocks[i] = {resource.allocate(bytes, 16), bytes};
+      }
+      for (size_t i = 0; i != live; ++i) resource.deallocate(blocks[i].first, blocks[i].second, 16);
+    }
+    const auto end = clock_t::now();
+    const auto ms = std::chrono::duration<double, std::milli>(end - start).count();
+    return ms > 0.0 ? (double)(rounds * live) / 1.0e6 / (ms / 1000.0) : 0.0;
+  }
+
+  double bench_threads(zs::mr_t &resource, unsigned numThreads, size_t rounds, size_t live) {
+    std::vector<std::thread> threads;
+    std::vector<double> mops(numThreads);
+    for (unsigned t = 0; t != numThreads; ++t)
+      threads.emplace_back([&, t] { mops[t] = bench(resource, rounds, live); });
+    for (auto &th : threads) th.join();
+    double sum = 0.0;
+    for (auto v : mops) sum += v;
+    return sum;
+  }
+
+}  // namespace
+
+int main() {
+  using namespace zs;
+  auto &raw = raw_memory_resource<host_mem_tag>::instance();
+  auto &pools = memory_pools::instance();
+  const size_t rounds = 2000, live = 1000;
+  const unsigned hw = std::thread::hardware_concurrency();
+
+  std::printf("%-12s %8s %14s\n", "resource", "threads", "Mallocs/s");
+  for (unsigned numThreads : {1u, hw > 1 ? hw : 2u}) {
+    std::printf("%-12s %8u %14.2f\n", "raw", numThreads,
+                bench_threads(raw, numThreads, rounds, live));
+    std::printf("%-12s %8u %14.2f\n", "pooled", numThreads,
+                bench_threads(pools, numThreads, rounds, live));
+  }
+  const auto stats = pools.stats();
+  std::printf("pool: %llu allocations, %llu cache hits, %llu refills, %zu bytes reserved\n",
+              (unsigned long long)stats.numAllocations, (unsigned long long)stats.numCacheHits,
+              (unsigned long long)stats.numCentralRefills, stats.bytesReserved);
+  return 0;
+}
@@ -0,0 +1,544 @@
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/io/MeshIO.hpp"
+#include "zensim/zpc_tpls/fmt/core.h"
+
+namespace {
+
+  void require(bool cond, const std::string &msg) {
+    if (!cond) throw std::runtime_error("mesh io check failed: " + msg);
+  }
+
+  std::string temp_path(const std::string &name) {
+    return (std::filesystem::temp_directory_path() / ("zpc_mesh_io_" + name)).string();
+  }
+  std::string write_file(const std::string &name, const std::string &contents) {
+    const auto path = temp_path(name);
+    std::ofstream os(path, std::ios::binary);
+    os.write(contents.data(), (std::streamsize)contents.size());
+    return path;
+  }
+
+  /// appends [v] in the requested byte order
+  template <typename T> void put(std::string &buf, T v, bool bigEndian) {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &v, sizeof(T));
+    const unsigned short probe = 1;
+    const bool hostBig = *(const unsigned char *)&probe == 0;
+    for (size_t i = 0; i != sizeof(T); ++i)
+      buf.push_back((char)bytes[bigEndian != hostBig ? sizeof(T) - 1 - i : i]);
+  }
+
+  template <typename MeshT, typename NodeT, typename ElemT>
+  void check_mesh(const MeshT &mesh, const std::vector<NodeT> &nodes,
+                  const std::vector<ElemT> &elems, const std::string &tag) {
+    require(mesh.nodes.size() == nodes.size(), "node count, " + tag);
+    require(mesh.elems.size() == elems.size(), "element count, " + tag);
+    for (size_t i = 0; i != nodes.size(); ++i)
+      for (size_t d = 0; d != nodes[i].size(); ++d)
+        require(mesh.nodes[i][d] == nodes[i][d], fmt::format("node {}, {}", i, tag));
+    for (size_t e = 0; e != elems.size(); ++e)
+      for (size_t j = 0; j != elems[e].size(); ++j)
+        require(mesh.elems[e][j] == elems[e][j], fmt::format("element {}, {}", e, tag));
+  }
+
+  void check_real_parsing() {
+    using zs::detail::parse_real_text;
+    const auto same_as_strtod = [](const std::string &token) {
+      double v = -1;
+      const char *end = parse_real_text(token.data(), token.data() + token.size(), v);
+      const double ref = std::strtod(token.c_str(), nullptr);
+      require(end == token.data() + token.size(), "whole token consumed: " + token);
+      require(std::memcmp(&v, &ref, sizeof(double)) == 0 || (std::isnan(v) && std::isnan(ref)),
+              fmt::format("{} parsed as {:.17g}, strtod gives {:.17g}", token, v, ref));
+    };
+    for (const char *token :
+         {"0", "-0", "1", "+2.5", "-0.125", ".5", "5.", "1e5", "1E-5", "-3.25e+2",
+          "9007199254740993", "123456789012345678901234567890", "0.30000000000000004", "1e-320",
+          "1.7976931348623157e308", "4.9406564584124654e-324", "1e23",
+          "0.000000000000000000000000001", "nan", "-inf"})
+      same_as_strtod(token);
+    std::mt19937_64 rng{7};
+    std::uniform_real_distribution<double> mantissa{-1, 1};
+    std::uniform_int_distribution<int> exponent{-30, 30};
+    char buf[64];
+    for (int i = 0; i != 100000; ++i) {
+      const double v = std::ldexp(mantissa(rng), exponent(rng));
+      std::snprintf(buf, sizeof(buf), i % 3 == 0 ? "%.17g" : i % 3 == 1 ? "%.9g" : "%.6f", v);
+      same_as_strtod(buf);
+    }
+    double v = 0;
+    const char *none = "x1";
+    require(parse_real_text(none, none + 2, v) == nullptr, "non-numbers are rejected");
+  }
+
+  void check_obj() {
+    using namespace zs;
+    const std::string text
+        = "# comment\n"
+          "o quad\n"
+          "v 0 0 0\n"
+          "v 1 0 0\n"
+          "v 1 1 0\r\n"
+          "  v 0 1 0\n"
+          "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+          "vn 0 0 1\n"
+          "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+          "v 0 0 1.5e0 1 1 1\n"
+          "usemtl x\n"
+          "s off\n"
+          "f -4//-1 -3//-1 -1//-1";
+    const auto path = write_file("small.obj", text);
+    const std::vector<std::array<float, 3>> nodes{
+        {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0, 0, 1.5f}};
+    const std::vector<std::array<int, 3>> tris{{0, 1, 2}, {0, 2, 3}, {1, 2, 4}};
+    auto pol = preferred_host_policy();
+    for (size_t chunkBytes : {(size_t)1, (size_t)7, (size_t)64, detail::s_mesh_chunk_bytes}) {
+      const auto tag = fmt::format("small obj, {} byte chunks", chunkBytes);
+      Mesh<float, 3, int, 3> mesh;
+      require(read_mesh(pol, path, mesh, chunkBytes), "read " + tag);
+      check_mesh(mesh, nodes, tris, tag);
+      require(mesh.norms.size() == 5 && mesh.uvs.size() == 5, "attribute counts, " + tag);
+      for (int v = 0; v != 5; ++v)
+        require(mesh.norms[v] == (std::array<float, 3>{0, 0, 1}), "normals, " + tag);
+      require(mesh.uvs[2] == (std::array<float, 2>{1, 1})
+                  && mesh.uvs[3] == (std::array<float, 2>{0, 1})
+                  && mesh.uvs[4] == (std::array<float, 2>{0, 0}),
+              "uvs, " + tag);
+    }
+
+    /// legacy entry: appends, indices are offset by the existing positions
+    std::vector<std::array<float, 3>> pos{{9, 9, 9}}, nrm{{0, 0, 0}};
+    std::vector<std::array<float, 2>> uv{{0, 0}};
+    std::vector<std::array<u32, 3>> ids;
+    require(load_obj(path, &pos, &nrm, &uv, &ids), "load_obj");
+    require(pos.size() == 6 && nrm.size() == 6 && uv.size() == 6 && ids.size() == 3,
+            "load_obj sizes");
+    require(pos[5][2] == 1.5f && ids[2] == (std::array<u32, 3>{2, 3, 5}), "load_obj contents");
+
+    const auto bad = write_file("bad.obj", "v 0 0 0\nv 1 0 0\nf 1 2 3\n");
+    Mesh<float, 3, int, 3> mesh;
+    mesh.nodes.push_back({7, 7, 7});
+    require(!read_mesh(pol, bad, mesh), "missing vertex is an error");
+    require(mesh.nodes.size() == 1 && mesh.elems.empty(), "failed read leaves the mesh as is");
+    require(!read_mesh(pol, temp_path("missing.obj"), mesh), "missing file");
+
+    /// any whitespace separates corners, a malformed corner fails the read
+    const auto spaced = write_file("spaced.obj", "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2\v3\f\n");
+    Mesh<float, 3, int, 3> tri;
+    require(read_mesh(pol, spaced, tri), "vertical tab and form feed separate corners");
+    check_mesh(tri, std::vector<std::array<float, 3>>{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}},
+               std::vector<std::array<int, 3>>{{0, 1, 2}}, "spaced obj");
+    const auto malformed = write_file("malformed.obj", "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2\v\fx3\n");
+    require(!read_mesh(pol, malformed, mesh), "malformed face corner is an error");
+  }
+
+  /// a w x h grid of quads with noisy coordinates, read under varying chunk sizes
+  void check_large_obj() {
+    using namespace zs;
+    const int w = 300, h = 200;
+    std::mt19937 rng{3};
+    std::uniform_real_distribution<float> noise{-1e-3f, 1e-3f};
+    std::vector<std::array<float, 3>> nodes;
+    std::vector<std::array<int, 3>> tris;
+    std::string text;
+    char buf[128];
+    for (int y = 0; y != h; ++y)
+      for (int x = 0; x != w; ++x) {
+        std::array<float, 3> p{x * 0.1f + noise(rng), y * 0.1f + noise(rng), noise(rng) * 1e4f};
+        nodes.push_back(p);
+        std::snprintf(buf, sizeof(buf), "v %.9g %.9g %.9g\n", p[0], p[1], p[2]);
+        text += buf;
+      }
+    for (int y = 0; y + 1 != h; ++y)
+      for (int x = 0; x + 1 != w; ++x) {
+        const int v = y * w + x;
+        std::snprintf(buf, sizeof(buf), "f %d %d %d %d\n", v + 1, v + 2, v + w + 2, v + w + 1);
+        text += buf;
+        tris.push_back({v, v + 1, v + w + 1});
+        tris.push_back({v, v + w + 1, v + w});
+      }
+    const auto path = write_file("grid.obj", text);
+    auto pol = preferred_host_policy();
+    Mesh<float, 3, int, 3> reference;
+    require(read_mesh(pol, path, reference), "read grid");
+    check_mesh(reference, nodes, tris, "grid obj");
+    /// the file has no normals, they are computed from the triangles
+    for (auto &n : reference.norms)
+      require(std::abs(std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]) - 1) < 1e-4f,
+              "unit normals");
+    for (size_t chunkBytes : {(size_t)100, (size_t)4096}) {
+      Mesh<float, 3, int, 3> mesh;
+      require(read_mesh(pol, path, mesh, chunkBytes), "read grid in chunks");
+      check_mesh(mesh, nodes, tris, fmt::format("grid obj, {} byte chunks", chunkBytes));
+    }
+
+    /// tilevector destination
+    TileVector<float, 32> verts{{{"x", 3}, {"nrm", 3}}, 0}, elems{{{"inds", 3}}, 0};
+    require(read_mesh(pol, path, verts, elems), "read grid into tilevectors");
+    require(verts.size() == nodes.size() && elems.size() == tris.size(), "tilevector sizes");
+    const auto vs = proxy<execspace_e::host>({}, verts);
+    const auto es = proxy<execspace_e::host>({}, elems);
+    for (size_t i = 0; i < nodes.size(); i += 7)
+      for (int d = 0; d != 3; ++d) {
+        require(vs("x", d, i) == nodes[i][d], "tilevector positions");
+        /// the file has no normals
+        require(vs("nrm", d, i) == 0.f, "tilevector normals");
+      }
+    for (size_t e = 0; e < tris.size(); e += 5)
+      for (int j = 0; j != 3; ++j)
+        require(es("inds", j, e, wrapt<int>{}) == tris[e][j], "tilevector indices");
+  }
+
+  void check_vtk() {
+    using namespace zs;
+    auto pol = preferred_host_policy();
+    const std::vector<std::array<double, 3>> nodes{
+        {0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {1, 1, 1.25}};
+    const std::vector<std::array<int, 4>> tets{{0, 1, 2, 3}, {1, 2, 3, 4}};
+
+    const std::string ascii
+        = "# vtk DataFile Version 2.0\ntets\nASCII\nDATASET UNSTRUCTURED_GRID\n"
+          "POINTS 5 double\n0 0 0 1 0 0\n0 1 0\n0 0 1 1 1 1.25\n\n"
+          "CELLS 2 10\n4 0 1 2 3\n4 1 2 3 4\n\nCELL_TYPES 2\n10\n10\n"
+          "CELL_DATA 2\nSCALARS id int 1\nLOOKUP_TABLE default\n0\n1\n";
+    const auto asciiPath = write_file("tets.vtk", ascii);
+    for (size_t chunkBytes : {(size_t)3, detail::s_mesh_chunk_bytes}) {
+      Mesh<double, 3, int, 4> mesh;
+      require(read_mesh(pol, asciiPath, mesh, chunkBytes), "read ascii vtk");
+      check_mesh(mesh, nodes, tets, fmt::format("ascii vtk, {} byte chunks", chunkBytes));
+    }
+    Mesh<float, 3, int, 4> legacy;
+    legacy.nodes.push_back({5, 5, 5});
+    require(read_tet_mesh_vtk(asciiPath, legacy), "read_tet_mesh_vtk");
+    require(legacy.nodes.size() == 6 && legacy.elems[1] == (std::array<int, 4>{2, 3, 4, 5}),
+            "read_tet_mesh_vtk appends");
+
+    /// 5.x layout
+    const std::string modern
+        = "# vtk DataFile Version 5.1\ntets\nASCII\nDATASET UNSTRUCTURED_GRID\n"
+          "POINTS 5 float\n0 0 0 1 0 0 0 1 0 0 0 1 1 1 1.25\n"
+          "METADATA\nINFORMATION 0\n\n"
+          "CELLS 3 8\nOFFSETS vtktypeint64\n0 4 8\nCONNECTIVITY vtktypeint64\n0 1 2 3 1 2 3 4\n"
+          "CELL_TYPES 2\n10\n10\n";
+    Mesh<double, 3, int, 4> mesh;
+    require(read_mesh(pol, write_file("modern.vtk", modern), mesh), "read 5.x vtk");
+    check_mesh(mesh, nodes, tets, "5.x ascii vtk");
+
+    /// binary, big endian
+    for (bool modernLayout : {false, true}) {
+      std::string bin = "# vtk DataFile Version 2.0\ntets\nBINARY\nDATASET UNSTRUCTURED_GRID\n";
+      bin += "POINTS 5 double\n";
+      for (auto &p : nodes)
+        for (double x : p) put(bin, x, true);
+      if (modernLayout) {
+        bin += "\nCELLS 3 8\nOFFSETS vtktypeint64\n";
+        for (long long o : {0ll, 4ll, 8ll}) put(bin, o, true);
+        bin += "\nCONNECTIVITY vtktypeint64\n";
+        for (auto &t : tets)
+          for (int v : t) put(bin, (long long)v, true);
+      } else {
+        bin += "\nCELLS 2 10\n";
+        for (auto &t : tets) {
+          put(bin, 4, true);
+          for (int v : t) put(bin, v, true);
+        }
+      }
+      bin += "\nCELL_TYPES 2\n";
+      put(bin, 10, true);
+      put(bin, 10, true);
+      bin += "\n";
+      Mesh<double, 3, int, 4> binMesh;
+      require(read_mesh(pol, write_file("binary.vtk", bin), binMesh), "read binary vtk");
+      check_mesh(binMesh, nodes, tets, modernLayout ? "binary 5.x vtk" : "binary vtk");
+    }
+
+    /// triangles from POLYDATA, cells of the wrong arity are rejected
+    const std::string poly = "# vtk DataFile Version 2.0\nsurface\nASCII\nDATASET POLYDATA\n"
+                             "POINTS 4 float\n0 0 0\n1 0 0\n1 1 0\n0 1 0\n"
+                             "POLYGONS 2 8\n3 0 1 2\n3 0 2 3\n";
+    const auto polyPath = write_file("poly.vtk", poly);
+    Mesh<float, 3, int, 3> surf;
+    require(read_mesh(pol, polyPath, surf), "read polydata");
+    check_mesh(surf, std::vector<std::array<float, 3>>{{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}},
+               std::vector<std::array<int, 3>>{{0, 1, 2}, {0, 2, 3}}, "polydata vtk");
+    Mesh<float, 3, int, 4> wrongArity;
+    require(!read_mesh(pol, polyPath, wrongArity), "arity mismatch");
+  }
+
+  void check_ply() {
+    using namespace zs;
+    auto pol = preferred_host_policy();
+    const std::vector<std::array<float, 3>> nodes{
+        {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0.5f, 2, 0.25f}};
+    const std::vector<std::array<int, 3>> tris{{0, 1, 2}, {0, 2, 3}, {3, 2, 4}};
+
+    const std::string ascii = "ply\nformat ascii 1.0\ncomment made by hand\n"
+                              "element vertex 5\nproperty float x\nproperty float y\n"
+                              "property float z\nproperty float nx\nproperty float ny\n"
+                              "property float nz\nproperty uchar red\n"
+                              "element face 2\nproperty uchar flags\n"
+                              "property list uchar int vertex_indices\nend_header\n"
+                              "0 0 0 0 0 1 255\n1 0 0 0 0 1 0\n1 1 0 0 0 1 0\n0 1 0 0 0 1 3\n"
+                              "0.5 2 0.25 0 1 0 9\n"
+                              "7 4 0 1 2 3\n0 3 3 2 4\n";
+    const auto asciiPath = write_file("ascii.ply", ascii);
+    for (size_t chunkBytes : {(size_t)5, detail::s_mesh_chunk_bytes}) {
+      Mesh<float, 3, int, 3> mesh;
+      require(read_mesh(pol, asciiPath, mesh, chunkBytes), "read ascii ply");
+      check_mesh(mesh, nodes, tris, fmt::format("ascii ply, {} byte chunks", chunkBytes));
+      require(mesh.norms[4] == (std::array<float, 3>{0, 1, 0}), "ascii ply normals");
+    }
+
+    /// binary, all triangles (parallel path) and mixed polygons (serial offsets)
+    std::string polygons;
+    size_t polygonsBody = 0;
+    for (bool bigEndian : {false, true})
+      for (bool quads : {false, true}) {
+        std::string bin = fmt::format(
+            "ply\nformat {} 1.0\nelement vertex 5\nproperty float x\nproperty float y\n"
+            "property float z\nproperty double u\nproperty double v\nelement face {}\n"
+            "property list uchar uint vertex_indices\nproperty short tail\nend_header\n",
+            bigEndian ? "binary_big_endian" : "binary_little_endian", quads ? 2 : 3);
+        for (auto &p : nodes) {
+          for (float x : p) put(bin, x, bigEndian);
+          put(bin, (double)p[0], bigEndian);
+          put(bin, (double)p[1], bigEndian);
+        }
+        const auto face = [&](std::vector<unsigned> ids) {
+          put(bin, (unsigned char)ids.size(), bigEndian);
+          for (auto id : ids) put(bin, id, bigEndian);
+          put(bin, (short)-1, bigEndian);
+        };
+        if (quads)
+          face({0, 1, 2, 3}), face({3, 2, 4});
+        else
+          for (auto &t : tris) face({(unsigned)t[0], (unsigned)t[1], (unsigned)t[2]});
+        const auto tag = fmt::format("binary ply, {}, {}",
+                                     bigEndian ? "big endian" : "little endian",
+                                     quads ? "polygons" : "triangles");
+        if (quads && !bigEndian) {
+          polygons = bin;
+          polygonsBody = bin.find("end_header\n") + 11;
+        }
+        Mesh<float, 3, int, 3> mesh;
+        require(read_mesh(pol, write_file("binary.ply", bin), mesh), "read " + tag);
+        check_mesh(mesh, nodes, tris, tag);
+        require(mesh.uvs[4] == (std::array<float, 2>{0.5f, 2}), "uvs, " + tag);
+        /// no normals in the file, computed from the triangles
+        require(mesh.norms[0] == (std::array<float, 3>{0, 0, 1}), "computed normals, " + tag);
+      }
+
+    const std::string truncated = "ply\nformat binary_little_endian 1.0\nelement vertex 3\n"
+                                  "property float x\nproperty float y\nend_header\n0000";
+    Mesh<float, 3, int, 3> mesh;
+    require(!read_mesh(pol, write_file("truncated.ply", truncated), mesh), "truncated ply");
+
+    /// cut anywhere in the vertex or face data, including within a face's index list
+    for (size_t size = polygonsBody; size != polygons.size(); ++size)
+      require(!read_mesh(pol, write_file("truncated.ply", polygons.substr(0, size)), mesh),
+              fmt::format("binary ply truncated to {} of {} bytes", size, polygons.size()));
+    /// a face (or another list) claiming more indices than the file holds
+    for (bool leadingList : {false, true}) {
+      std::string huge = fmt::format(
+          "ply\nformat binary_little_endian 1.0\n{}element vertex 1\nproperty float x\n"
+          "property float y\nproperty float z\nelement face 1\n"
+          "property list uint uint vertex_indices\nend_header\n",
+          leadingList ? "element extra 1\nproperty list uint uint ids\n" : "");
+      if (leadingList) put(huge, ~0u, false);
+      for (int d = 0; d != 3; ++d) put(huge, 0.f, false);
+      put(huge, leadingList ? 3u : ~0u, false);
+      for (unsigned id = 0; id != 3; ++id) put(huge, 0u, false);
+      require(!read_mesh(pol, write_file("truncated.ply", huge), mesh),
+              leadingList ? "oversized list" : "oversized face");
+    }
+  }
+
+  void check_real_formatting() {
+    using zs::detail::format_real_text;
+    using zs::detail::parse_real_text;
+    std::mt19937_64 rng{11};
+    const auto round_trips = [](auto v) {
+      char buf[64];
+      const char *end = format_real_text(buf, v);
+      double back = -1;
+      const char *stop = parse_real_text(buf, end, back);
+      return stop == end && (decltype(v))back == v
+             && std::signbit((decltype(v))back) == std::signbit(v);
+    };
+    for (float v : {0.f, -0.f, 1.f, -2.5f, 0.1f, 1e-38f, 1e-45f, 3.4028235e38f, 16777217.f})
+      require(round_trips(v), fmt::format("float {} formatting", v));
+    for (double v : {0.0, 0.1, -1e-300, 4.9e-324, 1.7976931348623157e308, 123456789.123456789})
+      require(round_trips(v), fmt::format("double {} formatting", v));
+    for (int i = 0; i != 20000; ++i) {
+      const auto bits = rng();
+      float f;
+      double d;
+      const auto fbits = (unsigned)bits;
+      std::memcpy(&f, &fbits, sizeof(f));
+      std::memcpy(&d, &bits, sizeof(d));
+      if (std::isfinite(f)) require(round_trips(f), fmt::format("float {} formatting", f));
+      if (std::isfinite(d)) require(round_trips(d), fmt::format("double {} formatting", d));
+    }
+  }
+
+  void check_file_stream() {
+    using namespace zs;
+    const auto path = temp_path("stream.bin");
+    {
+      FileStream out{path, FileOpenMode::write};
+      require(out.is_open() && out.is_writable() && !out.is_readable(), "write mode stream");
+      const std::string text = "0123456789";
+      require(out.write(text.data(), text.size()) == 10 && out.tell() == 10, "stream write");
+      require(out.read(nullptr, 1) == -1, "write mode stream is not readable");
+    }
+    {
+      FileStream app{path, FileOpenMode::append};
+      require(app.write("ab", 2) == 2, "stream append");
+    }
+    FileStream in{path, FileOpenMode::read};
+    require(in.is_readable() && !in.is_writable() && in.size() == 12, "read mode stream");
+    char buf[16]{};
+    require(in.seek(8) == 8 && in.read(buf, sizeof(buf)) == 4 && std::string(buf) == "89ab",
+            "stream seek and read");
+    require(in.read(buf, sizeof(buf)) == 0, "stream end");
+    FileStream moved{std::move(in)};
+    require(!in.is_open() && moved.is_open() && moved.seek(-3, SeekOrigin::end) == 9,
+            "moved stream");
+    require(!FileStream{temp_path("missing/stream.bin"), FileOpenMode::write}.is_open(),
+            "stream in a missing directory");
+  }
+
+  /// written meshes read back exactly, whatever the format, encoding and chunking
+  void check_writers() {
+    using namespace zs;
+    auto pol = preferred_host_policy();
+    std::mt19937 rng{5};
+    std::uniform_real_distribution<float> coord{-100.f, 100.f}, unit{0.f, 1.f};
+    const int nn = 2000, ne = 3000;
+    Mesh<float, 3, int, 3> tri;
+    for (int i = 0; i != nn; ++i) {
+      tri.nodes.push_back({coord(rng), coord(rng), coord(rng) * 1e-6f});
+      tri.norms.push_back({unit(rng), -unit(rng), unit(rng)});
+      tri.uvs.push_back({unit(rng), unit(rng)});
+    }
+    /// every node is referenced, obj attributes are bound through the faces
+    for (int e = 0; e != ne; ++e)
+      tri.elems.push_back({e % nn, (int)(rng() % nn), (int)(rng() % nn)});
+
+    const auto check_attributes = [&](const auto &mesh, const std::string &tag) {
+      for (int i = 0; i != nn; ++i)
+        for (int d = 0; d != 3; ++d) {
+          require(mesh.norms[i][d] == tri.norms[i][d], fmt::format("normal {}, {}", i, tag));
+          if (d < 2) require(mesh.uvs[i][d] == tri.uvs[i][d], fmt::format("uv {}, {}", i, tag));
+        }
+    };
+    for (size_t chunkBytes : {(size_t)64, (size_t)1000, detail::s_mesh_chunk_bytes}) {
+      for (auto [name, binary] : {std::pair{"tri.obj", false}, std::pair{"tri.ply", false},
+                                  std::pair{"tri_bin.ply", true}}) {
+        const auto tag = fmt::format("{}, {} byte chunks", name, chunkBytes);
+        const auto path = temp_path(name);
+        require(write_mesh(pol, path, tri, binary, chunkBytes), "write " + tag);
+        Mesh<float, 3, int, 3> mesh;
+        require(read_mesh(pol, path, mesh), "read back " + tag);
+        check_mesh(mesh, tri.nodes, tri.elems, tag);
+        check_attributes(mesh, tag);
+      }
+    }
+
+    /// tetrahedra in double precision through vtk
+    Mesh<double, 3, int, 4> tet;
+    std::uniform_real_distribution<double> dcoord{-1., 1.};
+    for (int i = 0; i != nn; ++i) tet.nodes.push_back({dcoord(rng), dcoord(rng), dcoord(rng)});
+    for (int e = 0; e != ne; ++e)
+      tet.elems.push_back(
+          {(int)(rng() % nn), (int)(rng() % nn), (int)(rng() % nn), (int)(rng() % nn)});
+    for (bool binary : {false, true})
+      for (size_t chunkBytes : {(size_t)100, detail::s_mesh_chunk_bytes}) {
+        const auto tag = fmt::format("{} vtk, {} byte chunks", binary ? "binary" : "ascii",
+                                     chunkBytes);
+        const auto path = temp_path("tet.vtk");
+        require(write_mesh(pol, path, tet, binary, chunkBytes), "write " + tag);
+        Mesh<double, 3, int, 4> mesh;
+        require(read_mesh(pol, path, mesh), "read back " + tag);
+        check_mesh(mesh, tet.nodes, tet.elems, tag);
+      }
+    require(write_tet_mesh_vtk(temp_path("tet_legacy.vtk"), tet), "write_tet_mesh_vtk");
+
+    /// 2d nodes are written on the z = 0 plane
+    Mesh<float, 2, int, 3> flat;
+    flat.nodes = {{0.f, 0.f}, {1.f, 0.f}, {0.f, 1.f}};
+    flat.elems = {{0, 1, 2}};
+    require(write_tri_mesh_obj(temp_path("flat.mesh"), flat), "write_tri_mesh_obj");
+    std::rename(temp_path("flat.mesh").c_str(), temp_path("flat.obj").c_str());
+    Mesh<float, 3, int, 3> lifted;
+    require(read_mesh(pol, temp_path("flat.obj"), lifted), "read back 2d obj");
+    check_mesh(lifted, std::vector<std::array<float, 3>>{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}},
+               flat.elems, "2d obj");
+
+    /// tilevector source
+    TileVector<float, 32> verts{{{"x", 3}, {"nrm", 3}, {"uv", 2}}, (size_t)nn},
+        elems{{{"inds", 3}}, (size_t)ne};
+    {
+      auto vs = proxy<execspace_e::host>({}, verts);
+      auto es = proxy<execspace_e::host>({}, elems);
+      for (int i = 0; i != nn; ++i)
+        for (int d = 0; d != 3; ++d) {
+          vs("x", d, i) = tri.nodes[i][d];
+          vs("nrm", d, i) = tri.norms[i][d];
+          if (d < 2) vs("uv", d, i) = tri.uvs[i][d];
+        }
+      for (int e = 0; e != ne; ++e)
+        for (int j = 0; j != 3; ++j) es("inds", j, e, wrapt<int>{}) = tri.elems[e][j];
+    }
+    for (bool binary : {false, true}) {
+      const auto path = temp_path("tiles.ply");
+      require(write_mesh(pol, path, verts, elems, "x", "inds", binary), "write tilevectors");
+      Mesh<float, 3, int, 3> mesh;
+      require(read_mesh(pol, path, mesh), "read back tilevectors");
+      check_mesh(mesh, tri.nodes, tri.elems, "tilevector ply");
+      check_attributes(mesh, "tilevector ply");
+    }
+
+    /// exported from the io worker while the caller keeps its own copy
+    auto done = write_mesh_async(temp_path("async.ply"), tri, true);
+    require(done.get(), "asynchronous write");
+    Mesh<float, 3, int, 3> mesh;
+    require(read_mesh(pol, temp_path("async.ply"), mesh), "read back asynchronous write");
+    check_mesh(mesh, tri.nodes, tri.elems, "asynchronous ply");
+
+    require(!write_mesh(pol, temp_path("tri_bin.obj"), tri, true), "binary obj is rejected");
+    require(!write_mesh(pol, temp_path("tri.stl"), tri), "unknown extension is rejected");
+    require(!write_mesh(pol, temp_path("missing/tri.obj"), tri), "missing directory");
+  }
+
+}  // namespace
+
+int main() {
+  try {
+    check_real_parsing();
+    check_obj();
+    check_large_obj();
+    check_vtk();
+    check_ply();
+    check_real_formatting();
+    check_file_stream();
+    check_writers();
+    fmt::print("mesh io checks passed\n");
+    return 0;
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return 1;
+  }
+}
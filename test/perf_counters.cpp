@@ -0,0 +1,86 @@
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/omp/execution/ExecutionPolicy.hpp"
+#include "zensim/profile/KernelProfiler.hpp"
+#include "zensim/profile/PerfCounters.hpp"
+#include "zensim/zpc_tpls/fmt/core.h"
+
+namespace {
+
+  void require(bool cond, const char *msg) {
+    if (!cond) throw std::runtime_error(std::string("perf counter check failed: ") + msg);
+  }
+
+}  // namespace
+
+int main() {
+  using namespace zs;
+  const bool supported = PerfCounters::supported();
+  fmt::print("hardware counters {}\n", supported ? "available" : "unavailable");
+
+  /// scoped sampling on the calling thread
+  std::vector<double> vals(1 << 20, 1.);
+  {
+    PerfCounterScope scope{};
+    double sum = 0;
+    for (auto v : vals) sum += v;
+    auto deltas = scope.stop();
+    require(sum == (double)vals.size(), "reduction result");
+    require(scope.available() == supported, "scope availability");
+    if (supported) {
+      require(deltas.valid(perf_instructions) && deltas[perf_instructions] > vals.size(),
+              "instructions retired by the scope");
+      fmt::print("scope: {} instructions, {} cycles, ipc {:.2f}\n", deltas[perf_instructions],
+                 deltas[perf_cycles], deltas.ipc());
+    } else
+      require(deltas.mask == 0, "no readings without counters");
+  }
+
+  /// exited threads detach, their counts stay in the sums
+  if (supported) {
+    const auto numAttached = PerfCounters::numAttachedThreads();
+    const auto before = PerfCounters::read();
+    std::thread worker{[&vals] {
+      PerfCounters::attachCurrentThread();
+      double sum = 0;
+      for (auto v : vals) sum += v;
+      require(sum == (double)vals.size(), "worker reduction result");
+    }};
+    worker.join();
+    const auto after = PerfCounters::read();
+    require(PerfCounters::numAttachedThreads() == numAttached, "exited thread detached");
+    require(after[perf_instructions] >= before[perf_instructions] + vals.size(),
+            "counts of the exited thread retained");
+  }
+
+  /// per-launch sampling through the profiled omp policy
+  auto &profiler = KernelProfiler::instance();
+  profiler.clear();
+  auto pol = omp_exec().threads(2).profile(true).perfCounters(true);
+  for (int iter = 0; iter != 4; ++iter)
+    pol(range(vals.size()), [&vals](size_t i) { vals[i] = vals[i] * 1.5 + 1; });
+  auto records = profiler.aggregate();
+  require(records.size() == 1 && records[0].count == 4, "one record of four launches");
+  if (supported) {
+    require(PerfCounters::numAttachedThreads() >= 2, "pool threads attached");
+    require(records[0].countedLaunches == 4, "launches carry counters");
+    require(records[0].counters.valid(perf_cycles)
+                && records[0].counters[perf_instructions] > vals.size(),
+            "accumulated counters");
+  } else
+    require(records[0].countedLaunches == 0, "launches without counters");
+  profiler.report();
+
+  /// disabled sampling keeps plain timings
+  profiler.clear();
+  pol.perfCounters(false);
+  pol(range(vals.size()), [&vals](size_t i) { vals[i] -= 1; });
+  records = profiler.aggregate();
+  require(records.size() == 1 && records[0].countedLaunches == 0, "counters are opt-in");
+  return 0;
+}
@@ -0,0 +1,141 @@
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/container/CellList.hpp"
+#include "zensim/geometry/AnalyticLevelSet.h"
+#include "zensim/geometry/PoissonDisk.hpp"
+#include "zensim/zpc_tpls/fmt/core.h"
+
+namespace {
+
+  void require(bool cond, const std::string &msg) {
+    if (!cond) throw std::runtime_error("poisson disk check failed: " + msg);
+  }
+
+  template <int dim> using point_t = zs::vec<float, dim>;
+
+  template <int dim, typename TileVectorT>
+  zs::Vector<point_t<dim>> positions(const TileVectorT &tv) {
+    using namespace zs;
+    zs::Vector<point_t<dim>> ret{tv.size()};
+    auto tvv = view<execspace_e::host>({}, tv);
+    for (size_t i = 0; i != tv.size(); ++i) ret[i] = tvv.pack(dim_c<dim>, "x", i);
+    return ret;
+  }
+
+  /// no two samples closer than [r], every probe of the interior within [r] of some sample
+  template <int dim, typename Ls>
+  void check_samples(const Ls &ls, const zs::Vector<point_t<dim>> &xs, float r,
+                     const std::string &tag) {
+    using namespace zs;
+    auto pol = preferred_host_policy();
+    constexpr auto space = RM_REF_T(pol)::exec_tag::value;
+    require(xs.size() > 0, "non-empty, " + tag);
+    for (size_t i = 0; i != xs.size(); ++i)
+      require(ls.getSignedDistance(xs[i]) < 0, "samples lie inside, " + tag);
+
+    CellList<dim> cl{};
+    cl.build(pol, r, xs);
+    Vector<int> conflicts{1};
+    conflicts.setVal(0);
+    pol(range(xs.size()), [cl = proxy<space>(cl), xs = proxy<space>(xs),
+                           conflicts = proxy<space>(conflicts), r](size_t i) mutable {
+      cl.iter_neighbors(xs[i], r, [&](int j, float d2) {
+        if (j != (int)i && d2 < r * r * (1 - 1e-5f)) atomic_add(wrapv<space>{}, &conflicts[0], 1);
+      });
+    });
+    require(conflicts.getVal() == 0, fmt::format("{} samples closer than r, {}", conflicts.getVal(), tag));
+
+    auto [lo, hi] = ls.getBoundingBox();
+    std::mt19937 rng{5};
+    int probes = 0, uncovered = 0;
+    auto clv = proxy<execspace_e::host>(cl);
+    while (probes != 4000) {
+      point_t<dim> p{};
+      for (int d = 0; d != dim; ++d)
+        p[d] = std::uniform_real_distribution<float>{lo[d], hi[d]}(rng);
+      if (ls.getSignedDistance(p) > -r) continue;
+      ++probes;
+      int ids[1];
+      float d2s[1];
+      if (clv.knn(p, r, ids, d2s) == 0) ++uncovered;
+    }
+    require(uncovered < probes / 50,
+            fmt::format("{} of {} interior probes uncovered, {}", uncovered, probes, tag));
+  }
+
+  void check_sphere() {
+    using namespace zs;
+    using Sphere = AnalyticLevelSet<analytic_geometry_e::Sphere, float, 3>;
+    auto pol = preferred_host_policy();
+    const Sphere sphere{point_t<3>{0.5f, -1.f, 2.f}, 1.f};
+    const float r = 0.05f;
+
+    TileVector<float, 32> tv{{{"m", 1}, {"x", 3}, {"v", 3}}, 0};
+    const auto n = poisson_disk_sample(pol, sphere, r, tv, "x", 7);
+    require(n == tv.size(), "tilevector resized");
+    const auto xs = positions<3>(tv);
+    check_samples<3>(sphere, xs, r, "sphere");
+
+    /// deterministic upon the seed, regardless of the policy
+    TileVector<float, 8> other{{{"x", 3}}, 0};
+    poisson_disk_sample(seq_exec(), sphere, r, other, "x", 7);
+    const auto ys = positions<3>(other);
+    require(ys.size() == xs.size(), "policy independent count");
+    for (size_t i = 0; i != xs.size(); ++i)
+      require((xs[i] - ys[i]).l2NormSqr() == 0.f, "policy independent samples");
+    poisson_disk_sample(pol, sphere, r, other, "x", 8);
+    require(other.size() != n || (positions<3>(other)[0] - xs[0]).l2NormSqr() != 0.f,
+            "seed changes the samples");
+
+    bool thrown = false;
+    try {
+      poisson_disk_sample(pol, sphere, r, tv, "m");
+    } catch (const std::runtime_error &) {
+      thrown = true;
+    }
+    require(thrown, "position property extent checked");
+  }
+
+  void check_cuboid_2d() {
+    using namespace zs;
+    using Box = AnalyticLevelSet<analytic_geometry_e::Cuboid, float, 2>;
+    auto pol = preferred_host_policy();
+    const Box box{point_t<2>{-1.f, 0.f}, point_t<2>{2.f, 0.5f}};
+    TileVector<float, 16> tv{{{"x", 2}}, 0};
+    poisson_disk_sample(pol, box, 0.02f, tv);
+    check_samples<2>(box, positions<2>(tv), 0.02f, "2d cuboid");
+  }
+
+  /// the scene builder path no longer relies on a precomputed sample tile
+  void check_sample_from_levelset() {
+    using namespace zs;
+    using Sphere = AnalyticLevelSet<analytic_geometry_e::Sphere, float, 3>;
+    const Sphere sphere{point_t<3>{0.f, 0.f, 0.f}, 0.5f};
+    const float dx = 0.05f, ppc = 8.f;
+    auto samples = sample_from_levelset(sphere, dx, ppc);
+    zs::Vector<point_t<3>> xs{samples.size()};
+    for (size_t i = 0; i != samples.size(); ++i) xs[i] = point_t<3>::from_array(samples[i]);
+    check_samples<3>(sphere, xs, poisson_disk_distance_by_ppc<3>(dx, ppc), "sample_from_levelset");
+    const float expected = 4.f / 3 * 3.14159265f * 0.125f / (dx * dx * dx) * ppc;
+    require(samples.size() > expected * 0.8f && samples.size() < expected * 1.2f,
+            fmt::format("{} samples for ppc {} ({} expected)", samples.size(), ppc, expected));
+  }
+
+}  // namespace
+
+int main() {
+  try {
+    check_sphere();
+    check_cuboid_2d();
+    check_sample_from_levelset();
+    fmt::print("poisson disk checks passed\n");
+    return 0;
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return 1;
+  }
+}
@@ -0,0 +1,135 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "zensim/reflect/ZpcReflectObject.hpp"
+#include "zensim/reflect/ZpcReflectRegistry.hpp"
+
+using namespace zs::reflect;
+
+namespace {
+
+  struct Particle {
+    float x{0}, v{0}, m{1};
+  };
+
+  constexpr int kNumTypes = 64;
+  std::vector<std::string> typeNames, fieldNames;
+  std::vector<FieldInfo> fieldInfos;
+  std::vector<TypeInfo> typeInfos;
+
+  template <int I> void getParticleField(const void* obj, Any* out) {
+    *out = Any((&static_cast<const Particle*>(obj)->x)[I]);
+  }
+  template <int I> void setParticleField(void* obj, const Any* val) {
+    (&static_cast<Particle*>(obj)->x)[I] = val->as<float>();
+  }
+  const FieldAccessor particleFields[] = {{"x", &getParticleField<0>, &setParticleField<0>},
+                                          {"v", &getParticleField<1>, &setParticleField<1>},
+                                          {"m", &getParticleField<2>, &setParticleField<2>}};
+
+  int check(bool cond, const char* msg) {
+    if (!cond) std::fprintf(stderr, "reflect registry check failed: %s\n", msg);
+    return cond ? 0 : 1;
+  }
+
+}  // namespace
+
+int main() {
+  constexpr int kNumFields = 40;
+  typeNames.reserve(kNumTypes);
+  fieldNames.reserve(kNumFields);
+  for (int f = 0; f < kNumFields; ++f) fieldNames.push_back("field" + std::to_string(f));
+  fieldInfos.resize(kNumFields);
+  for (int f = 0; f < kNumFields; ++f) {
+    fieldInfos[f].name = fieldNames[f].c_str();
+    fieldInfos[f].typeName = "float";
+  }
+  typeInfos.resize(kNumTypes);
+  for (int t = 0; t < kNumTypes; ++t) {
+    typeNames.push_back("ns::Type" + std::to_string(t));
+    typeInfos[t].name = typeNames[t].c_str();
+    typeInfos[t].typeHash = detail::fnv1a_64(typeInfos[t].name);
+    typeInfos[t].fields = fieldInfos.data();
+    typeInfos[t].fieldCount = kNumFields;
+    TypeRegistry::registerType(&typeInfos[t]);
+  }
+  TypeInfo particleInfo{};
+  particleInfo.name = "ns::Particle";
+  particleInfo.typeHash = detail::fnv1a_64(particleInfo.name);
+  Accessor particleAccessor{&particleInfo, particleFields, 3, nullptr, 0};
+  AutoRegisterAccessor reg{particleInfo.typeHash, &particleAccessor};
+
+  int failures = 0;
+  for (int pass = 0; pass < 2; ++pass) {
+    if (pass == 1) {
+      TypeRegistry::freeze();
+      AccessorRegistry::freeze();
+      failures += check(TypeRegistry::frozen() && AccessorRegistry::frozen(), "freeze");
+    }
+    for (int t = 0; t < kNumTypes; ++t) {
+      const TypeInfo* info = &typeInfos[t];
+      failures += check(TypeRegistry::findByName(info->name) == info, "type by name");
+      failures += check(TypeRegistry::findByName(NameHandle{info->name}) == info,
+                        "type by handle");
+      failures += check(TypeRegistry::findByHash(info->typeHash) == info, "type by hash");
+    }
+    failures += check(TypeRegistry::findByName("ns::Missing") == nullptr, "missing type");
+    failures += check(TypeRegistry::findByHash(0) == nullptr, "missing hash");
+
+    const TypeInfo& info = typeInfos[7];
+    for (int f = 0; f < kNumFields; ++f) {
+      failures += check(info.findField(fieldNames[f].c_str()) == &fieldInfos[f], "field by name");
+      failures += check(info.findField(NameHandle{fieldNames[f].c_str()}) == &fieldInfos[f],
+                        "field by handle");
+    }
+    failures += check(info.findField("field40") == nullptr, "missing field");
+
+    static constexpr NameHandle kV{"v"};
+    Particle p{};
+    failures += check(AccessorRegistry::find(particleInfo.typeHash) == &particleAccessor,
+                      "accessor by hash");
+    failures += check(AccessorRegistry::findByName("ns::Particle") == &particleAccessor,
+                      "accessor by name");
+    Any val(2.5f + pass);
+    failures += check(particleAccessor.setField(&p, kV, &val), "accessor setField");
+    Any out;
+    failures += check(particleAccessor.getField(&p, "v", &out) && out.as<float>() == p.v
+                          && p.v == 2.5f + pass,
+                      "accessor getField");
+    failures += check(!particleAccessor.hasField("w"), "missing accessor field");
+  }
+
+  /// registration is rejected while frozen, the indices stay intact for concurrent lookups
+  TypeInfo late{};
+  late.name = "ns::Late";
+  late.typeHash = detail::fnv1a_64(late.name);
+  failures += check(!TypeRegistry::registerType(&late), "registration rejected while frozen");
+  failures += check(!TypeRegistry::unregisterType(typeInfos[7].typeHash),
+                    "unregistration rejected while frozen");
+  failures += check(TypeRegistry::frozen() && typeInfos[7].fieldIndex != nullptr,
+                    "indices kept while frozen");
+  failures += check(TypeRegistry::findByName("ns::Late") == nullptr, "rejected type");
+  Accessor lateAccessor{&late, particleFields, 3, nullptr, 0};
+  AccessorEntry lateEntry{late.typeHash, &lateAccessor, nullptr};
+  failures += check(!AccessorRegistry::add(&lateEntry), "accessor rejected while frozen");
+
+  /// an explicit thaw releases the per-type name indices along with the registry's own
+  TypeRegistry::thaw();
+  failures += check(!TypeRegistry::frozen(), "thaw");
+  failures += check(typeInfos[7].fieldIndex == nullptr, "field index released on thaw");
+  failures += check(typeInfos[7].findField("field3") == &fieldInfos[3], "thawed field lookup");
+  failures += check(TypeRegistry::registerType(&late), "registration after thaw");
+  failures += check(TypeRegistry::findByName("ns::Late") == &late, "late type");
+  TypeRegistry::freeze();
+  failures += check(TypeRegistry::findByHash(late.typeHash) == &late, "late type refrozen");
+  failures += check(typeInfos[7].fieldIndex != nullptr, "field index rebuilt");
+  AccessorRegistry::thaw();
+  failures += check(AccessorRegistry::add(&lateEntry), "accessor after thaw");
+  AccessorRegistry::freeze();
+  failures += check(AccessorRegistry::find(late.typeHash) == &lateAccessor, "late accessor");
+  TypeRegistry::thaw();
+  failures += check(TypeRegistry::unregisterType(typeInfos[7].typeHash), "unregister after thaw");
+  failures += check(TypeRegistry::findByHash(typeInfos[7].typeHash) == nullptr, "unregistered");
+  return failures;
+}
@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/container/TileVector.hpp"
+#include "zensim/omp/execution/ScatterReduction.hpp"
+
+int main() {
+  using namespace zs;
+  /// at least a few threads so that multiple private buffers get merged
+  auto pol = omp_exec().threads(std::max(4u, default_omp_threads()));
+  constexpr auto space = execspace_e::openmp;
+
+  /// p2g-like scatter: particles clustered within a few cells of a 32^3 grid
+  constexpr int res = 32, numCells = res * res * res, numParticles = 1 << 20;
+  std::mt19937 rng{0};
+  std::normal_distribution<float> dist{res * 0.5f, 2.f};
+  std::vector<int> cellIds(numParticles);
+  std::vector<float> masses(numParticles);
+  for (int p = 0; p != numParticles; ++p) {
+    int c[3];
+    for (int d = 0; d != 3; ++d) c[d] = std::min(std::max((int)dist(rng), 0), res - 1);
+    cellIds[p] = (c[0] * res + c[1]) * res + c[2];
+    masses[p] = 1.f + (p % 7) * 0.125f;
+  }
+  std::vector<double> ref((size_t)numCells * 4, 0.);
+  for (int p = 0; p != numParticles; ++p)
+    for (int d = 0; d != 4; ++d) ref[(size_t)cellIds[p] * 4 + d] += masses[p] * (d + 1);
+
+  TileVector<float, 32> grid{{{"m", 1}, {"mv", 3}}, (size_t)numCells};
+  auto check = [&](const char *tag) {
+    auto gv = view<space>({}, grid);
+    for (int c = 0; c != numCells; ++c)
+      for (int d = 0; d != 4; ++d) {
+        double v = gv(d, c), r = ref[(size_t)c * 4 + d];
+        if (std::abs(v - r) > 1e-4 * std::abs(r) + 1e-4) {
+          std::fprintf(stderr, "%s: cell %d chn %d got %f expected %f\n", tag, c, d, v, r);
+          throw std::runtime_error("scatter reduction mismatch");
+        }
+      }
+  };
+  auto scatter = [&](auto &&add) {
+    grid.reset(0);
+    pol(range(numParticles), [&, gv = view<space>({}, grid)](int p) mutable {
+      const auto c = cellIds[p];
+      add(&gv("m", c), masses[p]);
+      for (int d = 0; d != 3; ++d) add(&gv("mv", d, c), masses[p] * (d + 2));
+    });
+  };
+
+  scatter([](float *dst, float v) { atomic_add(exec_omp, dst, v); });
+  check("atomic_add");
+
+  ScatterReducer<float> dense{pol, grid.data(), grid.bufferSize()};
+  scatter([&dense](float *dst, float v) { atomic_add(dense, dst, v); });
+  dense.merge(pol);
+  check("dense scatter reduction");
+  /// buffers are reused by subsequent passes
+  scatter([&dense](float *dst, float v) { atomic_add(dense, dst, v); });
+  dense.merge(pol);
+  check("dense scatter reduction (reuse)");
+
+  HashedScatterReducer<float> hashed{pol, grid.data(), grid.bufferSize()};
+  scatter([&hashed](float *dst, float v) { atomic_add(hashed, dst, v); });
+  hashed.merge(pol);
+  check("hashed scatter reduction");
+  return 0;
+}
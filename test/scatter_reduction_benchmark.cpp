@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/container/TileVector.hpp"
+#include "zensim/omp/execution/ScatterReduction.hpp"
+
+namespace {
+
+  using clock_t = std::chrono::steady_clock;
+
+  template <typename F> double time_ms(F &&f) {
+    f();  // warm up
+    const int reps = 5;
+    const auto start = clock_t::now();
+    for (int r = 0; r != reps; ++r) f();
+    return std::chrono::duration<double, std::milli>(clock_t::now() - start).count() / reps;
+  }
+
+}  // namespace
+
+int main() {
+  using namespace zs;
+  auto pol = omp_exec();
+  constexpr auto space = execspace_e::openmp;
+
+  /// p2g-like scatter into a 64^3 grid, particles clustered (heavy conflicts) or spread out
+  constexpr int res = 64, numCells = res * res * res, numParticles = 1 << 22;
+  TileVector<float, 32> grid{{{"m", 1}, {"mv", 3}}, (size_t)numCells};
+  std::vector<int> cellIds(numParticles);
+  std::vector<float> masses(numParticles);
+  for (int p = 0; p != numParticles; ++p) masses[p] = 1.f + (p % 7) * 0.125f;
+
+  auto scatter = [&](auto &&add) {
+    grid.reset(0);
+    pol(range(numParticles), [&, gv = view<space>({}, grid)](int p) mutable {
+      const auto c = cellIds[p];
+      add(&gv("m", c), masses[p]);
+      for (int d = 0; d != 3; ++d) add(&gv("mv", d, c), masses[p] * (d + 2));
+    });
+  };
+
+  ScatterReducer<float> dense{pol, grid.data(), grid.bufferSize()};
+  HashedScatterReducer<float> hashed{pol, grid.data(), grid.bufferSize()};
+  for (float spread : {2.f, (float)res}) {
+    std::mt19937 rng{0};
+    std::normal_distribution<float> dist{res * 0.5f, spread};
+    for (int p = 0; p != numParticles; ++p) {
+      int c[3];
+      for (int d = 0; d != 3; ++d) c[d] = std::min(std::max((int)dist(rng), 0), res - 1);
+      cellIds[p] = (c[0] * res + c[1]) * res + c[2];
+    }
+    const auto tAtomic
+        = time_ms([&] { scatter([](float *dst, float v) { atomic_add(exec_omp, dst, v); }); });
+    const auto tDense = time_ms([&] {
+      scatter([&dense](float *dst, float v) { atomic_add(dense, dst, v); });
+      dense.merge(pol);
+    });
+    const auto tHashed = time_ms([&] {
+      scatter([&hashed](float *dst, float v) { atomic_add(hashed, dst, v); });
+      hashed.merge(pol);
+    });
+    std::printf(
+        "scatter-add, spread %.0f cells (%d threads): atomic %.2f ms, dense %.2f ms, hashed "
+        "%.2f ms\n",
+        spread, pol.getThreads(), tAtomic, tDense, tHashed);
+  }
+  return 0;
+}
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/memory/Allocator.h"
+#include "zensim/omp/execution/ExecutionPolicy.hpp"
+#include "zensim/zpc_tpls/fmt/core.h"
+
+namespace {
+
+  void require(bool cond, const char *msg) {
+    if (!cond) throw std::runtime_error(std::string("scratch arena check failed: ") + msg);
+  }
+
+}  // namespace
+
+int main() {
+  using namespace zs;
+
+  /// bump allocation, stack-like release and rewinding
+  {
+    scratch_arena arena{(size_t)1 << 22};
+    auto a = static_cast<char *>(arena.allocate(1000, 64));
+    auto b = static_cast<char *>(arena.allocate(5000, 256));
+    require(a && b && b > a && (uintptr_t)b % 256 == 0, "aligned bump allocation");
+    a[999] = b[4999] = 1;  // committed
+    auto c = arena.allocate(100, 8);
+    arena.deallocate(c, 100, 8);
+    require(arena.allocate(100, 8) == c, "top block popped");
+    arena.deallocate(c, 100, 8);
+    arena.deallocate(a, 1000, 64);  // inner block
+    require(arena.stats().used > 0, "inner release keeps the top");
+    arena.deallocate(b, 5000, 256);
+    auto stats = arena.stats();
+    require(stats.used == 0, "rewound once idle");
+    require(stats.highWater >= 6000 && stats.committed >= stats.highWater, "high-water mark");
+    require(arena.allocate(64, 64) == a, "reuses the committed pages");
+    arena.deallocate(a, 64, 64);
+  }
+  /// released blocks beneath the top are popped along with it
+  {
+    scratch_arena arena{(size_t)1 << 22};
+    auto keep = arena.allocate(128, 64);
+    auto a = arena.allocate(128, 64);
+    auto b = arena.allocate(128, 64);
+    arena.deallocate(a, 128, 64);
+    arena.deallocate(b, 128, 64);
+    require(arena.stats().used == 128, "holes merged into the top");
+    arena.deallocate(keep, 128, 64);
+  }
+  /// requests beyond the reservation fall back upstream and grow the reservation
+  {
+    scratch_arena arena{(size_t)1 << 21};
+    const size_t big = (size_t)3 << 21;
+    auto p = static_cast<char *>(arena.allocate(big, 64));
+    p[big - 1] = 1;
+    auto stats = arena.stats();
+    require(stats.numFallbacks == 1 && stats.highWater >= big, "upstream fallback");
+    arena.deallocate(p, big, 64);
+    stats = arena.stats();
+    require(stats.numGrows == 1 && stats.reserved >= big, "grown upon rewind");
+    p = static_cast<char *>(arena.allocate(big, 64));
+    require(arena.stats().numFallbacks == 1, "served by the grown arena");
+    arena.deallocate(p, big, 64);
+    require(arena.trim() && arena.stats().committed == 0, "trimmed");
+  }
+
+  /// omp primitives draw their scratch from the per-thread arena
+  {
+    auto pol = omp_exec();
+    const size_t n = 1 << 18;
+    std::vector<u32> keys(n), sorted(n), scanned(n);
+    std::mt19937 gen{7};
+    for (auto &k : keys) k = gen() % 100000;
+    size_t committed = 0;
+    for (int iter = 0; iter != 8; ++iter) {
+      exclusive_scan(pol, keys.begin(), keys.end(), scanned.begin());
+      radix_sort(pol, keys.begin(), keys.end(), sorted.begin());
+      require(std::is_sorted(sorted.begin(), sorted.end()), "radix sort");
+      require(scanned.back() + keys.back()
+                  == std::accumulate(keys.begin(), keys.end(), (u32)0),
+              "exclusive scan");
+      auto stats = get_temporary_memory_stats(pol);
+      require(stats.used == 0, "scratch released after each primitive");
+      if (iter == 0)
+        committed = stats.committed;
+      else
+        require(stats.committed == committed, "no further commits once warmed up");
+    }
+    auto stats = get_temporary_memory_stats(pol);
+    fmt::print("omp scratch: high water {} bytes, {} committed, {} allocations\n",
+               stats.highWater, stats.committed, stats.numAllocations);
+    require(stats.numAllocations > 0 && stats.highWater > 0, "scratch in use");
+    require(trim_temporary_memory(pol), "trim idle arena");
+  }
+  return 0;
+}
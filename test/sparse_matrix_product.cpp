@@ -0,0 +1,85 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/math/matrix/SparseMatrixOperations.hpp"
+
+namespace {
+
+  template <typename SpMat> std::vector<double> dense(const SpMat &spmat) {
+    const int nrows = spmat.rows(), ncols = spmat.cols();
+    std::vector<double> ret((size_t)nrows * ncols, 0.);
+    for (int i = 0; i != nrows; ++i)
+      for (auto k = spmat._ptrs[i]; k != spmat._ptrs[i + 1]; ++k)
+        ret[(size_t)i * ncols + spmat._inds[k]] += spmat._vals[k];
+    return ret;
+  }
+
+}  // namespace
+
+int main() {
+  using namespace zs;
+  auto pol = preferred_host_policy();
+  using spmat_t = SparseMatrix<double, true, int, int>;
+
+  /// random jacobian-like J (m x n) and diagonal mass M (n x n)
+  constexpr int m = 300, n = 500, nnzPerRow = 6;
+  std::mt19937 rng{0};
+  std::uniform_int_distribution<int> col{0, n - 1};
+  std::uniform_real_distribution<double> val{-1., 1.};
+  std::vector<int> is, js, ms;
+  std::vector<double> vs, mvs;
+  for (int i = 0; i != m; ++i)
+    for (int k = 0; k != nnzPerRow; ++k) {
+      is.push_back(i);
+      js.push_back(col(rng));
+      vs.push_back(val(rng));
+    }
+  for (int i = 0; i != n; ++i) {
+    ms.push_back(i);
+    mvs.push_back(1. + std::abs(val(rng)));
+  }
+  spmat_t J{m, n}, Minv{n, n}, Jt{n, m};
+  J.build(pol, m, n, is, js, vs);
+  J.localOrdering(pol);
+  Minv.build(pol, n, n, ms, ms, mvs);
+  Jt.transposeFrom(pol, J);
+
+  /// J M^{-1} J^T
+  auto JMinv = spgemm(pol, J, Minv);
+  auto C = spgemm(pol, JMinv, Jt);
+  if (C.rows() != m || C.cols() != m) throw std::runtime_error("spgemm output size mismatch");
+  for (int i = 0; i != m; ++i)
+    for (auto k = C._ptrs[i] + 1; k < C._ptrs[i + 1]; ++k)
+      if (C._inds[k - 1] >= C._inds[k]) throw std::runtime_error("spgemm output is not sorted");
+
+  auto check = [&]() {
+    auto dJ = dense(J), dM = dense(Minv), dC = dense(C);
+    for (int i = 0; i != m; ++i)
+      for (int j = 0; j != m; ++j) {
+        double ref = 0;
+        for (int k = 0; k != n; ++k) ref += dJ[i * n + k] * dM[k * n + k] * dJ[j * n + k];
+        if (std::abs(ref - dC[i * m + j]) > 1e-10)
+          throw std::runtime_error("spgemm value mismatch");
+      }
+  };
+  check();
+
+  /// rows are batched by their table sizes, an oversized row forms a batch of its own
+  {
+    const int rowOffsets[] = {0, 3, 5, 5, 20, 21, 22};
+    size_t scratchSlots = 0;
+    const auto bounds = _spgemm_row_batches(rowOffsets, 6, scratchSlots, 12);
+    if (bounds != std::vector<size_t>{0, 3, 4, 6} || scratchSlots != 30)
+      throw std::runtime_error("spgemm row batches");
+  }
+
+  /// numeric phase only, upon unchanged patterns
+  for (auto &v : mvs) v *= 2;
+  Minv.build(pol, n, n, ms, ms, mvs);
+  spgemm_numeric(pol, J, Minv, JMinv);
+  spgemm_numeric(pol, JMinv, Jt, C);
+  check();
+  return 0;
+}
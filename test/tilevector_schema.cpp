@@ -0,0 +1,85 @@
+#include <stdexcept>
+
+#include "utils/initialization.hpp"
+#include "zensim/container/TileVector.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+
+namespace {
+
+  struct pos_tag {
+    static constexpr const char *name = "x";
+  };
+  struct vel_tag {
+    static constexpr const char *name = "v";
+  };
+  struct mass_tag {
+    static constexpr const char *name = "m";
+  };
+
+}  // namespace
+
+int main() {
+  using namespace zs;
+  auto pol = preferred_host_policy();
+  constexpr auto space = execspace_e::openmp;
+
+  using schema_t = PropertySchema<PropertyDecl<mass_tag, 1>, PropertyDecl<pos_tag, 3>,
+                                  PropertyDecl<vel_tag, 3>>;
+  static_assert(schema_t::num_channels == 7);
+  static_assert(schema_t::handle<pos_tag>.offset == 1 && schema_t::handle<pos_tag>.extent == 3);
+  static_assert(schema_t::handle<vel_tag>.offset == 4);
+  static_assert(!schema_t::has_property<int>);
+
+  constexpr size_t n = 1000;
+  TileVector<float, 32> pars{schema_t::tags(), n};
+  schema_t::validate(pars);
+
+  /// write through compile-time handles, upon an unnamed view
+  pol(range(n), [pars = view<space>(pars), x = schema_t::handle<pos_tag>,
+                 v = schema_t::handle<vel_tag>,
+                 m = schema_t::handle<mass_tag>] ZS_LAMBDA(size_t i) mutable {
+    pars(m, i) = 1.f + i;
+    for (int d = 0; d != 3; ++d) {
+      pars(x, d, i) = (float)(i * 3 + d);
+      pars(v, d, i) = -(float)(i * 3 + d);
+    }
+  });
+
+  /// read through runtime handles and compare against name-based access
+  const auto x = pars.getPropertyHandle("x");
+  const auto v = pars.getPropertyHandle("v");
+  if (x.offset != 1 || x.extent != 3 || !v.valid())
+    throw std::runtime_error("runtime property handle mismatch");
+  auto named = view<space>({}, pars);
+  if (named.propertyHandle("m").offset != 0 || named.propertyHandle("w").valid())
+    throw std::runtime_error("view property handle mismatch");
+  int mismatches = 0;
+  pol(range(n), [pars = view<space>(pars), named, x, v, &mismatches](size_t i) {
+    auto xi = pars.pack(dim_c<3>, x, i);
+    auto vi = pars.pack<3>(schema_t::handle<vel_tag>, i);
+    auto [a, b, c] = pars.tuple(dim_c<3>, v, i);
+    bool ok = xi == named.pack(dim_c<3>, "x", i) && vi == named.pack(dim_c<3>, "v", i)
+              && a == vi[0] && b == vi[1] && c == vi[2]
+              && pars(schema_t::handle<mass_tag>, i) == named("m", i) && pars(x, 2, i) == xi[2];
+    if (!ok) atomic_add(exec_omp, &mismatches, 1);
+  });
+  if (mismatches) throw std::runtime_error("handle-based access differs from named access");
+
+  /// layout checks
+  bool thrown = false;
+  try {
+    pars.getPropertyHandle("w");
+  } catch (const std::runtime_error &) {
+    thrown = true;
+  }
+  if (!thrown) throw std::runtime_error("missing property should throw");
+  thrown = false;
+  try {
+    TileVector<float, 32> other{{{"x", 3}, {"m", 1}, {"v", 3}}, n};
+    schema_t::validate(other);
+  } catch (const std::runtime_error &) {
+    thrown = true;
+  }
+  if (!thrown) throw std::runtime_error("schema mismatch should throw");
+  return 0;
+}